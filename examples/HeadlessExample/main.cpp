@@ -100,14 +100,12 @@ int main( int argc, const char* argv[] ) {
     }
     else {
         if ( viewerParameters.m_animationEnable ) {
-            // compute 2s of animation at 30fps
+            // compute 2s of animation at 30fps, and write them to prefix<i>.<format>
+            // (use --batch to overlap the image writing with the rendering)
             float duration = 2;
             float fps      = 30;
-            for ( int i = 0; i < duration * fps; ++i ) {
-                render( 1.f / fps );
-                auto filename = viewerParameters.m_imgPrefix + std::to_string( i ) + ".png";
-                saveFrame( filename );
-            }
+            viewer.renderFrames( int( duration * fps ), 1.f / fps );
+            std::cout << "Rendered at " << viewer.getFramesPerSecond() << " fps" << std::endl;
         }
         else {
             // compute one picture
@@ -0,0 +1,182 @@
+#include <Core/Animation/AnimationClip.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+namespace {
+/// Appends to \p times and \p values the keys of a track, skipping the keys which do not change
+/// the interpolated values: the ones in the middle of runs of equal values, at the start or at
+/// the end of the track. A constant track is reduced to its first key.
+template <typename Value, typename Container>
+void appendTrack( const std::vector<Scalar>& keyTimes,
+                  const std::vector<Value>& keyValues,
+                  std::vector<Scalar>& times,
+                  Container& values ) {
+    const size_t n   = keyValues.size();
+    const size_t end = times.size();
+    for ( size_t i = 0; i < n; ++i ) {
+        const bool samePrevious = i == 0 || keyValues[i] == keyValues[i - 1];
+        const bool sameNext     = i + 1 == n || keyValues[i] == keyValues[i + 1];
+        if ( samePrevious && sameNext ) { continue; }
+        times.push_back( keyTimes[i] );
+        values.push_back( keyValues[i] );
+    }
+    if ( times.size() == end ) {
+        times.push_back( keyTimes[0] );
+        values.push_back( keyValues[0] );
+    }
+}
+} // namespace
+
+AnimationClip::AnimationClip( const KeyFramedTransforms& animation ) {
+    bake( animation );
+}
+
+void AnimationClip::bake( const KeyFramedTransforms& animation ) {
+    m_translationTracks.clear();
+    m_rotationTracks.clear();
+    m_scaleTracks.clear();
+    m_translationTimes.clear();
+    m_rotationTimes.clear();
+    m_scaleTimes.clear();
+    m_translations.clear();
+    m_rotations.clear();
+    m_scales.clear();
+    m_startTime = std::numeric_limits<Scalar>::max();
+    m_endTime   = std::numeric_limits<Scalar>::lowest();
+
+    std::vector<Scalar> keyTimes;
+    std::vector<Vector3> keyTranslations;
+    std::vector<QuantizedRotation> keyRotations;
+    std::vector<Vector3> keyScales;
+    for ( const auto& boneAnimation : animation ) {
+        const auto& keyFrames = boneAnimation.getKeyFrames();
+        keyTimes.clear();
+        keyTranslations.clear();
+        keyRotations.clear();
+        keyScales.clear();
+        // same decomposition as linearInterpolate<Transform>
+        for ( const auto& keyFrame : keyFrames ) {
+            Matrix3 rotation, scaling;
+            keyFrame.second.computeRotationScaling( &rotation, &scaling );
+            keyTimes.push_back( keyFrame.first );
+            keyTranslations.push_back( keyFrame.second.translation() );
+            keyRotations.push_back( quantize( Quaternion( rotation ) ) );
+            keyScales.push_back( scaling.diagonal() );
+        }
+        m_startTime = std::min( m_startTime, keyTimes.front() );
+        m_endTime   = std::max( m_endTime, keyTimes.back() );
+
+        const auto translationBegin = uint( m_translationTimes.size() );
+        const auto rotationBegin    = uint( m_rotationTimes.size() );
+        const auto scaleBegin       = uint( m_scaleTimes.size() );
+        appendTrack( keyTimes, keyTranslations, m_translationTimes, m_translations );
+        appendTrack( keyTimes, keyRotations, m_rotationTimes, m_rotations );
+        appendTrack( keyTimes, keyScales, m_scaleTimes, m_scales );
+        m_translationTracks.push_back(
+            { translationBegin, uint( m_translationTimes.size() ) - translationBegin } );
+        m_rotationTracks.push_back(
+            { rotationBegin, uint( m_rotationTimes.size() ) - rotationBegin } );
+        m_scaleTracks.push_back( { scaleBegin, uint( m_scaleTimes.size() ) - scaleBegin } );
+    }
+
+    if ( animation.empty() ) {
+        m_startTime = 0_ra;
+        m_endTime   = 0_ra;
+    }
+}
+
+inline uint AnimationClip::findKey( const std::vector<Scalar>& times,
+                                    const Track& track,
+                                    Scalar t,
+                                    uint hint ) {
+    const Scalar* keys = times.data() + track.m_begin;
+    const uint last    = track.m_size - 1;
+    uint k             = std::min( hint, last );
+    if ( keys[k] > t ) {
+        // moving backward, e.g. when looping.
+        k = uint( std::upper_bound( keys, keys + k, t ) - keys );
+        return k > 0 ? k - 1 : 0;
+    }
+    // moving forward, by a few keys at most during playback.
+    for ( int step = 0; k < last && keys[k + 1] <= t; ++step ) {
+        if ( step == 4 ) {
+            return uint( std::upper_bound( keys + k + 1, keys + track.m_size, t ) - keys ) - 1;
+        }
+        ++k;
+    }
+    return k;
+}
+
+inline Scalar AnimationClip::interpolationFactor( const std::vector<Scalar>& times,
+                                                  const Track& track,
+                                                  Scalar t,
+                                                  uint k ) {
+    const Scalar* keys = times.data() + track.m_begin;
+    if ( k + 1 >= track.m_size || t <= keys[k] ) { return 0_ra; }
+    return ( t - keys[k] ) / ( keys[k + 1] - keys[k] );
+}
+
+AnimationClip::QuantizedRotation AnimationClip::quantize( const Quaternion& q ) {
+    const Quaternion n = q.normalized();
+    auto toInt16       = []( Scalar c ) { return int16_t( std::lround( c * 32767_ra ) ); };
+    return { toInt16( n.w() ), toInt16( n.x() ), toInt16( n.y() ), toInt16( n.z() ) };
+}
+
+inline Quaternion AnimationClip::dequantize( const QuantizedRotation& q ) {
+    return Quaternion( Scalar( q[0] ), Scalar( q[1] ), Scalar( q[2] ), Scalar( q[3] ) )
+        .normalized();
+}
+
+void AnimationClip::sample( Scalar t, Cursor& cursor, Pose& pose ) const {
+    const size_t numBones = getNumBones();
+    if ( cursor.m_keys.size() != 3 * numBones ) { cursor.m_keys.assign( 3 * numBones, 0 ); }
+    pose.resize( numBones );
+    uint* translationKeys = cursor.m_keys.data();
+    uint* rotationKeys    = translationKeys + numBones;
+    uint* scaleKeys       = rotationKeys + numBones;
+
+    auto lerp = []( const Vector3* v, Scalar f ) -> Vector3 {
+        return f > 0_ra ? Vector3( ( 1 - f ) * v[0] + f * v[1] ) : v[0];
+    };
+
+    for ( size_t i = 0; i < numBones; ++i ) {
+        const Track& tTrack = m_translationTracks[i];
+        const Track& rTrack = m_rotationTracks[i];
+        const Track& sTrack = m_scaleTracks[i];
+        const uint kt       = findKey( m_translationTimes, tTrack, t, translationKeys[i] );
+        const uint kr       = findKey( m_rotationTimes, rTrack, t, rotationKeys[i] );
+        const uint ks       = findKey( m_scaleTimes, sTrack, t, scaleKeys[i] );
+        translationKeys[i]  = kt;
+        rotationKeys[i]     = kr;
+        scaleKeys[i]        = ks;
+
+        const Vector3 iT = lerp( &m_translations[tTrack.m_begin + kt],
+                                 interpolationFactor( m_translationTimes, tTrack, t, kt ) );
+        const Vector3 iS = lerp( &m_scales[sTrack.m_begin + ks],
+                                 interpolationFactor( m_scaleTimes, sTrack, t, ks ) );
+        Quaternion iR    = dequantize( m_rotations[rTrack.m_begin + kr] );
+        const Scalar fr  = interpolationFactor( m_rotationTimes, rTrack, t, kr );
+        if ( fr > 0_ra ) {
+            iR = iR.slerp( fr, dequantize( m_rotations[rTrack.m_begin + kr + 1] ) );
+        }
+
+        pose[i].fromPositionOrientationScale( iT, iR, iS );
+    }
+}
+
+Pose AnimationClip::sample( Scalar t ) const {
+    Cursor cursor;
+    Pose pose;
+    sample( t, cursor, pose );
+    return pose;
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
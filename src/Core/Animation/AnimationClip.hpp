@@ -0,0 +1,133 @@
+#pragma once
+
+#include <Core/Animation/KeyFramedValue.hpp>
+#include <Core/Animation/Pose.hpp>
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <array>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/**
+ * AnimationClip is a baked, read-only version of the keyframed transforms animating the bones of a
+ * skeleton, optimized for playback.
+ *
+ * The keyframed transforms are decomposed into translation, rotation and scale tracks, stored
+ * as structures of arrays for all the bones. Keys in the middle of runs of equal values are
+ * removed, so that constant tracks hold a single key, and rotations are quantized on 16 bits
+ * per component.
+ *
+ * Sampling matches Ra::Core::Animation::linearInterpolate<Transform>, up to the rotation
+ * quantization. It uses a Cursor storing the last key used by each track, so that playing the
+ * clip forward finds the keys to interpolate in constant time. Each animated instance uses its
+ * own Cursor, the clip being shared.
+ *
+ * \note The clip does not follow the changes of the keyframes it was baked from,
+ * KeyFramedValueBase::getStamp() can be used to check if it has to be baked again.
+ */
+class RA_CORE_API AnimationClip
+{
+  public:
+    /// The keyframed transforms of each bone, as stored by the SkeletonComponent.
+    using KeyFramedTransforms = std::vector<KeyFramedValue<Transform>>;
+
+    /// Playback state of a clip instance, to be reused between samplings.
+    struct Cursor {
+        /// Last key used by each track.
+        std::vector<uint> m_keys;
+    };
+
+    /// Create an empty clip.
+    AnimationClip() = default;
+
+    /// Create the clip of the given keyframed transforms.
+    explicit AnimationClip( const KeyFramedTransforms& animation );
+
+    /// Bake the given keyframed transforms, replacing the current content of the clip.
+    void bake( const KeyFramedTransforms& animation );
+
+    /// \returns the number of animated bones.
+    inline size_t getNumBones() const;
+
+    /// \returns the total number of keys stored in the clip, after the removal of redundant ones.
+    inline size_t getNumKeys() const;
+
+    /// \returns the time of the first keyframe, 0 for an empty clip.
+    inline Scalar getStartTime() const;
+
+    /// \returns the time of the last keyframe, 0 for an empty clip.
+    inline Scalar getEndTime() const;
+
+    /**
+     * Computes in \p pose the local transforms of the bones at time \p t.
+     * \p pose is resized to getNumBones() if needed.
+     * \p cursor is initialized on first use and must not be shared between clips.
+     */
+    void sample( Scalar t, Cursor& cursor, Pose& pose ) const;
+
+    /// Computes the local transforms of the bones at time \p t, without playback cursor.
+    Pose sample( Scalar t ) const;
+
+  private:
+    /// Range of the keys of a track in the key arrays.
+    struct Track {
+        uint m_begin;
+        uint m_size;
+    };
+
+    using QuantizedRotation = std::array<int16_t, 4>;
+
+    /// \returns the index, relative to the track, of the last key of \p track at or before \p t,
+    /// 0 if \p t is before the first key, searching from \p hint.
+    static uint
+    findKey( const std::vector<Scalar>& times, const Track& track, Scalar t, uint hint );
+
+    /// \returns the interpolation parameter between the keys \p k and \p k + 1 of \p track,
+    /// 0 if \p k is the last key or \p t is before it.
+    static Scalar
+    interpolationFactor( const std::vector<Scalar>& times, const Track& track, Scalar t, uint k );
+
+    static QuantizedRotation quantize( const Quaternion& q );
+    static Quaternion dequantize( const QuantizedRotation& q );
+
+    /// One track per bone for each channel.
+    std::vector<Track> m_translationTracks;
+    std::vector<Track> m_rotationTracks;
+    std::vector<Track> m_scaleTracks;
+
+    std::vector<Scalar> m_translationTimes;
+    std::vector<Scalar> m_rotationTimes;
+    std::vector<Scalar> m_scaleTimes;
+
+    Vector3Array m_translations;
+    std::vector<QuantizedRotation> m_rotations;
+    Vector3Array m_scales;
+
+    Scalar m_startTime { 0_ra };
+    Scalar m_endTime { 0_ra };
+};
+
+inline size_t AnimationClip::getNumBones() const {
+    return m_translationTracks.size();
+}
+
+inline size_t AnimationClip::getNumKeys() const {
+    return m_translationTimes.size() + m_rotationTimes.size() + m_scaleTimes.size();
+}
+
+inline Scalar AnimationClip::getStartTime() const {
+    return m_startTime;
+}
+
+inline Scalar AnimationClip::getEndTime() const {
+    return m_endTime;
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
@@ -3,6 +3,7 @@
 #include <Core/Containers/AlignedStdVector.hpp>
 #include <Core/Types.hpp>
 #include <map>
+#include <vector>
 
 namespace Ra {
 namespace Core {
@@ -33,6 +34,24 @@ using MeshWeight = AlignedStdVector<VertexWeight>;
  */
 using WeightMatrix = Ra::Core::Sparse;
 
+/**
+ * Defines the skinning weights of a mesh with a fixed number of influences per vertex.
+ * Handle indices and weights are stored in two separate arrays, the influences of vertex i
+ * being at [i * m_numInfluences, ( i + 1 ) * m_numInfluences).
+ * Unused influences have weight 0 and handle 0, so that they can be processed without branching.
+ * \see packWeights
+ */
+struct PackedWeights {
+    /// The number of vertices.
+    uint m_numVertices { 0 };
+    /// The number of influences per vertex, a multiple of 4.
+    uint m_numInfluences { 0 };
+    /// The handle index of each influence.
+    std::vector<uint> m_handles;
+    /// The weight of each influence.
+    std::vector<Scalar> m_weights;
+};
+
 } // namespace Animation
 } // Namespace Core
 } // Namespace Ra
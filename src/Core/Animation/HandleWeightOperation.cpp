@@ -1,6 +1,7 @@
 #include <Core/Animation/HandleWeightOperation.hpp>
 #include <Core/Math/LinearAlgebra.hpp> // Math::checkInvalidNumbers
 #include <Core/Utils/Log.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace Ra {
@@ -115,6 +116,33 @@ bool normalizeWeights( Eigen::Ref<WeightMatrix> matrix, const bool MT ) {
     return !skinningWeightOk;
 }
 
+PackedWeights packWeights( const WeightMatrix& matrix ) {
+    PackedWeights packed;
+    packed.m_numVertices = uint( matrix.rows() );
+
+    std::vector<uint> count( packed.m_numVertices, 0 );
+    for ( int j = 0; j < matrix.outerSize(); ++j ) {
+        for ( WeightMatrix::InnerIterator it( matrix, j ); it; ++it ) {
+            ++count[it.row()];
+        }
+    }
+    const uint maxCount = count.empty() ? 0 : *std::max_element( count.begin(), count.end() );
+    packed.m_numInfluences = std::max( 4u, ( maxCount + 3 ) / 4 * 4 );
+
+    const size_t size = size_t( packed.m_numVertices ) * packed.m_numInfluences;
+    packed.m_handles.assign( size, 0 );
+    packed.m_weights.assign( size, 0_ra );
+    std::fill( count.begin(), count.end(), 0 );
+    for ( int j = 0; j < matrix.outerSize(); ++j ) {
+        for ( WeightMatrix::InnerIterator it( matrix, j ); it; ++it ) {
+            const size_t k      = size_t( it.row() ) * packed.m_numInfluences + count[it.row()]++;
+            packed.m_handles[k] = uint( j );
+            packed.m_weights[k] = it.value();
+        }
+    }
+    return packed;
+}
+
 } // namespace Animation
 } // Namespace Core
 } // Namespace Ra
@@ -53,6 +53,13 @@ RA_CORE_API bool checkNoWeightVertex( Eigen::Ref<const WeightMatrix> matrix,
  */
 RA_CORE_API bool normalizeWeights( Eigen::Ref<WeightMatrix> matrix, const bool MT = false );
 
+/**
+ * Return the PackedWeights holding the non zero weights of the given WeightMatrix.
+ * The number of influences per vertex is the maximal number of non zero weights of a row,
+ * rounded up to a multiple of 4. The influences of a vertex keep the order of the handles.
+ */
+RA_CORE_API PackedWeights packWeights( const WeightMatrix& matrix );
+
 } // namespace Animation
 } // Namespace Core
 } // Namespace Ra
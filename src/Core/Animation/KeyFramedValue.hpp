@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <set>
 
@@ -44,6 +45,25 @@ class RA_CORE_API KeyFramedValueBase
      * \returns the ordered list of the points in time where a keyframe is defined.
      */
     virtual inline std::vector<Scalar> getTimes() const = 0;
+
+    /**
+     * \returns a stamp identifying the current keyframes, which changes each time they are
+     * modified. Copies share the stamp of the original, so that data derived from the keyframes,
+     * e.g. an AnimationClip, can check whether it is up to date.
+     */
+    inline size_t getStamp() const { return m_stamp; }
+
+  protected:
+    /// Gives a new stamp to the keyframes, to be called when they are modified.
+    inline void touch() { m_stamp = newStamp(); }
+
+  private:
+    static size_t newStamp() {
+        static std::atomic<size_t> counter { 0 };
+        return ++counter;
+    }
+
+    size_t m_stamp { newStamp() };
 };
 
 /**
@@ -125,6 +145,7 @@ class KeyFramedValue : public KeyFramedValueBase
             if ( Math::areApproxEqual( lower->first, t ) ) { lower->second = frame; }
             else { m_keyframes.insert( upper, kf ); }
         }
+        touch();
     }
 
     /**
@@ -142,6 +163,7 @@ class KeyFramedValue : public KeyFramedValueBase
     inline bool removeKeyFrame( size_t i ) override {
         if ( size() == 1 ) return false;
         m_keyframes.erase( m_keyframes.begin() + i );
+        touch();
         return true;
     }
 
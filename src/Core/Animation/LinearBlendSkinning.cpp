@@ -1,6 +1,8 @@
 #include <Core/Animation/LinearBlendSkinning.hpp>
 
+#include <Core/Animation/HandleWeightOperation.hpp>
 #include <Core/Animation/SkinningData.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 
 namespace Ra {
 namespace Core {
@@ -10,36 +12,45 @@ void linearBlendSkinning( const SkinningRefData& refData,
                           const Vector3Array& tangents,
                           const Vector3Array& bitangents,
                           SkinningFrameData& frameData ) {
-    const auto& W          = refData.m_weights;
+    using SkinningMatrix = Eigen::Matrix<Scalar, 3, 4>;
+
     const auto& vertices   = refData.m_referenceMesh.vertices();
     const auto& normals    = refData.m_referenceMesh.normals();
     const auto& bindMatrix = refData.m_bindMatrices;
     const auto& pose       = frameData.m_skeleton.getPose( HandleArray::SpaceType::MODEL );
-#pragma omp parallel for
-    for ( int i = 0; i < int( frameData.m_currentPosition.size() ); ++i ) {
-        frameData.m_currentPosition[i]  = Vector3::Zero();
-        frameData.m_currentNormal[i]    = Vector3::Zero();
-        frameData.m_currentTangent[i]   = Vector3::Zero();
-        frameData.m_currentBitangent[i] = Vector3::Zero();
+    const int numVertices  = int( frameData.m_currentPosition.size() );
+
+    // Use the packed weights if they are up to date, pack them otherwise.
+    PackedWeights localWeights;
+    const PackedWeights* weights = &refData.m_packedWeights;
+    if ( weights->m_numVertices != uint( refData.m_weights.rows() ) ) {
+        localWeights = packWeights( refData.m_weights );
+        weights      = &localWeights;
     }
-    for ( int k = 0; k < W.outerSize(); ++k ) {
-        const int nonZero = W.col( k ).nonZeros();
-        WeightMatrix::InnerIterator it0( W, k );
-#pragma omp parallel for
-        for ( int nz = 0; nz < nonZero; ++nz ) {
-            WeightMatrix::InnerIterator it = it0 + Eigen::Index( nz );
-            const uint i                   = it.row();
-            const uint j                   = it.col();
-            const Scalar w                 = it.value();
-            // prepare the pose w.r.t. the bind matrix and the mesh transform
-            const Transform M = refData.m_meshTransformInverse * pose[j] * bindMatrix[j];
-            // apply LBS
-            frameData.m_currentPosition[i] += w * ( M * vertices[i] );
-            frameData.m_currentNormal[i] += w * ( M.linear() * normals[i] );
-            frameData.m_currentTangent[i] += w * ( M.linear() * tangents[i] );
-            frameData.m_currentBitangent[i] += w * ( M.linear() * bitangents[i] );
-        }
+    CORE_ASSERT( numVertices <= int( weights->m_numVertices ), "Weights and mesh mismatch." );
+
+    // prepare the pose w.r.t. the bind matrix and the mesh transform, once per handle.
+    AlignedStdVector<SkinningMatrix> M( pose.size() );
+    for ( size_t j = 0; j < pose.size(); ++j ) {
+        M[j] = ( refData.m_meshTransformInverse * pose[j] * bindMatrix[j] ).affine();
     }
+
+    // apply LBS : each vertex gathers its fixed number of influences, so that vertices are
+    // processed independently and the result does not depend on the number of threads.
+    const uint numInfluences = weights->m_numInfluences;
+    parallelFor( 0, numVertices, [&]( int i ) {
+        const uint* handles = weights->m_handles.data() + size_t( i ) * numInfluences;
+        const Scalar* w     = weights->m_weights.data() + size_t( i ) * numInfluences;
+        SkinningMatrix Mi   = w[0] * M[handles[0]];
+        for ( uint k = 1; k < numInfluences; ++k ) {
+            Mi += w[k] * M[handles[k]];
+        }
+        const auto linear               = Mi.leftCols<3>();
+        frameData.m_currentPosition[i]  = linear * vertices[i] + Mi.col( 3 );
+        frameData.m_currentNormal[i]    = linear * normals[i];
+        frameData.m_currentTangent[i]   = linear * tangents[i];
+        frameData.m_currentBitangent[i] = linear * bitangents[i];
+    } );
 }
 
 } // namespace Animation
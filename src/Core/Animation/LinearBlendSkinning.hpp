@@ -23,8 +23,12 @@ struct SkinningFrameData;
  * The skinning of the normal, tangent and bitangent vectors is approximated as:
  * \f$\mathbf{v}_i^t = \sum_{s\in S}\omega_{is}\mathbf{R}_s\mathbf{v}_i^0\f$
  *
+ * The per-handle matrices are computed once, then each vertex blends the matrices of its
+ * influences, read from refData.m_packedWeights (packed on the fly if not up to date).
+ *
  * \note Assumes frameData is well sized.
- * \note Parallelized loop inside (using openmp).
+ * \note Parallelized loop inside (using Core::parallelFor), the result does not depend on the
+ * number of threads.
  */
 // clang-format on
 void RA_CORE_API linearBlendSkinning( const SkinningRefData& refData,
@@ -1,13 +1,47 @@
 #include <Core/Animation/Skeleton.hpp>
 #include <Core/Math/LinearAlgebra.hpp> // Math::clamp
+#include <Core/Tasks/ParallelFor.hpp>
 
 #include <algorithm>
-#include <stack>
+#include <vector>
 
 namespace Ra {
 namespace Core {
 namespace Animation {
 
+namespace {
+/// Computes \p out = \p parent * \p local for affine transforms, as a linear combination of the
+/// columns of \p parent, which is about twice as fast as the generic Transform product.
+inline void compose( const Transform& parent, const Transform& local, Transform& out ) {
+    const auto& P = parent.matrix();
+    const auto& L = local.matrix();
+    auto& M       = out.matrix();
+    for ( int c = 0; c < 4; ++c ) {
+        M.col( c ) = P.col( 0 ) * L( 0, c ) + P.col( 1 ) * L( 1, c ) + P.col( 2 ) * L( 2, c ) +
+                     P.col( 3 ) * L( 3, c );
+    }
+}
+
+/// Computes the model space transforms of \p n bones from their local transforms, parents being
+/// before their children. Roots are multiplied by the identity, to avoid branching.
+void localToModel( const int* parents, uint n, const Transform* local, Transform* model ) {
+    const Transform identity = Transform::Identity();
+    for ( uint i = 0; i < n; ++i ) {
+        const Transform& parent = parents[i] < 0 ? identity : model[parents[i]];
+        compose( parent, local[i], model[i] );
+    }
+}
+
+/// Computes the local transforms of \p n bones from their model space transforms.
+void modelToLocal( const int* parents, uint n, const Transform* model, Transform* local ) {
+    const Transform identity = Transform::Identity();
+    for ( uint i = 0; i < n; ++i ) {
+        const Transform& parent = parents[i] < 0 ? identity : model[parents[i]];
+        compose( parent.inverse(), model[i], local[i] );
+    }
+}
+} // namespace
+
 /// CONSTRUCTOR
 Skeleton::Skeleton() : HandleArray(), m_graph(), m_modelSpace() {}
 
@@ -33,25 +67,35 @@ void Skeleton::setPose( const Pose& pose, const SpaceType MODE ) {
     if ( MODE == SpaceType::LOCAL ) {
         m_pose = pose;
         m_modelSpace.resize( m_pose.size() );
-        for ( uint i = 0; i < m_graph.size(); ++i ) {
-            if ( m_graph.isRoot( i ) ) { m_modelSpace[i] = m_pose[i]; }
-            for ( const auto& child : m_graph.children()[i] ) {
-                m_modelSpace[child] = m_modelSpace[i] * m_pose[child];
-            }
-        }
+        localToModel( m_graph.parents().data(), size(), m_pose.data(), m_modelSpace.data() );
     }
     else {
         m_modelSpace = pose;
         m_pose.resize( m_modelSpace.size() );
-        for ( uint i = 0; i < m_graph.size(); ++i ) {
-            if ( m_graph.isRoot( i ) ) { m_pose[i] = m_modelSpace[i]; }
-            for ( const auto& child : m_graph.children()[i] ) {
-                m_pose[child] = m_modelSpace[i].inverse() * m_modelSpace[child];
-            }
-        }
+        modelToLocal( m_graph.parents().data(), size(), m_modelSpace.data(), m_pose.data() );
     }
 }
 
+void Skeleton::computeModelPoses( const Pose& localPoses, Pose& modelPoses ) const {
+    const uint n = size();
+    CORE_ASSERT( n > 0 && localPoses.size() % n == 0, "Size mismatching" );
+    modelPoses.resize( localPoses.size() );
+    const int* parents = m_graph.parents().data();
+    parallelFor( size_t( 0 ), localPoses.size() / n, [&]( size_t k ) {
+        localToModel( parents, n, &localPoses[k * n], &modelPoses[k * n] );
+    } );
+}
+
+void Skeleton::computeLocalPoses( const Pose& modelPoses, Pose& localPoses ) const {
+    const uint n = size();
+    CORE_ASSERT( n > 0 && modelPoses.size() % n == 0, "Size mismatching" );
+    localPoses.resize( modelPoses.size() );
+    const int* parents = m_graph.parents().data();
+    parallelFor( size_t( 0 ), modelPoses.size() / n, [&]( size_t k ) {
+        modelToLocal( parents, n, &modelPoses[k * n], &localPoses[k * n] );
+    } );
+}
+
 const Transform& Skeleton::getTransform( const uint i, const SpaceType MODE ) const {
     CORE_ASSERT( ( i < size() ), "Index i out of bounds" );
     static_assert( std::is_same<bool, typename std::underlying_type<SpaceType>::type>::value,
@@ -99,40 +143,34 @@ void Skeleton::setTransform( const uint i, const Transform& T, const SpaceType M
 }
 
 void Skeleton::setLocalTransform( const uint i, const Transform& T ) {
-    m_pose[i] = T;
+    const auto& parents = m_graph.parents();
+    m_pose[i]           = T;
     // Compute the model space pose
     if ( m_graph.isRoot( i ) ) { m_modelSpace[i] = m_pose[i]; }
-    else { m_modelSpace[i] = m_modelSpace[m_graph.parents()[i]] * T; }
+    else { m_modelSpace[i] = m_modelSpace[parents[i]] * T; }
     if ( !m_graph.isLeaf( i ) ) {
-        std::stack<uint> stack;
-        stack.push( i );
+        std::vector<uint> stack { i };
         while ( !stack.empty() ) {
-            uint parent = stack.top();
-            stack.pop();
+            const uint parent = stack.back();
+            stack.pop_back();
             for ( const auto& child : m_graph.children()[parent] ) {
-                m_modelSpace[child] = m_modelSpace[parent] * m_pose[child];
-                stack.push( child );
+                compose( m_modelSpace[parent], m_pose[child], m_modelSpace[child] );
+                stack.push_back( child );
             }
         }
     }
 }
 
 void Skeleton::setModelTransform( const uint i, const Transform& T ) {
-    m_modelSpace[i] = T;
+    const auto& parents = m_graph.parents();
+    m_modelSpace[i]     = T;
     // Compute the local space pose
     if ( m_graph.isRoot( i ) ) { m_pose[i] = m_modelSpace[i]; }
-    else { m_pose[i] = m_modelSpace[m_graph.parents()[i]].inverse() * T; }
-    if ( !m_graph.isLeaf( i ) ) {
-        std::stack<uint> stack;
-        stack.push( i );
-        while ( !stack.empty() ) {
-            uint parent = stack.top();
-            stack.pop();
-            for ( const auto& child : m_graph.children()[parent] ) {
-                m_pose[child] = m_modelSpace[parent].inverse() * m_modelSpace[child];
-                stack.push( child );
-            }
-        }
+    else { m_pose[i] = m_modelSpace[parents[i]].inverse() * T; }
+    // only the local transforms of the children of i change.
+    const Transform inverse = T.inverse();
+    for ( const auto& child : m_graph.children()[i] ) {
+        m_pose[child] = inverse * m_modelSpace[child];
     }
 }
 
@@ -151,7 +189,7 @@ uint Skeleton::addBone( const uint parent,
                    "SpaceType is not a boolean" );
     if ( MODE == SpaceType::LOCAL ) {
         m_pose.push_back( T );
-        m_modelSpace.push_back( T * m_modelSpace[parent] );
+        m_modelSpace.push_back( m_modelSpace[parent] * T );
     }
     else {
         m_modelSpace.push_back( T );
@@ -20,6 +20,10 @@ namespace Animation {
  * During the edition of the transformation of a skeleton bone, the transformations
  * of all the bones are updated accroding to the Manipulation scheme
  * (cf Ra::Core:Animation::Skeleton::Manipulation).
+ *
+ * Bones are sorted so that parents come before their children, as ensured by the graph
+ * construction. Poses are then propagated between local and model spaces by a single forward
+ * loop over the flat array of the parents indices.
  */
 class RA_CORE_API Skeleton : public HandleArray
 {
@@ -49,6 +53,20 @@ class RA_CORE_API Skeleton : public HandleArray
      */
     void setTransform( const uint i, const Transform& T, const SpaceType MODE ) override;
 
+    /**
+     * Computes the model space poses of several skeletons sharing the hierarchy of this skeleton.
+     * \p localPoses stores the local poses of the skeletons one after the other, hence holds a
+     * multiple of size() transforms. \p modelPoses is resized accordingly.
+     * \note Skeletons are processed in parallel when a parallel task queue is set.
+     */
+    void computeModelPoses( const Pose& localPoses, Pose& modelPoses ) const;
+
+    /**
+     * Computes the local poses of several skeletons sharing the hierarchy of this skeleton,
+     * from their model space poses. Inverse of computeModelPoses().
+     */
+    void computeLocalPoses( const Pose& modelPoses, Pose& localPoses ) const;
+
     /**
      * Add a new root transform to the skeleton.
      * @param T      the joint transform associated to the new bone
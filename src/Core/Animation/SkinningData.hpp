@@ -27,6 +27,10 @@ struct SkinningRefData {
     /// The matrix of skinning weights.
     WeightMatrix m_weights;
 
+    /// The skinning weights with a fixed number of influences per vertex, used by
+    /// linearBlendSkinning. Must be updated with packWeights( m_weights ) when m_weights changes.
+    PackedWeights m_packedWeights;
+
     /// The optionnal centers of rotations for CoR skinning.
     Vector3Array m_CoR;
 
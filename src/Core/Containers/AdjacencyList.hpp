@@ -10,7 +10,7 @@ namespace Core {
 
 using ParentList   = AlignedStdVector<int>;
 using LevelList    = AlignedStdVector<uint8_t>;
-using ChildrenList = AlignedStdVector<uint8_t>;
+using ChildrenList = AlignedStdVector<uint>;
 using Adjacency    = AlignedStdVector<ChildrenList>;
 
 /**
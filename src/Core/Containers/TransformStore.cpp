@@ -0,0 +1,94 @@
+#include <Core/Containers/TransformStore.hpp>
+
+#include <algorithm>
+
+namespace Ra {
+namespace Core {
+
+TransformStore::Slot TransformStore::add( const Transform& local, Slot parent ) {
+    CORE_ASSERT( parent < 0 || isValid( parent ), "Invalid parent slot." );
+    Slot slot;
+    if ( m_freeSlots.empty() ) {
+        slot = Slot( m_valid.size() );
+        m_local.emplace_back();
+        m_world.emplace_back();
+        m_parent.push_back( -1 );
+        m_dirty.push_back( 0 );
+        m_changed.push_back( 0 );
+        m_valid.push_back( 1 );
+    }
+    else {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_valid[slot] = 1;
+    }
+    m_local[slot]   = local;
+    m_world[slot]   = parent < 0 ? local : m_world[parent] * local;
+    m_parent[slot]  = parent < 0 ? -1 : parent;
+    m_dirty[slot]   = 0;
+    m_changed[slot] = 0;
+    m_orderDirty    = true;
+    return slot;
+}
+
+void TransformStore::remove( Slot slot ) {
+    CORE_ASSERT( isValid( slot ), "Invalid transform slot." );
+    m_valid[slot]   = 0;
+    m_parent[slot]  = -1;
+    m_dirty[slot]   = 0;
+    m_changed[slot] = 0;
+    m_freeSlots.push_back( slot );
+    m_orderDirty = true;
+}
+
+void TransformStore::setParent( Slot slot, Slot parent ) {
+    CORE_ASSERT( isValid( slot ), "Invalid transform slot." );
+    CORE_ASSERT( parent < 0 || isValid( parent ), "Invalid parent slot." );
+#ifdef CORE_DEBUG
+    for ( Slot ancestor = parent; ancestor >= 0; ancestor = m_parent[ancestor] ) {
+        CORE_ASSERT( ancestor != slot, "Cycle in the transform hierarchy." );
+    }
+#endif
+    m_parent[slot] = parent < 0 ? -1 : parent;
+    m_dirty[slot]  = 1;
+    m_orderDirty   = true;
+}
+
+void TransformStore::sortByDepth() {
+    // depth of each valid slot, walking up to the first ancestor of known depth.
+    std::vector<int> depth( m_valid.size(), -1 );
+    std::vector<Slot> path;
+    int maxDepth = -1;
+    for ( Slot slot = 0; slot < Slot( m_valid.size() ); ++slot ) {
+        if ( !m_valid[slot] ) { continue; }
+        Slot node = slot;
+        while ( node >= 0 && depth[node] < 0 ) {
+            path.push_back( node );
+            node = m_parent[node];
+        }
+        int d = node < 0 ? -1 : depth[node];
+        while ( !path.empty() ) {
+            depth[path.back()] = ++d;
+            path.pop_back();
+        }
+        maxDepth = std::max( maxDepth, depth[slot] );
+    }
+
+    // counting sort, keeping the slots order within a level.
+    m_levels.assign( size_t( maxDepth + 2 ), 0 );
+    for ( Slot slot = 0; slot < Slot( m_valid.size() ); ++slot ) {
+        if ( m_valid[slot] ) { ++m_levels[depth[slot] + 1]; }
+    }
+    for ( size_t level = 1; level < m_levels.size(); ++level ) {
+        m_levels[level] += m_levels[level - 1];
+    }
+    m_order.resize( size() );
+    std::vector<size_t> next( m_levels.begin(), m_levels.end() - 1 );
+    for ( Slot slot = 0; slot < Slot( m_valid.size() ); ++slot ) {
+        if ( m_valid[slot] ) { m_order[next[depth[slot]]++] = slot; }
+    }
+    m_orderDirty = false;
+}
+
+} // namespace Core
+} // namespace Ra
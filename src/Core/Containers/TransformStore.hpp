@@ -0,0 +1,161 @@
+#pragma once
+
+#include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Types.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+
+/**
+ * Flat storage of a forest of transforms, e.g. the entities of a scene.
+ *
+ * Each node is a slot in contiguous arrays of local transforms, world transforms, parent
+ * indices and dirty flags. Local transforms are written by setLocal() (the back buffer), world
+ * transforms are only written by update() (the front buffer), so that they can be read without
+ * locks while the local transforms of the next frame are written.
+ *
+ * update() traverses the nodes by increasing depth, updating in parallel all the nodes of a
+ * given depth whose local transform, or the world transform of an ancestor, has changed.
+ *
+ * \note add(), remove() and setParent() must not be called concurrently with the other methods,
+ * and may invalidate the references returned by getLocal() and getWorld().
+ */
+class RA_CORE_API TransformStore
+{
+  public:
+    using Slot = int;
+
+    /// Adds a node, child of \p parent or a root if \p parent is negative.
+    /// Its world transform is computed right away.
+    /// \returns the slot of the node, which may be the one of a previously removed node.
+    Slot add( const Transform& local = Transform::Identity(), Slot parent = -1 );
+
+    /// Removes the node \p slot.
+    /// \warning the children of \p slot must have been removed or reparented beforehand.
+    void remove( Slot slot );
+
+    /// Sets the parent of \p slot, a root if \p parent is negative, keeping its local transform.
+    void setParent( Slot slot, Slot parent );
+
+    /// Sets the local transform of \p slot, applied to its world transform by the next update().
+    /// Thread safe for different slots.
+    inline void setLocal( Slot slot, const Transform& local );
+
+    /// \returns the local transform of \p slot, as set by the last setLocal().
+    inline const Transform& getLocal( Slot slot ) const;
+
+    /// \returns the world transform of \p slot, as computed by the last update().
+    inline const Transform& getWorld( Slot slot ) const;
+
+    inline Slot getParent( Slot slot ) const;
+
+    /// \returns true if the world transform of \p slot has been modified by the last update().
+    inline bool hasChanged( Slot slot ) const;
+
+    /// \returns true if \p slot is in use.
+    inline bool isValid( Slot slot ) const;
+
+    /// \returns the number of nodes.
+    inline size_t size() const;
+
+    /// \returns the number of slots, i.e. an upper bound of the valid slots.
+    inline size_t capacity() const;
+
+    /**
+     * Computes the world transforms of the nodes whose local transform or the world transform of
+     * an ancestor has changed since the last update.
+     * \p onChanged is called with the slot of each updated node, from the worker threads of the
+     * parallel task queue, after the world transforms of its ancestors have been updated.
+     */
+    template <typename Function>
+    void update( Function&& onChanged );
+
+    /// Computes the changed world transforms.
+    inline void update();
+
+  private:
+    /// Sorts the nodes by depth, into m_order and m_levels.
+    void sortByDepth();
+
+    AlignedStdVector<Transform> m_local;
+    AlignedStdVector<Transform> m_world;
+    std::vector<Slot> m_parent;
+
+    /// Local transform set since the last update.
+    std::vector<uint8_t> m_dirty;
+    /// World transform computed by the last update.
+    std::vector<uint8_t> m_changed;
+    std::vector<uint8_t> m_valid;
+    std::vector<Slot> m_freeSlots;
+
+    /// Valid slots sorted by depth, nodes of depth d being in [m_levels[d], m_levels[d + 1]).
+    std::vector<Slot> m_order;
+    std::vector<size_t> m_levels;
+    bool m_orderDirty { false };
+};
+
+inline void TransformStore::setLocal( Slot slot, const Transform& local ) {
+    CORE_ASSERT( isValid( slot ), "Invalid transform slot." );
+    m_local[slot] = local;
+    m_dirty[slot] = 1;
+}
+
+inline const Transform& TransformStore::getLocal( Slot slot ) const {
+    CORE_ASSERT( isValid( slot ), "Invalid transform slot." );
+    return m_local[slot];
+}
+
+inline const Transform& TransformStore::getWorld( Slot slot ) const {
+    CORE_ASSERT( isValid( slot ), "Invalid transform slot." );
+    return m_world[slot];
+}
+
+inline TransformStore::Slot TransformStore::getParent( Slot slot ) const {
+    CORE_ASSERT( isValid( slot ), "Invalid transform slot." );
+    return m_parent[slot];
+}
+
+inline bool TransformStore::hasChanged( Slot slot ) const {
+    return m_changed[slot] != 0;
+}
+
+inline bool TransformStore::isValid( Slot slot ) const {
+    return slot >= 0 && size_t( slot ) < m_valid.size() && m_valid[slot] != 0;
+}
+
+inline size_t TransformStore::size() const {
+    return m_valid.size() - m_freeSlots.size();
+}
+
+inline size_t TransformStore::capacity() const {
+    return m_valid.size();
+}
+
+template <typename Function>
+void TransformStore::update( Function&& onChanged ) {
+    if ( m_orderDirty ) { sortByDepth(); }
+    for ( size_t level = 0; level + 1 < m_levels.size(); ++level ) {
+        parallelFor( m_levels[level], m_levels[level + 1], [&]( size_t k ) {
+            const Slot slot    = m_order[k];
+            const Slot parent  = m_parent[slot];
+            const bool changed = m_dirty[slot] || ( parent >= 0 && m_changed[parent] );
+            m_changed[slot]    = changed;
+            if ( !changed ) { return; }
+            m_dirty[slot] = 0;
+            m_world[slot] = parent < 0 ? m_local[slot] : m_world[parent] * m_local[slot];
+            onChanged( slot );
+        } );
+    }
+}
+
+inline void TransformStore::update() {
+    update( []( Slot ) {} );
+}
+
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,92 @@
+#include <Core/Geometry/AabbTree.hpp>
+#include <Core/Geometry/Frustum.hpp>
+
+#include <algorithm>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+AabbTree::AabbTree( const std::vector<Aabb>& boxes, uint maxLeafSize ) {
+    build( boxes, maxLeafSize );
+}
+
+void AabbTree::build( const std::vector<Aabb>& boxes, uint maxLeafSize ) {
+    m_nodes.clear();
+    m_boxes.clear();
+    m_boxIds.clear();
+    m_maxLeafSize = std::max( maxLeafSize, 1u );
+    for ( uint i = 0; i < uint( boxes.size() ); ++i ) {
+        if ( !boxes[i].isEmpty() ) { m_boxIds.push_back( i ); }
+    }
+    if ( m_boxIds.empty() ) { return; }
+
+    m_nodes.reserve( 2 * m_boxIds.size() / m_maxLeafSize + 1 );
+    buildNode( 0, uint( m_boxIds.size() ), boxes );
+
+    m_boxes.reserve( m_boxIds.size() );
+    for ( const auto id : m_boxIds ) {
+        m_boxes.push_back( boxes[id] );
+    }
+}
+
+uint AabbTree::buildNode( uint begin, uint end, const std::vector<Aabb>& boxes ) {
+    const uint nodeIndex = uint( m_nodes.size() );
+    m_nodes.emplace_back();
+    const auto first = m_boxIds.begin() + begin;
+    const auto last  = m_boxIds.begin() + end;
+
+    Aabb box;
+    Aabb centroidBox;
+    for ( auto it = first; it != last; ++it ) {
+        box.extend( boxes[*it] );
+        centroidBox.extend( boxes[*it].center() );
+    }
+    m_nodes[nodeIndex].m_min   = box.min();
+    m_nodes[nodeIndex].m_max   = box.max();
+    m_nodes[nodeIndex].m_begin = begin;
+    m_nodes[nodeIndex].m_end   = end;
+    m_nodes[nodeIndex].m_right = 0;
+    if ( end - begin <= m_maxLeafSize ) { return nodeIndex; }
+
+    int axis;
+    centroidBox.sizes().maxCoeff( &axis );
+    const uint middle = begin + ( end - begin ) / 2;
+    std::nth_element( first, m_boxIds.begin() + middle, last, [&boxes, axis]( uint a, uint b ) {
+        return boxes[a].center()[axis] < boxes[b].center()[axis];
+    } );
+
+    buildNode( begin, middle, boxes );
+    const uint right           = buildNode( middle, end, boxes );
+    m_nodes[nodeIndex].m_right = right;
+    return nodeIndex;
+}
+
+void AabbTree::frustumQuery( const Frustum& frustum, std::vector<uint>& indicesOut ) const {
+    if ( isEmpty() ) { return; }
+    std::vector<uint> stack { 0 };
+    while ( !stack.empty() ) {
+        const uint index = stack.back();
+        const Node& node = m_nodes[index];
+        stack.pop_back();
+        const auto intersection = frustum.classify( Aabb( node.m_min, node.m_max ) );
+        if ( intersection == Frustum::Intersection::Outside ) { continue; }
+        if ( intersection == Frustum::Intersection::Inside ) {
+            indicesOut.insert(
+                indicesOut.end(), m_boxIds.begin() + node.m_begin, m_boxIds.begin() + node.m_end );
+        }
+        else if ( node.m_right == 0 ) {
+            for ( uint i = node.m_begin; i < node.m_end; ++i ) {
+                if ( frustum.intersects( m_boxes[i] ) ) { indicesOut.push_back( m_boxIds[i] ); }
+            }
+        }
+        else {
+            stack.push_back( node.m_right );
+            stack.push_back( index + 1 );
+        }
+    }
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
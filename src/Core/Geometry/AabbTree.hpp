@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+class Frustum;
+
+/// Bounding volume hierarchy over a set of boxes, e.g. the world space bounding boxes of the
+/// render objects of a scene, for frustum culling.
+/// Nodes split their boxes at the median of the centroids along their largest extent and are
+/// stored as a flat array in depth first order : the left child of a node directly follows it,
+/// and the boxes of a subtree are contiguous. Indices returned by the queries refer to the input
+/// boxes.
+class RA_CORE_API AabbTree
+{
+  public:
+    /// Create an empty AabbTree.
+    AabbTree() = default;
+
+    /// Create the AabbTree of boxes.
+    explicit AabbTree( const std::vector<Aabb>& boxes, uint maxLeafSize = 4 );
+
+    /// Build the hierarchy over the non empty boxes. Leaves hold at most maxLeafSize boxes.
+    void build( const std::vector<Aabb>& boxes, uint maxLeafSize = 4 );
+
+    /// Append to indicesOut the indices of the boxes intersecting the frustum, in no particular
+    /// order. The boxes of subtrees fully inside the frustum are added without further tests.
+    void frustumQuery( const Frustum& frustum, std::vector<uint>& indicesOut ) const;
+
+    /// Return true if the tree holds no box.
+    inline bool isEmpty() const;
+
+    /// Return the bounding box of all the boxes.
+    inline Aabb getAabb() const;
+
+    /// Return the number of nodes of the hierarchy.
+    inline size_t getNumNodes() const;
+
+  private:
+    /// A node of the hierarchy.
+    struct Node {
+        Vector3 m_min;
+        /// First box of the subtree in m_boxIds.
+        uint m_begin;
+        Vector3 m_max;
+        /// End of the boxes of the subtree in m_boxIds.
+        uint m_end;
+        /// Index of the right child, 0 for leaves.
+        uint m_right;
+    };
+
+    /// Build the node of boxes [begin, end) of m_boxIds, return its index.
+    uint buildNode( uint begin, uint end, const std::vector<Aabb>& boxes );
+
+    std::vector<Node> m_nodes;
+    /// Boxes in leaf order.
+    std::vector<Aabb> m_boxes;
+    /// Index in the input of each box of m_boxes.
+    std::vector<uint> m_boxIds;
+    uint m_maxLeafSize { 4 };
+};
+
+inline bool AabbTree::isEmpty() const {
+    return m_nodes.empty();
+}
+
+inline Aabb AabbTree::getAabb() const {
+    return isEmpty() ? Aabb() : Aabb( m_nodes[0].m_min, m_nodes[0].m_max );
+}
+
+inline size_t AabbTree::getNumNodes() const {
+    return m_nodes.size();
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,486 @@
+#include <Core/Geometry/Bvh.hpp>
+
+#include <Core/Geometry/DistanceQueries.hpp>
+#include <Core/Geometry/IndexedGeometry.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+namespace {
+constexpr Scalar s_noHit = std::numeric_limits<Scalar>::max();
+
+/// Inverse of the ray direction, null components being replaced by tiny values so that the slab
+/// tests never compute 0 * inf.
+Vector3 inverseDirection( const Vector3& dir ) {
+    constexpr Scalar eps = Scalar( 1e-20 );
+    Vector3 inv;
+    for ( int k = 0; k < 3; ++k ) {
+        inv[k] = 1_ra / ( std::abs( dir[k] ) > eps ? dir[k] : std::copysign( eps, dir[k] ) );
+    }
+    return inv;
+}
+
+/// Half of the surface area of a box.
+Scalar halfArea( const Aabb& box ) {
+    if ( box.isEmpty() ) { return 0_ra; }
+    const Vector3 s = box.sizes();
+    return s.x() * s.y() + s.y() * s.z() + s.z() * s.x();
+}
+} // namespace
+
+Bvh::Bvh( const IndexedGeometry<Vector3ui>& geometry, uint maxLeafSize ) {
+    build( geometry, maxLeafSize );
+}
+
+void Bvh::build( const IndexedGeometry<Vector3ui>& geometry, uint maxLeafSize ) {
+    build( geometry.vertices(), geometry.getIndices(), maxLeafSize );
+}
+
+void Bvh::build( const Vector3Array& vertices,
+                 const VectorArray<Vector3ui>& triangles,
+                 uint maxLeafSize ) {
+    m_nodes.clear();
+    m_vertices    = vertices;
+    m_maxLeafSize = std::max( maxLeafSize, 1u );
+    m_triangleIds.resize( triangles.size() );
+    std::iota( m_triangleIds.begin(), m_triangleIds.end(), 0u );
+    if ( triangles.empty() ) {
+        m_triangles.clear();
+        return;
+    }
+
+    std::vector<Aabb> boxes( triangles.size() );
+    Vector3Array centroids( triangles.size() );
+    for ( size_t i = 0; i < triangles.size(); ++i ) {
+        const auto& t = triangles[i];
+        boxes[i]      = Aabb( vertices[t[0]], vertices[t[0]] );
+        boxes[i].extend( vertices[t[1]] );
+        boxes[i].extend( vertices[t[2]] );
+        centroids[i] = boxes[i].center();
+    }
+
+    m_nodes.reserve( 2 * triangles.size() / m_maxLeafSize + 1 );
+    buildNode( 0, uint( triangles.size() ), 0, boxes, centroids );
+
+    m_triangles.resize( triangles.size() );
+    for ( size_t i = 0; i < triangles.size(); ++i ) {
+        m_triangles[i] = triangles[m_triangleIds[i]];
+    }
+    updateBounds();
+}
+
+uint Bvh::buildNode( uint begin,
+                     uint end,
+                     uint depth,
+                     const std::vector<Aabb>& boxes,
+                     const Vector3Array& centroids ) {
+    const uint nodeIndex = uint( m_nodes.size() );
+    m_nodes.emplace_back();
+    const uint count = end - begin;
+    if ( count <= m_maxLeafSize ) {
+        m_nodes[nodeIndex].m_index = begin;
+        m_nodes[nodeIndex].m_count = count;
+        return nodeIndex;
+    }
+
+    const auto first = m_triangleIds.begin() + begin;
+    const auto last  = m_triangleIds.begin() + end;
+    Aabb centroidBox;
+    for ( auto it = first; it != last; ++it ) {
+        centroidBox.extend( centroids[*it] );
+    }
+    const Vector3 extent = centroidBox.sizes();
+
+    // Binned SAH : find the best split plane among the bin boundaries of each axis.
+    constexpr int numBins = 16;
+    int bestAxis          = -1;
+    int bestBin           = 0;
+    Scalar bestCost       = s_noHit;
+    auto binIndex         = [&centroidBox, &extent]( const Vector3& c, int axis ) {
+        const int b = int( numBins * ( c[axis] - centroidBox.min()[axis] ) / extent[axis] );
+        return std::min( b, numBins - 1 );
+    };
+    // Deep nodes use median splits, which bound the depth of the hierarchy.
+    if ( depth < s_maxDepth / 2 ) {
+        for ( int axis = 0; axis < 3; ++axis ) {
+            if ( extent[axis] <= 0 ) { continue; }
+            std::array<Aabb, numBins> binBoxes;
+            std::array<uint, numBins> binCounts {};
+            for ( auto it = first; it != last; ++it ) {
+                const int b = binIndex( centroids[*it], axis );
+                binBoxes[b].extend( boxes[*it] );
+                ++binCounts[b];
+            }
+            // sweep from the right to get the cost of the right part of each split.
+            std::array<Scalar, numBins> rightCost;
+            Aabb rightBox;
+            uint rightCount = 0;
+            for ( int b = numBins - 1; b > 0; --b ) {
+                rightBox.extend( binBoxes[b] );
+                rightCount += binCounts[b];
+                rightCost[b] = rightCount * halfArea( rightBox );
+            }
+            Aabb leftBox;
+            uint leftCount = 0;
+            for ( int b = 0; b < numBins - 1; ++b ) {
+                leftBox.extend( binBoxes[b] );
+                leftCount += binCounts[b];
+                if ( leftCount == 0 || leftCount == count ) { continue; }
+                const Scalar cost = leftCount * halfArea( leftBox ) + rightCost[b + 1];
+                if ( cost < bestCost ) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin  = b;
+                }
+            }
+        }
+    }
+
+    auto middle = first;
+    if ( bestAxis >= 0 ) {
+        middle = std::partition( first, last, [&]( uint i ) {
+            return binIndex( centroids[i], bestAxis ) <= bestBin;
+        } );
+    }
+    if ( middle == first || middle == last ) {
+        int axis;
+        extent.maxCoeff( &axis );
+        middle = first + count / 2;
+        std::nth_element( first, middle, last, [&centroids, axis]( uint a, uint b ) {
+            return centroids[a][axis] < centroids[b][axis];
+        } );
+    }
+    const uint mid = uint( middle - m_triangleIds.begin() );
+
+    buildNode( begin, mid, depth + 1, boxes, centroids );
+    const uint right           = buildNode( mid, end, depth + 1, boxes, centroids );
+    m_nodes[nodeIndex].m_index = right;
+    m_nodes[nodeIndex].m_count = 0;
+    return nodeIndex;
+}
+
+void Bvh::updateBounds() {
+    // children are stored after their parent.
+    for ( size_t n = m_nodes.size(); n-- > 0; ) {
+        Node& node = m_nodes[n];
+        if ( node.m_count > 0 ) {
+            node.m_min = node.m_max = m_vertices[m_triangles[node.m_index][0]];
+            for ( uint i = node.m_index; i < node.m_index + node.m_count; ++i ) {
+                for ( int k = 0; k < 3; ++k ) {
+                    const Vector3& p = m_vertices[m_triangles[i][k]];
+                    node.m_min       = node.m_min.cwiseMin( p );
+                    node.m_max       = node.m_max.cwiseMax( p );
+                }
+            }
+        }
+        else {
+            const Node& left  = m_nodes[n + 1];
+            const Node& right = m_nodes[node.m_index];
+            node.m_min        = left.m_min.cwiseMin( right.m_min );
+            node.m_max        = left.m_max.cwiseMax( right.m_max );
+        }
+    }
+}
+
+void Bvh::refit( const Vector3Array& vertices ) {
+    CORE_ASSERT( vertices.size() == m_vertices.size(), "Refit changes the number of vertices" );
+    m_vertices = vertices;
+    updateBounds();
+}
+
+inline Scalar Bvh::intersectNode( const Node& node,
+                                  const Vector3& origin,
+                                  const Vector3& invDir,
+                                  Scalar tMax ) {
+    const Vector3 t0   = ( node.m_min - origin ).cwiseProduct( invDir );
+    const Vector3 t1   = ( node.m_max - origin ).cwiseProduct( invDir );
+    const Scalar tNear = std::max( t0.cwiseMin( t1 ).maxCoeff(), 0_ra );
+    const Scalar tFar  = t0.cwiseMax( t1 ).minCoeff();
+    return ( tNear <= tFar && tNear < tMax ) ? tNear : s_noHit;
+}
+
+inline bool Bvh::intersectTriangle( uint i, const Ray& ray, Hit& hit ) const {
+    // Moller-Trumbore
+    const auto& t      = m_triangles[i];
+    const Vector3& a   = m_vertices[t[0]];
+    const Vector3 ab   = m_vertices[t[1]] - a;
+    const Vector3 ac   = m_vertices[t[2]] - a;
+    const Vector3 pvec = ray.direction().cross( ac );
+    const Scalar det   = ab.dot( pvec );
+    if ( det == 0 ) { return false; }
+    const Scalar invDet = 1_ra / det;
+    const Vector3 tvec  = ray.origin() - a;
+    const Scalar u      = tvec.dot( pvec ) * invDet;
+    if ( u < 0 || u > 1 ) { return false; }
+    const Vector3 qvec = tvec.cross( ab );
+    const Scalar v     = ray.direction().dot( qvec ) * invDet;
+    if ( v < 0 || u + v > 1 ) { return false; }
+    const Scalar dist = ac.dot( qvec ) * invDet;
+    if ( dist < 0 || dist >= hit.m_t ) { return false; }
+    hit.m_t        = dist;
+    hit.m_triangle = m_triangleIds[i];
+    hit.m_u        = u;
+    hit.m_v        = v;
+    return true;
+}
+
+bool Bvh::closestHit( const Ray& ray, Hit& hitOut, Scalar tMax ) const {
+    if ( isEmpty() ) { return false; }
+    const Vector3 invDir = inverseDirection( ray.direction() );
+    Hit hit;
+    hit.m_t = tMax;
+
+    struct StackEntry {
+        uint m_node;
+        Scalar m_t;
+    };
+    std::array<StackEntry, 2 * s_maxDepth> stack;
+    uint stackSize = 0;
+
+    const Scalar tRoot = intersectNode( m_nodes[0], ray.origin(), invDir, hit.m_t );
+    if ( tRoot == s_noHit ) { return false; }
+    stack[stackSize++] = { 0, tRoot };
+    while ( stackSize > 0 ) {
+        const StackEntry entry = stack[--stackSize];
+        // a closer hit may have been found since the node was pushed.
+        if ( entry.m_t >= hit.m_t ) { continue; }
+        uint nodeIndex = entry.m_node;
+        while ( true ) {
+            const Node& node = m_nodes[nodeIndex];
+            if ( node.m_count > 0 ) {
+                for ( uint i = node.m_index; i < node.m_index + node.m_count; ++i ) {
+                    intersectTriangle( i, ray, hit );
+                }
+                break;
+            }
+            // visit the nearest child first
+            uint nearChild = nodeIndex + 1;
+            uint farChild  = node.m_index;
+            Scalar tNear   = intersectNode( m_nodes[nearChild], ray.origin(), invDir, hit.m_t );
+            Scalar tFar    = intersectNode( m_nodes[farChild], ray.origin(), invDir, hit.m_t );
+            if ( tFar < tNear ) {
+                std::swap( nearChild, farChild );
+                std::swap( tNear, tFar );
+            }
+            if ( tNear == s_noHit ) { break; }
+            if ( tFar != s_noHit ) { stack[stackSize++] = { farChild, tFar }; }
+            nodeIndex = nearChild;
+        }
+    }
+
+    if ( !hit.isValid() ) { return false; }
+    hitOut = hit;
+    return true;
+}
+
+bool Bvh::anyHit( const Ray& ray, Scalar tMax ) const {
+    if ( isEmpty() ) { return false; }
+    const Vector3 invDir = inverseDirection( ray.direction() );
+    Hit hit;
+    hit.m_t = tMax;
+
+    std::array<uint, 2 * s_maxDepth> stack;
+    uint stackSize     = 0;
+    stack[stackSize++] = 0;
+    while ( stackSize > 0 ) {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if ( intersectNode( node, ray.origin(), invDir, tMax ) == s_noHit ) { continue; }
+        if ( node.m_count > 0 ) {
+            for ( uint i = node.m_index; i < node.m_index + node.m_count; ++i ) {
+                if ( intersectTriangle( i, ray, hit ) ) { return true; }
+            }
+        }
+        else {
+            stack[stackSize++] = node.m_index;
+            stack[stackSize++] = uint( &node - m_nodes.data() ) + 1;
+        }
+    }
+    return false;
+}
+
+inline Scalar Bvh::distanceToNodeSq( const Node& node, const Vector3& q ) {
+    return ( node.m_min - q ).cwiseMax( q - node.m_max ).cwiseMax( 0_ra ).squaredNorm();
+}
+
+bool Bvh::closestPoint( const Vector3& q, Projection& projectionOut, Scalar maxDistanceSq ) const {
+    if ( isEmpty() ) { return false; }
+    Projection projection;
+    projection.m_distanceSquared = maxDistanceSq;
+
+    struct StackEntry {
+        uint m_node;
+        Scalar m_distanceSq;
+    };
+    std::array<StackEntry, 2 * s_maxDepth> stack;
+    uint stackSize = 0;
+
+    const Scalar dRoot = distanceToNodeSq( m_nodes[0], q );
+    if ( dRoot >= maxDistanceSq ) { return false; }
+    stack[stackSize++] = { 0, dRoot };
+    while ( stackSize > 0 ) {
+        const StackEntry entry = stack[--stackSize];
+        if ( entry.m_distanceSq >= projection.m_distanceSquared ) { continue; }
+        const Node& node = m_nodes[entry.m_node];
+        if ( node.m_count > 0 ) {
+            for ( uint i = node.m_index; i < node.m_index + node.m_count; ++i ) {
+                const auto& t = m_triangles[i];
+                const auto out =
+                    pointToTriSq( q, m_vertices[t[0]], m_vertices[t[1]], m_vertices[t[2]] );
+                if ( out.distanceSquared < projection.m_distanceSquared ) {
+                    projection.m_distanceSquared = out.distanceSquared;
+                    projection.m_triangle        = m_triangleIds[i];
+                    projection.m_point           = out.meshPoint;
+                }
+            }
+        }
+        else {
+            // visit the nearest child first
+            uint nearChild = entry.m_node + 1;
+            uint farChild  = node.m_index;
+            Scalar dNear   = distanceToNodeSq( m_nodes[nearChild], q );
+            Scalar dFar    = distanceToNodeSq( m_nodes[farChild], q );
+            if ( dFar < dNear ) {
+                std::swap( nearChild, farChild );
+                std::swap( dNear, dFar );
+            }
+            if ( dFar < projection.m_distanceSquared ) { stack[stackSize++] = { farChild, dFar }; }
+            if ( dNear < projection.m_distanceSquared ) {
+                stack[stackSize++] = { nearChild, dNear };
+            }
+        }
+    }
+
+    if ( !projection.isValid() ) { return false; }
+    projectionOut = projection;
+    return true;
+}
+
+void Bvh::tracePacket( const Ray* rays, Hit* hits, uint numRays ) const {
+    // the rays are stored as structure of arrays so that each node and triangle is tested against
+    // the whole packet at once. Unused slots repeat the last ray, their hits being dropped.
+    using Packet = Eigen::Array<Scalar, s_packetSize, 1>;
+    std::array<Packet, 3> origin, dir, invDir;
+    for ( uint r = 0; r < s_packetSize; ++r ) {
+        const Ray& ray    = rays[std::min( r, numRays - 1 )];
+        const Vector3 inv = inverseDirection( ray.direction() );
+        for ( int k = 0; k < 3; ++k ) {
+            origin[k][r] = ray.origin()[k];
+            dir[k][r]    = ray.direction()[k];
+            invDir[k][r] = inv[k];
+        }
+    }
+    Packet tHit = Packet::Constant( s_noHit );
+    Packet u    = Packet::Zero();
+    Packet v    = Packet::Zero();
+    Eigen::Array<uint, s_packetSize, 1> triangle =
+        Eigen::Array<uint, s_packetSize, 1>::Constant( uint( -1 ) );
+
+    // return the smallest entry parameter of the rays entering node before their closest hit,
+    // or s_noHit if none does.
+    auto intersectPacket = [&]( const Node& node ) {
+        Packet tNear = Packet::Zero();
+        Packet tFar  = tHit;
+        for ( int k = 0; k < 3; ++k ) {
+            const Packet t0 = ( node.m_min[k] - origin[k] ) * invDir[k];
+            const Packet t1 = ( node.m_max[k] - origin[k] ) * invDir[k];
+            tNear           = tNear.max( t0.min( t1 ) );
+            tFar            = tFar.min( t0.max( t1 ) );
+        }
+        return ( tNear <= tFar && tNear < tHit ).select( tNear, s_noHit ).minCoeff();
+    };
+
+    struct StackEntry {
+        uint m_node;
+        Scalar m_t;
+    };
+    std::array<StackEntry, 2 * s_maxDepth> stack;
+    uint stackSize = 0;
+
+    const Scalar tRoot = intersectPacket( m_nodes[0] );
+    if ( tRoot != s_noHit ) { stack[stackSize++] = { 0, tRoot }; }
+    while ( stackSize > 0 ) {
+        const StackEntry entry = stack[--stackSize];
+        // all the rays may have found a closer hit since the node was pushed.
+        if ( entry.m_t >= tHit.maxCoeff() ) { continue; }
+        const Node& node = m_nodes[entry.m_node];
+        if ( node.m_count > 0 ) {
+            for ( uint i = node.m_index; i < node.m_index + node.m_count; ++i ) {
+                // Moller-Trumbore, same operations as intersectTriangle.
+                const auto& t    = m_triangles[i];
+                const Vector3& a = m_vertices[t[0]];
+                const Vector3 ab = m_vertices[t[1]] - a;
+                const Vector3 ac = m_vertices[t[2]] - a;
+                const Packet px  = dir[1] * ac.z() - dir[2] * ac.y();
+                const Packet py  = dir[2] * ac.x() - dir[0] * ac.z();
+                const Packet pz  = dir[0] * ac.y() - dir[1] * ac.x();
+                const Packet det = ab.x() * px + ab.y() * py + ab.z() * pz;
+                const Packet tx  = origin[0] - a.x();
+                const Packet ty  = origin[1] - a.y();
+                const Packet tz  = origin[2] - a.z();
+                const Packet qx  = ty * ab.z() - tz * ab.y();
+                const Packet qy  = tz * ab.x() - tx * ab.z();
+                const Packet qz  = tx * ab.y() - ty * ab.x();
+                const Packet invDet = det.inverse();
+                const Packet pu     = ( tx * px + ty * py + tz * pz ) * invDet;
+                const Packet pv     = ( dir[0] * qx + dir[1] * qy + dir[2] * qz ) * invDet;
+                const Packet pt     = ( ac.x() * qx + ac.y() * qy + ac.z() * qz ) * invDet;
+                const Eigen::Array<bool, s_packetSize, 1> isHit =
+                    det != 0_ra && pu >= 0_ra && pu <= 1_ra && pv >= 0_ra && pu + pv <= 1_ra &&
+                    pt >= 0_ra && pt < tHit;
+                if ( !isHit.any() ) { continue; }
+                tHit     = isHit.select( pt, tHit );
+                u        = isHit.select( pu, u );
+                v        = isHit.select( pv, v );
+                triangle = isHit.select( m_triangleIds[i], triangle );
+            }
+        }
+        else {
+            // visit the nearest child first
+            uint nearChild = entry.m_node + 1;
+            uint farChild  = node.m_index;
+            Scalar tNear   = intersectPacket( m_nodes[nearChild] );
+            Scalar tFar    = intersectPacket( m_nodes[farChild] );
+            if ( tFar < tNear ) {
+                std::swap( nearChild, farChild );
+                std::swap( tNear, tFar );
+            }
+            if ( tFar != s_noHit ) { stack[stackSize++] = { farChild, tFar }; }
+            if ( tNear != s_noHit ) { stack[stackSize++] = { nearChild, tNear }; }
+        }
+    }
+
+    for ( uint r = 0; r < numRays; ++r ) {
+        hits[r] = Hit();
+        if ( triangle[r] == uint( -1 ) ) { continue; }
+        hits[r].m_t        = tHit[r];
+        hits[r].m_triangle = triangle[r];
+        hits[r].m_u        = u[r];
+        hits[r].m_v        = v[r];
+    }
+}
+
+void Bvh::closestHits( const std::vector<Ray>& rays, std::vector<Hit>& hitsOut ) const {
+    hitsOut.resize( rays.size() );
+    if ( isEmpty() ) {
+        std::fill( hitsOut.begin(), hitsOut.end(), Hit() );
+        return;
+    }
+    const uint numRays    = uint( rays.size() );
+    const uint numPackets = ( numRays + s_packetSize - 1 ) / s_packetSize;
+    parallelFor( 0u, numPackets, [&]( uint packet ) {
+        const uint first = packet * s_packetSize;
+        tracePacket( rays.data() + first,
+                     hitsOut.data() + first,
+                     std::min( s_packetSize, numRays - first ) );
+    } );
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
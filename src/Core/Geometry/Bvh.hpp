@@ -0,0 +1,176 @@
+#pragma once
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+template <typename T>
+class IndexedGeometry;
+
+/// Bounding volume hierarchy over the triangles of a mesh, for ray casting and distance queries.
+/// The hierarchy is built with the (binned) surface area heuristic and stored as a flat array of
+/// nodes in depth first order : the left child of a node directly follows it.
+/// The Bvh stores a copy of the vertices and of the triangles, reordered so that the triangles of
+/// a leaf are contiguous. Triangle indices returned by the queries refer to the indices of the
+/// geometry the Bvh was built from.
+class RA_CORE_API Bvh
+{
+  public:
+    /// Result of a ray query.
+    struct Hit {
+        /// Ray parameter of the hit point.
+        Scalar m_t { std::numeric_limits<Scalar>::max() };
+        /// Index of the hit triangle.
+        uint m_triangle { uint( -1 ) };
+        /// Barycentric coordinates of the hit point w.r.t. the second and third vertices.
+        Scalar m_u { 0 };
+        Scalar m_v { 0 };
+
+        /// Return true if a triangle was hit.
+        bool isValid() const { return m_triangle != uint( -1 ); }
+    };
+
+    /// Result of a closest point query.
+    struct Projection {
+        /// Squared distance from the query point to the closest point.
+        Scalar m_distanceSquared { std::numeric_limits<Scalar>::max() };
+        /// Index of the triangle holding the closest point.
+        uint m_triangle { uint( -1 ) };
+        /// Closest point on the mesh.
+        Vector3 m_point { Vector3::Zero() };
+
+        /// Return true if a triangle was found.
+        bool isValid() const { return m_triangle != uint( -1 ); }
+    };
+
+    /// Create an empty Bvh.
+    Bvh() = default;
+
+    /// Create the Bvh of the triangles of geometry.
+    explicit Bvh( const IndexedGeometry<Vector3ui>& geometry, uint maxLeafSize = 4 );
+
+    /// Build the hierarchy over the triangles of geometry.
+    /// Leaves hold at most maxLeafSize triangles.
+    void build( const IndexedGeometry<Vector3ui>& geometry, uint maxLeafSize = 4 );
+
+    /// Build the hierarchy over the given triangles.
+    void build( const Vector3Array& vertices,
+                const VectorArray<Vector3ui>& triangles,
+                uint maxLeafSize = 4 );
+
+    /// Update the vertices and the bounding boxes, keeping the hierarchy.
+    /// This is much cheaper than a new build (e.g. after skinning), but the queries get slower
+    /// when the deformation changes the spatial layout of the triangles a lot.
+    /// \note The number of vertices must not change.
+    void refit( const Vector3Array& vertices );
+
+    /// Find the closest triangle hit by ray with a parameter in [0, tMax).
+    /// \return true if a triangle was hit, hitOut being unchanged otherwise.
+    bool closestHit( const Ray& ray,
+                     Hit& hitOut,
+                     Scalar tMax = std::numeric_limits<Scalar>::max() ) const;
+
+    /// Return true if ray hits any triangle with a parameter in [0, tMax).
+    /// Faster than closestHit, e.g. for visibility queries.
+    bool anyHit( const Ray& ray, Scalar tMax = std::numeric_limits<Scalar>::max() ) const;
+
+    /// Find the closest hit of each ray, hitsOut being resized to the number of rays.
+    /// Rays are traversed by packets sharing the node tests, coherent rays (e.g. primary rays
+    /// of a camera) being faster to trace. Packets are processed with parallelFor.
+    void closestHits( const std::vector<Ray>& rays, std::vector<Hit>& hitsOut ) const;
+
+    /// Find the closest point to q on the triangles, with a squared distance below maxDistanceSq.
+    /// Triangles are tested with pointToTriSq, nodes farther than the current closest point
+    /// being skipped.
+    /// \return true if a triangle was found, projectionOut being unchanged otherwise.
+    bool closestPoint( const Vector3& q,
+                       Projection& projectionOut,
+                       Scalar maxDistanceSq = std::numeric_limits<Scalar>::max() ) const;
+
+    /// Return true if the Bvh holds no triangle.
+    inline bool isEmpty() const;
+
+    /// Return the bounding box of all the triangles.
+    inline Aabb getAabb() const;
+
+    /// Return the number of nodes of the hierarchy.
+    inline size_t getNumNodes() const;
+
+    /// Return the number of triangles.
+    inline size_t getNumTriangles() const;
+
+  private:
+    /// A node of the hierarchy (32 bytes in single precision).
+    struct Node {
+        Vector3 m_min;
+        /// Index of the right child, or of the first triangle for leaves.
+        uint m_index;
+        Vector3 m_max;
+        /// Number of triangles for leaves, 0 for inner nodes.
+        uint m_count;
+    };
+
+    /// Build the node of triangles [begin, end) of m_triangleIds, return its index.
+    /// boxes and centroids are the bounding boxes and centroids of the input triangles.
+    uint buildNode( uint begin,
+                    uint end,
+                    uint depth,
+                    const std::vector<Aabb>& boxes,
+                    const Vector3Array& centroids );
+
+    /// Recompute the bounding boxes from the vertices.
+    void updateBounds();
+
+    /// Intersect ray with triangle i, updating hit if closer.
+    inline bool intersectTriangle( uint i, const Ray& ray, Hit& hit ) const;
+
+    /// Return the parameter where ray enters node, or max() if it misses it before tMax.
+    static inline Scalar intersectNode( const Node& node,
+                                        const Vector3& origin,
+                                        const Vector3& invDir,
+                                        Scalar tMax );
+
+    /// Return the squared distance from q to the bounding box of node.
+    static inline Scalar distanceToNodeSq( const Node& node, const Vector3& q );
+
+    /// Trace a packet of at most s_packetSize rays.
+    void tracePacket( const Ray* rays, Hit* hits, uint numRays ) const;
+
+    static constexpr uint s_packetSize = 8;
+    static constexpr uint s_maxDepth   = 64;
+
+    std::vector<Node> m_nodes;
+    Vector3Array m_vertices;
+    /// Triangles in leaf order.
+    VectorArray<Vector3ui> m_triangles;
+    /// Index in the original geometry of each triangle of m_triangles.
+    std::vector<uint> m_triangleIds;
+    uint m_maxLeafSize { 4 };
+};
+
+inline bool Bvh::isEmpty() const {
+    return m_nodes.empty();
+}
+
+inline Aabb Bvh::getAabb() const {
+    return isEmpty() ? Aabb() : Aabb( m_nodes[0].m_min, m_nodes[0].m_max );
+}
+
+inline size_t Bvh::getNumNodes() const {
+    return m_nodes.size();
+}
+
+inline size_t Bvh::getNumTriangles() const {
+    return m_triangles.size();
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
@@ -9,6 +9,7 @@
 
 /// Functions in this file are utilities to compute the distance between various geometric sets.
 /// They always return the squared distance.
+/// For queries against a whole mesh, see Bvh::closestPoint (triangles) and KdTree (vertices).
 namespace Ra {
 namespace Core {
 namespace Geometry {
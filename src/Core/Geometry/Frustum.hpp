@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+/// The view frustum of a camera, given by the six clipping planes of a view-projection matrix
+/// (with OpenGL conventions, i.e. the frustum maps to the [-1, 1]^3 cube), for culling of
+/// bounding boxes.
+class Frustum
+{
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    /// Position of a box w.r.t. the frustum.
+    enum class Intersection { Outside, Intersecting, Inside };
+
+    /// Frustum of the identity matrix, i.e. the [-1, 1]^3 cube.
+    inline Frustum() : Frustum( Matrix4::Identity() ) {}
+
+    /// Frustum of a view-projection matrix (projection * view).
+    inline explicit Frustum( const Matrix4& viewProj );
+
+    /// Plane i as (a, b, c, d), points with a x + b y + c z + d >= 0 being on the inner side.
+    /// Planes are left, right, bottom, top, near and far. They are not normalized.
+    inline Vector4 getPlane( int i ) const;
+
+    /// Classify the non empty box w.r.t. the frustum.
+    /// The test is conservative : boxes near the corners of the frustum may be classified as
+    /// intersecting while being outside.
+    inline Intersection classify( const Aabb& box ) const;
+
+    /// Return true if the non empty box may be visible, i.e. is not outside of the frustum.
+    inline bool intersects( const Aabb& box ) const;
+
+  private:
+    /// One plane per row.
+    Eigen::Matrix<Scalar, 6, 4> m_planes;
+};
+
+inline Frustum::Frustum( const Matrix4& viewProj ) {
+    for ( int i = 0; i < 3; ++i ) {
+        m_planes.row( 2 * i )     = viewProj.row( 3 ) + viewProj.row( i );
+        m_planes.row( 2 * i + 1 ) = viewProj.row( 3 ) - viewProj.row( i );
+    }
+}
+
+inline Vector4 Frustum::getPlane( int i ) const {
+    return m_planes.row( i ).transpose();
+}
+
+inline Frustum::Intersection Frustum::classify( const Aabb& box ) const {
+    const Vector3 center = box.center();
+    const Vector3 half   = box.max() - center;
+    Intersection result  = Intersection::Inside;
+    for ( int i = 0; i < 6; ++i ) {
+        const Vector3 normal = m_planes.block<1, 3>( i, 0 ).transpose();
+        // signed distance (times the norm of the plane normal) of the center, and projected
+        // half extent of the box on the normal.
+        const Scalar distance = normal.dot( center ) + m_planes( i, 3 );
+        const Scalar radius   = normal.cwiseAbs().dot( half );
+        if ( distance + radius < 0_ra ) { return Intersection::Outside; }
+        if ( distance - radius < 0_ra ) { result = Intersection::Intersecting; }
+    }
+    return result;
+}
+
+inline bool Frustum::intersects( const Aabb& box ) const {
+    return classify( box ) != Intersection::Outside;
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
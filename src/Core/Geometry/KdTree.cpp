@@ -0,0 +1,174 @@
+#include <Core/Geometry/KdTree.hpp>
+
+#include <Core/Geometry/TriangleMesh.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+KdTree::KdTree( const Vector3Array& points, uint maxLeafSize ) {
+    build( points, maxLeafSize );
+}
+
+KdTree::KdTree( const AttribArrayGeometry& geometry, uint maxLeafSize ) {
+    build( geometry, maxLeafSize );
+}
+
+void KdTree::build( const AttribArrayGeometry& geometry, uint maxLeafSize ) {
+    build( geometry.vertices(), maxLeafSize );
+}
+
+void KdTree::build( const Vector3Array& points, uint maxLeafSize ) {
+    m_nodes.clear();
+    m_maxLeafSize = std::max( maxLeafSize, 1u );
+    m_pointIds.resize( points.size() );
+    std::iota( m_pointIds.begin(), m_pointIds.end(), 0u );
+    if ( points.empty() ) {
+        m_points.clear();
+        return;
+    }
+
+    m_nodes.reserve( 2 * points.size() / m_maxLeafSize + 1 );
+    buildNode( 0, uint( points.size() ), points );
+
+    m_points.resize( points.size() );
+    for ( size_t i = 0; i < points.size(); ++i ) {
+        m_points[i] = points[m_pointIds[i]];
+    }
+}
+
+uint KdTree::buildNode( uint begin, uint end, const Vector3Array& points ) {
+    const uint nodeIndex = uint( m_nodes.size() );
+    m_nodes.emplace_back();
+    const uint count = end - begin;
+    if ( count <= m_maxLeafSize ) {
+        m_nodes[nodeIndex].m_index = begin;
+        m_nodes[nodeIndex].m_count = count;
+        return nodeIndex;
+    }
+
+    // median split along the largest extent, which bounds the depth by log2(n).
+    const auto first = m_pointIds.begin() + begin;
+    const auto last  = m_pointIds.begin() + end;
+    Aabb box;
+    for ( auto it = first; it != last; ++it ) {
+        box.extend( points[*it] );
+    }
+    int axis;
+    box.sizes().maxCoeff( &axis );
+    const auto middle = first + count / 2;
+    std::nth_element( first, middle, last, [&points, axis]( uint a, uint b ) {
+        return points[a][axis] < points[b][axis];
+    } );
+    const uint mid     = begin + count / 2;
+    const Scalar split = points[*middle][axis];
+
+    buildNode( begin, mid, points );
+    const uint right           = buildNode( mid, end, points );
+    m_nodes[nodeIndex].m_split = split;
+    m_nodes[nodeIndex].m_axis  = uint( axis );
+    m_nodes[nodeIndex].m_index = right;
+    m_nodes[nodeIndex].m_count = 0;
+    return nodeIndex;
+}
+
+template <typename Visitor>
+void KdTree::visit( const Vector3& q, Scalar maxDistanceSq, Visitor&& visitor ) const {
+    if ( isEmpty() ) { return; }
+
+    // nodes to visit, with a lower bound of their squared distance to q.
+    struct StackEntry {
+        uint m_node;
+        Scalar m_distanceSq;
+    };
+    std::array<StackEntry, s_maxDepth> stack;
+    uint stackSize     = 0;
+    stack[stackSize++] = { 0, 0_ra };
+    while ( stackSize > 0 ) {
+        const StackEntry entry = stack[--stackSize];
+        if ( entry.m_distanceSq > maxDistanceSq ) { continue; }
+        const Node& node = m_nodes[entry.m_node];
+        if ( node.m_count > 0 ) {
+            for ( uint i = node.m_index; i < node.m_index + node.m_count; ++i ) {
+                const Scalar d = ( m_points[i] - q ).squaredNorm();
+                if ( d <= maxDistanceSq ) { visitor( m_pointIds[i], d, maxDistanceSq ); }
+            }
+        }
+        else {
+            // visit first the side of the split plane containing q.
+            const Scalar diff    = q[node.m_axis] - node.m_split;
+            const uint nearChild = diff < 0 ? entry.m_node + 1 : node.m_index;
+            const uint farChild  = diff < 0 ? node.m_index : entry.m_node + 1;
+            stack[stackSize++]   = { farChild, std::max( entry.m_distanceSq, diff * diff ) };
+            stack[stackSize++]   = { nearChild, entry.m_distanceSq };
+        }
+    }
+}
+
+bool KdTree::nearest( const Vector3& q,
+                      uint& indexOut,
+                      Scalar& distanceSqOut,
+                      Scalar maxDistanceSq ) const {
+    uint index  = uint( -1 );
+    Scalar best = maxDistanceSq;
+    visit( q, maxDistanceSq, [&index, &best]( uint i, Scalar d, Scalar& maxD ) {
+        if ( d < best ) {
+            index = i;
+            best  = d;
+            maxD  = d;
+        }
+    } );
+    if ( index == uint( -1 ) ) { return false; }
+    indexOut      = index;
+    distanceSqOut = best;
+    return true;
+}
+
+void KdTree::kNearest( const Vector3& q,
+                       uint k,
+                       std::vector<uint>& indicesOut,
+                       std::vector<Scalar>& distancesSqOut ) const {
+    indicesOut.clear();
+    distancesSqOut.clear();
+    if ( k == 0 ) { return; }
+
+    // max-heap of the k closest points found so far.
+    using Candidate = std::pair<Scalar, uint>;
+    std::vector<Candidate> heap;
+    heap.reserve( k );
+    visit( q, std::numeric_limits<Scalar>::max(), [&heap, k]( uint i, Scalar d, Scalar& maxD ) {
+        if ( heap.size() < k ) {
+            heap.emplace_back( d, i );
+            std::push_heap( heap.begin(), heap.end() );
+        }
+        else if ( d < heap.front().first ) {
+            std::pop_heap( heap.begin(), heap.end() );
+            heap.back() = { d, i };
+            std::push_heap( heap.begin(), heap.end() );
+        }
+        if ( heap.size() == k ) { maxD = heap.front().first; }
+    } );
+
+    std::sort_heap( heap.begin(), heap.end() );
+    indicesOut.reserve( heap.size() );
+    distancesSqOut.reserve( heap.size() );
+    for ( const auto& c : heap ) {
+        distancesSqOut.push_back( c.first );
+        indicesOut.push_back( c.second );
+    }
+}
+
+void KdTree::radiusSearch( const Vector3& q, Scalar radius, std::vector<uint>& indicesOut ) const {
+    indicesOut.clear();
+    visit( q, radius * radius, [&indicesOut]( uint i, Scalar, Scalar& ) {
+        indicesOut.push_back( i );
+    } );
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
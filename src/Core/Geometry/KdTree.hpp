@@ -0,0 +1,105 @@
+#pragma once
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+class AttribArrayGeometry;
+
+/// Kd-tree over a set of points, e.g. the vertices of a TriangleMesh or of a PointCloud, for
+/// nearest neighbours and radius queries.
+/// Nodes split their points at the median of their largest extent and are stored as a flat array
+/// in depth first order. The KdTree stores a copy of the points, reordered so that the points of a
+/// leaf are contiguous. Indices returned by the queries refer to the input points.
+/// \see Bvh::closestPoint for distance queries to the triangles of a mesh.
+class RA_CORE_API KdTree
+{
+  public:
+    /// Create an empty KdTree.
+    KdTree() = default;
+
+    /// Create the KdTree of points.
+    explicit KdTree( const Vector3Array& points, uint maxLeafSize = 8 );
+
+    /// Create the KdTree of the vertices of geometry.
+    explicit KdTree( const AttribArrayGeometry& geometry, uint maxLeafSize = 8 );
+
+    /// Build the tree over points. Leaves hold at most maxLeafSize points.
+    void build( const Vector3Array& points, uint maxLeafSize = 8 );
+
+    /// Build the tree over the vertices of geometry.
+    void build( const AttribArrayGeometry& geometry, uint maxLeafSize = 8 );
+
+    /// Find the closest point to q, with a squared distance below maxDistanceSq.
+    /// \return true if a point was found, indexOut and distanceSqOut being unchanged otherwise.
+    bool nearest( const Vector3& q,
+                  uint& indexOut,
+                  Scalar& distanceSqOut,
+                  Scalar maxDistanceSq = std::numeric_limits<Scalar>::max() ) const;
+
+    /// Find the k closest points to q, sorted by increasing distance.
+    /// indicesOut and distancesSqOut are resized to min(k, getNumPoints()).
+    void kNearest( const Vector3& q,
+                   uint k,
+                   std::vector<uint>& indicesOut,
+                   std::vector<Scalar>& distancesSqOut ) const;
+
+    /// Find all the points at a distance at most radius from q, in no particular order.
+    /// indicesOut is cleared first.
+    void radiusSearch( const Vector3& q, Scalar radius, std::vector<uint>& indicesOut ) const;
+
+    /// Return true if the tree holds no point.
+    inline bool isEmpty() const;
+
+    /// Return the number of points.
+    inline size_t getNumPoints() const;
+
+  private:
+    /// A node of the tree.
+    struct Node {
+        /// Coordinate of the split plane for inner nodes.
+        Scalar m_split;
+        /// Axis of the split plane for inner nodes.
+        uint m_axis;
+        /// Index of the right child, or of the first point for leaves.
+        uint m_index;
+        /// Number of points for leaves, 0 for inner nodes.
+        uint m_count;
+    };
+
+    /// Build the node of points [begin, end) of m_pointIds, return its index.
+    uint buildNode( uint begin, uint end, const Vector3Array& points );
+
+    /// Call visitor( index, distanceSq, maxDistanceSq ) on the points closer than maxDistanceSq
+    /// to q. The visitor may decrease maxDistanceSq to prune the traversal.
+    template <typename Visitor>
+    void visit( const Vector3& q, Scalar maxDistanceSq, Visitor&& visitor ) const;
+
+    static constexpr uint s_maxDepth = 64;
+
+    std::vector<Node> m_nodes;
+    /// Points in leaf order.
+    Vector3Array m_points;
+    /// Index in the input points of each point of m_points.
+    std::vector<uint> m_pointIds;
+    uint m_maxLeafSize { 8 };
+};
+
+inline bool KdTree::isEmpty() const {
+    return m_nodes.empty();
+}
+
+inline size_t KdTree::getNumPoints() const {
+    return m_points.size();
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
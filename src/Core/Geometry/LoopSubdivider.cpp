@@ -1,5 +1,7 @@
 #include <Core/Geometry/LoopSubdivider.hpp>
 
+#include <algorithm>
+
 namespace Ra {
 namespace Core {
 namespace Geometry {
@@ -38,6 +40,7 @@ bool LoopSubdivider::subdivide( deprecated::TopologicalMesh& mesh,
     m_newVertexOps.resize( n );
     m_newEdgePropOps.resize( n );
     m_newFacePropOps.resize( n );
+    m_stencil = SubdivisionStencil();
 
     deprecated::TopologicalMesh::FaceIter fit, f_end;
     deprecated::TopologicalMesh::EdgeIter eit, e_end;
@@ -351,82 +354,74 @@ void LoopSubdivider::recompute( const Vector3Array& newCoarseVertices,
                                 Vector3Array& newSubdivVertices,
                                 Vector3Array& newSubdivNormals,
                                 deprecated::TopologicalMesh& mesh ) {
-    // update vertices
+    getStencil( mesh ).apply(
+        newCoarseVertices, newCoarseNormals, newSubdivVertices, newSubdivNormals );
+}
+
+const SubdivisionStencil& LoopSubdivider::getStencil( deprecated::TopologicalMesh& mesh ) {
+    if ( !m_stencil.empty() ) { return m_stencil; }
+    using Row = SubdivisionStencil::Builder::Row;
+    SubdivisionStencil::Builder vertices( mesh.n_vertices() );
+    SubdivisionStencil::NormalBuilder normals( mesh.n_halfedges() );
+
+    // coarse mesh vertices and normals
     auto inTriIndexProp = mesh.getInputTriangleMeshIndexPropHandle();
-    auto hNormalProp    = mesh.halfedge_normals_pph();
-#pragma omp parallel for
-    for ( int i = 0; i < int( mesh.n_halfedges() ); ++i ) {
-        auto h = mesh.halfedge_handle( i );
-        // set position on coarse mesh vertices
+    int numInputs       = 0;
+    for ( uint i = 0; i < mesh.n_halfedges(); ++i ) {
+        auto h  = mesh.halfedge_handle( i );
         auto vh = mesh.property( m_hV, h );
         if ( vh.idx() != -1 ) // avoid both boundary and non-coarse halfedges
         {
-            auto idx = mesh.property( inTriIndexProp, h );
-            mesh.set_point( vh, newCoarseVertices[idx] );
-            mesh.property( hNormalProp, h ) = newCoarseNormals[idx];
+            const int idx = int( mesh.property( inTriIndexProp, h ) );
+            vertices.setInput( vh.idx(), idx );
+            normals.setInput( h.idx(), idx );
+            numInputs = std::max( numInputs, idx + 1 );
         }
     }
-    // for each subdiv step
-    for ( int i = 0; i < int( m_oldVertexOps.size() ); ++i ) {
-        // first update new vertices
-#pragma omp parallel for schedule( static )
-        for ( int j = 0; j < int( m_newVertexOps[i].size() ); ++j ) {
-            Ra::Core::Vector3 pos( 0, 0, 0 );
-            const auto& ops = m_newVertexOps[i][j];
-            for ( const auto& op : ops.second ) {
-                pos += op.first * mesh.point( op.second );
-            }
-            mesh.set_point( ops.first, pos );
+    // replay the operations of each subdiv step, in the same order as they were applied.
+    for ( size_t i = 0; i < m_oldVertexOps.size(); ++i ) {
+        // first new vertices
+        for ( const auto& ops : m_newVertexOps[i] ) {
+            vertices.setRow( ops.first.idx(), vertices.combine( ops.second ) );
         }
-        // then compute old vertices
-        std::vector<Ra::Core::Vector3> pos( m_oldVertexOps[i].size() );
-#pragma omp parallel for
-        for ( int j = 0; j < int( m_oldVertexOps[i].size() ); ++j ) {
-            pos[j]          = Ra::Core::Vector3( 0, 0, 0 );
-            const auto& ops = m_oldVertexOps[i][j];
-            for ( const auto& op : ops.second ) {
-                pos[j] += op.first * mesh.point( op.second );
-            }
+        // then old vertices, all computed before being committed
+        std::vector<Row> rows;
+        rows.reserve( m_oldVertexOps[i].size() );
+        for ( const auto& ops : m_oldVertexOps[i] ) {
+            rows.push_back( vertices.combine( ops.second ) );
         }
-        // then commit pos for old vertices
-#pragma omp parallel for schedule( static )
-        for ( int j = 0; j < int( m_oldVertexOps[i].size() ); ++j ) {
-            mesh.set_point( m_oldVertexOps[i][j].first, pos[j] );
+        for ( size_t j = 0; j < rows.size(); ++j ) {
+            vertices.setRow( m_oldVertexOps[i][j].first.idx(), std::move( rows[j] ) );
         }
-        // deal with normal on edge centers (other non-static properties can be updated the same
-        // way)
-        // This loop should not be parallelized!
-        for ( int j = 0; j < int( m_newEdgePropOps[i].size() ); ++j ) {
-            Ra::Core::Vector3 nor( 0, 0, 0 );
-            const auto& ops = m_newEdgePropOps[i][j];
-            for ( const auto& op : ops.second ) {
-                nor += op.first * mesh.property( hNormalProp, op.second );
-            }
-            mesh.property( hNormalProp, ops.first ) = nor.normalized();
+        // normals on edge centers, which depend on the previous ones
+        for ( const auto& ops : m_newEdgePropOps[i] ) {
+            normals.setNormalized( ops.first.idx(), ops.second );
         }
-        // deal with normal on faces centers (other non-static properties can be updated the same
-        // way)
-#pragma omp parallel for
-        for ( int j = 0; j < int( m_newFacePropOps[i].size() ); ++j ) {
-            Ra::Core::Vector3 nor( 0, 0, 0 );
-            const auto& ops = m_newFacePropOps[i][j];
-            for ( const auto& op : ops.second ) {
-                nor += op.first * mesh.property( hNormalProp, op.second );
-            }
-            mesh.property( hNormalProp, ops.first ) = nor.normalized();
+        // normals on face centers
+        for ( const auto& ops : m_newFacePropOps[i] ) {
+            normals.setNormalized( ops.first.idx(), ops.second );
         }
     }
-    // update subdivided TriangleMesh vertices and normals
+
+    // subdivided TriangleMesh vertices and normals
     auto outTriIndexProp = mesh.getOutputTriangleMeshIndexPropHandle();
-#pragma omp parallel for
-    for ( int i = 0; i < int( mesh.n_halfedges() ); ++i ) {
+    std::vector<int> vertexSlots;
+    std::vector<int> normalSlots;
+    for ( uint i = 0; i < mesh.n_halfedges(); ++i ) {
         auto h = mesh.halfedge_handle( i );
         if ( !mesh.is_boundary( h ) ) {
-            auto idx               = mesh.property( outTriIndexProp, h );
-            newSubdivVertices[idx] = mesh.point( mesh.to_vertex_handle( h ) );
-            newSubdivNormals[idx]  = mesh.property( hNormalProp, h );
+            const size_t idx = size_t( int( mesh.property( outTriIndexProp, h ) ) );
+            if ( idx >= vertexSlots.size() ) {
+                vertexSlots.resize( idx + 1, -1 );
+                normalSlots.resize( idx + 1, -1 );
+            }
+            vertexSlots[idx] = mesh.to_vertex_handle( h ).idx();
+            normalSlots[idx] = h.idx();
         }
     }
+    m_stencil = SubdivisionStencil( vertices.toMatrix( vertexSlots, numInputs ),
+                                    normals.toStencil( normalSlots, numInputs ) );
+    return m_stencil;
 }
 
 } // namespace Geometry
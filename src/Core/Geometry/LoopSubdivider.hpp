@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Core/Geometry/SubdivisionStencil.hpp>
 #include <Core/Geometry/deprecated/TopologicalMesh.hpp>
 #include <Core/Math/LinearAlgebra.hpp> // Math::pi
 #include <OpenMesh/Tools/Subdivider/Uniform/SubdividerT.hh>
@@ -42,6 +43,8 @@ class RA_CORE_API LoopSubdivider
     /// but with a different geometry (e.g. for an animated character),
     /// one may want to just reapply the subdivision operations instead
     /// for performance reasons.
+    /// The operations are compiled into a SubdivisionStencil on the first call, later calls are
+    /// sparse matrix-vector products which do not access \p mesh.
     /// This can be achieved with the following code:
     // clang-format off
     /// \code
@@ -64,6 +67,14 @@ class RA_CORE_API LoopSubdivider
                     Vector3Array& newSubdivNormals,
                     deprecated::TopologicalMesh& mesh );
 
+    /**
+     * \returns the stencil mapping the vertices and normals of the coarse TriangleMesh to the
+     * ones of the subdivided TriangleMesh, built on first call after the subdivision.
+     * \note The subdivided TriangleMesh must have been retrieved from \p mesh beforehand, as it
+     * defines the order of the subdivided vertices.
+     */
+    const SubdivisionStencil& getStencil( deprecated::TopologicalMesh& mesh );
+
   protected:
     /// Pre-compute weights.
     void init_weights( size_t max_valence ) {
@@ -146,6 +157,9 @@ class RA_CORE_API LoopSubdivider
 
     /// old vertex halfedges
     OpenMesh::HPropHandleT<deprecated::TopologicalMesh::VertexHandle> m_hV;
+
+    /// operations compiled for recompute
+    SubdivisionStencil m_stencil;
 };
 
 } // namespace Geometry
@@ -0,0 +1,123 @@
+#include <Core/Geometry/MultiDrawBatch.hpp>
+
+#include <Core/Geometry/StandardAttribNames.hpp>
+
+#include <algorithm>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+static_assert( sizeof( MultiDrawBatch::DrawCommand ) == 5 * sizeof( std::uint32_t ),
+               "DrawCommand must match the layout of an indirect indexed draw command" );
+static_assert( sizeof( MultiDrawBatch::DrawData ) == 80,
+               "DrawData must match the std430 layout of the per draw data" );
+
+namespace {
+/// Apply f to the elements of the Vector3 attribute name of geometry, if any.
+template <typename F>
+void transformAttrib( AttribArrayGeometry& geometry, const std::string& name, const F& f ) {
+    auto attr = geometry.getAttribBase( name );
+    if ( attr == nullptr || !attr->isVector3() ) { return; }
+    auto& data = attr->cast<Vector3>().getDataWithLock();
+    std::for_each( data.begin(), data.end(), f );
+    attr->cast<Vector3>().unlock();
+}
+} // namespace
+
+MultiDrawBatch::MultiDrawBatch( bool bakeTransforms ) : m_bakeTransforms( bakeTransforms ) {}
+
+void MultiDrawBatch::clear() {
+    m_mesh = TriangleMesh();
+    m_commands.clear();
+    m_drawData.clear();
+}
+
+bool MultiDrawBatch::isCompatible( const TriangleMesh& mesh ) const {
+    if ( isEmpty() ) { return true; }
+    if ( mesh.vertexAttribs().getNumAttribs() != m_mesh.vertexAttribs().getNumAttribs() ) {
+        return false;
+    }
+    bool compatible = true;
+    mesh.vertexAttribs().for_each_attrib( [this, &compatible]( const auto& attr ) {
+        auto other = m_mesh.getAttribBase( attr->getName() );
+        compatible = compatible && other != nullptr && attr->isFloat() == other->isFloat() &&
+                     attr->isVector2() == other->isVector2() &&
+                     attr->isVector3() == other->isVector3() &&
+                     attr->isVector4() == other->isVector4();
+    } );
+    return compatible;
+}
+
+int MultiDrawBatch::add( const TriangleMesh& mesh,
+                         const Transform& transform,
+                         uint materialIndex ) {
+    if ( !isCompatible( mesh ) ) { return -1; }
+
+    // the first draw gives the attributes of the arenas.
+    if ( isEmpty() ) {
+        mesh.vertexAttribs().for_each_attrib( [this]( const auto& attr ) {
+            const auto& name = attr->getName();
+            if ( m_mesh.getAttribBase( name ) != nullptr ) { return; }
+            if ( attr->isFloat() ) m_mesh.addAttrib<Scalar>( name );
+            if ( attr->isVector2() ) m_mesh.addAttrib<Vector2>( name );
+            if ( attr->isVector3() ) m_mesh.addAttrib<Vector3>( name );
+            if ( attr->isVector4() ) m_mesh.addAttrib<Vector4>( name );
+        } );
+    }
+
+    DrawCommand command;
+    command.m_count         = std::uint32_t( mesh.getIndices().size() * 3 );
+    command.m_instanceCount = 1;
+    command.m_firstIndex    = std::uint32_t( m_mesh.getIndices().size() * 3 );
+    command.m_baseVertex    = std::int32_t( m_mesh.vertices().size() );
+    command.m_baseInstance  = std::uint32_t( m_commands.size() );
+
+    // AttribArrayGeometry::append invalidates the aabb of the arenas.
+    if ( m_bakeTransforms ) {
+        AttribArrayGeometry draw( mesh );
+        const Matrix3 model        = transform.linear();
+        const Matrix3 normalMatrix = model.inverse().transpose();
+        auto point  = [&transform]( Vector3& p ) { p = transform * p; };
+        auto normal = [&normalMatrix]( Vector3& n ) { n = ( normalMatrix * n ).normalized(); };
+        auto vector = [&model]( Vector3& v ) { v = ( model * v ).normalized(); };
+        transformAttrib( draw, getAttribName( MeshAttrib::VERTEX_POSITION ), point );
+        transformAttrib( draw, getAttribName( MeshAttrib::VERTEX_NORMAL ), normal );
+        transformAttrib( draw, getAttribName( MeshAttrib::VERTEX_TANGENT ), vector );
+        transformAttrib( draw, getAttribName( MeshAttrib::VERTEX_BITANGENT ), vector );
+        m_mesh.AttribArrayGeometry::append( draw );
+    }
+    else {
+        m_mesh.AttribArrayGeometry::append( mesh );
+    }
+
+    auto& indices = m_mesh.getIndicesWithLock();
+    indices.insert( indices.end(), mesh.getIndices().begin(), mesh.getIndices().end() );
+    m_mesh.indicesUnlock();
+
+    DrawData data;
+    data.m_transform     = m_bakeTransforms ? Eigen::Matrix4f::Identity()
+                                            : Eigen::Matrix4f( transform.matrix().cast<float>() );
+    data.m_materialIndex = materialIndex;
+    std::fill( std::begin( data.m_padding ), std::end( data.m_padding ), 0u );
+
+    m_commands.push_back( command );
+    m_drawData.push_back( data );
+    return getNumDraws() - 1;
+}
+
+void MultiDrawBatch::setAllVisible( bool visible ) {
+    for ( auto& command : m_commands ) {
+        command.m_instanceCount = visible ? 1 : 0;
+    }
+}
+
+int MultiDrawBatch::getNumVisible() const {
+    return int( std::count_if( m_commands.begin(), m_commands.end(), []( const auto& command ) {
+        return command.m_instanceCount > 0;
+    } ) );
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/Geometry/TriangleMesh.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+/**
+ * Packing of several triangle meshes with the same vertex attributes into shared vertex and index
+ * arenas, drawn at once with an indirect multi draw call (e.g. glMultiDrawElementsIndirect).
+ *
+ * Each added mesh is a draw of the batch : its vertices are appended to the attributes of the
+ * arena mesh, and its triangles are appended unchanged, i.e. relative to the first vertex of the
+ * draw, given by the base vertex of its command.
+ * Transforms are either stored as per draw data (e.g. for a shader storage buffer indexed by the
+ * draw id), or baked in the vertices, so that the batch can be drawn by shaders expecting an
+ * identity model matrix.
+ */
+class RA_CORE_API MultiDrawBatch
+{
+  public:
+    /// Indirect indexed draw command, with the layout read by the GPU.
+    struct DrawCommand {
+        std::uint32_t m_count;
+        std::uint32_t m_instanceCount;
+        std::uint32_t m_firstIndex;
+        std::int32_t m_baseVertex;
+        std::uint32_t m_baseInstance;
+    };
+
+    /// Per draw data, with the std430 layout of a struct { mat4 model; uint material; }.
+    struct DrawData {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        Eigen::Matrix4f m_transform;
+        std::uint32_t m_materialIndex;
+        std::uint32_t m_padding[3];
+    };
+
+    /// Create an empty batch.
+    /// \param bakeTransforms true if the transforms are applied to the vertices (positions,
+    /// normals, tangents and bitangents), false if they are only stored in the draw data.
+    explicit MultiDrawBatch( bool bakeTransforms = false );
+
+    /// Remove all the draws.
+    void clear();
+
+    /// Return true if mesh has the same vertex attributes (names and types) as the meshes of the
+    /// batch, or if the batch is empty.
+    bool isCompatible( const TriangleMesh& mesh ) const;
+
+    /// Append a draw of mesh, with its model to world transform, and return its index.
+    /// \return the index of the draw, or -1 if mesh is not compatible with the batch.
+    int add( const TriangleMesh& mesh,
+             const Transform& transform = Transform::Identity(),
+             uint materialIndex         = 0 );
+
+    /// Set the visibility of a draw, as its number of instances.
+    inline void setVisible( int draw, bool visible );
+    inline bool isVisible( int draw ) const;
+
+    /// Set all the draws visible or hidden.
+    void setAllVisible( bool visible );
+
+    inline bool isEmpty() const;
+    inline int getNumDraws() const;
+    /// Return the number of visible draws.
+    int getNumVisible() const;
+
+    inline bool areTransformsBaked() const;
+
+    /// Vertex and index arenas : the vertex attributes of all the draws, and their triangles
+    /// relative to the base vertex of each draw.
+    inline const TriangleMesh& getMesh() const;
+    inline const std::vector<DrawCommand>& getCommands() const;
+    inline const AlignedStdVector<DrawData>& getDrawData() const;
+
+  private:
+    bool m_bakeTransforms;
+    TriangleMesh m_mesh;
+    std::vector<DrawCommand> m_commands;
+    AlignedStdVector<DrawData> m_drawData;
+};
+
+inline void MultiDrawBatch::setVisible( int draw, bool visible ) {
+    CORE_ASSERT( draw >= 0 && draw < getNumDraws(), "Invalid draw" );
+    m_commands[size_t( draw )].m_instanceCount = visible ? 1 : 0;
+}
+
+inline bool MultiDrawBatch::isVisible( int draw ) const {
+    CORE_ASSERT( draw >= 0 && draw < getNumDraws(), "Invalid draw" );
+    return m_commands[size_t( draw )].m_instanceCount > 0;
+}
+
+inline bool MultiDrawBatch::isEmpty() const {
+    return m_commands.empty();
+}
+
+inline int MultiDrawBatch::getNumDraws() const {
+    return int( m_commands.size() );
+}
+
+inline bool MultiDrawBatch::areTransformsBaked() const {
+    return m_bakeTransforms;
+}
+
+inline const TriangleMesh& MultiDrawBatch::getMesh() const {
+    return m_mesh;
+}
+
+inline const std::vector<MultiDrawBatch::DrawCommand>& MultiDrawBatch::getCommands() const {
+    return m_commands;
+}
+
+inline const AlignedStdVector<MultiDrawBatch::DrawData>& MultiDrawBatch::getDrawData() const {
+    return m_drawData;
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,137 @@
+#include <Core/Geometry/OcclusionBuffer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+namespace {
+/// Points with a smaller clip space w are considered behind the camera.
+constexpr Scalar s_minW = 1e-5_ra;
+
+/// Twice the signed area of triangle (a, b, p), in window coordinates.
+inline Scalar edge( const Vector3& a, const Vector3& b, Scalar px, Scalar py ) {
+    return ( b.x() - a.x() ) * ( py - a.y() ) - ( b.y() - a.y() ) * ( px - a.x() );
+}
+} // namespace
+
+OcclusionBuffer::OcclusionBuffer( uint width, uint height ) {
+    resize( width, height );
+}
+
+void OcclusionBuffer::resize( uint width, uint height ) {
+    m_width  = std::max( width, 1u );
+    m_height = std::max( height, 1u );
+    m_depth.assign( size_t( m_width ) * m_height, 1_ra );
+}
+
+void OcclusionBuffer::clear( const Matrix4& viewProj ) {
+    m_viewProj = viewProj;
+    std::fill( m_depth.begin(), m_depth.end(), 1_ra );
+}
+
+void OcclusionBuffer::addOccluder( const Transform& transform,
+                                   const Vector3Array& vertices,
+                                   const VectorArray<Vector3ui>& triangles ) {
+    const Matrix4 toClip = m_viewProj * transform.matrix();
+    Vector3Array window( vertices.size() );
+    std::vector<uint8_t> valid( vertices.size() );
+    for ( size_t i = 0; i < vertices.size(); ++i ) {
+        const Vector4 clip = toClip * vertices[i].homogeneous();
+        valid[i]           = clip.w() > s_minW;
+        if ( valid[i] ) {
+            const Vector3 ndc = clip.head<3>() / clip.w();
+            window[i]         = Vector3( ( ndc.x() + 1_ra ) * 0.5_ra * Scalar( m_width ),
+                                 ( ndc.y() + 1_ra ) * 0.5_ra * Scalar( m_height ),
+                                 ( ndc.z() + 1_ra ) * 0.5_ra );
+        }
+    }
+    for ( const auto& t : triangles ) {
+        if ( valid[t[0]] && valid[t[1]] && valid[t[2]] ) {
+            rasterizeTriangle( window[t[0]], window[t[1]], window[t[2]] );
+        }
+    }
+}
+
+void OcclusionBuffer::rasterizeTriangle( const Vector3& a, const Vector3& b, const Vector3& c ) {
+    Scalar area = edge( a, b, c.x(), c.y() );
+    if ( std::abs( area ) <= std::numeric_limits<Scalar>::min() ) { return; }
+    // counter clockwise order, so that the edge functions are positive inside.
+    const Vector3& v1 = area > 0_ra ? b : c;
+    const Vector3& v2 = area > 0_ra ? c : b;
+    area              = std::abs( area );
+
+    // pixels whose center may be covered, clamped before the conversion to int.
+    auto clampX = [this]( Scalar x ) { return std::clamp( x, 0_ra, Scalar( m_width ) ); };
+    auto clampY = [this]( Scalar y ) { return std::clamp( y, 0_ra, Scalar( m_height ) ); };
+    const int x0 = int( std::floor( clampX( std::min( { a.x(), v1.x(), v2.x() } ) - 0.5_ra ) ) );
+    const int x1 = int( std::ceil( clampX( std::max( { a.x(), v1.x(), v2.x() } ) - 0.5_ra ) ) );
+    const int y0 = int( std::floor( clampY( std::min( { a.y(), v1.y(), v2.y() } ) - 0.5_ra ) ) );
+    const int y1 = int( std::ceil( clampY( std::max( { a.y(), v1.y(), v2.y() } ) - 0.5_ra ) ) );
+
+    for ( int y = y0; y <= y1 && y < int( m_height ); ++y ) {
+        const Scalar py = Scalar( y ) + 0.5_ra;
+        for ( int x = x0; x <= x1 && x < int( m_width ); ++x ) {
+            const Scalar px = Scalar( x ) + 0.5_ra;
+            const Scalar w0 = edge( v1, v2, px, py );
+            const Scalar w1 = edge( v2, a, px, py );
+            const Scalar w2 = edge( a, v1, px, py );
+            if ( w0 < 0_ra || w1 < 0_ra || w2 < 0_ra ) { continue; }
+            const Scalar z = ( w0 * a.z() + w1 * v1.z() + w2 * v2.z() ) / area;
+            Scalar& depth  = m_depth[size_t( y ) * m_width + size_t( x )];
+            if ( z >= 0_ra && z < depth ) { depth = z; }
+        }
+    }
+}
+
+bool OcclusionBuffer::project( const Aabb& box, Rect& rect ) const {
+    Vector3 min = Vector3::Constant( std::numeric_limits<Scalar>::max() );
+    Vector3 max = Vector3::Constant( std::numeric_limits<Scalar>::lowest() );
+    for ( int i = 0; i < 8; ++i ) {
+        const Vector4 clip = m_viewProj * box.corner( Aabb::CornerType( i ) ).homogeneous();
+        if ( clip.w() <= s_minW ) { return false; }
+        const Vector3 ndc = clip.head<3>() / clip.w();
+        min               = min.cwiseMin( ndc );
+        max               = max.cwiseMax( ndc );
+    }
+    if ( min.z() < -1_ra ) { return false; }
+
+    auto toPixel = []( Scalar ndc, uint size ) {
+        return std::clamp( ( ndc + 1_ra ) * 0.5_ra * Scalar( size ), 0_ra, Scalar( size ) );
+    };
+    rect.m_x0    = int( std::floor( toPixel( min.x(), m_width ) ) );
+    rect.m_x1    = int( std::ceil( toPixel( max.x(), m_width ) ) );
+    rect.m_y0    = int( std::floor( toPixel( min.y(), m_height ) ) );
+    rect.m_y1    = int( std::ceil( toPixel( max.y(), m_height ) ) );
+    rect.m_depth = ( min.z() + 1_ra ) * 0.5_ra;
+    return true;
+}
+
+bool OcclusionBuffer::isOccluded( const Aabb& box ) const {
+    Rect rect;
+    if ( box.isEmpty() || !project( box, rect ) ) { return false; }
+    if ( rect.m_x0 >= rect.m_x1 || rect.m_y0 >= rect.m_y1 ) { return false; }
+    for ( int y = rect.m_y0; y < rect.m_y1; ++y ) {
+        const Scalar* row = m_depth.data() + size_t( y ) * m_width;
+        for ( int x = rect.m_x0; x < rect.m_x1; ++x ) {
+            if ( row[x] >= rect.m_depth ) { return false; }
+        }
+    }
+    return true;
+}
+
+Scalar OcclusionBuffer::getCoverage( const Aabb& box ) const {
+    Rect rect;
+    if ( box.isEmpty() ) { return 0_ra; }
+    if ( !project( box, rect ) ) { return 1_ra; }
+    const int width  = std::max( rect.m_x1 - rect.m_x0, 0 );
+    const int height = std::max( rect.m_y1 - rect.m_y0, 0 );
+    return Scalar( width * height ) / Scalar( m_width * m_height );
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
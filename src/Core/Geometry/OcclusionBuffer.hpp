@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+/// Small software depth buffer for occlusion culling.
+/// A few large occluders (e.g. walls, terrain, buildings) are rasterized at low resolution, then
+/// the bounding boxes of the other objects are tested against the buffer : a box is occluded if
+/// all the pixels covered by its screen space rectangle hold a depth smaller than the nearest
+/// depth of the box.
+/// Depths are the window coordinates in [0, 1] of the view-projection matrix given to clear(),
+/// with OpenGL conventions.
+/// \note Occluders are sampled at the pixel centers, like a GPU rasterizer, so thin occluders may
+/// hide objects seen through holes smaller than a pixel of the buffer.
+class RA_CORE_API OcclusionBuffer
+{
+  public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    /// Create a buffer of width x height pixels.
+    explicit OcclusionBuffer( uint width = 256, uint height = 128 );
+
+    /// Resize the buffer, which must then be cleared.
+    void resize( uint width, uint height );
+
+    /// Set the view-projection matrix (projection * view) and reset the depths to the far plane.
+    void clear( const Matrix4& viewProj );
+
+    /// Rasterize the triangles of an occluder, with vertices in model space and transform from
+    /// model to world space. Triangles crossing the near plane are skipped.
+    void addOccluder( const Transform& transform,
+                      const Vector3Array& vertices,
+                      const VectorArray<Vector3ui>& triangles );
+
+    /// Return true if the world space box is hidden by the occluders.
+    /// Boxes crossing the near plane or outside of the buffer are never occluded.
+    bool isOccluded( const Aabb& box ) const;
+
+    /// Return the fraction of the buffer covered by the screen space rectangle of the world space
+    /// box, 1 for boxes crossing the near plane, e.g. to select the occluders.
+    Scalar getCoverage( const Aabb& box ) const;
+
+    inline uint getWidth() const;
+    inline uint getHeight() const;
+
+    /// Return the depth of pixel (x, y), 1 being the far plane.
+    inline Scalar getDepth( uint x, uint y ) const;
+
+  private:
+    /// Screen space rectangle of a box, as the pixels [m_x0, m_x1) x [m_y0, m_y1) of the buffer.
+    struct Rect {
+        int m_x0, m_y0, m_x1, m_y1;
+        /// Nearest depth of the box.
+        Scalar m_depth;
+    };
+
+    /// Project the box, return false if it crosses the near plane.
+    /// The rectangle is clamped to the buffer.
+    bool project( const Aabb& box, Rect& rect ) const;
+
+    /// Rasterize a triangle in window coordinates.
+    void rasterizeTriangle( const Vector3& a, const Vector3& b, const Vector3& c );
+
+    Matrix4 m_viewProj { Matrix4::Identity() };
+    uint m_width;
+    uint m_height;
+    std::vector<Scalar> m_depth;
+};
+
+inline uint OcclusionBuffer::getWidth() const {
+    return m_width;
+}
+
+inline uint OcclusionBuffer::getHeight() const {
+    return m_height;
+}
+
+inline Scalar OcclusionBuffer::getDepth( uint x, uint y ) const {
+    return m_depth[y * m_width + x];
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
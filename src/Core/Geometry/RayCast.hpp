@@ -48,6 +48,8 @@ bool RA_CORE_API RayCastTriangle( const Ray& r,
                                   const Core::Vector3& c,
                                   std::vector<Scalar>& hitsOut );
 
+/// Intersect a ray with all the triangles of a mesh, testing each triangle.
+/// \see Bvh for faster closest hit and any hit queries.
 bool RA_CORE_API RayCastTriangleMesh( const Ray& r,
                                       const TriangleMesh& mesh,
                                       std::vector<Scalar>& hitsOut,
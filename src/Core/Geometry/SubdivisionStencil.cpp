@@ -0,0 +1,151 @@
+#include <Core/Geometry/SubdivisionStencil.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <algorithm>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+void SubdivisionStencil::compact( Builder::Row& row ) {
+    if ( row.empty() ) { return; }
+    std::sort( row.begin(), row.end(), []( const auto& a, const auto& b ) {
+        return a.first < b.first;
+    } );
+    size_t last = 0;
+    for ( size_t i = 1; i < row.size(); ++i ) {
+        if ( row[i].first == row[last].first ) { row[last].second += row[i].second; }
+        else { row[++last] = row[i]; }
+    }
+    row.resize( last + 1 );
+}
+
+SubdivisionStencil::Matrix
+SubdivisionStencil::Builder::toMatrix( const std::vector<int>& outputSlots, int numInputs ) const {
+    Matrix stencil( Eigen::Index( outputSlots.size() ), numInputs );
+    Eigen::VectorXi nonZeros( outputSlots.size() );
+    for ( size_t k = 0; k < outputSlots.size(); ++k ) {
+        nonZeros[k] = outputSlots[k] < 0 ? 0 : int( m_rows[outputSlots[k]].size() );
+    }
+    stencil.reserve( nonZeros );
+    for ( size_t k = 0; k < outputSlots.size(); ++k ) {
+        if ( outputSlots[k] < 0 ) { continue; }
+        for ( const auto& entry : m_rows[outputSlots[k]] ) {
+            stencil.insert( Eigen::Index( k ), entry.first ) = entry.second;
+        }
+    }
+    stencil.makeCompressed();
+    return stencil;
+}
+
+void SubdivisionStencil::NormalBuilder::setInput( int slot, int input ) {
+    m_slots[slot] = addValue( { { input, 1_ra } }, 0 );
+}
+
+int SubdivisionStencil::NormalBuilder::addValue( Builder::Row row, int level ) {
+    m_rows.push_back( std::move( row ) );
+    m_levels.push_back( level );
+    return int( m_rows.size() ) - 1;
+}
+
+SubdivisionStencil::NormalStencil
+SubdivisionStencil::NormalBuilder::toStencil( const std::vector<int>& outputSlots,
+                                              int numInputs ) const {
+    // values sorted by level, keeping their order in each level.
+    std::vector<std::vector<int>> levels;
+    for ( size_t v = 0; v < m_levels.size(); ++v ) {
+        if ( size_t( m_levels[v] ) >= levels.size() ) { levels.resize( m_levels[v] + 1 ); }
+        levels[m_levels[v]].push_back( int( v ) );
+    }
+    std::vector<int> index( m_levels.size() );
+    int offset = 0;
+    for ( const auto& level : levels ) {
+        for ( int v : level ) {
+            index[v] = offset++;
+        }
+    }
+
+    NormalStencil stencil;
+    offset = 0;
+    for ( size_t l = 0; l < levels.size(); ++l ) {
+        const auto& level = levels[l];
+        Matrix matrix( Eigen::Index( level.size() ), l == 0 ? numInputs : offset );
+        Eigen::VectorXi nonZeros( level.size() );
+        for ( size_t k = 0; k < level.size(); ++k ) {
+            nonZeros[k] = int( m_rows[level[k]].size() );
+        }
+        matrix.reserve( nonZeros );
+        for ( size_t k = 0; k < level.size(); ++k ) {
+            for ( const auto& entry : m_rows[level[k]] ) {
+                const int col = l == 0 ? entry.first : index[entry.first];
+                matrix.insert( Eigen::Index( k ), col ) = entry.second;
+            }
+        }
+        matrix.makeCompressed();
+        stencil.m_levels.push_back( std::move( matrix ) );
+        offset += int( level.size() );
+    }
+
+    stencil.m_outputs.reserve( outputSlots.size() );
+    for ( int slot : outputSlots ) {
+        const int value = slot < 0 ? -1 : m_slots[slot];
+        stencil.m_outputs.push_back( value < 0 ? -1 : index[value] );
+    }
+    return stencil;
+}
+
+void SubdivisionStencil::apply( const Vector3Array& coarseVertices,
+                                const Vector3Array& coarseNormals,
+                                Vector3Array& subdivVertices,
+                                Vector3Array& subdivNormals ) const {
+    apply( m_vertexStencil, coarseVertices, subdivVertices, false );
+
+    // each level is computed from the coarse normals or from the values of the previous levels.
+    Eigen::Index numValues = 0;
+    for ( const auto& level : m_normalStencil.m_levels ) {
+        numValues += level.rows();
+    }
+    Vector3Array values( static_cast<size_t>( numValues ) );
+    Eigen::Index offset = 0;
+    for ( size_t l = 0; l < m_normalStencil.m_levels.size(); ++l ) {
+        const auto& level = m_normalStencil.m_levels[l];
+        applyRows( level, l == 0 ? coarseNormals : values, values.data() + offset, l > 0 );
+        offset += level.rows();
+    }
+
+    const auto& outputs = m_normalStencil.m_outputs;
+    subdivNormals.resize( outputs.size() );
+    parallelFor( 0, int( outputs.size() ), [&]( int i ) {
+        if ( outputs[i] < 0 ) { subdivNormals[i] = Vector3::Zero(); }
+        else { subdivNormals[i] = values[outputs[i]]; }
+    } );
+}
+
+void SubdivisionStencil::apply( const Matrix& stencil,
+                                const Vector3Array& in,
+                                Vector3Array& out,
+                                bool normalize ) {
+    out.resize( size_t( stencil.rows() ) );
+    applyRows( stencil, in, out.data(), normalize );
+}
+
+void SubdivisionStencil::applyRows( const Matrix& stencil,
+                                    const Vector3Array& in,
+                                    Vector3* out,
+                                    bool normalize ) {
+    CORE_ASSERT( Eigen::Index( in.size() ) >= stencil.cols(), "Not enough coarse attributes." );
+    const int* outer   = stencil.outerIndexPtr();
+    const int* inner   = stencil.innerIndexPtr();
+    const Scalar* vals = stencil.valuePtr();
+    parallelFor( 0, int( stencil.rows() ), [&]( int i ) {
+        Vector3 v = Vector3::Zero();
+        for ( int k = outer[i]; k < outer[i + 1]; ++k ) {
+            v += vals[k] * in[inner[k]];
+        }
+        out[i] = normalize ? v.normalized() : v;
+    } );
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/RaCore.hpp>
+#include <Core/Types.hpp>
+
+#include <Eigen/Sparse>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+/**
+ * Maps from the vertices and normals of a coarse TriangleMesh to the ones of its subdivision, as
+ * computed by LoopSubdivider and CatmullClarkSubdivider.
+ *
+ * Row i of the vertex stencil holds the weights of the coarse vertices contributing to the
+ * subdivided vertex i. Evaluating a deformed cage is then a sparse matrix-vector product, without
+ * any topology traversal, run in parallel over the subdivided vertices.
+ *
+ * \note The subdividers normalize each interpolated normal, so subdivided normals are not a linear
+ * map of the coarse ones: they are evaluated by levels of sparse products, see NormalStencil.
+ */
+class RA_CORE_API SubdivisionStencil
+{
+  public:
+    /// Row major, so that each subdivided attribute is computed independently.
+    using Matrix = Eigen::SparseMatrix<Scalar, Eigen::RowMajor>;
+
+    /**
+     * Symbolic evaluation of the operations recorded by the subdividers.
+     * Each slot (vertex or halfedge of the subdivided TopologicalMesh) stores a row, i.e. the
+     * linear combination of coarse attributes giving its current value.
+     */
+    class Builder
+    {
+      public:
+        /// Pairs of coarse attribute index and weight, sorted by index.
+        using Row = std::vector<std::pair<int, Scalar>>;
+
+        explicit Builder( size_t numSlots ) : m_rows( numSlots ) {}
+
+        /// Sets \p slot to the coarse attribute \p input.
+        inline void setInput( int slot, int input );
+
+        /// Sets the row of \p slot.
+        inline void setRow( int slot, Row row );
+
+        /// \returns the row of \p slot.
+        inline const Row& getRow( int slot ) const;
+
+        /**
+         * \returns the combination of the current rows of the slots given by \p ops, as pairs of
+         * weight and OpenMesh handle, as recorded by the subdividers.
+         */
+        template <typename Ops>
+        Row combine( const Ops& ops ) const;
+
+        /**
+         * Builds the stencil of \p numInputs coarse attributes, row k being the row of
+         * outputSlots[k], or empty if outputSlots[k] is negative.
+         */
+        Matrix toMatrix( const std::vector<int>& outputSlots, int numInputs ) const;
+
+      private:
+        std::vector<Row> m_rows;
+    };
+
+    /**
+     * Normal operations, grouped by levels of operations which only depend on the previous ones.
+     * Level 0 copies coarse normals, and level l > 0 computes normalized combinations of the
+     * values of the levels before it, its values being appended after them.
+     */
+    struct NormalStencil {
+        std::vector<Matrix> m_levels;
+        /// Value of each subdivided normal, or -1 if none.
+        std::vector<int> m_outputs;
+    };
+
+    /**
+     * Symbolic evaluation of the normal operations recorded by the subdividers.
+     * Each operation adds a value, the normalized combination of the current values of some slots
+     * (halfedges of the subdivided TopologicalMesh), and sets it to its slot.
+     */
+    class NormalBuilder
+    {
+      public:
+        explicit NormalBuilder( size_t numSlots ) : m_slots( numSlots, -1 ) {}
+
+        /// Sets \p slot to the coarse normal \p input.
+        void setInput( int slot, int input );
+
+        /**
+         * Sets \p slot to the normalized combination of the current values of the slots given by
+         * \p ops, as pairs of weight and OpenMesh handle, as recorded by the subdividers.
+         * Copies of a single slot share its value, without normalization.
+         */
+        template <typename Ops>
+        void setNormalized( int slot, const Ops& ops );
+
+        /**
+         * Builds the normal stencil of \p numInputs coarse normals, subdivided normal k being the
+         * value of outputSlots[k], or zero if outputSlots[k] is negative.
+         */
+        NormalStencil toStencil( const std::vector<int>& outputSlots, int numInputs ) const;
+
+      private:
+        /// \returns the index of the new value.
+        int addValue( Builder::Row row, int level );
+
+        /// Current value of each slot, -1 if unset.
+        std::vector<int> m_slots;
+        /// Combination of each value, of coarse normals for level 0, of values otherwise.
+        std::vector<Builder::Row> m_rows;
+        std::vector<int> m_levels;
+    };
+
+    SubdivisionStencil() = default;
+
+    SubdivisionStencil( Matrix vertexStencil, NormalStencil normalStencil ) :
+        m_vertexStencil( std::move( vertexStencil ) ),
+        m_normalStencil( std::move( normalStencil ) ) {}
+
+    /// \returns true if the stencil has not been built.
+    inline bool empty() const;
+
+    /// Stencil of the vertices positions.
+    inline const Matrix& getVertexStencil() const;
+
+    /// Operations computing the vertices normals.
+    inline const NormalStencil& getNormalStencil() const;
+
+    /**
+     * Computes the subdivided vertices and normals from the coarse ones.
+     * \p subdivVertices and \p subdivNormals are resized if needed.
+     */
+    void apply( const Vector3Array& coarseVertices,
+                const Vector3Array& coarseNormals,
+                Vector3Array& subdivVertices,
+                Vector3Array& subdivNormals ) const;
+
+    /**
+     * Computes \p out = \p stencil * \p in, in parallel over the rows of \p stencil, normalizing
+     * the results if \p normalize is true.
+     */
+    static void
+    apply( const Matrix& stencil, const Vector3Array& in, Vector3Array& out, bool normalize );
+
+  private:
+    /// Sorts \p row by index and merges the duplicated indices.
+    static void compact( Builder::Row& row );
+
+    /// Computes \p out[i], for each row i of \p stencil, \p out may be a part of \p in not read
+    /// by \p stencil.
+    static void
+    applyRows( const Matrix& stencil, const Vector3Array& in, Vector3* out, bool normalize );
+
+    Matrix m_vertexStencil;
+    NormalStencil m_normalStencil;
+};
+
+inline void SubdivisionStencil::Builder::setInput( int slot, int input ) {
+    m_rows[slot] = { { input, 1_ra } };
+}
+
+inline void SubdivisionStencil::Builder::setRow( int slot, Row row ) {
+    m_rows[slot] = std::move( row );
+}
+
+inline const SubdivisionStencil::Builder::Row&
+SubdivisionStencil::Builder::getRow( int slot ) const {
+    return m_rows[slot];
+}
+
+template <typename Ops>
+SubdivisionStencil::Builder::Row SubdivisionStencil::Builder::combine( const Ops& ops ) const {
+    Row row;
+    for ( const auto& op : ops ) {
+        for ( const auto& entry : m_rows[op.second.idx()] ) {
+            row.emplace_back( entry.first, op.first * entry.second );
+        }
+    }
+    compact( row );
+    return row;
+}
+
+template <typename Ops>
+void SubdivisionStencil::NormalBuilder::setNormalized( int slot, const Ops& ops ) {
+    Builder::Row row;
+    int level = 0;
+    for ( const auto& op : ops ) {
+        const int value = m_slots[op.second.idx()];
+        if ( value < 0 ) { continue; }
+        row.emplace_back( value, op.first );
+        level = std::max( level, m_levels[value] );
+    }
+    compact( row );
+    if ( row.size() == 1 && row.front().second == 1_ra ) { m_slots[slot] = row.front().first; }
+    else { m_slots[slot] = addValue( std::move( row ), level + 1 ); }
+}
+
+inline bool SubdivisionStencil::empty() const {
+    return m_vertexStencil.rows() == 0;
+}
+
+inline const SubdivisionStencil::Matrix& SubdivisionStencil::getVertexStencil() const {
+    return m_vertexStencil;
+}
+
+inline const SubdivisionStencil::NormalStencil& SubdivisionStencil::getNormalStencil() const {
+    return m_normalStencil;
+}
+
+} // namespace Geometry
+} // namespace Core
+} // namespace Ra
@@ -1,7 +1,10 @@
 #include <Core/Geometry/Volume.hpp>
 
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/Utils/Log.hpp>
 
+#include <numeric>
+
 namespace Ra {
 namespace Core {
 namespace Geometry {
@@ -70,10 +73,9 @@ VolumeGrid::ValueType VolumeGrid::sample( const IndexType& i ) {
 
 void VolumeGrid::computeGradients() {
     m_gradient.resize( m_data.size() );
-    auto s = size();
+    const auto s = size();
 
-#pragma omp parallel for firstprivate( s )
-    for ( int k = 0; k < s.z(); ++k ) {
+    parallelFor( 0, s.z(), 1, [this, &s]( int k ) {
         for ( int j = 0; j < s.y(); ++j ) {
             for ( int i = 0; i < s.x(); ++i ) {
                 Eigen::Matrix<ValueType, 3, 1> s1;
@@ -90,7 +92,127 @@ void VolumeGrid::computeGradients() {
                     gradient[0], gradient[1], gradient[2], sample( { i, j, k } ) };
             }
         }
+    } );
+}
+
+VolumeSparse::VolumeSparse( const VolumeGrid& grid, const ValueType& background ) :
+    VolumeSparse() {
+    setSize( grid.size() );
+    setBinSize( grid.binSize() );
+    const auto& data = grid.data();
+
+    // visit the bins of brick which are inside the volume.
+    auto forEachBin = [this]( int brick, auto&& f ) {
+        const IndexType origin = brickOrigin( brick );
+        const IndexType end    = ( origin.array() + s_brickSize ).min( size().array() );
+        for ( int k = origin.z(); k < end.z(); ++k ) {
+            for ( int j = origin.y(); j < end.y(); ++j ) {
+                for ( int i = origin.x(); i < end.x(); ++i ) {
+                    const int local = ( i - origin.x() ) +
+                                      s_brickSize * ( ( j - origin.y() ) +
+                                                      s_brickSize * ( k - origin.z() ) );
+                    f( i + size().x() * ( j + size().y() * k ), local );
+                }
+            }
+        }
+    };
+
+    // find the non-empty bricks in parallel, allocate them, then copy them in parallel.
+    const int numBricks = brickGridSize().prod();
+    std::vector<char> nonEmpty( size_t( numBricks ), 0 );
+    parallelFor( 0, numBricks, [&]( int brick ) {
+        forEachBin( brick, [&]( int bin, int ) {
+            if ( data[size_t( bin )] != background ) { nonEmpty[size_t( brick )] = 1; }
+        } );
+    } );
+    for ( int brick = 0; brick < numBricks; ++brick ) {
+        if ( nonEmpty[size_t( brick )] ) { getOrCreateBrick( brick ); }
+    }
+    parallelFor( size_t( 0 ), m_bricks.size(), [&]( size_t pos ) {
+        Brick& brick = m_bricks[pos];
+        forEachBin( brick.m_index, [&]( int bin, int local ) {
+            const ValueType value = data[size_t( bin )];
+            if ( value != background ) {
+                brick.m_values[local] = value;
+                brick.m_active.set( local );
+            }
+        } );
+    } );
+}
+
+void VolumeSparse::addToBins( const Container& samples ) {
+    // locate the samples and their bricks in parallel (concurrent reads of the brick map).
+    constexpr uint noBrick = uint( -1 );
+    const int numBins      = size().prod();
+    std::vector<std::pair<int, int>> locations( samples.size() );
+    std::vector<uint> bricks( samples.size(), noBrick );
+    parallelFor( size_t( 0 ), samples.size(), [&]( size_t i ) {
+        const int idx = samples[i].index;
+        if ( idx < 0 || idx >= numBins ) { return; }
+        locations[i]  = locate( idx );
+        const auto it = m_brickIndex.find( locations[i].first );
+        if ( it != m_brickIndex.end() ) { bricks[i] = it->second; }
+    } );
+
+    // allocate the missing bricks, then group the samples by brick, keeping their order.
+    for ( size_t i = 0; i < samples.size(); ++i ) {
+        const int idx = samples[i].index;
+        if ( bricks[i] == noBrick && idx >= 0 && idx < numBins ) {
+            bricks[i] = getOrCreateBrick( locations[i].first );
+        }
+    }
+    std::vector<size_t> offsets( m_bricks.size() + 1, 0 );
+    for ( uint b : bricks ) {
+        if ( b != noBrick ) { ++offsets[b + 1]; }
+    }
+    std::partial_sum( offsets.begin(), offsets.end(), offsets.begin() );
+    std::vector<size_t> order( offsets.back() );
+    {
+        std::vector<size_t> next( offsets.begin(), offsets.end() - 1 );
+        for ( size_t i = 0; i < samples.size(); ++i ) {
+            if ( bricks[i] != noBrick ) { order[next[bricks[i]]++] = i; }
+        }
+    }
+
+    // each brick is filled by a single thread.
+    parallelFor( size_t( 0 ), m_bricks.size(), [&]( size_t pos ) {
+        Brick& brick = m_bricks[pos];
+        for ( size_t o = offsets[pos]; o < offsets[pos + 1]; ++o ) {
+            const size_t i  = order[o];
+            const int local = locations[i].second;
+            if ( brick.m_active[local] )
+                brick.m_values[local] += samples[i].value;
+            else {
+                brick.m_values[local] = samples[i].value;
+                brick.m_active.set( local );
+            }
+        }
+    } );
+    invalidateAabb();
+}
+
+VolumeGrid VolumeSparse::toGrid( const ValueType& background ) const {
+    VolumeGrid grid( background );
+    grid.setSize( size() );
+    grid.setBinSize( binSize() );
+    auto& data = grid.data();
+    parallelFor( size_t( 0 ), m_bricks.size(), [&]( size_t pos ) {
+        const Brick& brick = m_bricks[pos];
+        for ( int local = 0; local < s_brickVolume; ++local ) {
+            if ( brick.m_active[local] ) {
+                data[size_t( binIndex( brick.m_index, local ) )] = brick.m_values[local];
+            }
+        }
+    } );
+    return grid;
+}
+
+size_t VolumeSparse::getNumSamples() const {
+    size_t count = 0;
+    for ( const auto& brick : m_bricks ) {
+        count += brick.m_active.count();
     }
+    return count;
 }
 
 } // namespace Geometry
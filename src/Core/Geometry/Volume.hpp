@@ -9,6 +9,10 @@
 #undef RA_REQUIRE_OPTIONAL
 
 #include <algorithm> // find_if
+#include <array>
+#include <bitset>
+#include <unordered_map>
+#include <vector>
 
 namespace Ra {
 namespace Core {
@@ -252,14 +256,17 @@ class RA_CORE_API VolumeGrid : public AbstractDiscreteVolume
 
 /** Discrete volume data with sparse storage
  *
- * Samples are stored as SparseVolumeData::sample, which stores the bin linear
- * index, and the function value
+ * Bins are stored in bricks of s_brickSize^3 bins (two-level grid, similar to OpenVDB). A brick is
+ * allocated when a sample is first added to one of its bins, and is found through a hash map
+ * indexed by its position in the grid of bricks. Insertion and lookup are O(1) (amortized), and
+ * memory is proportional to the number of non-empty bricks.
  */
 class RA_CORE_API VolumeSparse : public AbstractDiscreteVolume
 {
   public:
     using ValueType = AbstractDiscreteVolume::ValueType;
     using IndexType = AbstractDiscreteVolume::IndexType;
+    /// A sample, the bin being given by its linear index x + size.x * ( y + size.y * z ).
     struct SampleType {
         int index;
         ValueType value;
@@ -268,8 +275,13 @@ class RA_CORE_API VolumeSparse : public AbstractDiscreteVolume
     };
     using Container = std::vector<SampleType>;
 
+    /// Number of bins of a brick along each dimension.
+    static constexpr int s_brickSize = 8;
+
   public:
     inline VolumeSparse() : AbstractDiscreteVolume( DISCRETE_SPARSE ) {}
+    /// Create a sparse volume holding the bins of grid whose value is not background.
+    explicit VolumeSparse( const VolumeGrid& grid, const ValueType& background = ValueType( 0. ) );
     VolumeSparse( const VolumeSparse& data )       = default;
     VolumeSparse& operator=( const VolumeSparse& ) = default;
     ~VolumeSparse() override                       = default;
@@ -277,50 +289,128 @@ class RA_CORE_API VolumeSparse : public AbstractDiscreteVolume
     using AbstractDiscreteVolume::addToBin;
     using AbstractDiscreteVolume::getBinValue;
 
+    /// Increment the bins of samples by their values, creating them if needed.
+    /// Gives the same result as calling addToBin on each sample in order, but the bricks are
+    /// filled in parallel with parallelFor. Samples out of bounds are ignored.
+    void addToBins( const Container& samples );
+
+    /// Return the dense version of the volume, bins without sample being set to background.
+    VolumeGrid toGrid( const ValueType& background = ValueType( 0. ) ) const;
+
+    /// Call f( index, value ) on each sample, index being the linear index of its bin.
+    template <typename Func>
+    inline void forEachSample( Func&& f ) const {
+        for ( const auto& brick : m_bricks ) {
+            for ( int local = 0; local < s_brickVolume; ++local ) {
+                if ( brick.m_active[local] ) {
+                    f( binIndex( brick.m_index, local ), brick.m_values[local] );
+                }
+            }
+        }
+    }
+
+    /// Return the number of bins holding a sample.
+    size_t getNumSamples() const;
+
+    /// Return the number of allocated bricks.
+    inline size_t getNumBricks() const { return m_bricks.size(); }
+
   protected:
     /** Get the function value at a given position p (if the bin exists)
      *
      * Returns an invalid value when no sample is registered in the targeted bin.
      *
-     * \complexity At most last - first applications of the predicate
-     * (http://en.cppreference.com/w/cpp/algorithm/find)
+     * \complexity O(1) (amortized), one hash map lookup.
      */
     inline Utils::optional<ValueType> getBinValue( typename IndexType::Scalar idx ) const override {
-        auto res = findBin( idx );
-        if ( res != std::end( m_data ) ) return res->value;
-        return {};
+        const auto loc = locate( idx );
+        const auto it  = m_brickIndex.find( loc.first );
+        if ( it == m_brickIndex.end() ) return {};
+        const Brick& brick = m_bricks[it->second];
+        if ( !brick.m_active[loc.second] ) return {};
+        return brick.m_values[loc.second];
     }
 
     /// Increment bin p by value
     ///
     /// Create the bin if not already existing
     ///
-    /// \complexity At most last - first applications of the predicate
-    /// (http://en.cppreference.com/w/cpp/algorithm/find)
+    /// \complexity O(1) (amortized), one hash map lookup.
     inline void addToBin( const ValueType& value, typename IndexType::Scalar idx ) override {
-        auto res = findBin( idx );
-        if ( res != std::end( m_data ) )
-            res->value += value;
-        else
-            m_data.emplace_back( idx, value );
+        const auto loc = locate( idx );
+        Brick& brick   = m_bricks[getOrCreateBrick( loc.first )];
+        if ( brick.m_active[loc.second] )
+            brick.m_values[loc.second] += value;
+        else {
+            brick.m_values[loc.second] = value;
+            brick.m_active.set( loc.second );
+        }
     }
 
-    inline void updateStorage() override { m_data.clear(); }
+    inline void updateStorage() override {
+        m_bricks.clear();
+        m_brickIndex.clear();
+    }
 
   private:
-    inline Container::iterator findBin( typename IndexType::Scalar idx ) {
-        return std::find_if( std::begin( m_data ),
-                             std::end( m_data ),
-                             [&idx]( const SampleType& s ) { return s.index == idx; } );
+    static constexpr int s_brickVolume = s_brickSize * s_brickSize * s_brickSize;
+
+    struct Brick {
+        /// Linear index of the brick in the grid of bricks.
+        int m_index;
+        std::array<ValueType, s_brickVolume> m_values;
+        /// Bins holding a sample.
+        std::bitset<s_brickVolume> m_active;
+    };
+
+    /// Return the number of bricks along each dimension.
+    inline IndexType brickGridSize() const {
+        return ( size().array() + ( s_brickSize - 1 ) ) / s_brickSize;
+    }
+
+    /// Return the linear index of the brick holding bin idx, and the index of the bin in it.
+    inline std::pair<int, int> locate( typename IndexType::Scalar idx ) const {
+        const IndexType& s    = size();
+        const IndexType p( idx % s.x(), ( idx / s.x() ) % s.y(), idx / ( s.x() * s.y() ) );
+        const IndexType brick = p / s_brickSize;
+        const IndexType local = p - s_brickSize * brick;
+        const IndexType b     = brickGridSize();
+        return { brick.x() + b.x() * ( brick.y() + b.y() * brick.z() ),
+                 local.x() + s_brickSize * ( local.y() + s_brickSize * local.z() ) };
+    }
+
+    /// Return the linear index of the bin local of brick brickIndex.
+    inline int binIndex( int brickIndex, int local ) const {
+        const IndexType p = brickOrigin( brickIndex ) +
+                            IndexType( local % s_brickSize,
+                                       ( local / s_brickSize ) % s_brickSize,
+                                       local / ( s_brickSize * s_brickSize ) );
+        return p.x() + size().x() * ( p.y() + size().y() * p.z() );
     }
-    inline Container::const_iterator findBin( typename IndexType::Scalar idx ) const {
-        return std::find_if( std::begin( m_data ),
-                             std::end( m_data ),
-                             [&idx]( const SampleType& s ) { return s.index == idx; } );
+
+    /// Return the first bin of brick brickIndex.
+    inline IndexType brickOrigin( int brickIndex ) const {
+        const IndexType b = brickGridSize();
+        return s_brickSize * IndexType( brickIndex % b.x(),
+                                        ( brickIndex / b.x() ) % b.y(),
+                                        brickIndex / ( b.x() * b.y() ) );
+    }
+
+    /// Return the position in m_bricks of brick brickIndex, allocating it if needed.
+    inline uint getOrCreateBrick( int brickIndex ) {
+        const auto res = m_brickIndex.emplace( brickIndex, uint( m_bricks.size() ) );
+        if ( res.second ) {
+            m_bricks.emplace_back();
+            m_bricks.back().m_index = brickIndex;
+            m_bricks.back().m_values.fill( ValueType( 0 ) );
+        }
+        return res.first->second;
     }
 
   private:
-    Container m_data;
+    std::vector<Brick> m_bricks;
+    /// Position in m_bricks of each allocated brick.
+    std::unordered_map<int, uint> m_brickIndex;
 
 }; // class VolumeSparse
 
@@ -0,0 +1,21 @@
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <atomic>
+
+namespace Ra {
+namespace Core {
+
+namespace {
+std::atomic<TaskQueue*> s_parallelTaskQueue { nullptr };
+} // namespace
+
+void setParallelTaskQueue( TaskQueue* taskQueue ) {
+    s_parallelTaskQueue = taskQueue;
+}
+
+TaskQueue* getParallelTaskQueue() {
+    return s_parallelTaskQueue;
+}
+
+} // namespace Core
+} // namespace Ra
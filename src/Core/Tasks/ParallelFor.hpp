@@ -0,0 +1,117 @@
+#pragma once
+
+#include <Core/RaCore.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+
+/// Set the task queue whose worker threads run parallelFor and parallelReduce.
+/// Applications set it once their task queue is created, and reset it to nullptr before
+/// destroying the task queue. Without task queue, the loops are run sequentially.
+RA_CORE_API void setParallelTaskQueue( TaskQueue* taskQueue );
+
+/// Return the task queue used by parallelFor and parallelReduce, nullptr if none.
+RA_CORE_API TaskQueue* getParallelTaskQueue();
+
+/// Calls f( i ) for each i in [begin, end), in parallel on the worker threads of the parallel
+/// task queue (see setParallelTaskQueue).
+/// The range is split in chunks of grain consecutive indices. If grain is 0, it is computed from
+/// the number of worker threads.
+/// parallelFor can be called from a task or from f itself : the calling thread always processes
+/// chunks, so that nested loops never wait for busy workers.
+template <typename Index, typename Function>
+void parallelFor( Index begin, Index end, Index grain, Function&& f );
+
+/// Same as parallelFor( begin, end, 0, f ).
+template <typename Index, typename Function>
+void parallelFor( Index begin, Index end, Function&& f );
+
+/// Reduces the range [begin, end) in parallel.
+/// The range is split in chunks as in parallelFor, each chunk [b, e) is reduced by
+/// f( b, e, identity ) -> T, and the chunk results are combined with reduce( T, T ) -> T, in
+/// chunk order, so that the result does not depend on the scheduling.
+template <typename Index, typename T, typename Function, typename Reduce>
+T parallelReduce( Index begin,
+                  Index end,
+                  Index grain,
+                  const T& identity,
+                  Function&& f,
+                  Reduce&& reduce );
+
+namespace TasksInternal {
+/// Return the number of chunks of size grain (0 for automatic) needed to cover count indices.
+inline size_t computeNumChunks( size_t count, size_t& grain, const TaskQueue* taskQueue ) {
+    if ( count == 0 ) { return 0; }
+    if ( grain == 0 ) {
+        // a few chunks per thread for load balancing.
+        const size_t numThreads = taskQueue ? taskQueue->getNumThreads() + 1 : 1;
+        grain                   = std::max( size_t( 1 ), count / ( 4 * numThreads ) );
+    }
+    return ( count + grain - 1 ) / grain;
+}
+} // namespace TasksInternal
+
+template <typename Index, typename Function>
+void parallelFor( Index begin, Index end, Index grain, Function&& f ) {
+    if ( end <= begin ) { return; }
+    TaskQueue* taskQueue   = getParallelTaskQueue();
+    const size_t count     = size_t( end - begin );
+    size_t chunkSize       = size_t( grain );
+    const size_t numChunks = TasksInternal::computeNumChunks( count, chunkSize, taskQueue );
+
+    if ( taskQueue == nullptr || numChunks < 2 ) {
+        for ( Index i = begin; i < end; ++i ) {
+            f( i );
+        }
+        return;
+    }
+
+    taskQueue->runParallelChunks( numChunks, [&]( size_t chunk ) {
+        const Index chunkBegin = begin + Index( chunk * chunkSize );
+        const Index chunkEnd   = begin + Index( std::min( count, ( chunk + 1 ) * chunkSize ) );
+        for ( Index i = chunkBegin; i < chunkEnd; ++i ) {
+            f( i );
+        }
+    } );
+}
+
+template <typename Index, typename Function>
+void parallelFor( Index begin, Index end, Function&& f ) {
+    parallelFor( begin, end, Index( 0 ), std::forward<Function>( f ) );
+}
+
+template <typename Index, typename T, typename Function, typename Reduce>
+T parallelReduce( Index begin,
+                  Index end,
+                  Index grain,
+                  const T& identity,
+                  Function&& f,
+                  Reduce&& reduce ) {
+    if ( end <= begin ) { return identity; }
+    TaskQueue* taskQueue   = getParallelTaskQueue();
+    const size_t count     = size_t( end - begin );
+    size_t chunkSize       = size_t( grain );
+    const size_t numChunks = TasksInternal::computeNumChunks( count, chunkSize, taskQueue );
+
+    if ( taskQueue == nullptr || numChunks < 2 ) { return f( begin, end, identity ); }
+
+    std::vector<T> partials( numChunks, identity );
+    taskQueue->runParallelChunks( numChunks, [&]( size_t chunk ) {
+        const Index chunkBegin = begin + Index( chunk * chunkSize );
+        const Index chunkEnd   = begin + Index( std::min( count, ( chunk + 1 ) * chunkSize ) );
+        partials[chunk]        = f( chunkBegin, chunkEnd, identity );
+    } );
+
+    T result = partials[0];
+    for ( size_t chunk = 1; chunk < numChunks; ++chunk ) {
+        result = reduce( result, partials[chunk] );
+    }
+    return result;
+}
+
+} // namespace Core
+} // namespace Ra
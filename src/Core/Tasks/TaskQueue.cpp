@@ -3,24 +3,156 @@
 #include <Core/Utils/Log.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <stack>
+#include <thread>
 
 namespace Ra {
 namespace Core {
 
-TaskQueue::TaskQueue( uint numThreads ) : m_processingTasks( 0 ), m_shuttingDown( false ) {
+/// Bounded Chase-Lev work-stealing deque (see "Correct and Efficient Work-Stealing for Weak
+/// Memory Models", Lê et al. 2013).
+/// The owner worker pushes and pops at the bottom, other workers steal from the top.
+/// The deque is never resized while tasks are running : at most all the tasks of a run are pushed
+/// on a single deque, so reset() is called with the number of tasks before each run.
+class TaskQueue::WorkerDeque
+{
+  public:
+    using IntegerType = TaskId::IntegerType;
+
+    /// Empties the deque and makes room for capacity tasks. Not thread safe.
+    void reset( size_t capacity ) {
+        if ( capacity > m_capacity ) {
+            size_t newCapacity = 1;
+            while ( newCapacity < capacity ) {
+                newCapacity <<= 1;
+            }
+            m_buffer.reset( new std::atomic<IntegerType>[newCapacity] );
+            m_capacity = newCapacity;
+        }
+        m_top.store( 0, std::memory_order_relaxed );
+        m_bottom.store( 0, std::memory_order_relaxed );
+    }
+
+    /// Pushes a task at the bottom of the deque. Must only be called by the owner.
+    void push( TaskId task ) {
+        const int64_t b = m_bottom.load( std::memory_order_relaxed );
+        CORE_ASSERT( b - m_top.load( std::memory_order_acquire ) < int64_t( m_capacity ),
+                     "Worker deque overflow" );
+        slot( b ).store( task.getValue(), std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+        m_bottom.store( b + 1, std::memory_order_relaxed );
+    }
+
+    /// Pops a task from the bottom of the deque. Must only be called by the owner.
+    /// Return an invalid id if the deque is empty.
+    TaskId pop() {
+        const int64_t b = m_bottom.load( std::memory_order_relaxed ) - 1;
+        m_bottom.store( b, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        int64_t t = m_top.load( std::memory_order_relaxed );
+        TaskId task;
+        if ( t <= b ) {
+            task = TaskId { slot( b ).load( std::memory_order_relaxed ) };
+            if ( t == b ) {
+                // Last task : race against stealers.
+                if ( !m_top.compare_exchange_strong(
+                         t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) {
+                    task = TaskId::Invalid();
+                }
+                m_bottom.store( b + 1, std::memory_order_relaxed );
+            }
+        }
+        else {
+            m_bottom.store( b + 1, std::memory_order_relaxed );
+        }
+        return task;
+    }
+
+    /// Steals a task from the top of the deque. Can be called from any thread.
+    /// Return an invalid id if the deque is empty or if another thread won the race.
+    TaskId steal() {
+        int64_t t = m_top.load( std::memory_order_acquire );
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        const int64_t b = m_bottom.load( std::memory_order_acquire );
+        TaskId task;
+        if ( t < b ) {
+            task = TaskId { slot( t ).load( std::memory_order_relaxed ) };
+            if ( !m_top.compare_exchange_strong(
+                     t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) {
+                task = TaskId::Invalid();
+            }
+        }
+        return task;
+    }
+
+  private:
+    std::atomic<IntegerType>& slot( int64_t i ) {
+        return m_buffer[size_t( i ) & ( m_capacity - 1 )];
+    }
+
+    /// Index of the next task to steal (top and bottom are on separate cache lines).
+    alignas( 64 ) std::atomic<int64_t> m_top { 0 };
+    /// Index of the next free slot.
+    alignas( 64 ) std::atomic<int64_t> m_bottom { 0 };
+    /// Circular buffer of tasks, m_capacity is a power of two.
+    std::unique_ptr<std::atomic<IntegerType>[]> m_buffer;
+    size_t m_capacity { 0 };
+};
+
+/// Chunks shared between the threads calling runParallelChunks.
+struct TaskQueue::ParallelJob {
+    ParallelJob( size_t numChunks, const std::function<void( size_t )>& f ) :
+        m_numChunks( numChunks ), m_f( f ) {}
+
+    /// Processes chunks until all of them are taken.
+    void process() {
+        size_t chunk;
+        while ( ( chunk = m_nextChunk++ ) < m_numChunks ) {
+            m_f( chunk );
+            ++m_processedChunks;
+        }
+    }
+
+    const size_t m_numChunks;
+    const std::function<void( size_t )>& m_f;
+    /// Next chunk to process.
+    std::atomic<size_t> m_nextChunk { 0 };
+    /// Number of processed chunks.
+    std::atomic<size_t> m_processedChunks { 0 };
+    /// Number of worker threads helping to process this job.
+    std::atomic<int> m_helpers { 0 };
+};
+
+TaskQueue::TaskQueue( uint numThreads, SchedulingPolicy policy ) :
+    m_processingTasks( 0 ), m_shuttingDown( false ), m_policy( policy ) {
     m_workerThreads.reserve( numThreads );
+    if ( m_policy == SchedulingPolicy::WorkStealing ) {
+        m_workerDeques.reserve( numThreads );
+        for ( uint i = 0; i < numThreads; ++i ) {
+            m_workerDeques.push_back( std::make_unique<WorkerDeque>() );
+        }
+    }
     for ( uint i = 0; i < numThreads; ++i ) {
-        m_workerThreads.emplace_back( &TaskQueue::runThread, this, i );
+        if ( m_policy == SchedulingPolicy::WorkStealing ) {
+            m_workerThreads.emplace_back( &TaskQueue::runStealingThread, this, i );
+        }
+        else {
+            m_workerThreads.emplace_back( &TaskQueue::runThread, this, i );
+        }
     }
 }
 
 TaskQueue::~TaskQueue() {
-    flushTaskQueue();
-    m_shuttingDown = true;
+    clearTaskQueue();
+    {
+        // set under lock so that no thread misses the notification.
+        std::lock_guard<std::mutex> lock( m_taskQueueMutex );
+        m_shuttingDown = true;
+    }
     m_threadNotifier.notify_all();
     for ( auto& t : m_workerThreads ) {
         t.join();
@@ -36,12 +168,16 @@ TaskQueue::TaskId TaskQueue::registerTask( std::unique_ptr<Task> task ) {
 
     m_tasks.push_back( std::move( task ) );
     m_dependencies.push_back( std::vector<TaskId>() );
+    m_numDependencies.push_back( 0 );
     m_remainingDependencies.push_back( 0 );
 
     CORE_ASSERT( m_tasks.size() == m_dependencies.size(), "Inconsistent task list" );
     CORE_ASSERT( m_tasks.size() == m_remainingDependencies.size(), "Inconsistent task list" );
     CORE_ASSERT( m_tasks.size() == m_timerData.size(), "Inconsistent task list" );
-    return TaskId { m_tasks.size() - 1 };
+    TaskId id { m_tasks.size() - 1 };
+    // only the first task with a given name is referenced
+    m_taskIds.emplace( m_timerData.back().taskName, id );
+    return id;
 }
 
 void TaskQueue::removeTask( TaskId taskId ) {
@@ -62,12 +198,9 @@ void TaskQueue::removeTask( TaskId taskId ) {
 }
 
 TaskQueue::TaskId TaskQueue::getTaskId( const std::string& taskName ) const {
-    auto itr = std::find_if( m_tasks.begin(), m_tasks.end(), [taskName]( const auto& task ) {
-        return task->getName() == taskName;
-    } );
-
-    if ( itr == m_tasks.end() ) return {};
-    return TaskId { itr - m_tasks.begin() };
+    auto itr = m_taskIds.find( taskName );
+    if ( itr == m_taskIds.end() ) return {};
+    return itr->second;
 }
 
 void TaskQueue::addDependency( TaskQueue::TaskId predecessor, TaskQueue::TaskId successor ) {
@@ -84,7 +217,7 @@ void TaskQueue::addDependency( TaskQueue::TaskId predecessor, TaskQueue::TaskId
                  "Cannot add a dependency twice" );
 
     m_dependencies[predecessor].push_back( successor );
-    ++m_remainingDependencies[successor];
+    ++m_numDependencies[successor];
 }
 
 bool TaskQueue::addDependency( const std::string& predecessor, TaskQueue::TaskId successor ) {
@@ -190,6 +323,14 @@ void TaskQueue::startTasks() {
     // Do a debug check
     detectCycles();
 
+    if ( m_policy == SchedulingPolicy::WorkStealing ) {
+        startStealingTasks();
+        return;
+    }
+
+    // Reset dependency counters (no-op for a fresh task graph).
+    m_remainingDependencies = m_numDependencies;
+
     // Enqueue all tasks with no dependencies.
     for ( uint t = 0; t < m_tasks.size(); ++t ) {
         // only queue non null m_tasks
@@ -200,6 +341,47 @@ void TaskQueue::startTasks() {
     m_threadNotifier.notify_all();
 }
 
+void TaskQueue::startStealingTasks() {
+    // Workers may still be leaving the previous run, wait for them before touching the deques.
+    while ( m_activeWorkers > 0 ) {
+        std::this_thread::yield();
+    }
+
+    const size_t numTasks = m_tasks.size();
+    if ( numTasks == 0 ) { return; }
+
+    if ( m_atomicRemainingDependenciesSize < numTasks ) {
+        m_atomicRemainingDependencies.reset( new std::atomic<uint>[numTasks] );
+        m_atomicRemainingDependenciesSize = numTasks;
+    }
+    for ( size_t t = 0; t < numTasks; ++t ) {
+        m_atomicRemainingDependencies[t].store( m_numDependencies[t], std::memory_order_relaxed );
+    }
+
+    for ( auto& deque : m_workerDeques ) {
+        deque->reset( numTasks );
+    }
+
+    // Distribute tasks with no dependencies among the workers.
+    int queued            = 0;
+    const uint numWorkers = uint( m_workerDeques.size() );
+    for ( uint t = 0; t < numTasks; ++t ) {
+        if ( m_numDependencies[t] == 0 ) {
+            m_workerDeques[queued % numWorkers]->push( TaskId { t } );
+            ++queued;
+        }
+    }
+    m_unfinishedTasks = int( numTasks );
+    m_queuedTasks     = queued;
+
+    {
+        std::lock_guard<std::mutex> lock( m_taskQueueMutex );
+        m_runActive = true;
+    }
+    // Wake up all threads.
+    m_threadNotifier.notify_all();
+}
+
 void TaskQueue::runTasksInThisThread() {
 
     // lock task queue so no other worker can start working while this thread do the job.
@@ -211,6 +393,9 @@ void TaskQueue::runTasksInThisThread() {
     // Do a debug check
     detectCycles();
 
+    // Reset dependency counters.
+    m_remainingDependencies = m_numDependencies;
+
     // Enqueue all tasks with no dependencies.
     for ( uint t = 0; t < m_tasks.size(); ++t ) {
         // only queue non null m_tasks
@@ -237,6 +422,13 @@ void TaskQueue::runTasksInThisThread() {
 }
 
 void TaskQueue::waitForTasks() {
+    if ( m_policy == SchedulingPolicy::WorkStealing ) {
+        while ( m_unfinishedTasks > 0 ) {
+            std::this_thread::yield();
+        }
+        return;
+    }
+
     bool isFinished = false;
     while ( !isFinished ) {
         // TODO : use a notifier for task queue empty.
@@ -257,11 +449,41 @@ void TaskQueue::flushTaskQueue() {
 
     CORE_ASSERT( m_processingTasks == 0, "You have tasks still in process" );
     CORE_ASSERT( m_taskQueue.empty(), " You have unprocessed tasks " );
+    CORE_ASSERT( m_unfinishedTasks == 0, " You have unprocessed tasks " );
 
-    m_tasks.clear();
-    m_dependencies.clear();
-    m_timerData.clear();
-    m_remainingDependencies.clear();
+    const size_t numTasks = m_persistentTaskCount;
+    // Remove dependencies involving non persistent tasks
+    for ( size_t t = numTasks; t < m_tasks.size(); ++t ) {
+        for ( auto successor : m_dependencies[t] ) {
+            if ( size_t( successor ) < numTasks ) { --m_numDependencies[successor]; }
+        }
+        auto itr = m_taskIds.find( m_timerData[t].taskName );
+        if ( itr != m_taskIds.end() && size_t( itr->second ) == t ) { m_taskIds.erase( itr ); }
+    }
+    for ( size_t t = 0; t < numTasks; ++t ) {
+        auto& successors = m_dependencies[t];
+        successors.erase(
+            std::remove_if( successors.begin(),
+                            successors.end(),
+                            [numTasks]( TaskId s ) { return size_t( s ) >= numTasks; } ),
+            successors.end() );
+    }
+
+    m_tasks.resize( numTasks );
+    m_dependencies.resize( numTasks );
+    m_numDependencies.resize( numTasks );
+    m_timerData.resize( numTasks );
+    m_remainingDependencies.resize( numTasks );
+}
+
+void TaskQueue::clearTaskQueue() {
+    m_persistentTaskCount = 0;
+    flushTaskQueue();
+}
+
+void TaskQueue::markTasksAsPersistent() {
+    std::lock_guard<std::mutex> lock( m_taskMutex );
+    m_persistentTaskCount = m_tasks.size();
 }
 
 void TaskQueue::runThread( uint id ) {
@@ -272,13 +494,20 @@ void TaskQueue::runThread( uint id ) {
         {
             std::unique_lock<std::mutex> lock( m_taskQueueMutex );
 
-            // Wait for a new task
-            m_threadNotifier.wait( lock,
-                                   [this]() { return m_shuttingDown || !m_taskQueue.empty(); } );
+            // Wait for a new task, or for parallel chunks to process
+            m_threadNotifier.wait( lock, [this]() {
+                return m_shuttingDown || !m_taskQueue.empty() || hasParallelWork();
+            } );
             // If the task queue is shutting down we quit, releasing
             // the lock.
             if ( m_shuttingDown ) { return; }
 
+            if ( m_taskQueue.empty() ) {
+                lock.unlock();
+                helpParallelJobs();
+                continue;
+            }
+
             // If we are here it means we got a task
             task = m_taskQueue.back();
             m_taskQueue.pop_back();
@@ -314,6 +543,158 @@ void TaskQueue::runThread( uint id ) {
     } // End of while(true)
 }
 
+void TaskQueue::runStealingThread( uint id ) {
+    while ( true ) {
+        // Wait for a run to start, and join it.
+        {
+            std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+            m_threadNotifier.wait(
+                lock, [this]() { return m_shuttingDown || m_runActive || hasParallelWork(); } );
+            if ( m_shuttingDown ) { return; }
+            if ( !m_runActive ) {
+                lock.unlock();
+                helpParallelJobs();
+                continue;
+            }
+            ++m_activeWorkers;
+        }
+
+        // Process tasks until the run ends.
+        while ( true ) {
+            TaskId task = acquireStealingTask( id );
+            if ( task.isValid() ) {
+                processStealingTask( id, task );
+                continue;
+            }
+
+            // No task available, sleep until a task is queued, parallel chunks are available, or
+            // the run ends.
+            std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+            ++m_sleepingWorkers;
+            m_threadNotifier.wait( lock, [this]() {
+                return m_shuttingDown || !m_runActive || m_queuedTasks > 0 || hasParallelWork();
+            } );
+            --m_sleepingWorkers;
+            if ( m_shuttingDown || !m_runActive ) { break; }
+            if ( m_queuedTasks <= 0 ) {
+                lock.unlock();
+                helpParallelJobs();
+            }
+        }
+        --m_activeWorkers;
+    }
+}
+
+TaskQueue::TaskId TaskQueue::acquireStealingTask( uint id ) {
+    TaskId task     = m_workerDeques[id]->pop();
+    const uint size = uint( m_workerDeques.size() );
+    for ( uint i = 1; task.isInvalid() && i < size; ++i ) {
+        task = m_workerDeques[( id + i ) % size]->steal();
+    }
+    if ( task.isValid() ) { --m_queuedTasks; }
+    return task;
+}
+
+void TaskQueue::processStealingTask( uint id, TaskId task ) {
+    while ( task.isValid() ) {
+        CORE_ASSERT( task < m_tasks.size(), "Invalid task" );
+
+        // Run task
+        m_timerData[task].start    = Utils::Clock::now();
+        m_timerData[task].threadId = id;
+        if ( m_tasks[task] ) { m_tasks[task]->process(); }
+        m_timerData[task].end = Utils::Clock::now();
+
+        // Release successors : the first ready one is processed immediately by this worker, the
+        // others are pushed on its deque, where idle workers may steal them.
+        TaskId next;
+        int newTasks = 0;
+        for ( auto t : m_dependencies[task] ) {
+            ON_ASSERT( uint nDepends = m_atomicRemainingDependencies[t].load() );
+            CORE_ASSERT( nDepends > 0, "Inconsistency in dependencies" );
+            if ( m_atomicRemainingDependencies[t].fetch_sub( 1 ) == 1 ) {
+                if ( next.isInvalid() ) { next = t; }
+                else {
+                    m_workerDeques[id]->push( t );
+                    ++newTasks;
+                }
+            }
+        }
+        if ( newTasks > 0 ) {
+            m_queuedTasks += newTasks;
+            if ( m_sleepingWorkers > 0 ) {
+                std::lock_guard<std::mutex> lock( m_taskQueueMutex );
+                if ( newTasks == 1 ) { m_threadNotifier.notify_one(); }
+                else {
+                    m_threadNotifier.notify_all();
+                }
+            }
+        }
+
+        // Last task of the run, m_tasks must not be accessed after this point since the task
+        // queue may be flushed.
+        if ( --m_unfinishedTasks == 0 ) {
+            CORE_ASSERT( next.isInvalid(), "Inconsistency in dependencies" );
+            std::lock_guard<std::mutex> lock( m_taskQueueMutex );
+            m_runActive = false;
+            m_threadNotifier.notify_all();
+        }
+        task = next;
+    }
+}
+
+void TaskQueue::runParallelChunks( size_t numChunks, const std::function<void( size_t )>& f ) {
+    if ( m_workerThreads.empty() || numChunks < 2 ) {
+        for ( size_t chunk = 0; chunk < numChunks; ++chunk ) {
+            f( chunk );
+        }
+        return;
+    }
+
+    ParallelJob job( numChunks, f );
+    {
+        std::lock_guard<std::mutex> lock( m_taskQueueMutex );
+        m_parallelJobs.push_back( &job );
+    }
+    m_threadNotifier.notify_all();
+
+    // The calling thread participates, then withdraws the job so that no new worker joins it.
+    job.process();
+    {
+        std::lock_guard<std::mutex> lock( m_taskQueueMutex );
+        m_parallelJobs.erase( std::find( m_parallelJobs.begin(), m_parallelJobs.end(), &job ) );
+    }
+
+    // Wait for the chunks being processed by the workers.
+    while ( job.m_processedChunks < numChunks || job.m_helpers > 0 ) {
+        std::this_thread::yield();
+    }
+}
+
+bool TaskQueue::hasParallelWork() const {
+    return std::any_of( m_parallelJobs.begin(), m_parallelJobs.end(), []( const ParallelJob* job ) {
+        return job->m_nextChunk < job->m_numChunks;
+    } );
+}
+
+void TaskQueue::helpParallelJobs() {
+    ParallelJob* job = nullptr;
+    {
+        std::lock_guard<std::mutex> lock( m_taskQueueMutex );
+        auto itr = std::find_if(
+            m_parallelJobs.begin(), m_parallelJobs.end(), []( const ParallelJob* j ) {
+                return j->m_nextChunk < j->m_numChunks;
+            } );
+        if ( itr == m_parallelJobs.end() ) { return; }
+        job = *itr;
+        // the job will not be destroyed before this thread leaves it
+        ++job->m_helpers;
+    }
+    job->process();
+    // job must not be accessed after this point.
+    --job->m_helpers;
+}
+
 void TaskQueue::printTaskGraph( std::ostream& output ) const {
     output << "digraph tasks {" << std::endl;
 
@@ -4,12 +4,15 @@
 #include <Core/Utils/Index.hpp>
 #include <Core/Utils/Timer.hpp> // Ra::Core::TimePoint
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace Ra {
@@ -25,6 +28,14 @@ namespace Core {
  * pooled threads.
  * Task are allowed to have dependencies. A task will be executed only when all its dependencies
  * are satisfied, i.e. all dependant tasks are finished.
+ * Two scheduling policies are available :
+ *  - SharedQueue (default) : ready tasks are stored in a single queue protected by a mutex.
+ *  - WorkStealing : each worker owns a lock-free deque. Successors released by a task are pushed
+ *    on the deque of the worker that finished it (one of them being run immediately), and idle
+ *    workers steal from the others. This scales better with many small tasks.
+ * Tasks can be marked as persistent (see markTasksAsPersistent()). Persistent tasks are kept
+ * when the task queue is flushed and are run again by the next startTasks(), with their dependency
+ * counters reset, so that a task graph can be recorded once and re-executed every frame.
  * Note that most functions are not thread safe and must not be called when the task queue is
  * running.
  */
@@ -34,6 +45,9 @@ class RA_CORE_API TaskQueue
     /// Identifier for a task in the task queue.
     using TaskId = Utils::Index;
 
+    /// Scheduling policy used to dispatch ready tasks to the worker threads.
+    enum class SchedulingPolicy { SharedQueue, WorkStealing };
+
     /// Record of a task's start and end time.
     struct TimerData {
         Utils::TimePoint start;
@@ -45,7 +59,8 @@ class RA_CORE_API TaskQueue
   public:
     /// Constructor. Initializes the thread worker pools with numThreads threads.
     /// if numThreads == 0, its a runTasksInThisThread only task queue
-    explicit TaskQueue( uint numThreads );
+    explicit TaskQueue( uint numThreads,
+                        SchedulingPolicy policy = SchedulingPolicy::SharedQueue );
 
     /// Destructor. Waits for all the threads and safely deletes them.
     ~TaskQueue();
@@ -64,6 +79,7 @@ class RA_CORE_API TaskQueue
     /// don't affect other task id's
     void removeTask( TaskId taskId );
 
+    /// Return the id of the first registered task with the given name, or an invalid id.
     TaskId getTaskId( const std::string& taskName ) const;
 
     /// Add dependency between two tasks. The successor task will be executed only when all
@@ -100,16 +116,76 @@ class RA_CORE_API TaskQueue
     /// Access the data from the last frame execution after processTaskQueue();
     const std::vector<TimerData>& getTimerData();
 
-    /// Erases all tasks. Will assert if tasks are unprocessed.
+    /// Erases all tasks, but the persistent ones. Will assert if tasks are unprocessed.
     void flushTaskQueue();
 
+    /// Erases all tasks, including the persistent ones. Will assert if tasks are unprocessed.
+    void clearTaskQueue();
+
+    /// Marks all the registered tasks as persistent, with the dependencies between them.
+    /// Persistent tasks are not erased by flushTaskQueue() and are run by each call to
+    /// startTasks() or runTasksInThisThread().
+    /// Tasks registered afterwards are erased by flushTaskQueue() as usual. Dependencies between
+    /// them and persistent tasks are allowed, and are erased with them.
+    void markTasksAsPersistent();
+
+    /// Return the number of persistent tasks.
+    size_t getPersistentTaskCount() const { return m_persistentTaskCount; }
+
     /// Prints the current task graph in dot format
     void printTaskGraph( std::ostream& output ) const;
 
+    /// Return the scheduling policy used by the worker threads.
+    SchedulingPolicy getSchedulingPolicy() const { return m_policy; }
+
+    /// Return the number of worker threads.
+    uint getNumThreads() const { return uint( m_workerThreads.size() ); }
+
+    //
+    // Data parallelism
+    //
+
+    /// Calls f( chunk ) for each chunk in [0, numChunks), on the calling thread and on the idle
+    /// worker threads, and returns when all the chunks are processed.
+    /// Unlike the other functions, this one is thread safe and can be called while the task
+    /// queue is running, e.g. from a task, or from f itself (nested parallelism) : the calling
+    /// thread always processes chunks, so that progress is guaranteed even if all workers are
+    /// busy.
+    /// \see parallelFor and parallelReduce in Core/Tasks/ParallelFor.hpp
+    void runParallelChunks( size_t numChunks, const std::function<void( size_t )>& f );
+
   private:
+    /// Chunks of work shared by runParallelChunks (defined in TaskQueue.cpp).
+    struct ParallelJob;
+
+    /// Return true if a parallel job has unprocessed chunks.
+    /// Must be called with m_taskQueueMutex locked.
+    bool hasParallelWork() const;
+
+    /// Helps processing the chunks of a parallel job, if any.
+    /// Must be called with m_taskQueueMutex unlocked.
+    void helpParallelJobs();
+
+    /// Per worker lock-free deque used in the WorkStealing policy (defined in TaskQueue.cpp).
+    class WorkerDeque;
+
     /// Function called by a new thread.
     void runThread( uint id );
 
+    /// Function called by a new thread when using the WorkStealing policy.
+    void runStealingThread( uint id );
+
+    /// Initializes the worker deques and dependency counters, and queue the tasks with no
+    /// dependencies, for the WorkStealing policy.
+    void startStealingTasks();
+
+    /// Get a task from the worker own deque, or steal one from another worker.
+    /// Return an invalid id if no task was found.
+    TaskId acquireStealingTask( uint id );
+
+    /// Run a task and its released successors on the worker id (WorkStealing policy).
+    void processStealingTask( uint id, TaskId task );
+
     /// Puts the task on the queue to be executed. A task can only be queued if it has
     /// no dependencies.
     void queueTask( TaskId task );
@@ -128,6 +204,12 @@ class RA_CORE_API TaskQueue
     std::vector<std::unique_ptr<Task>> m_tasks;
     /// For each task, stores which tasks depend on it.
     std::vector<std::vector<TaskId>> m_dependencies;
+    /// Number of tasks each task depends on (copied to the remaining dependencies at start).
+    std::vector<uint> m_numDependencies;
+    /// Id of the first task registered with a given name.
+    std::unordered_map<std::string, TaskId> m_taskIds;
+    /// Number of persistent tasks, stored at the beginning of m_tasks.
+    size_t m_persistentTaskCount { 0 };
 
     /// List of pending dependencies
     std::vector<std::pair<TaskId, std::string>> m_pendingDepsPre;
@@ -156,6 +238,36 @@ class RA_CORE_API TaskQueue
     /// Mutex for task registration (m_tasks, m_dependencies, m_timerData ...), if tasks are
     /// registered from multiple threads
     std::mutex m_taskMutex;
+
+    //
+    // WorkStealing policy variables.
+    //
+
+    /// Policy used to dispatch the tasks.
+    const SchedulingPolicy m_policy;
+    /// One deque per worker thread.
+    std::vector<std::unique_ptr<WorkerDeque>> m_workerDeques;
+    /// Number of tasks each task is waiting on, decremented concurrently during a run.
+    std::unique_ptr<std::atomic<uint>[]> m_atomicRemainingDependencies;
+    /// Capacity of m_atomicRemainingDependencies.
+    size_t m_atomicRemainingDependenciesSize { 0 };
+    /// Number of tasks pushed on the deques and not yet taken by a worker.
+    std::atomic<int> m_queuedTasks { 0 };
+    /// Number of tasks of the current run not yet finished.
+    std::atomic<int> m_unfinishedTasks { 0 };
+    /// Number of workers waiting on m_threadNotifier while a run is active.
+    std::atomic<int> m_sleepingWorkers { 0 };
+    /// Number of workers that may access the deques (i.e. that joined the current run).
+    std::atomic<int> m_activeWorkers { 0 };
+    /// True while tasks started with startTasks are running (protected by m_taskQueueMutex).
+    bool m_runActive { false };
+
+    //
+    // Data parallelism variables.
+    //
+
+    /// Parallel jobs with chunks to process (protected by m_taskQueueMutex).
+    std::vector<ParallelJob*> m_parallelJobs;
 };
 
 } // namespace Core
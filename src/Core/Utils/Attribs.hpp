@@ -1,4 +1,6 @@
 #pragma once
+#include <algorithm>
+#include <limits>
 #include <map>
 
 #include <Core/Containers/VectorArray.hpp>
@@ -73,15 +75,40 @@ class RA_CORE_API AttribBase : public ObservableVoid, public ContainerIntrospect
 
     virtual std::unique_ptr<AttribBase> clone() = 0;
 
+    /// Range of elements [m_begin, m_end).
+    struct Range {
+        size_t m_begin { 0 };
+        size_t m_end { 0 };
+        bool isEmpty() const { return m_end <= m_begin; }
+    };
+
+    /// Return the range of elements written since the last call to clearDirtyRange().
+    /// The range is extended by setData() and resize() (whole attribute), and when unlocking a
+    /// write access (the range given to Attrib::getDataWithLock(), or the whole attribute).
+    /// It allows consumers such as GPU buffers to only update the modified elements.
+    inline const Range& getDirtyRange() const;
+
+    /// Mark all the elements as up to date, called by the consumer of the dirty range.
+    inline void clearDirtyRange();
+
   protected:
     void inline lock( bool isLocked = true );
 
+    /// Extend the dirty range with [begin, end).
+    inline void setDirty( size_t begin, size_t end );
+
+    /// Range written by the current write access, the whole attribute if not given.
+    Range m_lockRange;
+
   private:
     /// The attribute's name.
     std::string m_name;
 
     /// Is data access locked by a user ?
     bool m_isLocked { false };
+
+    /// Elements written since the last clearDirtyRange().
+    Range m_dirtyRange;
 };
 
 /**
@@ -104,6 +131,11 @@ class Attrib : public AttribBase
     /// lock the content, when done call unlock()
     inline Container& getDataWithLock();
 
+    /// Read-write access to the elements [first, first + count) of the attribute content, the
+    /// caller must not modify other elements nor resize the container.
+    /// lock the content, when done call unlock(), which marks only these elements as dirty.
+    inline Container& getDataWithLock( size_t first, size_t count );
+
     /// @{
     /// ContainerIntrosectionInterface implementation
     size_t getSize() const override;
@@ -133,6 +165,7 @@ class Attrib : public AttribBase
     std::unique_ptr<AttribBase> clone() override {
         auto ptr    = std::make_unique<Attrib<T>>( getName() );
         ptr->m_data = m_data;
+        ptr->setDirty( 0, m_data.size() );
         return ptr;
     }
 
@@ -479,7 +512,27 @@ void AttribBase::unlock() {
 void AttribBase::lock( bool isLocked ) {
     CORE_ASSERT( isLocked != m_isLocked, "double (un)lock" );
     m_isLocked = isLocked;
-    if ( !m_isLocked ) notify();
+    if ( !m_isLocked ) {
+        setDirty( m_lockRange.m_begin, std::min( m_lockRange.m_end, getSize() ) );
+        notify();
+    }
+}
+
+const AttribBase::Range& AttribBase::getDirtyRange() const {
+    return m_dirtyRange;
+}
+
+void AttribBase::clearDirtyRange() {
+    m_dirtyRange = Range();
+}
+
+void AttribBase::setDirty( size_t begin, size_t end ) {
+    if ( end <= begin ) { return; }
+    if ( m_dirtyRange.isEmpty() ) { m_dirtyRange = { begin, end }; }
+    else {
+        m_dirtyRange.m_begin = std::min( m_dirtyRange.m_begin, begin );
+        m_dirtyRange.m_end   = std::max( m_dirtyRange.m_end, end );
+    }
 }
 
 /////////////// Attrib ///////////////////
@@ -495,10 +548,20 @@ Attrib<T>::~Attrib() {
 template <typename T>
 void Attrib<T>::resize( size_t s ) {
     m_data.resize( s );
+    setDirty( 0, s );
 }
 template <typename T>
 typename Attrib<T>::Container& Attrib<T>::getDataWithLock() {
     lock();
+    m_lockRange = { 0, std::numeric_limits<size_t>::max() };
+    return m_data;
+}
+
+template <typename T>
+typename Attrib<T>::Container& Attrib<T>::getDataWithLock( size_t first, size_t count ) {
+    CORE_ASSERT( first + count <= m_data.size(), "Invalid range" );
+    lock();
+    m_lockRange = { first, first + count };
     return m_data;
 }
 
@@ -511,6 +574,7 @@ template <typename T>
 void Attrib<T>::setData( const Container& data ) {
     CORE_ASSERT( !isLocked(), "try to set onto locked data" );
     m_data = data;
+    setDirty( 0, m_data.size() );
     notify();
 }
 
@@ -518,6 +582,7 @@ template <typename T>
 void Attrib<T>::setData( Container&& data ) {
     CORE_ASSERT( !isLocked(), "try to set onto locked data" );
     m_data = std::move( data );
+    setDirty( 0, m_data.size() );
     notify();
 }
 
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <assert.h>
 #include <deque>
+#include <functional>
+#include <vector>
 
 #include <Core/Utils/Index.hpp>
 
@@ -18,6 +20,10 @@ namespace Utils {
  * is removed. After a removal, the index becomes free again. A object will be given the first free
  * index available. If no free indices are available, the object will not be inserted and the
  * IndexMap is considered full.
+ *
+ * The IndexMap is a slot map : objects are stored contiguously (in no particular order) and a
+ * table maps each index to the position of its object, so that lookup and removal are O(1).
+ * Removing an object moves the last object in its place.
  */
 template <typename T>
 class IndexMap
@@ -121,7 +127,7 @@ class IndexMap
   protected:
     // Member variables
     Container m_data;       /// Objects in the IndexMap
-    IndexContainer m_index; /// Indices in the IndexMap
+    IndexContainer m_index; /// Indices in the IndexMap, m_index[i] being the index of m_data[i]
 
   private:
     // ===============================================================================
@@ -130,32 +136,28 @@ class IndexMap
     inline void push_free_index( const Index& idx ); /// Push a new free index in free list
     inline bool pop_free_index( Index& idx );        /// Pop a free index from the free list
 
-    // ===============================================================================
-    // HELPER FUNCTIONS
-    // ===============================================================================
-    // These function return an iterator to an object from an interator in an index.
-    inline ConstIterator citfromIndex( const ConstIndexIterator& it )
-        const; /// Returns a const iterator on an object from its intex iterator
-    inline Iterator
-    itfromIndex( const ConstIndexIterator&
-                     it ); /// Returns a non-const iterator on an object from its intex iterator
-    inline size_t idxfromIndex( const ConstIndexIterator& it )
-        const; /// Return the index of the object in the map from its index iterator
-
   private:
     // Member variables
-    IndexContainer m_free; /// List of available free indices.
+    /// Position in m_data of the object of each index, s_freeSlot for free indices.
+    std::vector<Index::IntegerType> m_slots;
+    /// Min-heap of the free indices lower than m_slots.size().
+    std::vector<Index::IntegerType> m_free;
+
+    static constexpr Index::IntegerType s_freeSlot = -1;
 };
 
 // ===============================================================================
 // CONSTRUCTOR
 // ===============================================================================
 template <typename T>
-IndexMap<T>::IndexMap() : m_data(), m_index(), m_free( 1, Index( 0 ) ) {}
+IndexMap<T>::IndexMap() : m_data(), m_index(), m_slots(), m_free() {}
 
 template <typename T>
 IndexMap<T>::IndexMap( const IndexMap& id_map ) :
-    m_data( id_map.m_data ), m_index( id_map.m_index ), m_free( id_map.m_free ) {}
+    m_data( id_map.m_data ),
+    m_index( id_map.m_index ),
+    m_slots( id_map.m_slots ),
+    m_free( id_map.m_free ) {}
 
 // ===============================================================================
 // DESTRUCTOR
@@ -170,11 +172,9 @@ template <typename T>
 inline Index IndexMap<T>::insert( const T& obj ) {
     Index idx;
     if ( pop_free_index( idx ) ) {
-        typename std::deque<Index>::iterator it =
-            std::lower_bound( m_index.begin(), m_index.end(), idx );
-        if ( it == m_index.end() ) { m_data.insert( m_data.end(), obj ); }
-        else { m_data.insert( citfromIndex( it ), obj ); }
-        m_index.insert( it, idx );
+        m_slots[idx] = Index::IntegerType( m_data.size() );
+        m_data.push_back( obj );
+        m_index.push_back( idx );
     }
     return idx;
 }
@@ -184,11 +184,9 @@ template <typename... Args>
 Index IndexMap<T>::emplace( const Args&&... args ) {
     Index idx;
     if ( pop_free_index( idx ) ) {
-        typename std::deque<Index>::iterator it =
-            std::lower_bound( m_index.begin(), m_index.end(), idx );
-        if ( it == m_index.end() ) { m_data.emplace( m_data.end(), args... ); }
-        else { m_data.emplace( citfromIndex( it ), args... ); }
-        m_index.insert( it, idx );
+        m_slots[idx] = Index::IntegerType( m_data.size() );
+        m_data.emplace_back( args... );
+        m_index.push_back( idx );
     }
     return idx;
 }
@@ -198,10 +196,18 @@ Index IndexMap<T>::emplace( const Args&&... args ) {
 // ===============================================================================
 template <typename T>
 inline bool IndexMap<T>::remove( const Index& idx ) {
-    typename std::deque<Index>::iterator it = std::find( m_index.begin(), m_index.end(), idx );
-    if ( it == m_index.end() ) { return false; }
-    m_data.erase( itfromIndex( it ) );
-    m_index.erase( it );
+    if ( !contains( idx ) ) { return false; }
+    // move the last object in place of the removed one.
+    const Index::IntegerType pos  = m_slots[idx];
+    const Index::IntegerType last = Index::IntegerType( m_data.size() ) - 1;
+    if ( pos != last ) {
+        m_data[pos]           = std::move( m_data[last] );
+        m_index[pos]          = m_index[last];
+        m_slots[m_index[pos]] = pos;
+    }
+    m_data.pop_back();
+    m_index.pop_back();
+    m_slots[idx] = s_freeSlot;
     push_free_index( idx );
     return true;
 }
@@ -211,17 +217,14 @@ inline bool IndexMap<T>::remove( const Index& idx ) {
 // ===============================================================================
 template <typename T>
 inline const T& IndexMap<T>::at( const Index& idx ) const {
-    typename std::deque<Index>::const_iterator it =
-        std::find( m_index.begin(), m_index.end(), idx );
-    CORE_ASSERT( it != m_index.end(), "Index not found" );
-    return m_data.at( idxfromIndex( it ) );
+    CORE_ASSERT( contains( idx ), "Index not found" );
+    return m_data[m_slots[idx]];
 }
 
 template <typename T>
 inline T& IndexMap<T>::access( const Index& idx ) {
-    typename std::deque<Index>::iterator it = std::find( m_index.begin(), m_index.end(), idx );
-    CORE_ASSERT( ( it != m_index.end() ), "Index not found" );
-    return *itfromIndex( it );
+    CORE_ASSERT( contains( idx ), "Index not found" );
+    return m_data[m_slots[idx]];
 }
 
 // ===============================================================================
@@ -236,8 +239,8 @@ template <typename T>
 inline void IndexMap<T>::clear() {
     m_index.clear();
     m_data.clear();
+    m_slots.clear();
     m_free.clear();
-    m_free.push_back( Index( 0 ) );
 }
 
 // ===============================================================================
@@ -250,14 +253,13 @@ inline bool IndexMap<T>::empty() const {
 
 template <typename T>
 inline bool IndexMap<T>::full() const {
-    return m_free.empty();
+    return m_free.empty() && m_slots.size() > size_t( Index::Max().getValue() );
 }
 
 template <typename T>
 inline bool IndexMap<T>::contains( const Index& idx ) const {
-    typename std::deque<Index>::const_iterator it =
-        std::find( m_index.begin(), m_index.end(), idx );
-    return !( it == m_index.end() );
+    return idx.isValid() && size_t( idx.getValue() ) < m_slots.size() &&
+           m_slots[idx] != s_freeSlot;
 }
 
 template <typename T>
@@ -330,56 +332,33 @@ inline typename IndexMap<T>::ConstIterator IndexMap<T>::cend() const {
 // ===============================================================================
 template <typename T>
 inline void IndexMap<T>::push_free_index( const Index& idx ) {
-    std::deque<Index>::iterator free_it = std::lower_bound( m_free.begin(), m_free.end(), idx );
-    m_free.insert( free_it, idx );
     if ( m_data.empty() ) {
+        // start again from index 0.
+        m_slots.clear();
         m_free.clear();
-        m_free.push_back( Index( 0 ) );
+        return;
     }
+    m_free.push_back( idx );
+    std::push_heap( m_free.begin(), m_free.end(), std::greater<Index::IntegerType>() );
 }
 
 template <typename T>
 inline bool IndexMap<T>::pop_free_index( Index& idx ) {
-    if ( m_free.empty() ) {
+    if ( !m_free.empty() ) {
+        std::pop_heap( m_free.begin(), m_free.end(), std::greater<Index::IntegerType>() );
+        idx = m_free.back();
+        m_free.pop_back();
+        return true;
+    }
+    if ( full() ) {
         idx = Index::Invalid();
         return false;
     }
-    idx = m_free.front();
-    m_free.pop_front();
-    if ( m_free.empty() ) {
-        Index next = idx + 1;
-        if ( next.isValid() ) {
-            if ( uint( next.getValue() ) > m_data.size() ) { m_free.push_back( next ); }
-        }
-    }
+    idx = Index( m_slots.size() );
+    m_slots.push_back( s_freeSlot );
     return true;
 }
 
-// ===============================================================================
-// HELPER FUNCTIONS
-// ===============================================================================
-
-template <typename T>
-typename IndexMap<T>::ConstIterator
-IndexMap<T>::citfromIndex( const typename IndexMap<T>::ConstIndexIterator& it ) const {
-    auto dataIt = m_data.begin();
-    std::advance( dataIt, std::distance( m_index.cbegin(), it ) );
-    return dataIt;
-}
-
-template <typename T>
-typename IndexMap<T>::Iterator
-IndexMap<T>::itfromIndex( const typename IndexMap<T>::ConstIndexIterator& it ) {
-    auto dataIt = m_data.begin();
-    std::advance( dataIt, std::distance( m_index.cbegin(), it ) );
-    return dataIt;
-}
-
-template <typename T>
-size_t IndexMap<T>::idxfromIndex( const typename IndexMap<T>::ConstIndexIterator& it ) const {
-    return std::distance( m_index.cbegin(), it );
-}
-
 } // namespace Utils
 } // namespace Core
 } // namespace Ra
@@ -5,6 +5,7 @@
 # ----------------------------------------------------
 
 set(core_sources
+    Animation/AnimationClip.cpp
     Animation/Cage.cpp
     Animation/DualQuaternionSkinning.cpp
     Animation/HandleArray.cpp
@@ -24,18 +25,26 @@ set(core_sources
     Asset/LightData.cpp
     Asset/MaterialData.cpp
     Containers/AdjacencyList.cpp
+    Containers/TransformStore.cpp
     Containers/VariableSet.cpp
+    Geometry/AabbTree.cpp
+    Geometry/Bvh.cpp
     Geometry/CatmullClarkSubdivider.cpp
     Geometry/IndexedGeometry.cpp
+    Geometry/KdTree.cpp
     Geometry/LoopSubdivider.cpp
     Geometry/MeshPrimitives.cpp
+    Geometry/MultiDrawBatch.cpp
+    Geometry/OcclusionBuffer.cpp
     Geometry/PolyLine.cpp
     Geometry/RayCast.cpp
+    Geometry/SubdivisionStencil.cpp
     Geometry/TopologicalMesh.cpp
     Geometry/TriangleMesh.cpp
     Geometry/Volume.cpp
     Geometry/deprecated/TopologicalMesh.cpp
     Resources/Resources.cpp
+    Tasks/ParallelFor.cpp
     Tasks/TaskQueue.cpp
     Utils/Attribs.cpp
     Utils/CircularIndex.cpp
@@ -45,6 +54,7 @@ set(core_sources
 )
 
 set(core_headers
+    Animation/AnimationClip.hpp
     Animation/Cage.hpp
     Animation/DualQuaternionSkinning.hpp
     Animation/HandleArray.hpp
@@ -81,22 +91,30 @@ set(core_headers
     Containers/Iterators.hpp
     Containers/MakeShared.hpp
     Containers/Tex.hpp
+    Containers/TransformStore.hpp
     Containers/VariableSet.hpp
     Containers/VectorArray.hpp
     CoreMacros.hpp
+    Geometry/AabbTree.hpp
     Geometry/AbstractGeometry.hpp
+    Geometry/Bvh.hpp
     Geometry/CatmullClarkSubdivider.hpp
     Geometry/Curve2D.hpp
     Geometry/DistanceQueries.hpp
+    Geometry/Frustum.hpp
     Geometry/IndexedGeometry.hpp
+    Geometry/KdTree.hpp
     Geometry/LoopSubdivider.hpp
     Geometry/MeshPrimitives.hpp
+    Geometry/MultiDrawBatch.hpp
     Geometry/Obb.hpp
+    Geometry/OcclusionBuffer.hpp
     Geometry/OpenMesh.hpp
     Geometry/PolyLine.hpp
     Geometry/RayCast.hpp
     Geometry/Spline.hpp
     Geometry/StandardAttribNames.hpp
+    Geometry/SubdivisionStencil.hpp
     Geometry/TopologicalMesh.hpp
     Geometry/TriangleMesh.hpp
     Geometry/Volume.hpp
@@ -108,6 +126,7 @@ set(core_headers
     Math/Quadric.hpp
     RaCore.hpp
     Resources/Resources.hpp
+    Tasks/ParallelFor.hpp
     Tasks/Task.hpp
     Tasks/TaskQueue.hpp
     Types.hpp
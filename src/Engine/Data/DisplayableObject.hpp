@@ -53,6 +53,9 @@ class RA_ENGINE_API Displayable
      */
     virtual void updateGL() = 0;
 
+    /// Returns true if the object was modified since the last updateGL().
+    virtual bool isDirty() const { return false; }
+
     /// Draw the mesh. Prog is used to set VertexAttribBinding, but it has to be
     /// already binded
     virtual void render( const ShaderProgram* prog ) = 0;
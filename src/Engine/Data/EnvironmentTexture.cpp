@@ -14,6 +14,7 @@
 #include <Core/Geometry/MeshPrimitives.hpp>
 #include <Core/Math/Math.hpp>
 #include <Core/Resources/Resources.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 
 #include <Engine/Data/Mesh.hpp>
 #include <Engine/Data/ShaderProgram.hpp>
@@ -414,35 +415,31 @@ void EnvironmentTexture::setupTexturesFromSphericalEquiRectangular() {
         m_skyData[imgIdx] = new float[textureSize * textureSize * 4];
     }
 
-    Scalar duv = 2_ra / textureSize;
-
-#pragma omp parallel for firstprivate( duv )
-    for ( int imgIdx = 0; imgIdx < 6; ++imgIdx ) {
-        // Fill in pixels
-        for ( int i = 0; i < textureSize; i++ ) {
-            Scalar u = -1 + i * duv;
-            for ( int j = 0; j < textureSize; j++ ) {
-                Scalar v  = -1 + j * duv;
-                Vector3 d = bases[imgIdx][0] + u * bases[imgIdx][1] + v * bases[imgIdx][2];
-                d         = d.normalized();
-                Vector2 st { w * sphericalPhi( d ) / ( 2 * M_PI ), h * sphericalTheta( d ) / M_PI };
-                // TODO : use st to access and filter the original envmap
-                // for now, no filtering is done. (eq to GL_NEAREST)
-                int s  = int( st.x() );
-                int t  = int( st.y() );
-                int cu = int( ( u / 2 + 0.5 ) * textureSize );
-                int cv = int( ( v / 2 + 0.5 ) * textureSize );
-
-                m_skyData[imgIdx][4 * ( cv * textureSize + cu ) + 0] =
-                    latlonPix[4 * ( t * w + s ) + 0];
-                m_skyData[imgIdx][4 * ( cv * textureSize + cu ) + 1] =
-                    latlonPix[4 * ( t * w + s ) + 1];
-                m_skyData[imgIdx][4 * ( cv * textureSize + cu ) + 2] =
-                    latlonPix[4 * ( t * w + s ) + 2];
-                m_skyData[imgIdx][4 * ( cv * textureSize + cu ) + 3] = 1;
-            }
+    const Scalar duv = 2_ra / textureSize;
+
+    // Fill in pixels, in parallel over the rows of the six faces
+    Core::parallelFor( 0, 6 * textureSize, [&]( int row ) {
+        const int imgIdx = row / textureSize;
+        const int i      = row % textureSize;
+        const Scalar u   = -1 + i * duv;
+        for ( int j = 0; j < textureSize; j++ ) {
+            Scalar v  = -1 + j * duv;
+            Vector3 d = bases[imgIdx][0] + u * bases[imgIdx][1] + v * bases[imgIdx][2];
+            d         = d.normalized();
+            Vector2 st { w * sphericalPhi( d ) / ( 2 * M_PI ), h * sphericalTheta( d ) / M_PI };
+            // TODO : use st to access and filter the original envmap
+            // for now, no filtering is done. (eq to GL_NEAREST)
+            int s  = int( st.x() );
+            int t  = int( st.y() );
+            int cu = int( ( u / 2 + 0.5 ) * textureSize );
+            int cv = int( ( v / 2 + 0.5 ) * textureSize );
+
+            m_skyData[imgIdx][4 * ( cv * textureSize + cu ) + 0] = latlonPix[4 * ( t * w + s ) + 0];
+            m_skyData[imgIdx][4 * ( cv * textureSize + cu ) + 1] = latlonPix[4 * ( t * w + s ) + 1];
+            m_skyData[imgIdx][4 * ( cv * textureSize + cu ) + 2] = latlonPix[4 * ( t * w + s ) + 2];
+            m_skyData[imgIdx][4 * ( cv * textureSize + cu ) + 3] = 1;
         }
-    }
+    } );
 
     for ( int imgIdx = 0; imgIdx < 6; ++imgIdx ) {
         flip_horizontally( m_skyData[imgIdx], textureSize, textureSize, 4 );
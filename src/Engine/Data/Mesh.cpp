@@ -116,6 +116,55 @@ void AttribArrayDisplayable::updatePickingRenderMode() {
     }
 }
 
+void AttribArrayDisplayable::uploadAttrib( size_t idx, AttribBase* attrib ) {
+    if ( m_vboSizes.size() < m_vbos.size() ) { m_vboSizes.resize( m_vbos.size(), 0 ); }
+    auto& vbo = m_vbos[idx];
+    if ( !vbo ) {
+        vbo             = globjects::Buffer::create();
+        m_vboSizes[idx] = 0;
+    }
+
+#ifdef CORE_USE_DOUBLE
+    // need conversion
+    const size_t eltSize = attrib->getNumberOfComponents();
+    const size_t stride  = eltSize * sizeof( float );
+#else
+    const size_t stride = size_t( attrib->getStride() );
+#endif
+    const size_t size = attrib->getSize() * stride;
+    auto range        = attrib->getDirtyRange();
+    // Sending the whole attribute reallocates the buffer storage, so that the driver does not
+    // wait for the draws still using the previous one.
+    if ( m_vboSizes[idx] != size ) { range = { 0, attrib->getSize() }; }
+    attrib->clearDirtyRange();
+    if ( range.isEmpty() ) { return; }
+
+    const size_t count = range.m_end - range.m_begin;
+#ifdef CORE_USE_DOUBLE
+    auto data              = std::make_unique<float[]>( count * eltSize );
+    const char* cptr       = reinterpret_cast<const char*>( attrib->dataPtr() );
+    const size_t cpuStride = size_t( attrib->getStride() );
+    for ( size_t i = 0; i < count; ++i ) {
+        auto tptr = reinterpret_cast<const Scalar*>( cptr + ( range.m_begin + i ) * cpuStride );
+        for ( size_t j = 0; j < eltSize; ++j ) {
+            data[i * eltSize + j] = float( tptr[j] );
+        }
+    }
+    const void* ptr = data.get();
+#else
+    const void* ptr = reinterpret_cast<const char*>( attrib->dataPtr() ) + range.m_begin * stride;
+#endif
+
+    if ( m_vboSizes[idx] != size ) {
+        vbo->setData( gl::GLsizeiptr( size ), ptr, GL_DYNAMIC_DRAW );
+        m_vboSizes[idx] = size;
+    }
+    else {
+        vbo->setSubData(
+            gl::GLintptr( range.m_begin * stride ), gl::GLsizeiptr( count * stride ), ptr );
+    }
+}
+
 void AttribArrayDisplayable::setDirty( const std::string& name ) {
     auto itr = m_handleToBuffer.find( name );
     if ( itr == m_handleToBuffer.end() ) {
@@ -123,8 +172,10 @@ void AttribArrayDisplayable::setDirty( const std::string& name ) {
         m_dataDirty.push_back( true );
         m_vbos.emplace_back( nullptr );
     }
-    else
+    else {
         m_dataDirty[itr->second] = true;
+        if ( itr->second < m_vboSizes.size() ) { m_vboSizes[itr->second] = 0; }
+    }
 
     m_isDirty = true;
 }
@@ -133,6 +184,7 @@ void AttribArrayDisplayable::setDirty( unsigned int index ) {
     if ( index < m_dataDirty.size() ) {
         m_dataDirty[index] = true;
         m_isDirty          = true;
+        if ( index < m_vboSizes.size() ) { m_vboSizes[index] = 0; }
     }
 }
 
@@ -144,8 +196,10 @@ void AttribArrayDisplayable::setDirty( const Ra::Core::Geometry::MeshAttrib& typ
         m_dataDirty.push_back( true );
         m_vbos.emplace_back( nullptr );
     }
-    else
+    else {
         m_dataDirty[itr->second] = true;
+        if ( itr->second < m_vboSizes.size() ) { m_vboSizes[itr->second] = 0; }
+    }
 
     m_isDirty = true;
 }
@@ -87,8 +87,13 @@ class RA_ENGINE_API AttribArrayDisplayable : public Displayable
     /// Get the render mode.
     inline MeshRenderMode getRenderMode() const;
 
+    /// Returns true if some attributes must be sent by the next updateGL().
+    inline bool isDirty() const override;
+
     /// @name
-    /// Mark attrib data as dirty, forcing an update of the OpenGL buffer.
+    /// Mark attrib data as dirty, forcing an update of the whole OpenGL buffer.
+    /// Attributes written through Core::Utils::Attrib::getDataWithLock() or setData() are
+    /// tracked automatically, and only their modified elements are sent.
     ///@{
 
     /// Use g_attribName to find the corresponding name and call setDirty(const std::string& name).
@@ -129,6 +134,11 @@ class RA_ENGINE_API AttribArrayDisplayable : public Displayable
     /// Update the picking render mode according to the object render mode
     void updatePickingRenderMode();
 
+    /// Send the attribute to its buffer m_vbos[idx], and clear its dirty range.
+    /// Only the dirty range is sent if the buffer already has the size of the attribute, the
+    /// whole attribute is sent otherwise.
+    void uploadAttrib( size_t idx, Ra::Core::Utils::AttribBase* attrib );
+
     class AttribObserver
     {
       public:
@@ -158,6 +168,8 @@ class RA_ENGINE_API AttribArrayDisplayable : public Displayable
     // m_vbos and m_dataDirty have the same size and are indexed thru m_handleToBuffer[attribName]
     std::vector<std::unique_ptr<globjects::Buffer>> m_vbos;
     std::vector<bool> m_dataDirty;
+    // Size in bytes of the data of m_vbos, 0 if the whole attribute must be sent.
+    std::vector<size_t> m_vboSizes;
 
     // Geometry attrib name (std::string) to buffer id (int)
     // buffer id are indices in m_vbos and m_dataDirty
@@ -345,6 +357,9 @@ class IndexedGeometry : public CoreGeometryDisplayable<T>, public VaoIndices
 
     void loadGeometry( T&& mesh ) override;
 
+    /// Returns true if some attributes or the indices must be sent by the next updateGL().
+    bool isDirty() const override;
+
   protected:
     void updateGL_specific_impl() override;
 };
@@ -498,6 +513,32 @@ CoreMeshType createCoreMeshFromGeometryData( const Ra::Core::Asset::GeometryData
     return mesh;
 }
 
+/// create a TriangleMesh, PolyMesh or other Core::*Mesh from GeometryData, moving the vertex
+/// attributes and the faces of \p data instead of copying them.
+/// \warning The geometry of \p data is left empty.
+template <typename CoreMeshType>
+CoreMeshType moveCoreMeshFromGeometryData( Ra::Core::Asset::GeometryData* data ) {
+    CoreMeshType mesh;
+    auto& geo = data->getGeometry();
+
+    if ( !data->isLineMesh() ) {
+        auto [layerKey, layerBase] =
+            geo.getFirstLayerOccurrenceWithLock( mesh.getLayerKey().first );
+        auto& layer =
+            static_cast<Core::Geometry::GeometryIndexLayer<typename CoreMeshType::IndexType>&>(
+                layerBase );
+        mesh.setIndices( std::move( layer.collection() ) );
+        geo.unlockLayer( layerKey );
+    }
+
+    // The attribute arrays are moved, where createCoreMeshFromGeometryData clones them.
+    static_cast<Core::Geometry::AttribArrayGeometry&>( mesh ) =
+        std::move( static_cast<Core::Geometry::AttribArrayGeometry&>( geo ) );
+    geo.clear();
+
+    return mesh;
+}
+
 /// Helpers to get RenderMesh type from CoreMesh Type
 namespace RenderMeshType {
 template <class CoreMeshT>
@@ -549,6 +590,10 @@ AttribArrayDisplayable::MeshRenderMode AttribArrayDisplayable::getRenderMode() c
     return m_renderMode;
 }
 
+bool AttribArrayDisplayable::isDirty() const {
+    return m_isDirty;
+}
+
 ///////////////// VaoIndices  ///////////////////////
 
 void VaoIndices::setIndicesDirty() {
@@ -614,8 +659,7 @@ void IndexedAttribArrayDisplayable<I>::updateGL() {
             auto idx = m_handleToBuffer[b->getName()];
 
             if ( m_dataDirty[idx] ) {
-                if ( !m_vbos[idx] ) { m_vbos[idx] = globjects::Buffer::create(); }
-                m_vbos[idx]->setData( b->getBufferSize(), b->dataPtr(), GL_DYNAMIC_DRAW );
+                uploadAttrib( idx, b );
                 m_dataDirty[idx] = false;
             }
         };
@@ -740,6 +784,7 @@ void CoreGeometryDisplayable<CoreGeometry>::addAttribObserver( const std::string
             m_vbos.emplace_back( nullptr );
         }
         auto idx = m_handleToBuffer[name];
+        if ( idx < m_vboSizes.size() ) { m_vboSizes[idx] = 0; }
         attrib->attach( AttribObserver( this, idx ) );
     }
     // else it's an attrib remove, do nothing, cleanup will be done in updateGL()
@@ -799,6 +844,8 @@ void CoreGeometryDisplayable<T>::setupCoreMeshObservers() {
     int idx = 0;
     m_dataDirty.resize( m_mesh.vertexAttribs().getNumAttribs() );
     m_vbos.resize( m_mesh.vertexAttribs().getNumAttribs() );
+    // the attributes of a new geometry are sent entirely.
+    m_vboSizes.assign( m_vbos.size(), 0 );
     // here capture ref to idx to propagate idx incrementation
     m_mesh.vertexAttribs().for_each_attrib( [&idx, this]( Ra::Core::Utils::AttribBase* b ) {
         auto name              = b->getName();
@@ -847,46 +894,14 @@ void CoreGeometryDisplayable<CoreGeometry>::updateGL() {
         CORE_ASSERT( !( m_mesh.vertices().empty() ), "No vertex." );
 
         updateGL_specific_impl();
-#ifdef CORE_USE_DOUBLE
-        // need convserion
         auto func = [this]( Ra::Core::Utils::AttribBase* b ) {
             auto idx = m_handleToBuffer[b->getName()];
 
             if ( m_dataDirty[idx] ) {
-                if ( !m_vbos[idx] ) { m_vbos[idx] = globjects::Buffer::create(); }
-
-                auto stride      = b->getStride();
-                auto eltSize     = b->getNumberOfComponents();
-                auto size        = b->getSize();
-                auto data        = std::make_unique<float[]>( size * eltSize );
-                const void* ptr  = b->dataPtr();
-                const char* cptr = reinterpret_cast<const char*>( ptr );
-
-                for ( size_t i = 0; i < size; i++ ) {
-                    auto tptr = reinterpret_cast<const Scalar*>( cptr + i * stride );
-                    for ( size_t j = 0; j < eltSize; ++j ) {
-                        data[i * eltSize + j] = tptr[j];
-                    }
-                }
-
-                m_vbos[idx]->setData(
-                    size * eltSize * sizeof( float ), data.get(), GL_DYNAMIC_DRAW );
-
-                m_dataDirty[idx] = false;
-            }
-        };
-
-#else
-        auto func = [this]( Ra::Core::Utils::AttribBase* b ) {
-            auto idx = m_handleToBuffer[b->getName()];
-
-            if ( m_dataDirty[idx] ) {
-                if ( !m_vbos[idx] ) { m_vbos[idx] = globjects::Buffer::create(); }
-                m_vbos[idx]->setData( b->getBufferSize(), b->dataPtr(), GL_DYNAMIC_DRAW );
+                uploadAttrib( idx, b );
                 m_dataDirty[idx] = false;
             }
         };
-#endif
         m_mesh.vertexAttribs().for_each_attrib( func );
 
         // cleanup removed attrib
@@ -956,6 +971,11 @@ void IndexedGeometry<T>::updateGL_specific_impl() {
     base::m_vao->unbind();
 }
 
+template <typename T>
+bool IndexedGeometry<T>::isDirty() const {
+    return base::isDirty() || m_indicesDirty;
+}
+
 template <typename T>
 void IndexedGeometry<T>::render( const ShaderProgram* prog ) {
     if ( base::m_vao ) {
@@ -0,0 +1,87 @@
+#include <Engine/Data/MultiDrawMesh.hpp>
+
+#include <Engine/OpenGL.hpp>
+
+#include <globjects/Buffer.h>
+#include <globjects/VertexArray.h>
+
+namespace Ra {
+namespace Engine {
+namespace Data {
+
+MultiDrawMesh::MultiDrawMesh( const std::string& name ) : Mesh( name ) {}
+
+MultiDrawMesh::~MultiDrawMesh() = default;
+
+void MultiDrawMesh::loadBatch( const Core::Geometry::MultiDrawBatch& batch ) {
+    m_commands      = batch.getCommands();
+    m_drawData      = batch.getDrawData();
+    m_commandsDirty = true;
+    m_drawDataDirty = true;
+    loadGeometry( Core::Geometry::TriangleMesh( batch.getMesh() ) );
+}
+
+void MultiDrawMesh::setVisible( int draw, bool visible ) {
+    CORE_ASSERT( draw >= 0 && draw < getNumDraws(), "Invalid draw" );
+    auto& instanceCount = m_commands[size_t( draw )].m_instanceCount;
+    if ( ( instanceCount > 0 ) != visible ) {
+        instanceCount   = visible ? 1 : 0;
+        m_commandsDirty = true;
+    }
+}
+
+void MultiDrawMesh::updateGL() {
+    Mesh::updateGL();
+    if ( m_commandsDirty ) {
+        if ( !m_commandBuffer ) { m_commandBuffer = globjects::Buffer::create(); }
+        m_commandBuffer->setData(
+            static_cast<gl::GLsizeiptr>( m_commands.size() * sizeof( m_commands[0] ) ),
+            m_commands.data(),
+            GL_DYNAMIC_DRAW );
+        m_commandsDirty = false;
+    }
+    if ( m_drawDataDirty ) {
+        if ( !m_drawDataBuffer ) { m_drawDataBuffer = globjects::Buffer::create(); }
+        m_drawDataBuffer->setData(
+            static_cast<gl::GLsizeiptr>( m_drawData.size() * sizeof( m_drawData[0] ) ),
+            m_drawData.data(),
+            GL_STATIC_DRAW );
+        m_drawDataDirty = false;
+    }
+}
+
+void MultiDrawMesh::render( const ShaderProgram* prog ) {
+    if ( !m_vao || m_commands.empty() ) { return; }
+    GL_CHECK_ERROR;
+    m_vao->bind();
+    autoVertexAttribPointer( prog );
+    GL_CHECK_ERROR;
+#ifndef OS_MACOS
+    m_drawDataBuffer->bindBase( GL_SHADER_STORAGE_BUFFER, DrawDataBinding );
+    m_commandBuffer->bind( GL_DRAW_INDIRECT_BUFFER );
+    m_vao->multiDrawElementsIndirect( static_cast<GLenum>( m_renderMode ),
+                                      GL_UNSIGNED_INT,
+                                      nullptr,
+                                      GLsizei( m_commands.size() ),
+                                      0 );
+    globjects::Buffer::unbind( GL_DRAW_INDIRECT_BUFFER );
+#else
+    // glMultiDrawElementsIndirect requires OpenGL >= 4.3, Apple provides OpenGL 4.1
+    for ( const auto& command : m_commands ) {
+        if ( command.m_instanceCount == 0 ) { continue; }
+        m_vao->drawElementsBaseVertex(
+            static_cast<GLenum>( m_renderMode ),
+            GLsizei( command.m_count ),
+            GL_UNSIGNED_INT,
+            reinterpret_cast<const void*>( command.m_firstIndex * sizeof( std::uint32_t ) ),
+            command.m_baseVertex );
+    }
+#endif
+    GL_CHECK_ERROR;
+    m_vao->unbind();
+    GL_CHECK_ERROR;
+}
+
+} // namespace Data
+} // namespace Engine
+} // namespace Ra
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Core/Geometry/MultiDrawBatch.hpp>
+#include <Engine/Data/Mesh.hpp>
+#include <Engine/RaEngine.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace globjects {
+class Buffer;
+}
+
+namespace Ra {
+namespace Engine {
+namespace Data {
+
+/**
+ * Mesh drawing the draws of a Core::Geometry::MultiDrawBatch with a single indirect multi draw
+ * call : the vertex and index arenas of the batch are the core geometry of the mesh, and its draw
+ * commands are stored in a GL_DRAW_INDIRECT_BUFFER.
+ * The per draw data of the batch are bound as a shader storage buffer, at binding point
+ * DrawDataBinding, for shaders indexing them with gl_DrawID (or gl_BaseInstance).
+ * \note On MacOS (OpenGL 4.1), draws are issued one by one with glDrawElementsBaseVertex.
+ */
+class RA_ENGINE_API MultiDrawMesh : public Mesh
+{
+  public:
+    /// Binding point of the per draw data shader storage buffer.
+    static constexpr unsigned int DrawDataBinding = 0;
+
+    explicit MultiDrawMesh( const std::string& name );
+    ~MultiDrawMesh() override;
+
+    /// Load the arenas, the draw commands and the draw data of batch.
+    void loadBatch( const Core::Geometry::MultiDrawBatch& batch );
+
+    /// Set the visibility of a draw of the loaded batch. Only the draw commands are uploaded to
+    /// the GPU at the next updateGL().
+    void setVisible( int draw, bool visible );
+    inline int getNumDraws() const;
+
+    void updateGL() override;
+    void render( const ShaderProgram* prog ) override;
+
+  private:
+    std::vector<Core::Geometry::MultiDrawBatch::DrawCommand> m_commands;
+    Core::AlignedStdVector<Core::Geometry::MultiDrawBatch::DrawData> m_drawData;
+
+    std::unique_ptr<globjects::Buffer> m_commandBuffer;
+    std::unique_ptr<globjects::Buffer> m_drawDataBuffer;
+    bool m_commandsDirty { false };
+    bool m_drawDataDirty { false };
+};
+
+inline int MultiDrawMesh::getNumDraws() const {
+    return int( m_commands.size() );
+}
+
+} // namespace Data
+} // namespace Engine
+} // namespace Ra
@@ -11,7 +11,16 @@ namespace Data {
 RenderParameters::StaticParameterBinder RenderParameters::s_binder;
 
 void RenderParameters::bind( const Data::ShaderProgram* shader ) const {
-    m_parameterSets.visit( s_binder, shader );
+    auto& plan = m_bindingPlans.getPlan( shader->getLinkId() );
+    BindingContext context { shader, plan };
+    m_parameterSets.visit( s_binder, context );
+    plan.resize( context.m_next );
+}
+
+int RenderParameters::BindingContext::getLocation( const std::string& name ) {
+    return m_plan.getLocation( m_next++, name, [this]( const std::string& n ) {
+        return m_shader->getUniformLocation( n );
+    } );
 }
 
 void RenderParameters::addParameter( const std::string& name, const std::string& value ) {
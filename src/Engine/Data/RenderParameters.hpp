@@ -2,6 +2,7 @@
 
 #include <Engine/RaEngine.hpp>
 
+#include <cstdint>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -15,6 +16,7 @@
 #include <Core/Containers/VariableSet.hpp>
 
 #include <Engine/Data/ShaderProgram.hpp>
+#include <Engine/Data/UniformCache.hpp>
 
 namespace Ra {
 namespace Engine {
@@ -277,6 +279,16 @@ class RA_ENGINE_API RenderParameters final
     Core::VariableSet& getStorage() { return m_parameterSets; }
     /// \}
   private:
+    /// Per bind data of the binder, forwarded as an rvalue to the visit operators.
+    struct BindingContext {
+        const Data::ShaderProgram* m_shader;
+        UniformBindingPlans::Plan& m_plan;
+        size_t m_next { 0 };
+
+        /// Return the location of the next parameter, named name.
+        int getLocation( const std::string& name );
+    };
+
     /**
      * \brief Static visitor to bind the stored parameters.
      * \note Binds only statically supported types. To bind unsupported types, use a custom
@@ -293,8 +305,9 @@ class RA_ENGINE_API RenderParameters final
          */
         void operator()( const std::string& name,
                          const Ra::Core::Utils::Color& p,
-                         const Data::ShaderProgram* shader ) {
-            shader->setUniform( name.c_str(), Ra::Core::Utils::Color::VectorType( p ) );
+                         BindingContext&& context ) {
+            context.m_shader->setUniform( context.getLocation( name ),
+                                          Ra::Core::Utils::Color::VectorType( p ) );
         }
 
         /**
@@ -302,10 +315,11 @@ class RA_ENGINE_API RenderParameters final
          */
         void operator()( const std::string& name,
                          const RenderParameters::TextureInfo& p,
-                         const Data::ShaderProgram* shader ) {
+                         BindingContext&& context ) {
             auto [tex, texUnit] = p;
-            if ( texUnit == -1 ) { shader->setUniformTexture( name.c_str(), tex ); }
-            else { shader->setUniform( name.c_str(), tex, texUnit ); }
+            const int location  = context.getLocation( name );
+            if ( texUnit == -1 ) { context.m_shader->setUniformTexture( location, tex ); }
+            else { context.m_shader->setUniform( location, tex, texUnit ); }
         }
 
         /**
@@ -315,16 +329,16 @@ class RA_ENGINE_API RenderParameters final
         template <typename T>
         void operator()( const std::string& /*name*/,
                          const std::reference_wrapper<T>& p,
-                         const Data::ShaderProgram* shader ) {
-            p.get().bind( shader );
+                         BindingContext&& context ) {
+            p.get().bind( context.m_shader );
         }
 
         /**
          * \brief Bind any type of parameter that do not requires special access
          */
         template <typename T>
-        void operator()( const std::string& name, const T& p, const Data::ShaderProgram* shader ) {
-            shader->setUniform( name.c_str(), p );
+        void operator()( const std::string& name, const T& p, BindingContext&& context ) {
+            context.m_shader->setUniform( context.getLocation( name ), p );
         }
     };
 
@@ -333,6 +347,9 @@ class RA_ENGINE_API RenderParameters final
      */
     static StaticParameterBinder s_binder;
 
+    /// Binding plans of the last shader programs the parameters were bound to.
+    mutable UniformBindingPlans m_bindingPlans;
+
     /**
      * Storage of the parameters
      */
@@ -13,6 +13,7 @@
 #include <Engine/Data/Texture.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <numeric> // for std::accumulate
 #include <regex>
 
@@ -208,6 +209,10 @@ void ShaderProgram::load( const ShaderConfiguration& shaderConfig ) {
 }
 
 void ShaderProgram::link() {
+    static std::atomic<std::uint64_t> linkCount { 0 };
+    m_uniformCache.setLinkId( ++linkCount );
+    m_textureUnitsByLocation.clear();
+
     m_program = globjects::Program::create();
 
     for ( unsigned int i = 0; i < ShaderType_COUNT; ++i ) {
@@ -249,8 +254,9 @@ void ShaderProgram::link() {
              type == GL_SAMPLER_2D_MULTISAMPLE_ARRAY ||
              type == GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY ||
              type == GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY ) {
-            auto location      = m_program->getUniformLocation( name );
-            textureUnits[name] = TextureBinding( texUnit++, location );
+            auto location                      = m_program->getUniformLocation( name );
+            m_textureUnitsByLocation[location] = texUnit;
+            textureUnits[name]                 = TextureBinding( texUnit++, location );
         }
     }
 }
@@ -296,80 +302,104 @@ ShaderConfiguration ShaderProgram::getBasicConfiguration() const {
 }
 
 template <>
-void ShaderProgram::setUniform( const char* name, const Core::Vector2d& value ) const {
-    m_program->setUniform( name, value.cast<GL_SCALAR_PLAIN>().eval() );
+void ShaderProgram::setUniform( int location, const Core::Vector2d& value ) const {
+    setUniform( location, value.cast<GL_SCALAR_PLAIN>().eval() );
 }
 
 template <>
-void ShaderProgram::setUniform( const char* name, const Core::Vector3d& value ) const {
-    m_program->setUniform( name, value.cast<GL_SCALAR_PLAIN>().eval() );
+void ShaderProgram::setUniform( int location, const Core::Vector3d& value ) const {
+    setUniform( location, value.cast<GL_SCALAR_PLAIN>().eval() );
 }
 
 template <>
-void ShaderProgram::setUniform( const char* name, const Core::Vector4d& value ) const {
-    m_program->setUniform( name, value.cast<GL_SCALAR_PLAIN>().eval() );
+void ShaderProgram::setUniform( int location, const Core::Vector4d& value ) const {
+    setUniform( location, value.cast<GL_SCALAR_PLAIN>().eval() );
 }
 
 template <>
-void ShaderProgram::setUniform( const char* name, const Core::Matrix2d& value ) const {
-    m_program->setUniform( name, value.cast<GL_SCALAR_PLAIN>().eval() );
+void ShaderProgram::setUniform( int location, const Core::Matrix2d& value ) const {
+    setUniform( location, value.cast<GL_SCALAR_PLAIN>().eval() );
 }
 
 template <>
-void ShaderProgram::setUniform( const char* name, const Core::Matrix3d& value ) const {
-    m_program->setUniform( name, value.cast<GL_SCALAR_PLAIN>().eval() );
+void ShaderProgram::setUniform( int location, const Core::Matrix3d& value ) const {
+    setUniform( location, value.cast<GL_SCALAR_PLAIN>().eval() );
 }
 
 template <>
-void ShaderProgram::setUniform( const char* name, const Core::Matrix4d& value ) const {
-    m_program->setUniform( name, value.cast<GL_SCALAR_PLAIN>().eval() );
+void ShaderProgram::setUniform( int location, const Core::Matrix4d& value ) const {
+    setUniform( location, value.cast<GL_SCALAR_PLAIN>().eval() );
 }
 
 template <>
-void ShaderProgram::setUniform( const char* name, const Scalar& value ) const {
-    m_program->setUniform( name, static_cast<GL_SCALAR_PLAIN>( value ) );
+void ShaderProgram::setUniform( int location, const Scalar& value ) const {
+    const auto glValue = static_cast<GL_SCALAR_PLAIN>( value );
+    if ( location >= 0 && updateUniformValue( location, glValue ) ) {
+        m_program->setUniform( location, glValue );
+    }
 }
 
 template <typename T,
           typename std::enable_if<!std::is_same<T, GL_SCALAR_PLAIN>::value>::type* = nullptr>
-void scalarVectorAdapter( globjects::Program* prog,
-                          const char* name,
-                          const std::vector<T>& value ) {
+std::vector<GL_SCALAR_PLAIN> scalarVectorAdapter( const std::vector<T>& value ) {
     std::vector<GL_SCALAR_PLAIN> convertedValue;
     std::transform( value.begin(),
                     value.end(),
                     std::back_inserter( convertedValue ),
                     []( Scalar c ) -> GL_SCALAR_PLAIN { return c; } );
-    prog->setUniform( name, convertedValue );
+    return convertedValue;
 }
 
 template <typename T,
           typename std::enable_if<std::is_same<T, GL_SCALAR_PLAIN>::value>::type* = nullptr>
-void scalarVectorAdapter( globjects::Program* prog,
-                          const char* name,
-                          const std::vector<T>& value ) {
-    prog->setUniform( name, value );
+const std::vector<GL_SCALAR_PLAIN>& scalarVectorAdapter( const std::vector<T>& value ) {
+    return value;
 }
 
 template <>
-void ShaderProgram::setUniform( const char* name, const std::vector<Scalar>& value ) const {
-    scalarVectorAdapter<Scalar>( m_program.get(), name, value );
+void ShaderProgram::setUniform( int location, const std::vector<Scalar>& value ) const {
+    const auto& glValue = scalarVectorAdapter<Scalar>( value );
+    if ( location >= 0 && updateUniformValue( location, glValue ) ) {
+        m_program->setUniform( location, glValue );
+    }
 }
 
 void ShaderProgram::setUniform( const char* name, Texture* tex, int texUnit ) const {
-    tex->bind( texUnit );
-
-    m_program->setUniform( name, texUnit );
+    setUniform( getUniformLocation( name ), tex, texUnit );
 }
 
 void ShaderProgram::setUniformTexture( const char* name, Texture* tex ) const {
     auto itr = textureUnits.find( std::string( name ) );
     if ( itr != textureUnits.end() ) {
         tex->bind( itr->second.m_texUnit );
-        m_program->setUniform( itr->second.m_location, itr->second.m_texUnit );
+        setUniform( itr->second.m_location, itr->second.m_texUnit );
     }
 }
 
+void ShaderProgram::setUniform( int location, Texture* tex, int texUnit ) const {
+    // Texture units are global state : always bind the texture.
+    tex->bind( texUnit );
+    setUniform( location, texUnit );
+}
+
+void ShaderProgram::setUniformTexture( int location, Texture* tex ) const {
+    auto itr = m_textureUnitsByLocation.find( location );
+    if ( itr != m_textureUnitsByLocation.end() ) {
+        tex->bind( itr->second );
+        setUniform( location, itr->second );
+    }
+}
+
+int ShaderProgram::getUniformLocation( const char* name ) const {
+    return m_uniformCache.getLocation(
+        name, [this]( const char* n ) { return m_program->getUniformLocation( n ); } );
+}
+
+int ShaderProgram::getUniformLocation( const std::string& name ) const {
+    return m_uniformCache.getLocation(
+        name, [this]( const std::string& n ) { return m_program->getUniformLocation( n ); } );
+}
+
 globjects::Program* ShaderProgram::getProgramObject() const {
     return m_program.get();
 }
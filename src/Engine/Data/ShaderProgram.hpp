@@ -6,13 +6,18 @@
 
 #include <Core/CoreMacros.hpp>
 #include <Engine/Data/ShaderConfiguration.hpp>
+#include <Engine/Data/UniformCache.hpp>
 
 #include <globjects/Program.h>
 
 #include <array>
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 namespace globjects {
 class Shader;
@@ -48,6 +53,8 @@ class RA_ENGINE_API ShaderProgram final
     void unbind() const;
 
     /// Uniform setters
+    /// Setting a uniform to the value it already holds is skipped, as uniforms are part of the
+    /// program state.
     template <typename T>
     void setUniform( const char* name, const T& value ) const;
     void setUniform( const char* name, Texture* tex, int texUnit ) const;
@@ -58,6 +65,22 @@ class RA_ENGINE_API ShaderProgram final
     //! @warning, call a std::map::find (in O(log(active tex unit in the shader)))
     void setUniformTexture( const char* name, Texture* tex ) const;
 
+    /// Uniform setters by location, \see getUniformLocation.
+    /// Negative locations are ignored.
+    template <typename T>
+    void setUniform( int location, const T& value ) const;
+    void setUniform( int location, Texture* tex, int texUnit ) const;
+    void setUniformTexture( int location, Texture* tex ) const;
+
+    /// Return the location of the uniform name, -1 if the program has no such active uniform.
+    /// Locations are queried once, then cached until the program is linked again.
+    int getUniformLocation( const char* name ) const;
+    int getUniformLocation( const std::string& name ) const;
+
+    /// Return an identifier of the linked program, unique among all the programs and changed at
+    /// each link, to cache data depending on the uniform locations.
+    inline std::uint64_t getLinkId() const;
+
     globjects::Program* getProgramObject() const;
 
     ///\todo go private, and update ShaderConfiguration to add from source !
@@ -77,6 +100,18 @@ class RA_ENGINE_API ShaderProgram final
     };
     using TextureUnits = std::map<std::string, TextureBinding>;
     TextureUnits textureUnits;
+    /// Texture unit of the samplers, by location.
+    std::unordered_map<int, int> m_textureUnitsByLocation;
+
+    /// Store the value of the uniform at location.
+    /// \return false if the uniform already holds this value.
+    template <typename T>
+    bool updateUniformValue( int location, const T& value ) const;
+    template <typename T>
+    bool updateUniformValue( int location, const std::vector<T>& value ) const;
+
+    /// Uniform locations and values since the last link.
+    mutable UniformCache m_uniformCache;
 
     void loadShader( Data::ShaderType type,
                      const std::string& name,
@@ -104,34 +139,55 @@ class RA_ENGINE_API ShaderProgram final
 
 // declare specialization, definied in .cpp
 template <>
-RA_ENGINE_API void ShaderProgram::setUniform( const char* name, const Core::Vector2d& value ) const;
+RA_ENGINE_API void ShaderProgram::setUniform( int location, const Core::Vector2d& value ) const;
 
 template <>
-RA_ENGINE_API void ShaderProgram::setUniform( const char* name, const Core::Vector3d& value ) const;
+RA_ENGINE_API void ShaderProgram::setUniform( int location, const Core::Vector3d& value ) const;
 
 template <>
-RA_ENGINE_API void ShaderProgram::setUniform( const char* name, const Core::Vector4d& value ) const;
+RA_ENGINE_API void ShaderProgram::setUniform( int location, const Core::Vector4d& value ) const;
 
 template <>
-RA_ENGINE_API void ShaderProgram::setUniform( const char* name, const Core::Matrix2d& value ) const;
+RA_ENGINE_API void ShaderProgram::setUniform( int location, const Core::Matrix2d& value ) const;
 
 template <>
-RA_ENGINE_API void ShaderProgram::setUniform( const char* name, const Core::Matrix3d& value ) const;
+RA_ENGINE_API void ShaderProgram::setUniform( int location, const Core::Matrix3d& value ) const;
 
 template <>
-RA_ENGINE_API void ShaderProgram::setUniform( const char* name, const Core::Matrix4d& value ) const;
+RA_ENGINE_API void ShaderProgram::setUniform( int location, const Core::Matrix4d& value ) const;
 
 template <>
-RA_ENGINE_API void ShaderProgram::setUniform( const char* name, const Scalar& value ) const;
+RA_ENGINE_API void ShaderProgram::setUniform( int location, const Scalar& value ) const;
 
 template <>
-RA_ENGINE_API void ShaderProgram::setUniform( const char* name,
+RA_ENGINE_API void ShaderProgram::setUniform( int location,
                                               const std::vector<Scalar>& value ) const;
 
 // Uniform setters
 template <typename T>
 inline void ShaderProgram::setUniform( const char* name, const T& value ) const {
-    m_program->setUniform<T>( name, value );
+    setUniform( getUniformLocation( name ), value );
+}
+
+template <typename T>
+inline void ShaderProgram::setUniform( int location, const T& value ) const {
+    if ( location >= 0 && updateUniformValue( location, value ) ) {
+        m_program->setUniform<T>( location, value );
+    }
+}
+
+inline std::uint64_t ShaderProgram::getLinkId() const {
+    return m_uniformCache.getLinkId();
+}
+
+template <typename T>
+inline bool ShaderProgram::updateUniformValue( int location, const T& value ) const {
+    return m_uniformCache.updateValue( location, &value, sizeof( T ) );
+}
+
+template <typename T>
+inline bool ShaderProgram::updateUniformValue( int location, const std::vector<T>& value ) const {
+    return m_uniformCache.updateValue( location, value.data(), value.size() * sizeof( T ) );
 }
 
 } // namespace Data
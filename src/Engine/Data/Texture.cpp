@@ -1,3 +1,4 @@
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/Tasks/Task.hpp>
 #include <Core/Tasks/TaskQueue.hpp>
 #include <Core/Utils/Log.hpp>
@@ -298,15 +299,14 @@ void Texture::sRGBToLinearRGB( uint8_t* texels, uint numComponent, bool hasAlpha
             return uint8_t( c * 255 );
         };
         uint numValues = hasAlphaChannel ? numComponent - 1 : numComponent;
-#pragma omp parallel for
-        for ( int i = 0; i < int( m_textureParameters.width * m_textureParameters.height *
-                                  m_textureParameters.depth );
-              ++i ) {
+        const size_t numTexels =
+            m_textureParameters.width * m_textureParameters.height * m_textureParameters.depth;
+        Core::parallelFor( size_t( 0 ), numTexels, [&]( size_t i ) {
             // Convert each R or RGB value while keeping alpha unchanged
-            for ( uint p = i * numComponent; p < i * numComponent + numValues; ++p ) {
+            for ( size_t p = i * numComponent; p < i * numComponent + numValues; ++p ) {
                 texels[p] = linearize( texels[p] );
             }
-        }
+        } );
     }
 }
 
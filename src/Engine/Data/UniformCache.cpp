@@ -0,0 +1,46 @@
+#include <Engine/Data/UniformCache.hpp>
+
+#include <algorithm>
+
+namespace Ra {
+namespace Engine {
+namespace Data {
+
+void UniformCache::setLinkId( std::uint64_t linkId ) {
+    if ( linkId == m_linkId ) { return; }
+    // Locations and values of the uniforms are reset by the link.
+    m_linkId = linkId;
+    m_locations.clear();
+    m_values.clear();
+}
+
+bool UniformCache::updateValue( int location, const void* data, size_t size ) {
+    if ( size_t( location ) >= m_values.size() ) { m_values.resize( size_t( location ) + 1 ); }
+    auto& bytes = m_values[size_t( location )];
+    auto first  = static_cast<const std::uint8_t*>( data );
+    // An empty value means that the uniform was never set since the link.
+    if ( !bytes.empty() && bytes.size() == size &&
+         std::equal( first, first + size, bytes.begin() ) ) {
+        return false;
+    }
+    bytes.assign( first, first + size );
+    return true;
+}
+
+UniformBindingPlans::Plan& UniformBindingPlans::getPlan( std::uint64_t linkId ) {
+    // Parameters are typically bound to a few programs (one per rendering pass). Plans of
+    // programs which were deleted or linked again are dropped when there are too many of them.
+    constexpr size_t maxPlans = 16;
+    auto plan = std::find_if( m_plans.begin(), m_plans.end(), [linkId]( const Plan& p ) {
+        return p.m_linkId == linkId;
+    } );
+    if ( plan != m_plans.end() ) { return *plan; }
+    if ( m_plans.size() >= maxPlans ) { m_plans.clear(); }
+    m_plans.emplace_back();
+    m_plans.back().m_linkId = linkId;
+    return m_plans.back();
+}
+
+} // namespace Data
+} // namespace Engine
+} // namespace Ra
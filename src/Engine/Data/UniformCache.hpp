@@ -0,0 +1,124 @@
+#pragma once
+
+#include <Engine/RaEngine.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Ra {
+namespace Engine {
+namespace Data {
+
+/**
+ * Uniform locations and values of a linked shader program, cached by ShaderProgram so that the
+ * program is only queried for unknown locations, and only set the uniforms whose value changed.
+ * Does not depend on OpenGL : the locations are queried through a functor.
+ */
+class RA_ENGINE_API UniformCache
+{
+  public:
+    /// Return the identifier of the link the cached data belong to, 0 before the first link.
+    inline std::uint64_t getLinkId() const;
+
+    /// Set the identifier of the current link, the cached data being cleared if it changed.
+    void setLinkId( std::uint64_t linkId );
+
+    /// Return the location of the uniform name, computed by query( name ) if not cached.
+    template <typename Name, typename Query>
+    int getLocation( const Name& name, Query&& query );
+
+    /// Store the value of the uniform at location.
+    /// \return false if the uniform already holds this value.
+    bool updateValue( int location, const void* data, size_t size );
+
+  private:
+    std::uint64_t m_linkId { 0 };
+    /// Cached uniform locations, by name.
+    std::map<std::string, int, std::less<>> m_locations;
+    /// Bytes of the last value set to each uniform location.
+    std::vector<std::vector<std::uint8_t>> m_values;
+};
+
+/**
+ * \brief Uniform locations of the parameters of a RenderParameters for each linked shader program
+ * they are bound to, in the order of the visit of the parameters by the binder.
+ * Each location is checked against the name of the visited parameter, and queried again if the
+ * parameters have changed since the last bind.
+ */
+class RA_ENGINE_API UniformBindingPlans
+{
+  public:
+    class Plan
+    {
+      public:
+        /// Return the location of the index-th bound parameter, named name, computed by
+        /// query( name ) if the plan holds another parameter at this index.
+        template <typename Query>
+        int getLocation( size_t index, const std::string& name, Query&& query );
+
+        /// Drop the locations of the parameters bound after the first size ones.
+        inline void resize( size_t size );
+
+        /// Return the number of locations of the plan.
+        inline size_t size() const;
+
+      private:
+        friend class UniformBindingPlans;
+        std::uint64_t m_linkId { 0 };
+        std::vector<std::pair<std::string, int>> m_locations;
+    };
+
+    /// Return the plan of the program linked with the identifier linkId, empty if it is new.
+    Plan& getPlan( std::uint64_t linkId );
+
+    /// Return the number of plans.
+    inline size_t size() const;
+
+  private:
+    std::vector<Plan> m_plans;
+};
+
+inline std::uint64_t UniformCache::getLinkId() const {
+    return m_linkId;
+}
+
+template <typename Name, typename Query>
+int UniformCache::getLocation( const Name& name, Query&& query ) {
+    auto itr = m_locations.find( name );
+    if ( itr == m_locations.end() ) { itr = m_locations.emplace( name, query( name ) ).first; }
+    return itr->second;
+}
+
+template <typename Query>
+int UniformBindingPlans::Plan::getLocation( size_t index,
+                                            const std::string& name,
+                                            Query&& query ) {
+    if ( index < m_locations.size() ) {
+        if ( m_locations[index].first != name ) { m_locations[index] = { name, query( name ) }; }
+    }
+    else {
+        CORE_ASSERT( index == m_locations.size(), "Locations are requested in binding order." );
+        m_locations.emplace_back( name, query( name ) );
+    }
+    return m_locations[index].second;
+}
+
+inline void UniformBindingPlans::Plan::resize( size_t size ) {
+    m_locations.resize( size );
+}
+
+inline size_t UniformBindingPlans::Plan::size() const {
+    return m_locations.size();
+}
+
+inline size_t UniformBindingPlans::size() const {
+    return m_plans.size();
+}
+
+} // namespace Data
+} // namespace Engine
+} // namespace Ra
@@ -25,6 +25,7 @@
 #include <Engine/Scene/System.hpp>
 #include <Engine/Scene/SystemDisplay.hpp>
 
+#include <chrono>
 #include <iostream>
 #include <string>
 
@@ -150,10 +151,18 @@ void RadiumEngine::cleanup() {
     m_shaderProgramManager.reset( nullptr );
 
     m_loadedFile.reset();
+    // parsing threads can not be stopped, wait for them before releasing the loaders.
+    for ( auto& load : m_asyncLoads ) {
+        load.m_data.wait();
+        load.m_loaded.set_value( false );
+    }
+    m_asyncLoads.clear();
 
     for ( auto& system : m_systems ) {
         system.second.reset();
     }
+    m_persistentTaskQueue = nullptr;
+    m_persistentTaskCount = 0;
 
     Scene::ComponentMessenger::destroyInstance();
 
@@ -162,6 +171,7 @@ void RadiumEngine::cleanup() {
 
 void RadiumEngine::endFrameSync() {
     m_entityManager->swapBuffers();
+    if ( !m_asyncLoads.empty() ) { processAsyncLoads(); }
     m_signalManager->fireFrameEnded();
 }
 
@@ -173,10 +183,37 @@ void RadiumEngine::getTasks( Core::TaskQueue* taskQueue, Scalar dt ) {
         m_timeData.m_singleStep = false;
     }
 
-    FrameInfo frameInfo {
-        m_timeData.m_time, m_timeData.m_realTime ? dt : m_timeData.m_dt, frameCounter++ };
+    // persistent tasks keep a reference to m_frameInfo, update it in place.
+    m_frameInfo.m_animationTime = m_timeData.m_time;
+    m_frameInfo.m_dt            = m_timeData.m_realTime ? dt : m_timeData.m_dt;
+    m_frameInfo.m_numFrame      = frameCounter++;
+
+    // Generate again the persistent tasks if a system asked for it, or if the task queue does
+    // not hold them.
+    bool updatePersistentTasks = ( taskQueue != m_persistentTaskQueue ) ||
+                                 ( taskQueue->getPersistentTaskCount() != m_persistentTaskCount );
     for ( auto& syst : m_systems ) {
-        syst.second->generateTasks( taskQueue, frameInfo );
+        const auto& system    = syst.second;
+        updatePersistentTasks = updatePersistentTasks ||
+                                ( system->hasPersistentTasks() && system->tasksNeedUpdate() );
+    }
+    if ( updatePersistentTasks ) {
+        taskQueue->clearTaskQueue();
+        for ( auto& syst : m_systems ) {
+            if ( syst.second->hasPersistentTasks() ) {
+                syst.second->generateTasks( taskQueue, m_frameInfo );
+                syst.second->m_tasksNeedUpdate = false;
+            }
+        }
+        taskQueue->markTasksAsPersistent();
+        m_persistentTaskQueue = taskQueue;
+        m_persistentTaskCount = taskQueue->getPersistentTaskCount();
+    }
+
+    for ( auto& syst : m_systems ) {
+        if ( !syst.second->hasPersistentTasks() ) {
+            syst.second->generateTasks( taskQueue, m_frameInfo );
+        }
     }
 }
 
@@ -233,31 +270,102 @@ Data::Displayable* RadiumEngine::getMesh( const std::string& entityName,
 bool RadiumEngine::loadFile( const std::string& filename ) {
     releaseFile();
 
+    m_loadedFile = parseFile( filename, findFileLoaders( filename ) );
+
+    if ( m_loadedFile == nullptr ) {
+        LOG( logERROR ) << "There is no loader to handle \"" << Core::Utils::getFileExt( filename )
+                        << "\" extension ! File can't be loaded.";
+
+        return false;
+    }
+
+    addToScene( filename, m_loadedFile.get() );
+    m_loadingState = true;
+    return true;
+}
+
+std::future<bool> RadiumEngine::loadFileAsync( const std::string& filename ) {
+    auto parse = [filename, loaders = findFileLoaders( filename )]() {
+        return parseFile( filename, loaders );
+    };
+    AsyncLoad load;
+    load.m_filename = filename;
+    load.m_data     = std::async( std::launch::async, parse );
+    auto loaded     = load.m_loaded.get_future();
+    m_asyncLoads.push_back( std::move( load ) );
+    m_signalManager->fireFileLoadingStep( filename,
+                                          Scene::SignalManager::FileLoadingStep::Started );
+    return loaded;
+}
+
+size_t RadiumEngine::processAsyncLoads( size_t maxFiles ) {
+    using FileLoadingStep = Scene::SignalManager::FileLoadingStep;
+    for ( auto& load : m_asyncLoads ) {
+        if ( !load.m_parsed &&
+             load.m_data.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready ) {
+            load.m_parsed = true;
+            m_signalManager->fireFileLoadingStep( load.m_filename, FileLoadingStep::Parsed );
+        }
+    }
+
+    // Files are added in loading order, up to the first one still being parsed.
+    size_t added = 0;
+    for ( auto it = m_asyncLoads.begin();
+          it != m_asyncLoads.end() && it->m_parsed && added < maxFiles; ) {
+        auto data = it->m_data.get();
+        if ( data == nullptr ) {
+            LOG( logERROR ) << "There is no loader able to load \"" << it->m_filename
+                            << "\" ! File can't be loaded.";
+            m_signalManager->fireFileLoadingStep( it->m_filename, FileLoadingStep::Failed );
+            it->m_loaded.set_value( false );
+        }
+        else {
+            addToScene( it->m_filename, data.get() );
+            m_signalManager->fireFileLoadingStep( it->m_filename, FileLoadingStep::Loaded );
+            it->m_loaded.set_value( true );
+        }
+        it = m_asyncLoads.erase( it );
+        ++added;
+    }
+    return m_asyncLoads.size();
+}
+
+void RadiumEngine::waitForAsyncLoads() {
+    while ( !m_asyncLoads.empty() ) {
+        m_asyncLoads.front().m_data.wait();
+        processAsyncLoads( m_asyncLoads.size() );
+    }
+}
+
+RadiumEngine::FileLoaderList RadiumEngine::findFileLoaders( const std::string& filename ) const {
     std::string extension = Core::Utils::getFileExt( filename );
 
+    FileLoaderList loaders;
     for ( auto& l : m_fileLoaders ) {
         if ( l->handleFileExtension( extension ) ) {
-            FileData* data = l->loadFile( filename );
-            if ( data != nullptr ) {
-                m_loadedFile.reset( data );
-                break;
-            }
+            loaders.emplace_back( l, &m_fileLoaderMutexes.at( l.get() ) );
         }
     }
+    return loaders;
+}
 
-    if ( m_loadedFile == nullptr ) {
-        LOG( logERROR ) << "There is no loader to handle \"" << extension
-                        << "\" extension ! File can't be loaded.";
-
-        return false;
+std::unique_ptr<FileData> RadiumEngine::parseFile( const std::string& filename,
+                                                   const FileLoaderList& loaders ) {
+    for ( const auto& [loader, mutex] : loaders ) {
+        std::lock_guard<std::mutex> lock( *mutex );
+        std::unique_ptr<FileData> data { loader->loadFile( filename ) };
+        if ( data != nullptr ) { return data; }
     }
+    return nullptr;
+}
 
+void RadiumEngine::addToScene( const std::string& filename, const FileData* data ) {
     std::string entityName = Core::Utils::getBaseName( filename, false );
 
     Scene::Entity* entity = m_entityManager->createEntity( entityName );
 
     for ( auto& system : m_systems ) {
-        system.second->handleAssetLoading( entity, m_loadedFile.get() );
+        system.second->handleAssetLoading( entity, data );
     }
 
     if ( !entity->getComponents().empty() ) {
@@ -269,8 +377,6 @@ bool RadiumEngine::loadFile( const std::string& filename ) {
         LOG( logWARNING ) << "File \"" << filename << "\" has no usable data. Deleting entity...";
         m_entityManager->removeEntity( entity );
     }
-    m_loadingState = true;
-    return true;
 }
 
 void RadiumEngine::releaseFile() {
@@ -299,6 +405,7 @@ Data::ShaderProgramManager* RadiumEngine::getShaderProgramManager() const {
 }
 
 void RadiumEngine::registerFileLoader( std::shared_ptr<FileLoaderInterface> fileLoader ) {
+    m_fileLoaderMutexes[fileLoader.get()];
     m_fileLoaders.push_back( fileLoader );
 }
 
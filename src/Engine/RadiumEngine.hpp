@@ -1,6 +1,8 @@
 #pragma once
 #include <Engine/RaEngine.hpp>
 
+#include <Engine/FrameInfo.hpp>
+
 #include <Core/Tasks/TaskQueue.hpp>
 #include <Core/Types.hpp>
 #include <Core/Utils/Singleton.hpp>
@@ -8,10 +10,13 @@
 #include <glbinding/Version.h>
 #include <globjects/State.h>
 
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stack>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Ra {
@@ -81,6 +86,9 @@ class RA_ENGINE_API RadiumEngine
 
     /**
      * Builds the set of task that must be executed for the current frame.
+     * Tasks of systems with persistent tasks (see Scene::System::hasPersistentTasks) are
+     * registered as persistent tasks in the task queue, and are generated again only when needed.
+     * Tasks of other systems are generated at each frame.
      *
      * @see Documentation on Engine Object Model the what are tasks and what they can do
      * @param taskQueue the task queue that will be executed for the current frame
@@ -147,8 +155,39 @@ class RA_ENGINE_API RadiumEngine
      */
     void releaseFile();
 
+    /**
+     * Loads the given file without blocking the caller.
+     * The file is parsed on a worker thread, so that several files can be parsed concurrently
+     * (calls to a given loader are serialized). Parsed files are then added to the scene in the
+     * order of the calls to loadFileAsync by processAsyncLoads(), called by endFrameSync() : the
+     * root entity and the components of the
+     * systems are created between two frames, their OpenGL resources being created by the
+     * renderer or through the gpu task queue, as for loadFile.
+     * The steps of the loading are notified by the file loading notifier of the signal manager.
+     * @note Unlike loadFile, the engine is not set in the "loading state" : the content of the
+     * file is released as soon as it is added to the scene.
+     * @warning The returned future is ready once the file is added to the scene, waiting for it
+     * on the thread running endFrameSync would block forever. Use waitForAsyncLoads instead.
+     * @param file
+     * @return a future holding true if the file is loaded, false else.
+     */
+    std::future<bool> loadFileAsync( const std::string& file );
+
+    /**
+     * Adds to the scene the files loaded with loadFileAsync whose parsing is done, in loading
+     * order : a parsed file waits until the files requested before it are added.
+     * @param maxFiles maximum number of files added to the scene, to bound the time spent in
+     * this call.
+     * @return the number of files still waiting to be added to the scene.
+     */
+    size_t processAsyncLoads( size_t maxFiles = 1 );
+
+    /// Waits for all the files loaded with loadFileAsync and adds them to the scene.
+    void waitForAsyncLoads();
+
     /// Is called at the end of the frame to synchronize any data
     /// that may have been updated during the frame's multithreaded processing.
+    /// Adds to the scene the next file loaded with loadFileAsync, if it is parsed.
     void endFrameSync();
 
     /// Manager getters
@@ -361,6 +400,30 @@ class RA_ENGINE_API RadiumEngine
     SystemContainer::const_iterator findSystem( const std::string& name ) const;
     SystemContainer::iterator findSystem( const std::string& name );
 
+    /// File loaders handling a file, with the mutex serializing the calls to each of them.
+    using FileLoaderList =
+        std::vector<std::pair<std::shared_ptr<Core::Asset::FileLoaderInterface>, std::mutex*>>;
+
+    /// Get the file loaders handling the extension of filename.
+    FileLoaderList findFileLoaders( const std::string& filename ) const;
+
+    /// Parse filename with the first loader of loaders able to load it.
+    /// \return the content of the file, or nullptr if no loader can load it.
+    static std::unique_ptr<Core::Asset::FileData> parseFile( const std::string& filename,
+                                                             const FileLoaderList& loaders );
+
+    /// Create the root entity of a loaded file and give the content of the file to all systems
+    /// to add components to this entity.
+    void addToScene( const std::string& filename, const Core::Asset::FileData* data );
+
+    /// File loaded by loadFileAsync, not yet added to the scene.
+    struct AsyncLoad {
+        std::string m_filename;
+        std::future<std::unique_ptr<Core::Asset::FileData>> m_data;
+        std::promise<bool> m_loaded;
+        bool m_parsed { false };
+    };
+
     /**
      * Stores the systems by priority.
      * \note For convenience, higher priority means that a system will be evaluated first.
@@ -368,6 +431,7 @@ class RA_ENGINE_API RadiumEngine
     SystemContainer m_systems;
 
     std::vector<std::shared_ptr<Core::Asset::FileLoaderInterface>> m_fileLoaders;
+    mutable std::map<const Core::Asset::FileLoaderInterface*, std::mutex> m_fileLoaderMutexes;
 
     std::unique_ptr<Rendering::RenderObjectManager> m_renderObjectManager;
     std::unique_ptr<Scene::EntityManager> m_entityManager;
@@ -378,6 +442,9 @@ class RA_ENGINE_API RadiumEngine
 
     bool m_loadingState { false };
 
+    /// Files loaded by loadFileAsync, in loading order.
+    std::vector<AsyncLoad> m_asyncLoads;
+
     /// For internal resources management in a filesystem
     std::string m_resourcesRootDir;
 
@@ -416,6 +483,13 @@ class RA_ENGINE_API RadiumEngine
 
     TimeData m_timeData;
 
+    /// Information about the current frame, given to the systems when generating tasks.
+    FrameInfo m_frameInfo;
+
+    /// Task queue holding the persistent tasks of the systems, and the number of these tasks.
+    Core::TaskQueue* m_persistentTaskQueue { nullptr };
+    size_t m_persistentTaskCount { 0 };
+
     /// OpenGL State, usefull to set state of the rendering pipeline. Initialized during
     /// initializedGL()
     std::unique_ptr<globjects::State> m_openglState { nullptr };
@@ -9,6 +9,7 @@
 
 #include <Engine/Data/LambertianMaterial.hpp>
 #include <Engine/Data/Material.hpp>
+#include <Engine/Data/MultiDrawMesh.hpp>
 #include <Engine/Data/RenderParameters.hpp>
 #include <Engine/Data/ShaderProgramManager.hpp>
 #include <Engine/Data/Texture.hpp>
@@ -16,6 +17,7 @@
 #include <Engine/OpenGL.hpp>
 #include <Engine/Rendering/DebugRender.hpp>
 #include <Engine/Rendering/RenderObject.hpp>
+#include <Engine/Rendering/RenderObjectManager.hpp>
 #include <Engine/Scene/DefaultLightManager.hpp>
 #include <Engine/Scene/Light.hpp>
 #include <globjects/Framebuffer.h>
@@ -27,7 +29,11 @@
 
 #include <Engine/Scene/SystemDisplay.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <map>
+#include <unordered_set>
 
 #include <globjects/Texture.h>
 
@@ -149,34 +155,152 @@ void ForwardRenderer::initBuffers() {
     m_secondaryTextures["Volume"] = m_textures[RendererTextures_Volume].get();
 }
 
+void ForwardRenderer::prepareStepInternal( const Data::ViewingParameters& renderData ) {
+    CORE_UNUSED( renderData );
+    updateBatches();
+    updateWireframes();
+}
+
 void ForwardRenderer::updateStepInternal( const Data::ViewingParameters& renderData ) {
     CORE_UNUSED( renderData );
     // TODO : Improve the way RO are distributed in fancy (opaque), transparent and volume
     // to simplify rendering loop and code maintenance
     // i.e. Volume should considered as transparent but stored in the volumetric list and
     // transparent-but-not-volume object should be kept in the fancy list, ...
+    // Stable split, to keep the order of the sorted render queues.
     m_transparentRenderObjects.clear();
     m_volumetricRenderObjects.clear();
-    for ( auto it = m_fancyRenderObjects.begin(); it != m_fancyRenderObjects.end(); ) {
-        if ( ( *it )->isTransparent() ) {
-            m_transparentRenderObjects.push_back( *it );
-            it = m_fancyRenderObjects.erase( it );
-        }
-        else {
-            auto material = ( *it )->getMaterial();
-            if ( material &&
-                 material->getMaterialAspect() == Data::Material::MaterialAspect::MAT_DENSITY ) {
-                m_volumetricRenderObjects.push_back( *it );
-                it = m_fancyRenderObjects.erase( it );
-            }
-            else { ++it; }
+    size_t numOpaque = 0;
+    for ( auto& ro : m_fancyRenderObjects ) {
+        auto material = ro->getMaterial();
+        if ( ro->isTransparent() ) { m_transparentRenderObjects.push_back( std::move( ro ) ); }
+        else if ( material &&
+                  material->getMaterialAspect() == Data::Material::MaterialAspect::MAT_DENSITY ) {
+            m_volumetricRenderObjects.push_back( std::move( ro ) );
         }
+        else { m_fancyRenderObjects[numOpaque++] = std::move( ro ); }
     }
+    m_fancyRenderObjects.resize( numOpaque );
     m_fancyTransparentCount = m_transparentRenderObjects.size();
     m_fancyVolumetricCount  = m_volumetricRenderObjects.size();
 
-    // simple hack to clean wireframes ...
-    if ( m_fancyRenderObjects.size() < m_wireframes.size() ) { m_wireframes.clear(); }
+    removeBatchedRenderObjects();
+}
+
+void ForwardRenderer::updateBatches() {
+    if ( !m_batching || m_wireframe ) {
+        m_batches.clear();
+        return;
+    }
+
+    // Candidates are the opaque triangle meshes which were not moved nor modified since the
+    // previous frame, among all the geometry render objects (culled or not), so that batches are
+    // not rebuilt when the camera moves.
+    std::map<BatchKey, std::vector<RenderObjectPtr>> groups;
+    for ( const auto& ro : getRenderObjects( RenderObjectType::Geometry ) ) {
+        if ( !ro->isVisible() || ro->isXRay() || ro->isTransparent() ) { continue; }
+        auto material = ro->getMaterial();
+        if ( material &&
+             material->getMaterialAspect() == Data::Material::MaterialAspect::MAT_DENSITY ) {
+            continue;
+        }
+        auto mesh = dynamic_cast<const Data::Mesh*>( ro->getMesh().get() );
+        if ( mesh == nullptr ||
+             mesh->getRenderMode() != Data::AttribArrayDisplayable::MeshRenderMode::RM_TRIANGLES ) {
+            continue;
+        }
+        auto technique      = ro->getRenderTechnique();
+        const auto depth    = DefaultRenderingPasses::Z_PREPASS;
+        const auto lighting = DefaultRenderingPasses::LIGHTING_OPAQUE;
+        BatchKey key { technique->getShader( depth ),
+                       technique->getShader( lighting ),
+                       technique->getParametersProvider( depth ),
+                       technique->getParametersProvider( lighting ) };
+        if ( key.m_depthShader == nullptr || key.m_lightingShader == nullptr ||
+             ro->hasRenderStateChanged() ) {
+            continue;
+        }
+        groups[key].push_back( ro );
+    }
+
+    std::map<BatchKey, MeshBatch> batches;
+    for ( auto& group : groups ) {
+        auto& candidates = group.second;
+        if ( candidates.size() < 2 ) { continue; }
+        std::sort( candidates.begin(), candidates.end() );
+
+        auto it = m_batches.find( group.first );
+        if ( it != m_batches.end() && it->second.m_candidates == candidates ) {
+            batches.emplace( group.first, std::move( it->second ) );
+            continue;
+        }
+
+        // Transforms are baked in the vertices, as the material shaders read a model matrix.
+        Core::Geometry::MultiDrawBatch packer( true );
+        MeshBatch batch;
+        for ( const auto& ro : candidates ) {
+            auto mesh = static_cast<const Data::Mesh*>( ro->getMesh().get() );
+            if ( packer.add( mesh->getCoreGeometry(), ro->getRenderTransform() ) >= 0 ) {
+                batch.m_members.push_back( ro.get() );
+            }
+        }
+        if ( batch.m_members.size() < 2 ) { continue; }
+        batch.m_candidates = std::move( candidates );
+        batch.m_mesh       = std::make_shared<Data::MultiDrawMesh>( "MultiDrawBatch" );
+        batch.m_mesh->loadBatch( packer );
+        batches.emplace( group.first, std::move( batch ) );
+    }
+    m_batches = std::move( batches );
+}
+
+void ForwardRenderer::removeBatchedRenderObjects() {
+    if ( m_batches.empty() ) { return; }
+
+    // Members keep the visibility computed by the culling, and are removed from the opaque queue.
+    std::unordered_set<const RenderObject*> visible;
+    for ( const auto& ro : m_fancyRenderObjects ) {
+        visible.insert( ro.get() );
+    }
+    std::unordered_set<const RenderObject*> batched;
+    for ( auto& b : m_batches ) {
+        auto& batch     = b.second;
+        batch.m_visible = false;
+        for ( size_t i = 0; i < batch.m_members.size(); ++i ) {
+            const bool isVisible = visible.count( batch.m_members[i] ) > 0;
+            batch.m_mesh->setVisible( int( i ), isVisible );
+            batch.m_visible = batch.m_visible || isVisible;
+            batched.insert( batch.m_members[i] );
+        }
+        batch.m_mesh->updateGL();
+    }
+    m_fancyRenderObjects.erase(
+        std::remove_if( m_fancyRenderObjects.begin(),
+                        m_fancyRenderObjects.end(),
+                        [&batched]( const auto& ro ) { return batched.count( ro.get() ) > 0; } ),
+        m_fancyRenderObjects.end() );
+}
+
+void ForwardRenderer::renderBatches( const Data::RenderParameters& lightParams,
+                                     const Data::ViewingParameters& renderData,
+                                     Core::Utils::Index passId ) {
+    static const Core::Matrix4 identity = Core::Matrix4::Identity();
+    const bool depthPass                = passId == DefaultRenderingPasses::Z_PREPASS;
+    for ( const auto& b : m_batches ) {
+        if ( !b.second.m_visible ) { continue; }
+        const auto& key = b.first;
+        auto shader     = depthPass ? key.m_depthShader : key.m_lightingShader;
+        auto provider   = depthPass ? key.m_depthProvider : key.m_lightingProvider;
+        shader->bind();
+        shader->setUniform( "transform.proj", renderData.projMatrix );
+        shader->setUniform( "transform.view", renderData.viewMatrix );
+        shader->setUniform( "transform.model", identity );
+        shader->setUniform( "transform.worldNormal", identity );
+        lightParams.bind( shader );
+        if ( provider != nullptr ) { provider->getParameters().bind( shader ); }
+        if ( renderData.viewMatrix.determinant() < 0 ) { glFrontFace( GL_CW ); }
+        else { glFrontFace( GL_CCW ); }
+        b.second.m_mesh->render( shader );
+    }
 }
 
 template <typename IndexContainerType>
@@ -202,58 +326,118 @@ void computeIndices( Core::Geometry::LineMesh::IndexContainerType& indices,
     indices.erase( std::unique( indices.begin(), indices.end() ), indices.end() );
 }
 
-// store LineMesh and Core, define the observer functor to update data one core update for wireframe
-// linemesh
-template <typename CoreGeometry>
-class VerticesUpdater
+// Observer flagging a change of the core geometry drawn by a wireframe. The core geometry may be
+// modified by the engine tasks while rendering, the wireframe is only updated by
+// ForwardRenderer::updateWireframes(), once the tasks are done.
+class WireframeChangeObserver
 {
   public:
-    VerticesUpdater( std::shared_ptr<Data::LineMesh> disp, CoreGeometry& core ) :
-        m_disp { disp }, m_core { core } {};
+    explicit WireframeChangeObserver( std::shared_ptr<std::atomic<bool>> changed ) :
+        m_changed { std::move( changed ) } {}
 
-    void operator()() { m_disp->getCoreGeometry().setVertices( m_core.vertices() ); }
-    std::shared_ptr<Data::LineMesh> m_disp;
-    CoreGeometry& m_core;
+    void operator()() { *m_changed = true; }
+    std::shared_ptr<std::atomic<bool>> m_changed;
 };
 
+// compute the lines drawing the edges of a core mesh
 template <typename CoreGeometry>
-class IndicesUpdater
-{
-  public:
-    IndicesUpdater( std::shared_ptr<Data::LineMesh> disp, CoreGeometry& core ) :
-        m_disp { disp }, m_core { core } {};
-
-    void operator()() {
-        auto lineIndices = m_disp->getCoreGeometry().getIndicesWithLock();
-        computeIndices( lineIndices, m_core.getIndices() );
-        m_disp->getCoreGeometry().indicesUnlock();
-    }
-    std::shared_ptr<Data::LineMesh> m_disp;
-    CoreGeometry& m_core;
-};
-
-// create a linemesh to draw wireframe given a core mesh
-template <typename CoreGeometry>
-void setupLineMesh( std::shared_ptr<Data::LineMesh>& disp, CoreGeometry& core ) {
-
+Core::Geometry::LineMesh computeLineMesh( const CoreGeometry& core ) {
     Core::Geometry::LineMesh lines;
     Core::Geometry::LineMesh::IndexContainerType indices;
 
     lines.setVertices( core.vertices() );
     computeIndices( indices, core.getIndices() );
-    if ( indices.size() > 0 ) {
-        lines.setIndices( std::move( indices ) );
-        disp =
+    lines.setIndices( std::move( indices ) );
+    return lines;
+}
+
+// create a linemesh to draw wireframe given a core mesh, and the function updating it from the
+// core mesh changes
+template <typename CoreGeometry>
+void setupLineMesh( std::shared_ptr<Data::Displayable>& mesh,
+                    std::function<void()>& update,
+                    CoreGeometry& core ) {
+
+    auto lines = computeLineMesh( core );
+    if ( lines.getIndices().size() > 0 ) {
+        auto disp =
             Ra::Core::make_shared<Data::LineMesh>( std::string( "wireframe" ), std::move( lines ) );
-        disp->updateGL();
 
-        // add observer
-        auto handle = core.template getAttribHandle<typename CoreGeometry::Point>(
+        // add observers
+        auto verticesChanged = std::make_shared<std::atomic<bool>>( false );
+        auto indicesChanged  = std::make_shared<std::atomic<bool>>( false );
+        auto handle          = core.template getAttribHandle<typename CoreGeometry::Point>(
             Ra::Core::Geometry::getAttribName( Ra::Core::Geometry::VERTEX_POSITION ) );
-        core.vertexAttribs().getAttrib( handle ).attach( VerticesUpdater( disp, core ) );
-        core.attach( IndicesUpdater( disp, core ) );
+        core.vertexAttribs().getAttrib( handle ).attach(
+            WireframeChangeObserver( verticesChanged ) );
+        core.attach( WireframeChangeObserver( indicesChanged ) );
+
+        mesh   = disp;
+        update = [disp, &core, verticesChanged, indicesChanged]() {
+            // a topology change is rare, the lines are then rebuilt
+            if ( indicesChanged->exchange( false ) ) {
+                verticesChanged->store( false );
+                disp->loadGeometry( computeLineMesh( core ) );
+            }
+            else if ( verticesChanged->exchange( false ) ) {
+                disp->getCoreGeometry().setVertices( core.vertices() );
+            }
+            disp->updateGL();
+        };
+    }
+    else {
+        mesh.reset();
+        update = nullptr;
     }
-    else { disp.reset(); }
+}
+
+void ForwardRenderer::updateWireframes() {
+    if ( !m_wireframe ) { return; }
+
+    // simple hack to clean wireframes ... (culled render objects keep their wireframe)
+    if ( m_renderObjectManager->getRenderObjectsCount() < m_wireframes.size() ) {
+        m_wireframes.clear();
+    }
+
+    for ( const auto& ro : m_fancyRenderObjects ) {
+        auto it = m_wireframes.find( ro.get() );
+        if ( it == m_wireframes.end() ) {
+            Wireframe wireframe;
+
+            using trimesh  = Ra::Engine::Data::IndexedGeometry<Ra::Core::Geometry::TriangleMesh>;
+            using polymesh = Ra::Engine::Data::IndexedGeometry<Ra::Core::Geometry::PolyMesh>;
+            using quadmesh = Ra::Engine::Data::IndexedGeometry<Ra::Core::Geometry::QuadMesh>;
+
+            auto displayable = ro->getMesh();
+            auto tm          = std::dynamic_pointer_cast<trimesh>( displayable );
+            auto tp          = std::dynamic_pointer_cast<polymesh>( displayable );
+            auto tq          = std::dynamic_pointer_cast<quadmesh>( displayable );
+
+            auto processLineMesh = []( auto cm, Wireframe& w ) {
+                if ( cm->getRenderMode() ==
+                     Data::AttribArrayDisplayable::MeshRenderMode::RM_TRIANGLES ) {
+                    setupLineMesh( w.m_mesh, w.m_update, cm->getCoreGeometry() );
+                }
+            };
+            if ( tm ) { processLineMesh( tm, wireframe ); }
+            if ( tp ) { processLineMesh( tp, wireframe ); }
+            if ( tq ) { processLineMesh( tq, wireframe ); }
+
+            it = m_wireframes.emplace( ro.get(), std::move( wireframe ) ).first;
+        }
+        if ( it->second.m_update && ro->isVisible() ) { it->second.m_update(); }
+    }
+}
+
+size_t ForwardRenderer::countStateChangesInternal() const {
+    return Renderer::countStateChangesInternal() +
+           countStateChanges( m_transparentRenderObjects,
+                              DefaultRenderingPasses::LIGHTING_TRANSPARENT ) +
+           countStateChanges( m_volumetricRenderObjects,
+                              DefaultRenderingPasses::LIGHTING_VOLUMETRIC ) +
+           size_t( std::count_if( m_batches.begin(), m_batches.end(), []( const auto& b ) {
+               return b.second.m_visible;
+           } ) );
 }
 
 void ForwardRenderer::renderInternal( const Data::ViewingParameters& renderData ) {
@@ -298,6 +482,7 @@ void ForwardRenderer::renderInternal( const Data::ViewingParameters& renderData
     for ( const auto& ro : m_fancyRenderObjects ) {
         ro->render( {}, renderData, DefaultRenderingPasses::Z_PREPASS );
     }
+    renderBatches( {}, renderData, DefaultRenderingPasses::Z_PREPASS );
     // Transparent objects are rendered in the Z-prepass, but only their fully opaque fragments
     // (if any) might influence the z-buffer.
     // Rendering transparent objects assuming that they
@@ -327,6 +512,8 @@ void ForwardRenderer::renderInternal( const Data::ViewingParameters& renderData
                 ro->render(
                     l->getRenderParameters(), renderData, DefaultRenderingPasses::LIGHTING_OPAQUE );
             }
+            renderBatches(
+                l->getRenderParameters(), renderData, DefaultRenderingPasses::LIGHTING_OPAQUE );
             // Rendering transparent objects assuming that they discard all their non-opaque
             // fragments
             for ( const auto& ro : m_transparentRenderObjects ) {
@@ -441,36 +628,11 @@ void ForwardRenderer::renderInternal( const Data::ViewingParameters& renderData
         glBlendFuncSeparate( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO );
         GL_ASSERT( glDrawBuffers( 1, buffers ) ); // Draw color texture
 
+        // the wireframes are built and updated by prepareStepInternal(), they are only drawn here.
         auto drawWireframe = [this, &renderData]( const auto& ro ) {
-            std::shared_ptr<Data::Displayable> wro;
-
-            WireMap::iterator it = m_wireframes.find( ro.get() );
-            if ( it == m_wireframes.end() ) {
-                std::shared_ptr<Data::LineMesh> disp;
-
-                using trimesh = Ra::Engine::Data::IndexedGeometry<Ra::Core::Geometry::TriangleMesh>;
-                using polymesh = Ra::Engine::Data::IndexedGeometry<Ra::Core::Geometry::PolyMesh>;
-                using quadmesh = Ra::Engine::Data::IndexedGeometry<Ra::Core::Geometry::QuadMesh>;
-
-                auto displayable = ro->getMesh();
-                auto tm          = std::dynamic_pointer_cast<trimesh>( displayable );
-                auto tp          = std::dynamic_pointer_cast<polymesh>( displayable );
-                auto tq          = std::dynamic_pointer_cast<quadmesh>( displayable );
-
-                auto processLineMesh = []( auto cm, std::shared_ptr<Data::LineMesh>& lm ) {
-                    if ( cm->getRenderMode() ==
-                         Data::AttribArrayDisplayable::MeshRenderMode::RM_TRIANGLES ) {
-                        setupLineMesh( lm, cm->getCoreGeometry() );
-                    }
-                };
-                if ( tm ) { processLineMesh( tm, disp ); }
-                if ( tp ) { processLineMesh( tp, disp ); }
-                if ( tq ) { processLineMesh( tq, disp ); }
-
-                m_wireframes[ro.get()] = disp;
-                wro                    = disp;
-            }
-            else { wro = it->second; }
+            WireMap::const_iterator it = m_wireframes.find( ro.get() );
+            if ( it == m_wireframes.end() ) { return; }
+            const auto& wro = it->second.m_mesh;
 
             const Data::ShaderProgram* shader =
                 m_shaderProgramManager->getShaderProgram( "Wireframe" );
@@ -478,9 +640,7 @@ void ForwardRenderer::renderInternal( const Data::ViewingParameters& renderData
             if ( shader && wro ) {
                 shader->bind();
                 if ( ro->isVisible() ) {
-                    wro->updateGL();
-
-                    Core::Matrix4 modelMatrix = ro->getTransformAsMatrix();
+                    Core::Matrix4 modelMatrix = ro->getRenderTransform().matrix();
                     shader->setUniform( "transform.proj", renderData.projMatrix );
                     shader->setUniform( "transform.view", renderData.viewMatrix );
                     shader->setUniform( "transform.model", modelMatrix );
@@ -561,7 +721,7 @@ void ForwardRenderer::uiInternal( const Data::ViewingParameters& renderData ) {
                 // bind data
                 shader->bind();
 
-                Core::Matrix4 M  = ro->getTransformAsMatrix();
+                Core::Matrix4 M  = ro->getRenderTransform().matrix();
                 Core::Matrix4 MV = renderData.viewMatrix * M;
                 Core::Vector3 V  = MV.block<3, 1>( 0, 3 );
                 Scalar d         = V.norm();
@@ -2,6 +2,10 @@
 
 #include <Engine/Rendering/Renderer.hpp>
 
+#include <functional>
+#include <map>
+#include <tuple>
+
 namespace globjects {
 class Framebuffer;
 }
@@ -9,8 +13,11 @@ class Framebuffer;
 namespace Ra {
 namespace Engine {
 namespace Data {
+class MultiDrawMesh;
+class RenderParameters;
+class ShaderParameterProvider;
 class Texture;
-}
+} // namespace Data
 namespace Rendering {
 
 /** Default renderer for the Radium Engine
@@ -29,16 +36,30 @@ class RA_ENGINE_API ForwardRenderer : public Renderer
     std::string getRendererName() const override { return "Forward Renderer"; }
     bool buildRenderTechnique( RenderObject* ro ) const override;
 
+    /**
+     * Set the batching of static opaque meshes, disabled by default.
+     * Opaque triangle meshes which did not move since the previous frame, and which share their
+     * shaders and parameter providers, are packed in a Data::MultiDrawMesh and drawn with a single
+     * multi draw call in the Z-prepass and opaque lighting passes.
+     * A render object leaves its batch as soon as its transform, its local transform or its mesh
+     * is modified (see RenderObject::hasRenderStateChanged()), and the batch is rebuilt when the
+     * object is static again. Batching is not used in wireframe mode.
+     */
+    inline void enableBatching( bool enabled );
+    inline bool isBatchingEnabled() const;
+
   protected:
     void initializeInternal() override;
     void resizeInternal() override;
 
+    void prepareStepInternal( const Data::ViewingParameters& renderData ) override;
     void updateStepInternal( const Data::ViewingParameters& renderData ) override;
 
     void postProcessInternal( const Data::ViewingParameters& renderData ) override;
     void renderInternal( const Data::ViewingParameters& renderData ) override;
     void debugInternal( const Data::ViewingParameters& renderData ) override;
     void uiInternal( const Data::ViewingParameters& renderData ) override;
+    size_t countStateChangesInternal() const override;
 
   private:
     void initShaders();
@@ -46,6 +67,17 @@ class RA_ENGINE_API ForwardRenderer : public Renderer
 
     void updateShadowMaps();
 
+    /// Rebuild the batches of static opaque meshes whose members changed.
+    void updateBatches();
+    /// Set the visibility of the batch members, and remove them from the opaque render queue.
+    void removeBatchedRenderObjects();
+    /// Build the wireframes of the new render objects, and update the others from the changes of
+    /// their core geometry, in wireframe mode.
+    void updateWireframes();
+    void renderBatches( const Data::RenderParameters& lightParams,
+                        const Data::ViewingParameters& renderData,
+                        Core::Utils::Index passId );
+
   protected:
     /// \brief Draw the picture background.
     /// This method allows custom renderers to draw objects on the background.
@@ -85,10 +117,51 @@ class RA_ENGINE_API ForwardRenderer : public Renderer
     std::vector<std::shared_ptr<Data::Texture>> m_shadowMaps;
     std::vector<Core::Matrix4> m_lightMatrices;
 
-    using WireMap = std::map<RenderObject*, std::shared_ptr<Data::Displayable>>;
+    /// Line mesh drawing the edges of a render object in wireframe mode.
+    struct Wireframe {
+        std::shared_ptr<Data::Displayable> m_mesh;
+        /// Update m_mesh from the changes of the render object core geometry, if any.
+        std::function<void()> m_update;
+    };
+    using WireMap = std::map<RenderObject*, Wireframe>;
     WireMap m_wireframes;
+
+  private:
+    /// Shaders and parameter providers of the Z-prepass and opaque lighting passes shared by the
+    /// members of a batch.
+    struct BatchKey {
+        const Data::ShaderProgram* m_depthShader;
+        const Data::ShaderProgram* m_lightingShader;
+        const Data::ShaderParameterProvider* m_depthProvider;
+        const Data::ShaderParameterProvider* m_lightingProvider;
+
+        auto tie() const {
+            return std::tie( m_depthShader, m_lightingShader, m_depthProvider, m_lightingProvider );
+        }
+        bool operator<( const BatchKey& other ) const { return tie() < other.tie(); }
+    };
+
+    struct MeshBatch {
+        /// Render objects packed in the batch, sorted by address, and the ones which are drawn
+        /// by the batch, in the order of its draws.
+        std::vector<RenderObjectPtr> m_candidates;
+        std::vector<const RenderObject*> m_members;
+        std::shared_ptr<Data::MultiDrawMesh> m_mesh;
+        bool m_visible { false };
+    };
+
+    bool m_batching { false };
+    std::map<BatchKey, MeshBatch> m_batches;
 };
 
+inline void ForwardRenderer::enableBatching( bool enabled ) {
+    m_batching = enabled;
+}
+
+inline bool ForwardRenderer::isBatchingEnabled() const {
+    return m_batching;
+}
+
 } // namespace Rendering
 } // namespace Engine
 } // namespace Ra
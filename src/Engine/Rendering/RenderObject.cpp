@@ -230,13 +230,13 @@ Core::Aabb RenderObject::computeAabb() {
 }
 
 void RenderObject::setLocalTransform( const Core::Transform& transform ) {
-    m_localTransform = transform;
+    m_localTransform        = transform;
+    m_localTransformChanged = true;
     invalidateAabb();
 }
 
 void RenderObject::setLocalTransform( const Core::Matrix4& transform ) {
-    m_localTransform = Core::Transform( transform );
-    invalidateAabb();
+    setLocalTransform( Core::Transform( transform ) );
 }
 
 const Core::Transform& RenderObject::getLocalTransform() const {
@@ -247,6 +247,31 @@ const Core::Matrix4& RenderObject::getLocalTransformAsMatrix() const {
     return m_localTransform.matrix();
 }
 
+void RenderObject::updateRenderState() {
+    const Core::Transform transform = getTransform();
+    // The transform comparison also catches entity transforms swapped more than once since the
+    // previous frame.
+    m_renderStateChanged = m_localTransformChanged ||
+                           m_component->getEntity()->hasTransformChanged() ||
+                           transform.matrix() != m_renderTransform.matrix() ||
+                           ( m_mesh && m_mesh->isDirty() );
+    m_localTransformChanged = false;
+    m_renderTransform       = transform;
+    m_renderAabb            = computeAabb();
+}
+
+const Core::Transform& RenderObject::getRenderTransform() const {
+    return m_renderTransform;
+}
+
+const Core::Aabb& RenderObject::getRenderAabb() const {
+    return m_renderAabb;
+}
+
+bool RenderObject::hasRenderStateChanged() const {
+    return m_renderStateChanged;
+}
+
 void RenderObject::hasBeenRenderedOnce() {
     if ( m_hasLifetime ) {
         if ( --m_lifetime <= 0 ) {
@@ -270,7 +295,7 @@ void RenderObject::render( const Data::RenderParameters& lightParams,
                            const Data::RenderParameters& shaderParams ) {
     if ( !m_visible || !shader ) { return; }
     // Radium V2 : avoid this temporary
-    Core::Matrix4 modelMatrix  = getTransformAsMatrix();
+    Core::Matrix4 modelMatrix  = m_renderTransform.matrix();
     Core::Matrix4 normalMatrix = modelMatrix.inverse().transpose();
     // bind data
     shader->bind();
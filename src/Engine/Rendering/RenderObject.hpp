@@ -151,6 +151,19 @@ class RA_ENGINE_API RenderObject final : public Core::Utils::IndexedObject
     const Core::Matrix4& getLocalTransformAsMatrix() const;
     ///@}
 
+    /// \name Render state
+    /// Transform and bounding box used by the renderer, snapshotted by updateRenderState() when a
+    /// frame is prepared (see Renderer::prepare()), so that tasks can move or deform the object
+    /// while the frame is rendered.
+    ///@{
+    void updateRenderState();
+    const Core::Transform& getRenderTransform() const;
+    const Core::Aabb& getRenderAabb() const;
+    /// Returns true if the local transform, the entity transform or the mesh of the object were
+    /// modified since the previous call to updateRenderState().
+    bool hasRenderStateChanged() const;
+    ///@}
+
     /// Basically just decreases lifetime counter.
     /// If it goes to zero, then render object notifies the manager that it needs to be deleted.
     /// Does nothing if lifetime is set to -1
@@ -211,6 +224,11 @@ class RA_ENGINE_API RenderObject final : public Core::Utils::IndexedObject
     bool m_isAabbValid { false };
     Core::Aabb m_aabb;
     int m_aabbObserverIndex { -1 };
+
+    Core::Transform m_renderTransform { Core::Transform::Identity() };
+    Core::Aabb m_renderAabb;
+    bool m_localTransformChanged { true };
+    bool m_renderStateChanged { true };
 };
 
 } // namespace Rendering
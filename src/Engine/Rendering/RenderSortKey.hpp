@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Core/Types.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+namespace Ra {
+namespace Engine {
+namespace Rendering {
+
+/**
+ * Packed 64 bits key used to sort the render queues, so that consecutive draws share their
+ * shader program and parameters (material and textures), which minimizes the state changes.
+ * From the most significant bits :
+ *  - opaque objects : bucket (4) | shader (20) | parameters (20) | depth, front to back (20)
+ *  - blended objects : bucket (4) | depth, back to front (20) | shader (20) | parameters (20)
+ * Shader and parameters are small ids given by the renderer, larger ids are truncated.
+ * Depth is the view space distance of the object, objects behind the camera are at depth 0.
+ */
+namespace RenderSortKey {
+
+using Key = std::uint64_t;
+
+/// Buckets are drawn in this order. Objects of the blended buckets are sorted back to front.
+enum class Bucket : std::uint8_t { Opaque = 0, Transparent, Volumetric };
+
+/// Number of bits of the shader, parameters and depth fields.
+constexpr int FieldBits = 20;
+constexpr std::uint32_t FieldMask = ( 1u << FieldBits ) - 1;
+
+/// Return true if the objects of the bucket are sorted back to front.
+constexpr bool isBlended( Bucket bucket ) {
+    return bucket != Bucket::Opaque;
+}
+
+/// Quantize a distance on FieldBits bits, preserving the order of the distances.
+/// The bit pattern of a positive float grows with its value : keep its exponent and the most
+/// significant bits of its mantissa.
+inline std::uint32_t quantizeDepth( Scalar depth ) {
+    const float d = depth > 0_ra ? float( depth ) : 0.f;
+    std::uint32_t bits;
+    std::memcpy( &bits, &d, sizeof( bits ) );
+    return ( bits >> ( 31 - FieldBits ) ) & FieldMask;
+}
+
+inline Key make( Bucket bucket, std::uint32_t shader, std::uint32_t parameters, Scalar depth ) {
+    const Key b = Key( bucket ) << ( 3 * FieldBits );
+    const Key s = shader & FieldMask;
+    const Key p = parameters & FieldMask;
+    const Key d = quantizeDepth( depth );
+    if ( isBlended( bucket ) ) {
+        return b | ( Key( FieldMask - d ) << ( 2 * FieldBits ) ) | ( s << FieldBits ) | p;
+    }
+    return b | ( s << ( 2 * FieldBits ) ) | ( p << FieldBits ) | d;
+}
+
+inline Bucket getBucket( Key key ) {
+    return Bucket( key >> ( 3 * FieldBits ) );
+}
+
+inline std::uint32_t getShader( Key key ) {
+    const int shift = isBlended( getBucket( key ) ) ? FieldBits : 2 * FieldBits;
+    return std::uint32_t( key >> shift ) & FieldMask;
+}
+
+inline std::uint32_t getParameters( Key key ) {
+    const int shift = isBlended( getBucket( key ) ) ? 0 : FieldBits;
+    return std::uint32_t( key >> shift ) & FieldMask;
+}
+
+} // namespace RenderSortKey
+} // namespace Rendering
+} // namespace Engine
+} // namespace Ra
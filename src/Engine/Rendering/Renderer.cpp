@@ -1,6 +1,7 @@
 #include <Engine/Rendering/Renderer.hpp>
 
 #include <Core/Asset/FileData.hpp>
+#include <Core/Geometry/Frustum.hpp>
 #include <Core/Geometry/MeshPrimitives.hpp>
 #include <Core/Utils/Log.hpp>
 #include <Engine/Data/Material.hpp>
@@ -16,6 +17,7 @@
 #include <Engine/Rendering/RenderObject.hpp>
 #include <Engine/Rendering/RenderObjectManager.hpp>
 #include <Engine/Scene/LightManager.hpp>
+#include <Engine/Scene/SignalManager.hpp>
 
 // temporary fix for issue #837
 #include <Engine/Scene/GeometryComponent.hpp>
@@ -51,7 +53,19 @@ Renderer::Renderer() :
     m_pickingFbo { nullptr },
     m_pickingTexture { nullptr } {}
 
-Renderer::~Renderer() = default;
+Renderer::~Renderer() {
+    // The engine, and its signal manager, may have been destroyed before the renderer.
+    if ( auto engine = RadiumEngine::getInstance() ) {
+        if ( auto signalManager = engine->getSignalManager() ) {
+            if ( m_roAddedObserverId != -1 ) {
+                signalManager->getRenderObjectCreatedNotifier().detach( m_roAddedObserverId );
+            }
+            if ( m_roRemovedObserverId != -1 ) {
+                signalManager->getRenderObjectDestroyedNotifier().detach( m_roRemovedObserverId );
+            }
+        }
+    }
+}
 
 void Renderer::initialize( uint width, uint height ) {
     /// For internal resources management in a filesystem
@@ -65,6 +79,24 @@ void Renderer::initialize( uint width, uint height ) {
     m_renderObjectManager  = RadiumEngine::getInstance()->getRenderObjectManager();
     m_shaderProgramManager = RadiumEngine::getInstance()->getShaderProgramManager();
 
+    // Keep the render queues up to date from the render objects added and removed.
+    // Events may come from any thread, they are applied at the beginning of the next frame.
+    auto signalManager = RadiumEngine::getInstance()->getSignalManager();
+    if ( m_roAddedObserverId == -1 ) {
+        m_roAddedObserverId = signalManager->getRenderObjectCreatedNotifier().attach(
+            [this]( const Scene::ItemEntry& entry ) {
+                std::lock_guard<std::mutex> lock( m_eventMutex );
+                m_renderObjectEvents.push_back( { entry.m_roIndex, true } );
+            } );
+    }
+    if ( m_roRemovedObserverId == -1 ) {
+        m_roRemovedObserverId = signalManager->getRenderObjectDestroyedNotifier().attach(
+            [this]( const Scene::ItemEntry& entry ) {
+                std::lock_guard<std::mutex> lock( m_eventMutex );
+                m_renderObjectEvents.push_back( { entry.m_roIndex, false } );
+            } );
+    }
+
     m_width  = width;
     m_height = height;
 
@@ -268,7 +300,7 @@ Renderer::PickingResult Renderer::doPickingNow( const PickingQuery& query,
             if ( ro->isVisible() && ro->isPickable() ) {
                 m_pickingShaders[i]->setUniform( "objectId", ro->getIndex().getValue() );
 
-                Core::Matrix4 M  = ro->getTransformAsMatrix();
+                Core::Matrix4 M  = ro->getRenderTransform().matrix();
                 Core::Matrix4 MV = renderData.viewMatrix * M;
                 Scalar d         = MV.block<3, 1>( 0, 3 ).norm();
 
@@ -320,24 +352,12 @@ void Renderer::render( const Data::ViewingParameters& data ) {
     std::lock_guard<std::mutex> renderLock( m_renderMutex );
     CORE_UNUSED( renderLock );
 
-    m_timerData.renderStart = Core::Utils::Clock::now();
-
     // 0. Save eventual already bound FBO (e.g. QtOpenGLWidget) and viewport
     saveExternalFBOInternal();
 
-    // 1. Gather render objects if needed
-    // TODO : make this only once and only update modified objects at each frame
-    //  Actually, this correspond to 3 loops over all ROs. Could be done without loops, just by
-    //  using observers
-    feedRenderQueuesInternal( data );
-
-    m_timerData.feedRenderQueuesEnd = Core::Utils::Clock::now();
-
-    // 2. Update them (from an opengl point of view)
-    // TODO : This naively updates the OpenGL State of objects at each frame.
-    //  Do it only for modified objects (With an observer ?)
-    updateRenderObjectsInternal( data );
-    m_timerData.updateEnd = Core::Utils::Clock::now();
+    // 1. and 2. Gather render objects and update them, unless already done by prepare().
+    if ( !m_prepared ) { prepareInternal( data ); }
+    m_prepared = false;
 
     // 3. Do picking if needed
     // TODO : Make picking much more effient.
@@ -348,6 +368,7 @@ void Renderer::render( const Data::ViewingParameters& data ) {
     m_pickingQueries.clear();
 
     updateStepInternal( data );
+    m_timerData.stateChangeCount = countStateChangesInternal();
 
     // 4. Do the rendering.
     renderInternal( data );
@@ -374,6 +395,33 @@ void Renderer::render( const Data::ViewingParameters& data ) {
     notifyRenderObjectsRenderingInternal();
 }
 
+void Renderer::prepare( const Data::ViewingParameters& data ) {
+    if ( !m_initialized ) return;
+
+    std::lock_guard<std::mutex> renderLock( m_renderMutex );
+    CORE_UNUSED( renderLock );
+
+    prepareInternal( data );
+    m_prepared = true;
+}
+
+void Renderer::prepareInternal( const Data::ViewingParameters& data ) {
+    m_timerData.renderStart = Core::Utils::Clock::now();
+
+    // 1. Gather render objects, updated from the render objects added and removed since the
+    // last frame.
+    feedRenderQueuesInternal( data );
+
+    m_timerData.feedRenderQueuesEnd = Core::Utils::Clock::now();
+
+    // 2. Update them (from an opengl point of view)
+    // TODO : This naively updates the OpenGL State of objects at each frame.
+    //  Do it only for modified objects (With an observer ?)
+    updateRenderObjectsInternal( data );
+    prepareStepInternal( data );
+    m_timerData.updateEnd = Core::Utils::Clock::now();
+}
+
 void Renderer::saveExternalFBOInternal() {
     RadiumEngine::getInstance()->pushFboAndViewport();
     // Set the internal rendering viewport
@@ -396,40 +444,281 @@ void Renderer::updateRenderObjectsInternal( const Data::ViewingParameters& /*ren
     }
 }
 
-void Renderer::feedRenderQueuesInternal( const Data::ViewingParameters& /*renderData*/ ) {
+void Renderer::feedRenderQueuesInternal( const Data::ViewingParameters& renderData ) {
+    updateRenderQueuesInternal();
+    // The rendering only reads this snapshot of the render objects transforms and bounding boxes,
+    // which are written by the tasks of the next frame in pipelined mode.
+    for ( const auto& renderObjects : m_renderObjects ) {
+        for ( const auto& ro : renderObjects ) {
+            ro->updateRenderState();
+        }
+    }
+    if ( m_stateSorting ) { sortRenderQueuesInternal( renderData ); }
+
     m_fancyRenderObjects.clear();
     m_debugRenderObjects.clear();
     m_uiRenderObjects.clear();
     m_xrayRenderObjects.clear();
 
-    m_renderObjectManager->getRenderObjectsByType( m_fancyRenderObjects,
-                                                   RenderObjectType::Geometry );
-    m_renderObjectManager->getRenderObjectsByType( m_debugRenderObjects, RenderObjectType::Debug );
-    m_renderObjectManager->getRenderObjectsByType( m_uiRenderObjects, RenderObjectType::UI );
+    auto split = [this]( const std::vector<RenderObjectPtr>& renderObjects,
+                         std::vector<RenderObjectPtr>& renderQueue ) {
+        for ( const auto& ro : renderObjects ) {
+            if ( ro->isXRay() ) { m_xrayRenderObjects.push_back( ro ); }
+            else { renderQueue.push_back( ro ); }
+        }
+    };
+    split( m_renderObjects[size_t( RenderObjectType::Geometry )], m_fancyRenderObjects );
+    split( m_renderObjects[size_t( RenderObjectType::Debug )], m_debugRenderObjects );
+    split( m_renderObjects[size_t( RenderObjectType::UI )], m_uiRenderObjects );
+
+    cullRenderObjectsInternal( renderData );
+}
+
+void Renderer::updateRenderQueuesInternal() {
+    std::vector<RenderObjectEvent> events;
+    {
+        std::lock_guard<std::mutex> lock( m_eventMutex );
+        std::swap( events, m_renderObjectEvents );
+    }
+
+    size_t numRenderObjects = 0;
+    for ( const auto& renderObjects : m_renderObjects ) {
+        numRenderObjects += renderObjects.size();
+    }
+
+    // Render objects may also be removed without event (expired render objects, or signals
+    // switched off) : rebuild everything when the count does not match.
+    // Events received while rebuilding are applied at the next frame, skipping the render objects
+    // already there.
+    int added = 0;
+    for ( const auto& event : events ) {
+        added += event.m_added ? 1 : -1;
+    }
+    if ( int( numRenderObjects ) + added != int( m_renderObjectManager->getRenderObjectsCount() ) ) {
+        std::fill( m_renderObjectTypes.begin(), m_renderObjectTypes.end(), -1 );
+        m_sortIds.clear();
+        for ( size_t type = 0; type < m_renderObjects.size(); ++type ) {
+            auto& renderObjects = m_renderObjects[type];
+            renderObjects.clear();
+            m_renderObjectManager->getRenderObjectsByType( renderObjects,
+                                                           RenderObjectType( type ) );
+            for ( const auto& ro : renderObjects ) {
+                const size_t index = size_t( ro->getIndex().getValue() );
+                if ( index >= m_renderObjectTypes.size() ) {
+                    m_renderObjectTypes.resize( index + 1, -1 );
+                }
+                m_renderObjectTypes[index] = int( type );
+            }
+        }
+        return;
+    }
+    if ( events.empty() ) { return; }
+
+    // Apply the events in order, as indices are reused by the RenderObjectManager.
+    std::array<bool, size_t( RenderObjectType::Count )> removed {};
+    for ( const auto& event : events ) {
+        const size_t index = size_t( event.m_index.getValue() );
+        if ( index >= m_renderObjectTypes.size() ) { m_renderObjectTypes.resize( index + 1, -1 ); }
+        int& type = m_renderObjectTypes[index];
+        if ( event.m_added ) {
+            // Already there, or already removed.
+            if ( type != -1 || !m_renderObjectManager->exists( event.m_index ) ) { continue; }
+            auto ro = m_renderObjectManager->getRenderObject( event.m_index );
+            type    = int( ro->getType() );
+            m_renderObjects[size_t( type )].push_back( ro );
+        }
+        else if ( type != -1 ) {
+            removed[size_t( type )] = true;
+            type                    = -1;
+        }
+    }
+
+    // Render objects whose index is not in m_renderObjectTypes anymore have been removed, or their
+    // index has been reused by a render object appended to the queue.
+    for ( size_t type = 0; type < m_renderObjects.size(); ++type ) {
+        if ( !removed[type] ) { continue; }
+        auto& renderObjects = m_renderObjects[type];
+        std::vector<uint8_t> seen( m_renderObjectTypes.size(), 0 );
+        for ( auto it = renderObjects.rbegin(); it != renderObjects.rend(); ++it ) {
+            const size_t index = size_t( ( *it )->getIndex().getValue() );
+            if ( m_renderObjectTypes[index] != int( type ) || seen[index] ) { it->reset(); }
+            seen[index] = 1;
+        }
+        renderObjects.erase( std::remove( renderObjects.begin(), renderObjects.end(), nullptr ),
+                             renderObjects.end() );
+    }
+}
+
+void Renderer::sortRenderQueuesInternal( const Data::ViewingParameters& renderData ) {
+    // Ids are given in order of appearance, and are reset when the queues are rebuilt or when
+    // there are too many of them, to avoid accumulating the addresses of deleted objects.
+    if ( m_sortIds.size() > RenderSortKey::FieldMask ) { m_sortIds.clear(); }
 
-    for ( auto it = m_fancyRenderObjects.begin(); it != m_fancyRenderObjects.end(); ) {
-        if ( ( *it )->isXRay() ) {
-            m_xrayRenderObjects.push_back( *it );
-            it = m_fancyRenderObjects.erase( it );
+    for ( auto& renderObjects : m_renderObjects ) {
+        m_sortKeys.resize( renderObjects.size() );
+        for ( size_t i = 0; i < renderObjects.size(); ++i ) {
+            m_sortKeys[i] = { computeSortKey( *renderObjects[i], renderData.viewMatrix ),
+                              uint( i ) };
+        }
+        // Only objects which moved or were added since the last frame are out of order.
+        if ( std::is_sorted( m_sortKeys.begin(), m_sortKeys.end() ) ) { continue; }
+        std::sort( m_sortKeys.begin(), m_sortKeys.end() );
+
+        m_sortedRenderObjects.clear();
+        m_sortedRenderObjects.reserve( renderObjects.size() );
+        for ( const auto& key : m_sortKeys ) {
+            m_sortedRenderObjects.push_back( std::move( renderObjects[key.second] ) );
         }
-        else { ++it; }
+        std::swap( renderObjects, m_sortedRenderObjects );
+    }
+}
+
+RenderSortKey::Key Renderer::computeSortKey( RenderObject& ro, const Core::Matrix4& viewMatrix ) {
+    using RenderSortKey::Bucket;
+    // Same classification as the ForwardRenderer, with the pass drawing each bucket.
+    auto material           = ro.getMaterial();
+    auto bucket             = Bucket::Opaque;
+    Core::Utils::Index pass = DefaultRenderingPasses::LIGHTING_OPAQUE;
+    if ( ro.isTransparent() ) {
+        bucket = Bucket::Transparent;
+        pass   = DefaultRenderingPasses::LIGHTING_TRANSPARENT;
+    }
+    else if ( material &&
+              material->getMaterialAspect() == Data::Material::MaterialAspect::MAT_DENSITY ) {
+        bucket = Bucket::Volumetric;
+        pass   = DefaultRenderingPasses::LIGHTING_VOLUMETRIC;
+    }
+
+    const void* shader     = nullptr;
+    const void* parameters = material.get();
+    if ( auto technique = ro.getRenderTechnique() ) {
+        shader = technique->getShader( pass );
+        if ( auto provider = technique->getParametersProvider( pass ) ) { parameters = provider; }
     }
+    auto sortId = [this]( const void* ptr ) {
+        return m_sortIds.emplace( ptr, uint( m_sortIds.size() ) ).first->second;
+    };
+
+    const auto& aabb = ro.getRenderAabb();
+    const Scalar depth =
+        aabb.isEmpty() ? 0_ra : -( viewMatrix * aabb.center().homogeneous() ).z();
+    return RenderSortKey::make( bucket, sortId( shader ), sortId( parameters ), depth );
+}
+
+size_t Renderer::countStateChangesInternal() const {
+    return countStateChanges( m_fancyRenderObjects, DefaultRenderingPasses::LIGHTING_OPAQUE ) +
+           countStateChanges( m_debugRenderObjects, DefaultRenderingPasses::LIGHTING_OPAQUE ) +
+           countStateChanges( m_xrayRenderObjects, DefaultRenderingPasses::LIGHTING_OPAQUE ) +
+           countStateChanges( m_uiRenderObjects, DefaultRenderingPasses::LIGHTING_OPAQUE );
+}
+
+size_t Renderer::countStateChanges( const std::vector<RenderObjectPtr>& renderQueue,
+                                    Core::Utils::Index passId ) {
+    size_t count                                  = 0;
+    const Data::ShaderProgram* shader             = nullptr;
+    const Data::ShaderParameterProvider* provider = nullptr;
+    for ( const auto& ro : renderQueue ) {
+        if ( !ro->isVisible() ) { continue; }
+        auto technique = ro->getRenderTechnique();
+        if ( !technique ) { continue; }
+        auto roShader = technique->getShader( passId );
+        if ( !roShader ) { continue; }
+        auto roProvider = technique->getParametersProvider( passId );
+        if ( roShader != shader ) { ++count; }
+        if ( roProvider != provider ) { ++count; }
+        shader   = roShader;
+        provider = roProvider;
+    }
+    return count;
+}
 
-    for ( auto it = m_debugRenderObjects.begin(); it != m_debugRenderObjects.end(); ) {
-        if ( ( *it )->isXRay() ) {
-            m_xrayRenderObjects.push_back( *it );
-            it = m_debugRenderObjects.erase( it );
+void Renderer::cullRenderObjectsInternal( const Data::ViewingParameters& renderData ) {
+    m_timerData.frustumCulledCount   = 0;
+    m_timerData.occlusionCulledCount = 0;
+    if ( !m_frustumCulling && !m_occlusionCulling ) { return; }
+
+    // Render objects without bounding box (e.g. empty meshes) are never culled.
+    const size_t numObjects = m_fancyRenderObjects.size();
+    std::vector<Core::Aabb> boxes( numObjects );
+    std::vector<uint8_t> visible( numObjects, 1 );
+    for ( size_t i = 0; i < numObjects; ++i ) {
+        boxes[i] = m_fancyRenderObjects[i]->getRenderAabb();
+    }
+
+    const Core::Matrix4 viewProj = renderData.projMatrix * renderData.viewMatrix;
+    if ( m_frustumCulling ) {
+        const Core::Geometry::Frustum frustum( viewProj );
+        if ( m_hierarchicalCulling ) {
+            std::vector<uint> inFrustum;
+            m_cullingTree.build( boxes );
+            m_cullingTree.frustumQuery( frustum, inFrustum );
+            for ( size_t i = 0; i < numObjects; ++i ) {
+                visible[i] = boxes[i].isEmpty();
+            }
+            for ( const auto i : inFrustum ) {
+                visible[i] = 1;
+            }
+        }
+        else {
+            for ( size_t i = 0; i < numObjects; ++i ) {
+                visible[i] = boxes[i].isEmpty() || frustum.intersects( boxes[i] );
+            }
         }
-        else { ++it; }
+        m_timerData.frustumCulledCount = size_t( std::count( visible.begin(), visible.end(), 0 ) );
     }
 
-    for ( auto it = m_uiRenderObjects.begin(); it != m_uiRenderObjects.end(); ) {
-        if ( ( *it )->isXRay() ) {
-            m_xrayRenderObjects.push_back( *it );
-            it = m_uiRenderObjects.erase( it );
+    if ( m_occlusionCulling ) {
+        if ( !m_occlusionBuffer ) {
+            m_occlusionBuffer = std::make_unique<Core::Geometry::OcclusionBuffer>();
+        }
+        m_occlusionBuffer->clear( viewProj );
+
+        // Occluders : the opaque triangle meshes of moderate size covering the largest part of
+        // the screen.
+        constexpr size_t maxOccluders         = 8;
+        constexpr size_t maxOccluderTriangles = 4096;
+        constexpr Scalar minOccluderCoverage  = 0.02_ra;
+        std::vector<std::pair<Scalar, size_t>> occluders;
+        for ( size_t i = 0; i < numObjects; ++i ) {
+            const auto& ro = m_fancyRenderObjects[i];
+            if ( !visible[i] || boxes[i].isEmpty() || !ro->isVisible() || ro->isTransparent() ) {
+                continue;
+            }
+            auto mesh = dynamic_cast<const Data::Mesh*>( ro->getMesh().get() );
+            if ( mesh == nullptr || mesh->getRenderMode() != Data::Mesh::RM_TRIANGLES ||
+                 mesh->getCoreGeometry().getIndices().size() > maxOccluderTriangles ) {
+                continue;
+            }
+            const Scalar coverage = m_occlusionBuffer->getCoverage( boxes[i] );
+            if ( coverage >= minOccluderCoverage ) { occluders.emplace_back( coverage, i ); }
+        }
+        const size_t numOccluders = std::min( occluders.size(), maxOccluders );
+        std::partial_sort( occluders.begin(),
+                           occluders.begin() + numOccluders,
+                           occluders.end(),
+                           []( const auto& a, const auto& b ) { return a.first > b.first; } );
+        occluders.resize( numOccluders );
+        for ( const auto& occluder : occluders ) {
+            const auto& ro       = m_fancyRenderObjects[occluder.second];
+            const auto& geometry = static_cast<const Data::Mesh*>( ro->getMesh().get() )
+                                       ->getCoreGeometry();
+            m_occlusionBuffer->addOccluder(
+                ro->getRenderTransform(), geometry.vertices(), geometry.getIndices() );
+        }
+
+        for ( size_t i = 0; i < numObjects && !occluders.empty(); ++i ) {
+            if ( visible[i] && m_occlusionBuffer->isOccluded( boxes[i] ) ) {
+                visible[i] = 0;
+                ++m_timerData.occlusionCulledCount;
+            }
         }
-        else { ++it; }
     }
+
+    size_t last = 0;
+    for ( size_t i = 0; i < numObjects; ++i ) {
+        if ( visible[i] ) { m_fancyRenderObjects[last++] = std::move( m_fancyRenderObjects[i] ); }
+    }
+    m_fancyRenderObjects.resize( last );
 }
 
 // subroutine to Renderer::splitRenderQueuesForPicking()
@@ -467,7 +756,7 @@ void Renderer::renderForPicking(
         for ( const auto& ro : renderQueuePicking[i] ) {
             if ( ro->isVisible() && ro->isPickable() ) {
                 pickingShaders[i]->setUniform( "objectId", ro->getIndex().getValue() );
-                Core::Matrix4 M = ro->getTransformAsMatrix();
+                Core::Matrix4 M = ro->getRenderTransform().matrix();
                 Core::Matrix4 N = M.inverse().transpose();
                 pickingShaders[i]->setUniform( "transform.model", M );
                 pickingShaders[i]->setUniform( "transform.worldNormal", N );
@@ -592,7 +881,7 @@ void Renderer::preparePicking( const Data::ViewingParameters& renderData ) {
             if ( ro->isVisible() && ro->isPickable() ) {
                 m_pickingShaders[i]->setUniform( "objectId", ro->getIndex().getValue() );
 
-                Core::Matrix4 M  = ro->getTransformAsMatrix();
+                Core::Matrix4 M  = ro->getRenderTransform().matrix();
                 Core::Matrix4 MV = renderData.viewMatrix * M;
                 Scalar d         = MV.block<3, 1>( 0, 3 ).norm();
 
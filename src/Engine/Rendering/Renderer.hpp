@@ -6,12 +6,17 @@
 #include <chrono>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
+#include <Core/Geometry/AabbTree.hpp>
+#include <Core/Geometry/OcclusionBuffer.hpp>
 #include <Core/Types.hpp>
 #include <Core/Utils/Color.hpp>
 #include <Core/Utils/Timer.hpp>
 #include <Engine/Data/DisplayableObject.hpp>
+#include <Engine/Rendering/RenderObjectTypes.hpp>
+#include <Engine/Rendering/RenderSortKey.hpp>
 
 namespace globjects {
 class Framebuffer;
@@ -57,6 +62,13 @@ class RA_ENGINE_API Renderer
         Core::Utils::TimePoint mainRenderEnd;
         Core::Utils::TimePoint postProcessEnd;
         Core::Utils::TimePoint renderEnd;
+        /// Number of geometry render objects outside of the view frustum.
+        size_t frustumCulledCount { 0 };
+        /// Number of geometry render objects hidden by the occluders.
+        size_t occlusionCulledCount { 0 };
+        /// Number of shader program and shader parameters changes between the consecutive draws
+        /// of the render queues, in their lighting pass.
+        size_t stateChangeCount { 0 };
     };
 
     /**
@@ -209,6 +221,38 @@ class RA_ENGINE_API Renderer
      */
     inline void enablePostProcess( bool enabled );
 
+    /**
+     * Set the view frustum culling of the geometry render objects, enabled by default.
+     * @param enabled true if render objects whose bounding box is outside of the view frustum
+     * must not be drawn.
+     */
+    inline void enableFrustumCulling( bool enabled );
+
+    /**
+     * Set the use of a bounding volume hierarchy over the render objects for frustum culling.
+     * It is rebuilt at each frame, and pays off for scenes made of many render objects, mostly
+     * outside of the view frustum.
+     * @param enabled true if frustum culling must traverse a hierarchy of bounding boxes.
+     */
+    inline void enableHierarchicalCulling( bool enabled );
+
+    /**
+     * Set the occlusion culling of the geometry render objects, disabled by default.
+     * The opaque triangle meshes covering the largest part of the screen are rasterized in a small
+     * software depth buffer, hiding the render objects whose bounding box is behind them.
+     * @param enabled true if hidden render objects must not be drawn.
+     */
+    inline void enableOcclusionCulling( bool enabled );
+
+    /**
+     * Set the sorting of the render queues, enabled by default.
+     * Render objects are sorted by shader program, then by shader parameters (material and
+     * textures), then by depth, to minimize the state changes between draws.
+     * Blended objects (transparent and volumetric ones) are sorted back to front.
+     * @param enabled true if the render queues must be sorted.
+     */
+    inline void enableStateSorting( bool enabled );
+
     /**
      * @brief Tell the renderer it needs to render.
      * This method does the following steps :
@@ -231,6 +275,21 @@ class RA_ENGINE_API Renderer
      */
     void render( const Data::ViewingParameters& renderData );
 
+    /**
+     * @brief Gathers the render objects and updates their OpenGL state, i.e. the first steps of
+     * render(), which then skips them.
+     * Once prepared, the rendering only uses the GPU copy of the render objects data and the
+     * snapshot of their transforms and bounding boxes (see RenderObject::updateRenderState()), so
+     * that the engine tasks of the next frame can run concurrently, as long as they do not add or
+     * remove render objects.
+     * Renderers must therefore not read the CPU side geometry of the render objects while
+     * rendering : the resources they build from it (e.g. the ForwardRenderer wireframes) are
+     * updated by prepareStepInternal(), and the core geometry observers they attach may be
+     * notified by the tasks at any time.
+     * @note Requires the OpenGL context to be bound.
+     */
+    void prepare( const Data::ViewingParameters& renderData );
+
     /**
      * @brief Initialize renderer
      */
@@ -363,6 +422,13 @@ class RA_ENGINE_API Renderer
      */
     virtual void resizeInternal() = 0;
 
+    /**
+     * Update the renderer dependent resources built from the CPU data of the render objects,
+     * called at the end of prepare(), while the engine tasks are not running.
+     * @param renderData
+     */
+    virtual void prepareStepInternal( const Data::ViewingParameters& /*renderData*/ ) {}
+
     /**
      * Update the renderer dependent resources for the next frame
      * @param renderData
@@ -398,14 +464,45 @@ class RA_ENGINE_API Renderer
      */
     virtual void uiInternal( const Data::ViewingParameters& renderData ) = 0; // idem ?
 
+    /**
+     * @brief Count the state changes of the frame, called after updateStepInternal().
+     * Override it if your renderer draws its own render queues.
+     * \see countStateChanges
+     */
+    virtual size_t countStateChangesInternal() const;
+
+    /**
+     * Return the number of shader program and shader parameters changes when drawing the visible
+     * render objects of renderQueue, in this order, for the pass passId.
+     */
+    static size_t countStateChanges( const std::vector<RenderObjectPtr>& renderQueue,
+                                     Core::Utils::Index passId );
+
+    /**
+     * Return all the render objects of the given type, sorted if state sorting is enabled, but
+     * neither culled nor split between the render queues.
+     */
+    inline const std::vector<RenderObjectPtr>& getRenderObjects( RenderObjectType type ) const;
+
   private:
     // 0.
     void saveExternalFBOInternal();
     void restoreExternalFBOInternal();
 
+    // 1. and 2.
+    void prepareInternal( const Data::ViewingParameters& renderData );
+
     // 1.
     void feedRenderQueuesInternal( const Data::ViewingParameters& renderData );
 
+    // 1.0
+    void updateRenderQueuesInternal();
+    void sortRenderQueuesInternal( const Data::ViewingParameters& renderData );
+    RenderSortKey::Key computeSortKey( RenderObject& ro, const Core::Matrix4& viewMatrix );
+
+    // 1.1
+    void cullRenderObjectsInternal( const Data::ViewingParameters& renderData );
+
     // 2.0
     void updateRenderObjectsInternal( const Data::ViewingParameters& renderData );
 
@@ -467,6 +564,10 @@ class RA_ENGINE_API Renderer
     bool m_drawDebug { true };          // Should we render debug stuff ?
     bool m_wireframe { false };         // Are we rendering in "real" wireframe mode
     bool m_postProcessEnabled { true }; // Should we do post processing ?
+    bool m_frustumCulling { true };       // Should we skip render objects outside of the view ?
+    bool m_hierarchicalCulling { false }; // Should frustum culling use a hierarchy of boxes ?
+    bool m_occlusionCulling { false };    // Should we skip render objects hidden by occluders ?
+    bool m_stateSorting { true };         // Should we sort the render queues by state ?
 
     // derived class could use the already created textures
     /// Depth texture : might be attached to the main framebuffer
@@ -480,6 +581,34 @@ class RA_ENGINE_API Renderer
     // Renderer timings data
     TimerData m_timerData;
 
+    // CULLING STUFF
+    /// Hierarchy over the bounding boxes of the geometry render objects, for frustum culling.
+    Core::Geometry::AabbTree m_cullingTree;
+    /// Depth buffer of the occluders, allocated on first use.
+    std::unique_ptr<Core::Geometry::OcclusionBuffer> m_occlusionBuffer;
+
+    // RENDER QUEUES STUFF
+    /// Render object added to (m_added true) or removed from the RenderObjectManager.
+    struct RenderObjectEvent {
+        Core::Utils::Index m_index;
+        bool m_added;
+    };
+    /// Events received from the SignalManager since the last frame, protected by m_eventMutex.
+    std::vector<RenderObjectEvent> m_renderObjectEvents;
+    std::mutex m_eventMutex;
+    int m_roAddedObserverId { -1 };
+    int m_roRemovedObserverId { -1 };
+    /// All the render objects of each type, kept up to date from the events, and sorted by
+    /// state. The render queues are split from them at each frame.
+    std::array<std::vector<RenderObjectPtr>, size_t( RenderObjectType::Count )> m_renderObjects;
+    /// Type of the render object of each index in m_renderObjects, -1 if absent.
+    std::vector<int> m_renderObjectTypes;
+    /// Small ids of the shader programs and shader parameters providers, for the sort keys.
+    std::unordered_map<const void*, uint> m_sortIds;
+    /// Sort keys and positions of the render objects of a type, reused at each frame.
+    std::vector<std::pair<RenderSortKey::Key, uint>> m_sortKeys;
+    std::vector<RenderObjectPtr> m_sortedRenderObjects;
+
     std::mutex m_renderMutex;
 
     // PICKING STUFF
@@ -503,6 +632,8 @@ class RA_ENGINE_API Renderer
     void preparePicking( const Data::ViewingParameters& renderData );
 
     bool m_initialized { false };
+    /// True between prepare() and render().
+    bool m_prepared { false };
 };
 
 inline const std::vector<std::tuple<int, int, int>>& Renderer::PickingResult::getIndices() const {
@@ -588,6 +719,22 @@ inline void Renderer::enablePostProcess( bool enabled ) {
     m_postProcessEnabled = enabled;
 }
 
+inline void Renderer::enableFrustumCulling( bool enabled ) {
+    m_frustumCulling = enabled;
+}
+
+inline void Renderer::enableHierarchicalCulling( bool enabled ) {
+    m_hierarchicalCulling = enabled;
+}
+
+inline void Renderer::enableOcclusionCulling( bool enabled ) {
+    m_occlusionCulling = enabled;
+}
+
+inline void Renderer::enableStateSorting( bool enabled ) {
+    m_stateSorting = enabled;
+}
+
 inline void Renderer::addPickingRequest( const PickingQuery& query ) {
     m_pickingQueries.push_back( query );
 }
@@ -617,6 +764,11 @@ inline const Core::Utils::Color& Renderer::getBackgroundColor() const {
     return m_backgroundColor;
 }
 
+inline const std::vector<Renderer::RenderObjectPtr>&
+Renderer::getRenderObjects( RenderObjectType type ) const {
+    return m_renderObjects[size_t( type )];
+}
+
 } // namespace Rendering
 } // namespace Engine
 } // namespace Ra
@@ -75,6 +75,9 @@ class RA_ENGINE_API CameraManager : public System
     //
     void generateTasks( Core::TaskQueue* taskQueue, const Engine::FrameInfo& frameInfo ) override;
 
+    /// Camera updates are generated once, and check the camera visibility when run.
+    bool hasPersistentTasks() const override { return true; }
+
     void handleAssetLoading( Entity* entity, const Core::Asset::FileData* data ) override;
 
     /// this static data member handles default camera values.
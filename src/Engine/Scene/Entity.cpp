@@ -2,24 +2,29 @@
 
 #include <Core/Math/LinearAlgebra.hpp>
 #include <Engine/RadiumEngine.hpp>
+#include <Engine/Rendering/RenderObject.hpp>
+#include <Engine/Rendering/RenderObjectManager.hpp>
 #include <Engine/Scene/Component.hpp>
+#include <Engine/Scene/EntityManager.hpp>
 #include <Engine/Scene/SignalManager.hpp>
 
 namespace Ra {
 namespace Engine {
 namespace Scene {
 
-Entity::Entity( const std::string& name ) :
-    Core::Utils::IndexedObject(),
-    m_transform { Core::Transform::Identity() },
-    m_doubleBufferedTransform { Core::Transform::Identity() },
-    m_name { name } {}
+Entity::Entity( const std::string& name ) : Core::Utils::IndexedObject(), m_name { name } {}
 
 Entity::~Entity() {
     // Ensure components are deleted before the entity for consistent
     // ordering of signals.
     m_transformationObservers.detachAll();
     m_components.clear();
+    // children become roots.
+    while ( !m_children.empty() ) {
+        m_children.back()->setParent( nullptr );
+    }
+    setParent( nullptr );
+    if ( m_transforms ) { m_transforms->remove( m_transformSlot ); }
     RadiumEngine::getInstance()->getSignalManager()->fireEntityDestroyed( ItemEntry( this ) );
 }
 
@@ -68,10 +73,19 @@ void Entity::removeComponent( const std::string& name ) {
 }
 
 void Entity::swapTransformBuffers() {
-    if ( m_transformChanged ) {
-        m_transform        = m_doubleBufferedTransform;
-        m_transformChanged = false;
-        m_transformationObservers.notify( this );
+    RadiumEngine::getInstance()->getEntityManager()->swapBuffers();
+}
+
+void Entity::setParent( Entity* parent ) {
+    if ( parent == m_parent ) { return; }
+    if ( m_parent ) {
+        auto& siblings = m_parent->m_children;
+        siblings.erase( std::find( siblings.begin(), siblings.end(), this ) );
+    }
+    m_parent = parent;
+    if ( m_parent ) { m_parent->m_children.push_back( this ); }
+    if ( m_transforms ) {
+        m_transforms->setParent( m_transformSlot, m_parent ? m_parent->m_transformSlot : -1 );
     }
 }
 
@@ -95,6 +109,17 @@ void Entity::invalidateAabb() {
     m_isAabbValid = false;
 }
 
+void Entity::invalidateWorldAabbs() {
+    auto roMgr = RadiumEngine::getInstance()->getRenderObjectManager();
+    for ( const auto& component : m_components ) {
+        for ( const auto& roIndex : component->getRenderObjects() ) {
+            roMgr->getRenderObject( roIndex )->invalidateAabb();
+        }
+        component->invalidateAabb();
+    }
+    m_isAabbValid = false;
+}
+
 } // namespace Scene
 } // namespace Engine
 } // namespace Ra
@@ -2,11 +2,11 @@
 
 #include <Engine/RaEngine.hpp>
 
-#include <mutex>
+#include <memory>
 #include <string>
-#include <thread>
 #include <vector>
 
+#include <Core/Containers/TransformStore.hpp>
 #include <Core/Types.hpp>
 #include <Core/Utils/IndexedObject.hpp>
 #include <Core/Utils/Observable.hpp>
@@ -16,9 +16,17 @@ namespace Engine {
 namespace Scene {
 
 class Component;
+class EntityManager;
 class System;
 
-/// An entity is an scene element. It ties together components with a transform.
+/**
+ * An entity is an scene element. It ties together components with a transform.
+ *
+ * Entities form a hierarchy: the transform set by setTransform() is relative to the parent
+ * entity, and getTransform() returns the world transform computed by EntityManager::swapBuffers().
+ * Transforms are stored in the TransformStore of the EntityManager, and can be read without
+ * locks while the transforms of the next frame are set.
+ */
 class RA_ENGINE_API Entity : public Core::Utils::IndexedObject
 {
   public:
@@ -36,13 +44,27 @@ class RA_ENGINE_API Entity : public Core::Utils::IndexedObject
     inline void rename( const std::string& name );
 
     // Transform
+    /// Sets the transform relative to the parent entity, applied at the end of the frame.
     inline void setTransform( const Core::Transform& transform );
     inline void setTransform( const Core::Matrix4& transform );
-    const Core::Transform& getTransform() const;
-    const Core::Matrix4& getTransformAsMatrix() const;
-
+    /// \returns the world transform, as computed at the end of the last frame.
+    inline const Core::Transform& getTransform() const;
+    inline const Core::Matrix4& getTransformAsMatrix() const;
+    /// \returns the transform relative to the parent entity, as set by the last setTransform().
+    inline const Core::Transform& getLocalTransform() const;
+    /// \returns true if the world transform was modified at the end of the last frame.
+    inline bool hasTransformChanged() const;
+
+    /// Applies the pending transforms of all the entities, see EntityManager::swapBuffers().
     void swapTransformBuffers();
 
+    // Hierarchy
+    /// Sets the parent entity, or makes this entity a root if \p parent is nullptr.
+    /// The transform relative to the parent is kept.
+    void setParent( Entity* parent );
+    inline Entity* getParent() const;
+    inline const std::vector<Entity*>& getChildren() const;
+
     /// get a ref to transformation observers to add/remove an observer
     inline Core::Utils::Observable<const Entity*>& transformationObservers() const;
 
@@ -69,14 +91,22 @@ class RA_ENGINE_API Entity : public Core::Utils::IndexedObject
     void invalidateAabb();
 
   private:
-    Core::Transform m_transform;
-    Core::Transform m_doubleBufferedTransform;
-    mutable std::mutex m_transformMutex;
+    friend class EntityManager;
+
+    /// Invalidates the aabbs of the entity, its components and their render objects, after a
+    /// change of the world transform.
+    void invalidateWorldAabbs();
+
+    /// Transform storage, set by the EntityManager.
+    Core::TransformStore* m_transforms { nullptr };
+    Core::TransformStore::Slot m_transformSlot { -1 };
+
+    Entity* m_parent { nullptr };
+    std::vector<Entity*> m_children;
 
     std::vector<std::unique_ptr<Component>> m_components;
 
     std::string m_name {};
-    bool m_transformChanged { false };
 
     bool m_isAabbValid { false };
     Core::Aabb m_aabb;
@@ -96,8 +126,8 @@ inline void Entity::rename( const std::string& name ) {
 }
 
 inline void Entity::setTransform( const Core::Transform& transform ) {
-    m_transformChanged        = true;
-    m_doubleBufferedTransform = transform;
+    CORE_ASSERT( m_transforms, "Entity not added to the EntityManager." );
+    m_transforms->setLocal( m_transformSlot, transform );
 }
 
 inline void Entity::setTransform( const Core::Matrix4& transform ) {
@@ -105,15 +135,30 @@ inline void Entity::setTransform( const Core::Matrix4& transform ) {
 }
 
 inline const Core::Transform& Entity::getTransform() const {
-    // Radium-V2 : why a mutex on read ? there is no lock on write on this!
-    std::lock_guard<std::mutex> lock( m_transformMutex );
-    return m_transform;
+    CORE_ASSERT( m_transforms, "Entity not added to the EntityManager." );
+    return m_transforms->getWorld( m_transformSlot );
 }
 
 inline const Core::Matrix4& Entity::getTransformAsMatrix() const {
-    // Radium-V2 : why a mutex on read ? there is no lock on write on this!
-    std::lock_guard<std::mutex> lock( m_transformMutex );
-    return m_transform.matrix();
+    return getTransform().matrix();
+}
+
+inline const Core::Transform& Entity::getLocalTransform() const {
+    CORE_ASSERT( m_transforms, "Entity not added to the EntityManager." );
+    return m_transforms->getLocal( m_transformSlot );
+}
+
+inline bool Entity::hasTransformChanged() const {
+    CORE_ASSERT( m_transforms, "Entity not added to the EntityManager." );
+    return m_transforms->hasChanged( m_transformSlot );
+}
+
+inline Entity* Entity::getParent() const {
+    return m_parent;
+}
+
+inline const std::vector<Entity*>& Entity::getChildren() const {
+    return m_children;
 }
 
 inline uint Entity::getNumComponents() const {
@@ -16,6 +16,7 @@ EntityManager::EntityManager() {
     auto idx  = m_entities.emplace( SystemEntity::createInstance() );
     auto& ent = m_entities[idx];
     ent->setIndex( idx );
+    addTransform( ent.get() );
     CORE_ASSERT( ent.get() == SystemEntity::getInstance(), "Invalid singleton instanciation" );
     m_entitiesName.insert( { ent->getName(), ent->getIndex() } );
     RadiumEngine::getInstance()->getSignalManager()->fireEntityCreated(
@@ -32,6 +33,7 @@ Entity* EntityManager::createEntity( const std::string& name ) {
     auto idx  = m_entities.emplace( new Entity( name ) );
     auto& ent = m_entities[idx];
     ent->setIndex( idx );
+    addTransform( ent.get() );
 
     std::string entityName = name;
     if ( name.empty() ) {
@@ -64,6 +66,7 @@ void EntityManager::removeEntity( Core::Utils::Index idx ) {
 
     auto& ent        = m_entities[idx];
     std::string name = ent->getName();
+    m_transformOwners[ent->m_transformSlot] = nullptr;
     m_entities.remove( idx );
     m_entitiesName.erase( name );
 }
@@ -102,9 +105,25 @@ Entity* EntityManager::getEntity( const std::string& name ) const {
 }
 
 void EntityManager::swapBuffers() {
-    for ( auto& e : m_entities ) {
-        e->swapTransformBuffers();
+    m_transforms.update( [this]( Core::TransformStore::Slot slot ) {
+        m_transformOwners[slot]->invalidateWorldAabbs();
+    } );
+    for ( size_t slot = 0; slot < m_transformOwners.size(); ++slot ) {
+        Entity* e = m_transformOwners[slot];
+        if ( e && m_transforms.hasChanged( Core::TransformStore::Slot( slot ) ) ) {
+            e->m_transformationObservers.notify( e );
+        }
+    }
+}
+
+void EntityManager::addTransform( Entity* entity ) {
+    const auto slot = m_transforms.add();
+    if ( size_t( slot ) >= m_transformOwners.size() ) {
+        m_transformOwners.resize( size_t( slot ) + 1, nullptr );
     }
+    m_transformOwners[slot] = entity;
+    entity->m_transforms    = &m_transforms;
+    entity->m_transformSlot = slot;
 }
 
 void EntityManager::deleteEntities() {
@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 
+#include <Core/Containers/TransformStore.hpp>
 #include <Core/Utils/IndexMap.hpp>
 #include <Core/Utils/Singleton.hpp>
 
@@ -71,8 +72,17 @@ class RA_ENGINE_API EntityManager
      */
     std::vector<Entity*> getEntities() const;
 
+    /**
+     * @brief Applies the transforms set during the frame.
+     * World transforms of the moved entities and of their descendants are updated in parallel,
+     * level by level of the hierarchy, together with the invalidation of their aabbs. The
+     * transformation observers of the moved entities are then notified.
+     */
     void swapBuffers();
 
+    /// @brief Get the transforms of all the entities.
+    inline const Core::TransformStore& getTransformStore() const;
+
     /**
      * @brief Get an entity given its name.
      * @param name Name of the entity to retrieve.
@@ -86,10 +96,22 @@ class RA_ENGINE_API EntityManager
     void deleteEntities();
 
   private:
+    /// Allocates the transform of a new entity.
+    void addTransform( Entity* entity );
+
+    // Declared before m_entities, as entities release their transform on deletion.
+    Core::TransformStore m_transforms;
+    /// Entity owning each slot of m_transforms.
+    std::vector<Entity*> m_transformOwners;
+
     Core::Utils::IndexMap<std::unique_ptr<Entity>> m_entities;
     std::map<std::string, Core::Utils::Index> m_entitiesName;
 };
 
+inline const Core::TransformStore& EntityManager::getTransformStore() const {
+    return m_transforms;
+}
+
 } // namespace Scene
 } // namespace Engine
 } // namespace Ra
@@ -47,7 +47,22 @@ PointCloudComponent::PointCloudComponent( const std::string& name,
                                           Entity* entity,
                                           const Ra::Core::Asset::GeometryData* data ) :
     GeometryComponent( name, entity ), m_displayMesh( nullptr ) {
-    generatePointCloud( data );
+    Ra::Core::Geometry::PointCloud mesh;
+    // add custom attribs
+    mesh.vertexAttribs().copyAllAttributes( data->getGeometry().vertexAttribs() );
+    generatePointCloud( data, std::move( mesh ) );
+}
+
+PointCloudComponent::PointCloudComponent( const std::string& name,
+                                          Entity* entity,
+                                          Ra::Core::Asset::GeometryData&& data ) :
+    GeometryComponent( name, entity ), m_displayMesh( nullptr ) {
+    auto& geo = data.getGeometry();
+    Ra::Core::Geometry::PointCloud mesh;
+    static_cast<Ra::Core::Geometry::AttribArrayGeometry&>( mesh ) =
+        std::move( static_cast<Ra::Core::Geometry::AttribArrayGeometry&>( geo ) );
+    geo.clear();
+    generatePointCloud( &data, std::move( mesh ) );
 }
 
 PointCloudComponent::PointCloudComponent( const std::string& name,
@@ -66,16 +81,12 @@ PointCloudComponent::~PointCloudComponent() = default;
 
 void PointCloudComponent::initialize() {}
 
-void PointCloudComponent::generatePointCloud( const Ra::Core::Asset::GeometryData* data ) {
+void PointCloudComponent::generatePointCloud( const Ra::Core::Asset::GeometryData* data,
+                                              Ra::Core::Geometry::PointCloud&& mesh ) {
     m_contentName = data->getName();
     m_displayMesh = Ra::Core::make_shared<Data::PointCloud>( m_contentName );
     m_displayMesh->setRenderMode( Data::AttribArrayDisplayable::RM_POINTS );
 
-    Ra::Core::Geometry::PointCloud mesh;
-
-    // add custom attribs
-    mesh.vertexAttribs().copyAllAttributes( data->getGeometry().vertexAttribs() );
-
     m_displayMesh->loadGeometry( std::move( mesh ) );
 
     finalizeROFromGeometry( data->hasMaterial() ? &( data->getMaterial() ) : nullptr,
@@ -69,6 +69,15 @@ class SurfaceMeshComponent : public GeometryComponent
     inline SurfaceMeshComponent( const std::string& name,
                                  Entity* entity,
                                  const Ra::Core::Asset::GeometryData* data );
+
+    /*!
+     * Constructor from loaded data, without copy of the geometry
+     * \warning Moves the geometry of \p data, which is left empty (its name, frame and material
+     * are kept)
+     */
+    inline SurfaceMeshComponent( const std::string& name,
+                                 Entity* entity,
+                                 Ra::Core::Asset::GeometryData&& data );
     inline SurfaceMeshComponent( const std::string& name,
                                  Entity* entity,
                                  std::shared_ptr<RenderMeshType> data );
@@ -93,7 +102,7 @@ class SurfaceMeshComponent : public GeometryComponent
     inline void setDeformable( bool b );
 
   private:
-    inline void generateMesh( const Ra::Core::Asset::GeometryData* data );
+    inline void generateMesh( const Ra::Core::Asset::GeometryData* data, CoreMeshType&& mesh );
 
     inline void finalizeROFromGeometry( const Core::Asset::MaterialData* data,
                                         Core::Transform transform );
@@ -123,6 +132,15 @@ class RA_ENGINE_API PointCloudComponent : public GeometryComponent
                          Entity* entity,
                          const Ra::Core::Asset::GeometryData* data );
 
+    /*!
+     * Constructor from loaded data, without copy of the geometry
+     * \warning Moves the geometry of \p data, which is left empty (its name, frame and material
+     * are kept)
+     */
+    PointCloudComponent( const std::string& name,
+                         Entity* entity,
+                         Ra::Core::Asset::GeometryData&& data );
+
     /*!
      * Constructor from an existing mesh
      * \warning Moves the mesh and takes its ownership
@@ -152,7 +170,8 @@ class RA_ENGINE_API PointCloudComponent : public GeometryComponent
     void setDeformable( bool b );
 
   private:
-    void generatePointCloud( const Ra::Core::Asset::GeometryData* data );
+    void generatePointCloud( const Ra::Core::Asset::GeometryData* data,
+                             Core::Geometry::PointCloud&& mesh );
 
     void finalizeROFromGeometry( const Core::Asset::MaterialData* data, Core::Transform transform );
 
@@ -214,7 +233,15 @@ SurfaceMeshComponent<CoreMeshType>::SurfaceMeshComponent(
     Entity* entity,
     const Ra::Core::Asset::GeometryData* data ) :
     GeometryComponent( name, entity ), m_displayMesh( nullptr ) {
-    generateMesh( data );
+    generateMesh( data, Data::createCoreMeshFromGeometryData<CoreMeshType>( data ) );
+}
+
+template <typename CoreMeshType>
+SurfaceMeshComponent<CoreMeshType>::SurfaceMeshComponent( const std::string& name,
+                                                          Entity* entity,
+                                                          Ra::Core::Asset::GeometryData&& data ) :
+    GeometryComponent( name, entity ), m_displayMesh( nullptr ) {
+    generateMesh( &data, Data::moveCoreMeshFromGeometryData<CoreMeshType>( &data ) );
 }
 
 template <typename CoreMeshType>
@@ -237,10 +264,10 @@ SurfaceMeshComponent<CoreMeshType>::SurfaceMeshComponent( const std::string& nam
 }
 
 template <typename CoreMeshType>
-void SurfaceMeshComponent<CoreMeshType>::generateMesh( const Ra::Core::Asset::GeometryData* data ) {
-    m_contentName     = data->getName();
-    m_displayMesh     = Ra::Core::make_shared<RenderMeshType>( m_contentName );
-    CoreMeshType mesh = Data::createCoreMeshFromGeometryData<CoreMeshType>( data );
+void SurfaceMeshComponent<CoreMeshType>::generateMesh( const Ra::Core::Asset::GeometryData* data,
+                                                       CoreMeshType&& mesh ) {
+    m_contentName = data->getName();
+    m_displayMesh = Ra::Core::make_shared<RenderMeshType>( m_contentName );
 
     m_displayMesh->loadGeometry( std::move( mesh ) );
 
@@ -14,6 +14,18 @@ namespace Ra {
 namespace Engine {
 namespace Scene {
 
+namespace {
+/// Create a ComponentType from \p data, moving its geometry if \p consume is true.
+template <typename ComponentType>
+Component* createGeometryComponent( const std::string& name,
+                                    Entity* entity,
+                                    Ra::Core::Asset::GeometryData* data,
+                                    bool consume ) {
+    if ( consume ) { return new ComponentType( name, entity, std::move( *data ) ); }
+    return new ComponentType( name, entity, data );
+}
+} // namespace
+
 GeometrySystem::GeometrySystem() : System() {}
 
 void GeometrySystem::handleAssetLoading( Entity* entity,
@@ -27,19 +39,23 @@ void GeometrySystem::handleAssetLoading( Entity* entity,
         std::string componentName = "GEOM_" + entity->getName() + std::to_string( id++ );
         switch ( data->getType() ) {
         case Ra::Core::Asset::GeometryData::POINT_CLOUD:
-            comp = new PointCloudComponent( componentName, entity, data );
+            comp = createGeometryComponent<PointCloudComponent>(
+                componentName, entity, data, m_consumeGeometryData );
             break;
         case Ra::Core::Asset::GeometryData::LINE_MESH:
             //            comp = new LineMeshComponent( componentName, entity, data );
             //            break;
         case Ra::Core::Asset::GeometryData::TRI_MESH:
-            comp = new TriangleMeshComponent( componentName, entity, data );
+            comp = createGeometryComponent<TriangleMeshComponent>(
+                componentName, entity, data, m_consumeGeometryData );
             break;
         case Ra::Core::Asset::GeometryData::QUAD_MESH:
-            comp = new QuadMeshComponent( componentName, entity, data );
+            comp = createGeometryComponent<QuadMeshComponent>(
+                componentName, entity, data, m_consumeGeometryData );
             break;
         case Ra::Core::Asset::GeometryData::POLY_MESH:
-            comp = new PolyMeshComponent( componentName, entity, data );
+            comp = createGeometryComponent<PolyMeshComponent>(
+                componentName, entity, data, m_consumeGeometryData );
             break;
         case Ra::Core::Asset::GeometryData::TETRA_MESH:
         case Ra::Core::Asset::GeometryData::HEX_MESH:
@@ -15,6 +15,22 @@ class RA_ENGINE_API GeometrySystem : public System
     void handleAssetLoading( Entity* entity, const Ra::Core::Asset::FileData* fileData ) override;
 
     void generateTasks( Ra::Core::TaskQueue* taskQueue, const FrameInfo& frameInfo ) override;
+
+    /// No task is generated.
+    bool hasPersistentTasks() const override { return true; }
+
+    /// Move the geometries of the loaded files into the components instead of copying them, so
+    /// that each mesh is held once in memory during loading.
+    /// \warning The geometries of the loaded FileData are then emptied: the systems handling the
+    /// files after this one, and RadiumEngine::getFileData(), only get their names, frames and
+    /// materials.
+    inline void setConsumeGeometryData( bool consume ) { m_consumeGeometryData = consume; }
+
+    /// Return true if the geometries of the loaded files are moved into the components.
+    inline bool isConsumingGeometryData() const { return m_consumeGeometryData; }
+
+  private:
+    bool m_consumeGeometryData { false };
 };
 
 } // namespace Scene
@@ -32,6 +32,10 @@ SignalManager::FrameObservable& SignalManager::getEndFrameNotifier() {
     return m_frameEndCallbacks;
 }
 
+SignalManager::FileObservable& SignalManager::getFileLoadingNotifier() {
+    return m_fileLoadingCallbacks;
+}
+
 void SignalManager::fireEntityCreated( const ItemEntry& entity ) const {
     CORE_ASSERT( entity.isEntityNode(), "Invalid entry" );
     notify<const ItemEntry&>( m_entityCreatedCallbacks, entity );
@@ -65,6 +69,11 @@ void SignalManager::fireFrameEnded() const {
     notify<>( m_frameEndCallbacks );
 }
 
+void SignalManager::fireFileLoadingStep( const std::string& filename,
+                                         FileLoadingStep step ) const {
+    notify<const std::string&, FileLoadingStep>( m_fileLoadingCallbacks, filename, step );
+}
+
 } // namespace Scene
 } // namespace Engine
 } // namespace Ra
@@ -3,6 +3,7 @@
 #include <Engine/RaEngine.hpp>
 
 #include <mutex>
+#include <string>
 
 #include <Core/Utils/Observable.hpp>
 
@@ -25,11 +26,22 @@ namespace Scene {
  * owning them and destroyed
  *
  * Signals of end of frame send no parameters.
+ *
+ * Signals on files loaded with RadiumEngine::loadFileAsync send the name of the file and the
+ * FileLoadingStep it reached.
  **/
 class RA_ENGINE_API SignalManager
 {
 
   public:
+    /// Steps of the asynchronous loading of a file, \see RadiumEngine::loadFileAsync
+    enum class FileLoadingStep {
+        Started, ///< The file is being parsed on a worker thread
+        Parsed,  ///< The file is parsed and waits to be added to the scene
+        Loaded,  ///< The content of the file is added to the scene
+        Failed   ///< No loader could parse the file
+    };
+
     /// Notifies all observers of an entity creation
     void fireEntityCreated( const ItemEntry& entity ) const;
     /// Notifies all observers of an entity removal
@@ -47,6 +59,8 @@ class RA_ENGINE_API SignalManager
 
     /// Notifies all observers of a end of frame event
     void fireFrameEnded() const;
+    /// Notifies all observers of a step of the asynchronous loading of a file
+    void fireFileLoadingStep( const std::string& filename, FileLoadingStep step ) const;
 
     /// Enable/disable the notification of observers
     void setOn( bool on ) { m_isOn = on; }
@@ -55,6 +69,8 @@ class RA_ENGINE_API SignalManager
     using ItemObservable = Ra::Core::Utils::Observable<const ItemEntry&>;
     /// Type for frame observable
     using FrameObservable = Ra::Core::Utils::Observable<>;
+    /// Type for file loading observable
+    using FileObservable = Ra::Core::Utils::Observable<const std::string&, FileLoadingStep>;
 
     /// Access to the observable members
     ///@{
@@ -65,6 +81,7 @@ class RA_ENGINE_API SignalManager
     ItemObservable& getRenderObjectCreatedNotifier();
     ItemObservable& getRenderObjectDestroyedNotifier();
     FrameObservable& getEndFrameNotifier();
+    FileObservable& getFileLoadingNotifier();
     ///@}
 
   private:
@@ -89,6 +106,9 @@ class RA_ENGINE_API SignalManager
     FrameObservable m_frameEndCallbacks;
     ///@}
 
+    /// File loading observable
+    FileObservable m_fileLoadingCallbacks;
+
     /// Helper function to notify observers
     template <typename... TArgs>
     void notify( const Ra::Core::Utils::Observable<TArgs...>& o, TArgs... args ) const {
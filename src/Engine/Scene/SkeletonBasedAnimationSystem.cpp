@@ -46,24 +46,32 @@ SkeletonBasedAnimationSystem::~SkeletonBasedAnimationSystem() {
 
 void SkeletonBasedAnimationSystem::generateTasks( Core::TaskQueue* taskQueue,
                                                   const FrameInfo& frameInfo ) {
+    // Tasks are persistent : frameInfo is read when they are run.
+    // Check once per frame if the animation time changed, before any animator task.
+    auto timeFunc = [this, &frameInfo]() {
+        m_timeChanged = !Core::Math::areApproxEqual( m_time, frameInfo.m_animationTime );
+        m_time        = frameInfo.m_animationTime;
+    };
+    auto timeTaskId = taskQueue->registerTask(
+        std::make_unique<Core::FunctionTask>( timeFunc, "AnimatorTimeTask" ) );
+
     for ( auto compEntry : m_components ) {
         // deal with AnimationComponents
         if ( auto animComp = dynamic_cast<SkeletonComponent*>( compEntry.second ) ) {
-            if ( !Core::Math::areApproxEqual( m_time, frameInfo.m_animationTime ) ) {
-                // here we update the skeleton w.r.t. the animation
-                auto animFunc =
-                    std::bind( &SkeletonComponent::update, animComp, frameInfo.m_animationTime );
-                auto animTask = std::make_unique<Core::FunctionTask>(
-                    animFunc, "AnimatorTask_" + animComp->getSkeleton()->getName() );
-                taskQueue->registerTask( std::move( animTask ) );
-            }
-            else {
-                // here we update the skeleton w.r.t. the manipulation
-                auto animFunc = std::bind( &SkeletonComponent::updateDisplay, animComp );
-                auto animTask = std::make_unique<Core::FunctionTask>(
-                    animFunc, "AnimatorTask_" + animComp->getSkeleton()->getName() );
-                taskQueue->registerTask( std::move( animTask ) );
-            }
+            auto animFunc = [this, animComp, &frameInfo]() {
+                if ( m_timeChanged ) {
+                    // here we update the skeleton w.r.t. the animation
+                    animComp->update( frameInfo.m_animationTime );
+                }
+                else {
+                    // here we update the skeleton w.r.t. the manipulation
+                    animComp->updateDisplay();
+                }
+            };
+            auto animTask = std::make_unique<Core::FunctionTask>(
+                animFunc, "AnimatorTask_" + animComp->getSkeleton()->getName() );
+            auto animTaskId = taskQueue->registerTask( std::move( animTask ) );
+            taskQueue->addDependency( timeTaskId, animTaskId );
         }
         // deal with SkinningComponents
         else if ( auto skinComp = dynamic_cast<SkinningComponent*>( compEntry.second ) ) {
@@ -81,8 +89,6 @@ void SkeletonBasedAnimationSystem::generateTasks( Core::TaskQueue* taskQueue,
             taskQueue->addDependency( skinTaskId, endTaskId );
         }
     }
-
-    m_time = frameInfo.m_animationTime;
 }
 
 void SkeletonBasedAnimationSystem::handleAssetLoading( Entity* entity,
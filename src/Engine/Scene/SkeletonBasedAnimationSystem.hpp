@@ -28,6 +28,9 @@ class RA_ENGINE_API SkeletonBasedAnimationSystem : public System
     /// Creates a task for each AnimationComponent to update skeleton display.
     void generateTasks( Core::TaskQueue* taskQueue, const FrameInfo& frameInfo ) override;
 
+    /// Tasks read the animation time from the frame info when run.
+    bool hasPersistentTasks() const override { return true; }
+
     /// Loads Skeletons and Animations from a file data into the givn Entity.
     void handleAssetLoading( Entity* entity, const Core::Asset::FileData* fileData ) override;
     /// \}
@@ -54,6 +57,9 @@ class RA_ENGINE_API SkeletonBasedAnimationSystem : public System
 
     /// The current animation time.
     Scalar m_time { 0_ra };
+
+    /// True if the animation time changed since the previous frame.
+    bool m_timeChanged { true };
 };
 
 } // namespace Scene
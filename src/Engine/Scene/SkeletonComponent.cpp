@@ -167,9 +167,8 @@ void SkeletonComponent::update( Scalar t ) {
     Scalar lastTime = 0;
     if ( !m_animations.empty() ) {
         // m_animationID is always < m_animation.size() unless m_animations.empty()
-        for ( const auto& boneAnim : m_animations[m_animationID] ) {
-            lastTime = std::max( lastTime, *boneAnim.getTimes().rbegin() );
-        }
+        bakeCurrentAnimation();
+        lastTime = std::max( lastTime, m_clip.getEndTime() );
     }
     if ( m_autoRepeat ) {
         if ( !m_pingPong ) { m_animationTime = std::fmod( m_animationTime, lastTime ); }
@@ -185,19 +184,29 @@ void SkeletonComponent::update( Scalar t ) {
 
     // get the current pose from the animation
     Core::Animation::Pose pose = m_skel.getPose( SpaceType::LOCAL );
-    if ( !m_animations.empty() ) {
-#pragma omp parallel for
-        for ( int i = 0; i < int( m_animations[m_animationID].size() ); ++i ) {
-            pose[uint( i )] = m_animations[m_animationID][uint( i )].at(
-                m_animationTime, Core::Animation::linearInterpolate<Core::Transform> );
-        }
-    }
+    if ( !m_animations.empty() ) { m_clip.sample( m_animationTime, m_clipCursor, pose ); }
     else { pose = m_refPose; }
     m_skel.setPose( pose, SpaceType::LOCAL );
 
     updateDisplay();
 }
 
+void SkeletonComponent::bakeCurrentAnimation() {
+    // the keyframes may be edited at any time, e.g. from the timeline.
+    const auto& animation = m_animations[m_animationID];
+    bool upToDate         = m_clipStamps.size() == animation.size();
+    for ( size_t i = 0; upToDate && i < animation.size(); ++i ) {
+        upToDate = m_clipStamps[i] == animation[i].getStamp();
+    }
+    if ( upToDate ) { return; }
+
+    m_clip.bake( animation );
+    m_clipStamps.resize( animation.size() );
+    for ( size_t i = 0; i < animation.size(); ++i ) {
+        m_clipStamps[i] = animation[i].getStamp();
+    }
+}
+
 Scalar SkeletonComponent::getAnimationTime() const {
     return m_animationTime;
 }
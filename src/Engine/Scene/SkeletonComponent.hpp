@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Core/Animation/AnimationClip.hpp>
 #include <Core/Animation/HandleWeight.hpp>
 #include <Core/Animation/KeyFramedValue.hpp>
 #include <Core/Animation/Skeleton.hpp>
@@ -199,6 +200,9 @@ class RA_ENGINE_API SkeletonComponent : public Component
     /// \}
 
   private:
+    /// Bakes the current animation into m_clip if its keyframes have changed.
+    void bakeCurrentAnimation();
+
     /// Entity name for CC.
     std::string m_skelName;
 
@@ -214,6 +218,15 @@ class RA_ENGINE_API SkeletonComponent : public Component
     /// Current animation ID.
     size_t m_animationID { 0 };
 
+    /// The current animation baked for playback.
+    Core::Animation::AnimationClip m_clip;
+
+    /// Stamps of the keyframes m_clip was baked from.
+    std::vector<size_t> m_clipStamps;
+
+    /// Playback cursor of m_clip.
+    Core::Animation::AnimationClip::Cursor m_clipCursor;
+
     /// Current animation time (might be different from the app time -- see below).
     Scalar m_animationTime { 0_ra };
 
@@ -7,6 +7,7 @@
 #include <Core/Animation/LinearBlendSkinning.hpp>
 #include <Core/Animation/RotationCenterSkinning.hpp>
 #include <Core/Geometry/DistanceQueries.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/Utils/Color.hpp>
 #include <Core/Utils/Log.hpp>
 
@@ -245,12 +246,11 @@ void SkinningComponent::skin() {
             m_topoMesh.updatePositions( m_frameData.m_currentPosition );
             m_topoMesh.updateWedgeNormals();
             m_topoMesh.updateTriangleMeshNormals( m_frameData.m_currentNormal );
-#pragma omp parallel for
-            for ( int i = 0; i < int( m_frameData.m_currentNormal.size() ); ++i ) {
+            Core::parallelFor( 0, int( m_frameData.m_currentNormal.size() ), [this]( int i ) {
                 Core::Math::getOrthogonalVectors( m_frameData.m_currentNormal[i],
                                                   m_frameData.m_currentTangent[i],
                                                   m_frameData.m_currentBitangent[i] );
-            }
+            } );
         }
     }
 }
@@ -329,6 +329,7 @@ void SkinningComponent::createWeightMatrix() {
     if ( normalizeWeights( m_refData.m_weights, true ) ) {
         LOG( logINFO ) << "Skinning weights have been normalized";
     }
+    m_refData.m_packedWeights = packWeights( m_refData.m_weights );
 }
 
 void SkinningComponent::setupIO( const std::string& id ) {
@@ -15,6 +15,7 @@ class FileData;
 
 namespace Engine {
 struct FrameInfo;
+class RadiumEngine;
 
 namespace Scene {
 
@@ -26,10 +27,13 @@ class Entity;
  * list of "active" components associated to an entity.
  * At each frame, each system loaded into the engine will be queried for tasks.
  * The goal of the tasks is to update the active components during the frame.
+ * Systems with persistent tasks (see hasPersistentTasks()) are only queried when their tasks need
+ * to be updated, i.e. when components are added or removed.
  */
 class RA_ENGINE_API System
 {
     friend class Component;
+    friend class Ra::Engine::RadiumEngine;
 
   public:
     System()          = default;
@@ -58,6 +62,23 @@ class RA_ENGINE_API System
     virtual void generateTasks( Core::TaskQueue* taskQueue,
                                 const Engine::FrameInfo& frameInfo ) = 0;
 
+    /**
+     * Tells if the tasks generated by generateTasks() can be run again at each frame.
+     * In this case, the tasks are generated once and are kept in the task queue until
+     * invalidateTasks() is called (this is done when a component is registered or unregistered).
+     * Persistent tasks must not capture per-frame values : they must read them at each run, e.g.
+     * through the frameInfo reference given to generateTasks(), which stays valid and is updated
+     * at each frame.
+     * Default to false : tasks are generated at each frame.
+     */
+    virtual bool hasPersistentTasks() const { return false; }
+
+    /// Requests the persistent tasks to be generated again before the next frame.
+    void invalidateTasks() { m_tasksNeedUpdate = true; }
+
+    /// Returns true if the persistent tasks must be generated again.
+    bool tasksNeedUpdate() const { return m_tasksNeedUpdate; }
+
     /** Returns the components stored for the given entity.
      *
      * @param entity
@@ -101,6 +122,10 @@ class RA_ENGINE_API System
   protected:
     /// List of active components.
     std::vector<std::pair<const Entity*, Component*>> m_components;
+
+  private:
+    /// True if persistent tasks have to be generated again.
+    bool m_tasksNeedUpdate { true };
 };
 
 } // namespace Scene
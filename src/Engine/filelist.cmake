@@ -12,6 +12,7 @@ set(engine_sources
     Data/Material.cpp
     Data/MaterialConverters.cpp
     Data/Mesh.cpp
+    Data/MultiDrawMesh.cpp
     Data/PlainMaterial.cpp
     Data/RawShaderMaterial.cpp
     Data/RenderParameters.cpp
@@ -22,6 +23,7 @@ set(engine_sources
     Data/SimpleMaterial.cpp
     Data/Texture.cpp
     Data/TextureManager.cpp
+    Data/UniformCache.cpp
     Data/VolumeObject.cpp
     Data/VolumetricMaterial.cpp
     Data/stb.cpp
@@ -65,6 +67,7 @@ set(engine_headers
     Data/Material.hpp
     Data/MaterialConverters.hpp
     Data/Mesh.hpp
+    Data/MultiDrawMesh.hpp
     Data/PlainMaterial.hpp
     Data/RawShaderMaterial.hpp
     Data/RenderParameters.hpp
@@ -75,6 +78,7 @@ set(engine_headers
     Data/SimpleMaterial.hpp
     Data/Texture.hpp
     Data/TextureManager.hpp
+    Data/UniformCache.hpp
     Data/ViewingParameters.hpp
     Data/VolumeObject.hpp
     Data/VolumetricMaterial.hpp
@@ -87,6 +91,7 @@ set(engine_headers
     Rendering/RenderObject.hpp
     Rendering/RenderObjectManager.hpp
     Rendering/RenderObjectTypes.hpp
+    Rendering/RenderSortKey.hpp
     Rendering/RenderTechnique.hpp
     Rendering/Renderer.hpp
     Scene/CameraComponent.hpp
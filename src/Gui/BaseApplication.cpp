@@ -5,6 +5,7 @@
 
 #include <Core/CoreMacros.hpp>
 #include <Core/Resources/Resources.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/Tasks/Task.hpp>
 #include <Core/Tasks/TaskQueue.hpp>
 #include <Core/Types.hpp>
@@ -104,6 +105,13 @@ BaseApplication::BaseApplication( int& argc,
         "Control the maximum number of threads. 0 will set to the number of cores available",
         "number",
         "0" );
+    QCommandLineOption workStealingOpt(
+        QStringList { "w", "workstealing", "work-stealing" },
+        "Dispatch the engine tasks with per-thread work-stealing queues instead of a shared one." );
+    QCommandLineOption pipelinedOpt(
+        QStringList { "pipelined" },
+        "Run the engine tasks of the next frame while rendering the current one, at the cost of "
+        "one frame of latency." );
     QCommandLineOption numFramesOpt(
         QStringList { "n", "numframes" }, "Run for a fixed number of frames.", "number", "0" );
     QCommandLineOption pluginOpt( QStringList { "p", "plugins", "pluginsPath" },
@@ -144,6 +152,8 @@ BaseApplication::BaseApplication( int& argc,
                          fileOpt,
                          camOpt,
                          maxThreadsOpt,
+                         workStealingOpt,
+                         pipelinedOpt,
                          numFramesOpt,
                          recordOpt,
                          datapathOpt } );
@@ -168,6 +178,8 @@ BaseApplication::BaseApplication( int& argc,
     if ( parser.isSet( pluginOpt ) ) m_pluginPath = parser.value( pluginOpt ).toStdString();
     if ( parser.isSet( numFramesOpt ) ) m_numFrames = parser.value( numFramesOpt ).toUInt();
     if ( parser.isSet( maxThreadsOpt ) ) m_maxThreads = parser.value( maxThreadsOpt ).toUInt();
+    if ( parser.isSet( workStealingOpt ) ) m_workStealing = true;
+    if ( parser.isSet( pipelinedOpt ) ) m_pipelinedFrames = true;
     if ( parser.isSet( recordOpt ) ) {
         m_recordFrames = true;
         setContinuousUpdate( true );
@@ -342,7 +354,12 @@ void BaseApplication::initialize( const WindowFactory& factory,
     // unless monothread CPU
     uint numThreads =
         std::max( m_maxThreads == 0 ? RA_MAX_THREAD : std::min( m_maxThreads, RA_MAX_THREAD ), 1u );
-    m_taskQueue = std::make_unique<Core::TaskQueue>( numThreads );
+    m_taskQueue = std::make_unique<Core::TaskQueue>(
+        numThreads,
+        m_workStealing ? Core::TaskQueue::SchedulingPolicy::WorkStealing
+                       : Core::TaskQueue::SchedulingPolicy::SharedQueue );
+    // parallel loops (see Core/Tasks/ParallelFor.hpp) share the task queue threads
+    Core::setParallelTaskQueue( m_taskQueue.get() );
 
     setupScene();
     emit starting();
@@ -482,44 +499,41 @@ void BaseApplication::radiumFrame() {
     // Get picking results from last frame and forward it to the selection.
     m_viewer->processPicking();
 
-    timerData.tasksStart = Core::Utils::Clock::now();
-
-    // ----------
-    // 2. Run the engine task queue.
-    m_engine->getTasks( m_taskQueue.get(), dt );
-
-    if ( m_recordGraph ) { m_taskQueue->printTaskGraph( std::cout ); }
-
-    // Run one frame of tasks
-    m_taskQueue->startTasks();
-    m_taskQueue->waitForTasks();
-    timerData.taskData = m_taskQueue->getTimerData();
-    m_taskQueue->flushTaskQueue();
-
-    timerData.tasksEnd = Core::Utils::Clock::now();
+    if ( m_pipelinedFrames ) { pipelinedTasksAndRendering( dt, timerData ); }
+    else {
+        // ----------
+        // 2. Run the engine task queue, unless the tasks of this frame already ran while
+        // rendering the previous one, when leaving the pipelined mode.
+        if ( !m_pipelinedTasksDone ) {
+            timerData.tasksStart = Core::Utils::Clock::now();
+            runTasks( dt, timerData );
+        }
+        else { timerData.taskData = m_pipelinedTaskData; }
+        m_pipelinedTasksDone = false;
 
-    // run engine gpu tasks (need active context)
-    ///\todo make rendering one gpu task.
-    m_viewer->makeCurrent();
-    m_engine->runGpuTasks();
-    m_viewer->doneCurrent();
+        // run engine gpu tasks (need active context)
+        ///\todo make rendering one gpu task.
+        m_viewer->makeCurrent();
+        m_engine->runGpuTasks();
+        m_viewer->doneCurrent();
 
-    // also update gizmo manager to deal with annimation playing / reset
-    // m_viewer->getGizmoManager()->updateValues();
+        // also update gizmo manager to deal with annimation playing / reset
+        // m_viewer->getGizmoManager()->updateValues();
 
-    // update viewer internal time-dependant state
-    m_viewer->update( dt );
+        // update viewer internal time-dependant state
+        m_viewer->update( dt );
 
-    // ----------
-    // 3. Kickoff rendering
-    m_viewer->startRendering( dt );
-    m_viewer->swapBuffers();
+        // ----------
+        // 3. Kickoff rendering
+        m_viewer->startRendering( dt );
+        m_viewer->swapBuffers();
 
-    timerData.renderData = m_viewer->getRenderer()->getTimerData();
+        timerData.renderData = m_viewer->getRenderer()->getTimerData();
 
-    // ----------
-    // 4. Synchronize whatever needs synchronisation
-    m_engine->endFrameSync();
+        // ----------
+        // 4. Synchronize whatever needs synchronisation
+        m_engine->endFrameSync();
+    }
 
     // ----------
     // 5. Frame end.
@@ -543,6 +557,58 @@ void BaseApplication::radiumFrame() {
     m_mainWindow->onFrameComplete();
 }
 
+void BaseApplication::runTasks( Scalar dt, FrameTimerData& timerData ) {
+    m_engine->getTasks( m_taskQueue.get(), dt );
+
+    if ( m_recordGraph ) { m_taskQueue->printTaskGraph( std::cout ); }
+
+    // Run one frame of tasks
+    m_taskQueue->startTasks();
+    m_taskQueue->waitForTasks();
+    timerData.taskData = m_taskQueue->getTimerData();
+    m_taskQueue->flushTaskQueue();
+
+    timerData.tasksEnd = Core::Utils::Clock::now();
+}
+
+void BaseApplication::pipelinedTasksAndRendering( Scalar dt, FrameTimerData& timerData ) {
+    // The tasks of this frame ran while rendering the previous one, unless there was none.
+    if ( !m_pipelinedTasksDone ) {
+        timerData.tasksStart = Core::Utils::Clock::now();
+        runTasks( dt, timerData );
+    }
+    else { timerData.taskData = m_pipelinedTaskData; }
+
+    m_viewer->makeCurrent();
+    m_engine->runGpuTasks();
+    m_viewer->doneCurrent();
+    m_viewer->update( dt );
+
+    // Snapshot the state to render: entities transforms are swapped and the modified render
+    // objects are uploaded, so that the tasks of the next frame only write into the CPU side
+    // buffers while rendering.
+    m_engine->endFrameSync();
+    m_viewer->prepareRendering( dt );
+
+    // Run the tasks of the next frame concurrently with the rendering of this one.
+    timerData.tasksStart = Core::Utils::Clock::now();
+    m_engine->getTasks( m_taskQueue.get(), dt );
+    if ( m_recordGraph ) { m_taskQueue->printTaskGraph( std::cout ); }
+    m_taskQueue->startTasks();
+
+    m_viewer->startRendering( dt );
+    m_viewer->swapBuffers();
+    timerData.renderData = m_viewer->getRenderer()->getTimerData();
+
+    // Tasks are never running outside of radiumFrame, so that the scene can be safely edited
+    // between frames.
+    m_taskQueue->waitForTasks();
+    m_pipelinedTaskData = m_taskQueue->getTimerData();
+    m_taskQueue->flushTaskQueue();
+    timerData.tasksEnd  = Core::Utils::Clock::now();
+    m_pipelinedTasksDone = true;
+}
+
 void BaseApplication::appNeedsToQuit() {
     LOG( logDEBUG ) << "About to quit.";
     m_isAboutToQuit = true;
@@ -562,6 +628,11 @@ void BaseApplication::setRealFrameRate( bool on ) {
     m_realFrameRate = on;
 }
 
+void BaseApplication::setPipelinedFrames( bool on ) {
+    // m_pipelinedTasksDone is kept, so that the tasks which already ran are not run again.
+    m_pipelinedFrames = on;
+}
+
 void BaseApplication::setRecordFrames( bool on ) {
     setContinuousUpdate( on );
     if ( on ) askForUpdate();
@@ -580,6 +651,7 @@ BaseApplication::~BaseApplication() {
     m_mainWindow->cleanup();
     m_engine->cleanup();
     Ra::Engine::RadiumEngine::destroyInstance();
+    Core::setParallelTaskQueue( nullptr );
 
     // This will remove the directory if empty.
     QDir().rmdir( m_exportFoldername.c_str() );
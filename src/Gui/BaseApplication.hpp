@@ -187,6 +187,8 @@ class RA_GUI_API BaseApplication : public QApplication
     void appNeedsToQuit();
 
     void setRealFrameRate( bool on );
+    /// If true, the engine tasks of the next frame run while rendering the current one.
+    void setPipelinedFrames( bool on );
     void setRecordFrames( bool on );
     void setRecordTimings( bool on );
     void setRecordGraph( bool on );
@@ -217,6 +219,12 @@ class RA_GUI_API BaseApplication : public QApplication
 
     void setupScene();
 
+    /// Runs the engine tasks of one frame.
+    void runTasks( Scalar dt, FrameTimerData& timerData );
+
+    /// Renders the current frame while running the engine tasks of the next one.
+    void pipelinedTasksAndRendering( Scalar dt, FrameTimerData& timerData );
+
     /// check wheter someone ask for update
     bool isUpdateNeeded() { return m_isUpdateNeeded.load(); }
 
@@ -254,6 +262,14 @@ class RA_GUI_API BaseApplication : public QApplication
     uint m_frameCountBeforeUpdate;
     uint m_numFrames;
     uint m_maxThreads;
+    /// If true, the task queue dispatches tasks with per-thread work-stealing deques.
+    bool m_workStealing { false };
+    /// If true, the engine tasks of the next frame run while rendering the current one.
+    bool m_pipelinedFrames { false };
+    /// True if the tasks of the next frame already ran, in pipelined mode.
+    bool m_pipelinedTasksDone { false };
+    /// Timings of the tasks of the next frame, in pipelined mode.
+    std::vector<Core::TaskQueue::TimerData> m_pipelinedTaskData;
     std::vector<FrameTimerData> m_timerData;
     std::string m_pluginPath;
 
@@ -26,6 +26,9 @@ void FrameTimerData::print( std::ostream& ostream ) const {
         ostream << "\t}"
                 << "\n";
         ostream << "\trender: " << reStart << " " << reEnd << " " << reEnd - reStart << "\n";
+        ostream << "\tculled: " << renderData.frustumCulledCount << " (frustum) "
+                << renderData.occlusionCulledCount << " (occlusion)\n";
+        ostream << "\tstate changes: " << renderData.stateChangeCount << "\n";
     }
     ostream << "}"
             << "\n";
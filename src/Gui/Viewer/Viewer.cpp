@@ -223,6 +223,25 @@ void Viewer::startRendering( const Scalar dt ) {
     m_pickingManager->clear();
     makeCurrent();
 
+    if ( !m_renderingPrepared ) { prepareCamera(); }
+    m_renderingPrepared = false;
+
+    m_currentRenderer->render( getViewingParameters( dt ) );
+}
+
+void Viewer::prepareRendering( const Scalar dt ) {
+    CORE_ASSERT( m_glInitialized.load(), "OpenGL needs to be initialized before rendering." );
+
+    CORE_ASSERT( m_currentRenderer != nullptr, "No renderer found." );
+
+    makeCurrent();
+    prepareCamera();
+    m_currentRenderer->prepare( getViewingParameters( dt ) );
+    doneCurrent();
+    m_renderingPrepared = true;
+}
+
+void Viewer::prepareCamera() {
     // update znear/zfar to fit the scene ...
     auto entityManager = Engine::RadiumEngine::getInstance()->getEntityManager();
     if ( entityManager ) {
@@ -255,9 +274,10 @@ void Viewer::startRendering( const Scalar dt ) {
         else
             LOG( logDEBUG ) << "Unable to attach the head light!";
     }
-    Engine::Data::ViewingParameters data {
-        m_camera->getCamera()->getViewMatrix(), m_camera->getCamera()->getProjMatrix(), dt };
-    m_currentRenderer->render( data );
+}
+
+Engine::Data::ViewingParameters Viewer::getViewingParameters( const Scalar dt ) const {
+    return { m_camera->getCamera()->getViewMatrix(), m_camera->getCamera()->getProjMatrix(), dt };
 }
 
 void Viewer::swapBuffers() {
@@ -123,6 +123,11 @@ class RA_GUI_API Viewer : public WindowQt, public KeyMappingManageable<Viewer>
     /// Start rendering (potentially asynchronously in a separate thread)
     void startRendering( const Scalar dt );
 
+    /// Prepares the next startRendering(): fits the camera range to the scene and uploads the
+    /// modified render objects to the GPU. Once prepared, the engine tasks of the next frame can
+    /// run while rendering (see Engine::Rendering::Renderer::prepare()).
+    void prepareRendering( const Scalar dt );
+
     /// Blocks until rendering is finished.
     void swapBuffers();
 
@@ -281,6 +286,12 @@ class RA_GUI_API Viewer : public WindowQt, public KeyMappingManageable<Viewer>
 
     Ra::Engine::Rendering::Renderer::PickingResult pickAtPosition( Core::Vector2 position );
 
+    /// Fits the camera z range to the scene and attaches the head light if needed.
+    void prepareCamera();
+
+    /// Viewing parameters of the current camera.
+    Engine::Data::ViewingParameters getViewingParameters( const Scalar dt ) const;
+
     void propagateEventToParent( QEvent* event );
 
     std::tuple<KeyMappingManager::KeyMappingAction,
@@ -292,6 +303,8 @@ class RA_GUI_API Viewer : public WindowQt, public KeyMappingManageable<Viewer>
                          bool wheel );
 
     Scalar m_depthUnderMouse;
+    /// True between prepareRendering() and startRendering().
+    bool m_renderingPrepared { false };
     std::unique_ptr<RadiumHelpDialog> m_helpDialog { nullptr };
 
   protected:
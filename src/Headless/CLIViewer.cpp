@@ -2,10 +2,14 @@
 
 #include <Core/Asset/Camera.hpp>
 #include <Core/Asset/FileLoaderInterface.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/Tasks/TaskQueue.hpp>
 #include <Core/Utils/Log.hpp>
+#include <Core/Utils/Timer.hpp>
 
+#include <Engine/Data/Texture.hpp>
 #include <Engine/Data/ViewingParameters.hpp>
+#include <Engine/OpenGL.hpp>
 #include <Engine/RadiumEngine.hpp>
 #include <Engine/Rendering/Renderer.hpp>
 #include <Engine/Scene/DefaultCameraManager.hpp>
@@ -14,12 +18,142 @@
 #include <Engine/Scene/SkeletonBasedAnimationSystem.hpp>
 #include <Engine/Scene/SystemDisplay.hpp>
 
+#include <globjects/Buffer.h>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb/stb_image_write.h>
+#include <tinyEXR/tinyexr.h>
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
 namespace Ra {
 namespace Headless {
 using namespace Ra::Core::Utils;
+using namespace gl;
 
 constexpr int defaultSystemPriority = 1000;
 
+namespace {
+/// Write the w x h RGBA image read back from OpenGL (i.e. bottom row first) to filename.
+/// pixels are flipped in place for floating point formats, and converted to 8 bits otherwise.
+bool writeImage( const std::string& filename,
+                 const std::string& format,
+                 int w,
+                 int h,
+                 std::vector<float>& pixels ) {
+    const auto row = size_t( w ) * 4;
+    if ( format == "hdr" || format == "exr" ) {
+        for ( int j = 0; j < h / 2; ++j ) {
+            std::swap_ranges( pixels.begin() + j * row,
+                              pixels.begin() + ( j + 1 ) * row,
+                              pixels.begin() + ( h - 1 - j ) * row );
+        }
+        if ( format == "hdr" ) {
+            return stbi_write_hdr( filename.c_str(), w, h, 4, pixels.data() ) != 0;
+        }
+        const char* err = nullptr;
+        if ( SaveEXR( pixels.data(), w, h, 4, 1, filename.c_str(), &err ) != TINYEXR_SUCCESS ) {
+            LOG( logERROR ) << "Cannot write frame to " << filename << " : " << ( err ? err : "" );
+            FreeEXRErrorMessage( err );
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<unsigned char> image( pixels.size() );
+    for ( int j = 0; j < h; ++j ) {
+        auto in  = pixels.begin() + j * row;
+        auto out = image.begin() + ( h - 1 - j ) * row;
+        std::transform( in, in + row, out, []( float c ) {
+            return static_cast<unsigned char>( std::clamp( c * 255.f, 0.f, 255.f ) );
+        } );
+    }
+    if ( format == "bmp" ) {
+        return stbi_write_bmp( filename.c_str(), w, h, 4, image.data() ) != 0;
+    }
+    return stbi_write_png( filename.c_str(), w, h, 4, image.data(), int( row ) ) != 0;
+}
+} // namespace
+
+/**
+ * Persistent pool of worker threads running the jobs writing the frames in batch mode.
+ * push() blocks while too many jobs are waiting, so that the frames read back faster than they
+ * are encoded do not accumulate in memory.
+ */
+class CLIViewer::FrameWriter
+{
+  public:
+    FrameWriter( uint numThreads, size_t capacity ) : m_capacity { capacity } {
+        for ( uint i = 0; i < numThreads; ++i ) {
+            m_workers.emplace_back( &FrameWriter::runWorker, this );
+        }
+    }
+
+    /// Write the pending frames, then stop the workers.
+    ~FrameWriter() {
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            m_stop = true;
+        }
+        m_jobAvailable.notify_all();
+        for ( auto& worker : m_workers ) {
+            worker.join();
+        }
+    }
+
+    /// Add a job, waiting while the queue is full.
+    /// The job returns false if it failed, and is then counted in the failures returned by wait().
+    void push( std::function<bool()> job ) {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_jobDone.wait( lock, [this]() { return m_jobs.size() < m_capacity; } );
+        m_jobs.push_back( std::move( job ) );
+        lock.unlock();
+        m_jobAvailable.notify_one();
+    }
+
+    /// Wait for all the jobs, and return the number of jobs that failed since the last call.
+    int wait() {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_jobDone.wait( lock, [this]() { return m_jobs.empty() && m_running == 0; } );
+        return std::exchange( m_failures, 0 );
+    }
+
+  private:
+    void runWorker() {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        while ( true ) {
+            m_jobAvailable.wait( lock, [this]() { return m_stop || !m_jobs.empty(); } );
+            if ( m_jobs.empty() ) { return; }
+            auto job = std::move( m_jobs.front() );
+            m_jobs.pop_front();
+            ++m_running;
+            lock.unlock();
+            bool success = job();
+            lock.lock();
+            --m_running;
+            if ( !success ) { ++m_failures; }
+            m_jobDone.notify_all();
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<bool()>> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::condition_variable m_jobDone;
+    size_t m_capacity;
+    size_t m_running { 0 };
+    int m_failures { 0 };
+    bool m_stop { false };
+};
+
 CLIViewer::CLIViewer( std::unique_ptr<OpenGLContext> context ) :
     CLIBaseApplication(), m_glContext { std::move( context ) } {
     // add ->required() to force user to give a filename;
@@ -27,6 +161,14 @@ CLIViewer::CLIViewer( std::unique_ptr<OpenGLContext> context ) :
         ->check( CLI::ExistingFile );
     addOption( "-s,--size", m_parameters.m_size, "Size of the computed image." )->delimiter( 'x' );
     addFlag( "-a,--animation", m_parameters.m_animationEnable, "Enable Radium Animation system." );
+    addFlag( "--pipelined",
+             m_parameters.m_pipelinedFrames,
+             "Run the engine tasks of the next frame while rendering the current one." );
+    addFlag( "--batch",
+             m_parameters.m_batchMode,
+             "Read the frames back asynchronously and write them on worker threads." );
+    addOption( "--format", m_parameters.m_imgFormat, "Format of the written images." )
+        ->check( CLI::IsMember( { "png", "bmp", "hdr", "exr" } ) );
 }
 
 CLIViewer::~CLIViewer() {
@@ -92,24 +234,120 @@ int CLIViewer::init( int argc, const char* argv[] ) {
 }
 
 int CLIViewer::oneFrame( float timeStep ) {
-    if ( m_parameters.m_animationEnable ) {
-        auto animationSystem = dynamic_cast<Ra::Engine::Scene::SkeletonBasedAnimationSystem*>(
-            m_engine->getSystem( "SkeletonBasedAnimationSystem" ) );
-        if ( animationSystem ) { animationSystem->toggleSkeleton( false ); }
-        m_engine->setConstantTimeStep( timeStep );
-        m_engine->step();
+    auto stepAnimation = [this, timeStep]() {
+        if ( m_parameters.m_animationEnable ) {
+            auto animationSystem = dynamic_cast<Ra::Engine::Scene::SkeletonBasedAnimationSystem*>(
+                m_engine->getSystem( "SkeletonBasedAnimationSystem" ) );
+            if ( animationSystem ) { animationSystem->toggleSkeleton( false ); }
+            m_engine->setConstantTimeStep( timeStep );
+            m_engine->step();
+        }
+    };
+    if ( !m_taskQueue ) {
+        m_taskQueue = std::make_unique<Ra::Core::TaskQueue>(
+            std::max( 1u, std::thread::hardware_concurrency() ) - 1 );
+    }
+    Ra::Core::setParallelTaskQueue( m_taskQueue.get() );
+
+    // In pipelined mode, the tasks of this frame ran during the previous call (they are not run
+    // again if the mode was switched off since).
+    if ( !m_pipelinedTasksDone ) {
+        stepAnimation();
+        m_engine->getTasks( m_taskQueue.get(), Scalar( timeStep ) );
+        m_taskQueue->startTasks();
+        m_taskQueue->waitForTasks();
+        m_taskQueue->flushTaskQueue();
     }
-
-    Ra::Core::TaskQueue tasks( std::thread::hardware_concurrency() - 1 );
-    m_engine->getTasks( &tasks, Scalar( timeStep ) );
-    tasks.startTasks();
-    tasks.waitForTasks();
-    tasks.flushTaskQueue();
 
     Ra::Engine::Data::ViewingParameters data {
         m_camera->getViewMatrix(), m_camera->getProjMatrix(), timeStep };
-    m_renderer->render( data );
+    if ( m_parameters.m_pipelinedFrames ) {
+        // snapshot the state to render, then run the next frame tasks while rendering.
+        m_engine->endFrameSync();
+        m_renderer->prepare( data );
+        stepAnimation();
+        m_engine->getTasks( m_taskQueue.get(), Scalar( timeStep ) );
+        m_taskQueue->startTasks();
+        m_renderer->render( data );
+        m_taskQueue->waitForTasks();
+        m_taskQueue->flushTaskQueue();
+        m_pipelinedTasksDone = true;
+    }
+    else {
+        m_renderer->render( data );
+        m_engine->endFrameSync();
+        m_pipelinedTasksDone = false;
+    }
+    Ra::Core::setParallelTaskQueue( nullptr );
+
+    return 0;
+}
+
+int CLIViewer::renderFrames( int frameCount, float timeStep ) {
+    if ( !m_renderer || !m_camera ) {
+        LOG( logERROR ) << "CLIViewer : a renderer and a camera are needed to render frames";
+        return 1;
+    }
+    const bool batch = m_parameters.m_batchMode;
+    if ( batch && !m_frameWriter ) {
+        uint numThreads = std::max( 1u, std::thread::hardware_concurrency() / 2 );
+        m_frameWriter   = std::make_unique<FrameWriter>( numThreads, 2 * numThreads );
+    }
+
+    const auto tex        = m_renderer->getDisplayTexture();
+    const int w           = int( tex->width() );
+    const int h           = int( tex->height() );
+    const auto bufferSize = size_t( w ) * size_t( h ) * 4 * sizeof( float );
+
+    // Frame i is read back in readback[i % 2]. In batch mode, the buffer is mapped once the next
+    // frame is rendered, so that the transfer does not stall the rendering.
+    std::array<std::unique_ptr<globjects::Buffer>, 2> readback;
+    for ( auto& buffer : readback ) {
+        buffer = globjects::Buffer::create();
+        buffer->setData( GLsizeiptr( bufferSize ), nullptr, GL_STREAM_READ );
+    }
 
+    int failures = 0;
+    auto writeFrame = [this, &readback, &failures, batch, bufferSize, w, h]( int frame ) {
+        auto filename =
+            m_parameters.m_imgPrefix + std::to_string( frame ) + "." + m_parameters.m_imgFormat;
+        std::vector<float> pixels( bufferSize / sizeof( float ) );
+        auto& buffer = readback[size_t( frame % 2 )];
+        std::memcpy( pixels.data(), buffer->map( GL_READ_ONLY ), bufferSize );
+        buffer->unmap();
+        if ( batch ) {
+            m_frameWriter->push(
+                [filename, format = m_parameters.m_imgFormat, pixels = std::move( pixels ), w, h]()
+                mutable { return writeImage( filename, format, w, h, pixels ); } );
+        }
+        else if ( !writeImage( filename, m_parameters.m_imgFormat, w, h, pixels ) ) {
+            ++failures;
+        }
+    };
+
+    auto start = Clock::now();
+    for ( int i = 0; i < frameCount; ++i ) {
+        oneFrame( timeStep );
+        m_renderer->getDisplayTexture()->bind();
+        readback[size_t( i % 2 )]->bind( GL_PIXEL_PACK_BUFFER );
+        GL_ASSERT( glGetTexImage( GL_TEXTURE_2D, 0, GL_RGBA, GL_FLOAT, nullptr ) );
+        globjects::Buffer::unbind( GL_PIXEL_PACK_BUFFER );
+        if ( !batch ) { writeFrame( i ); }
+        else if ( i > 0 ) { writeFrame( i - 1 ); }
+    }
+    if ( batch && frameCount > 0 ) {
+        writeFrame( frameCount - 1 );
+        failures += m_frameWriter->wait();
+    }
+    auto elapsed      = getIntervalSeconds( start, Clock::now() );
+    m_framesPerSecond = elapsed > 0 ? frameCount / double( elapsed ) : 0;
+    LOG( logINFO ) << "CLIViewer : " << frameCount << " frames written in " << elapsed << "s ("
+                   << m_framesPerSecond << " fps)";
+
+    if ( failures > 0 ) {
+        LOG( logERROR ) << "CLIViewer : " << failures << " frames could not be written";
+        return 1;
+    }
     return 0;
 }
 
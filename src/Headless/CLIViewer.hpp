@@ -10,6 +10,7 @@
 
 namespace Ra {
 namespace Core {
+class TaskQueue;
 namespace Asset {
 class FileLoaderInterface;
 class Camera;
@@ -37,10 +38,16 @@ class HEADLESS_API CLIViewer : public CLIBaseApplication
     struct ViewerParameters {
         /// Load animation system at startup
         bool m_animationEnable { false };
+        /// Run the engine tasks of the next frame while rendering the current one
+        bool m_pipelinedFrames { false };
+        /// Read the frames back asynchronously and write them on worker threads
+        bool m_batchMode { false };
         /// Size of the image
         std::array<int, 2> m_size { { 512, 512 } };
         /// image name prefix
         std::string m_imgPrefix { "frame" };
+        /// image format (png, bmp, hdr or exr)
+        std::string m_imgFormat { "png" };
         /// The data file to manage
         std::string m_dataFile = { "" };
     };
@@ -53,6 +60,9 @@ class HEADLESS_API CLIViewer : public CLIBaseApplication
     const Engine::RadiumEngine* getEngine() const { return m_engine; }
 
   private:
+    /// Worker threads writing the frames read back in batch mode (defined in CLIViewer.cpp).
+    class FrameWriter;
+
     /// Headless OpenGLContext
     std::unique_ptr<OpenGLContext> m_glContext;
 
@@ -65,6 +75,18 @@ class HEADLESS_API CLIViewer : public CLIBaseApplication
     /// The application parameters
     ViewerParameters m_parameters;
 
+    /// Task queue running the engine tasks
+    std::unique_ptr<Ra::Core::TaskQueue> m_taskQueue;
+
+    /// True if the tasks of the next frame already ran, in pipelined mode.
+    bool m_pipelinedTasksDone { false };
+
+    /// Persistent pool converting and encoding the frames, in batch mode
+    std::unique_ptr<FrameWriter> m_frameWriter;
+
+    /// Throughput of the last call to renderFrames
+    double m_framesPerSecond { 0 };
+
     /// is the engine initialized ?
     bool m_engineInitialized { false };
 
@@ -93,6 +115,9 @@ class HEADLESS_API CLIViewer : public CLIBaseApplication
      * and the following parameters :
      *   - --size <width x height> : the size of the rendered picture
      *   - --animation : load the Radium animation system
+     *   - --pipelined : run the engine tasks of the next frame while rendering the current one
+     *   - --batch : read the frames back asynchronously and write them on worker threads
+     *   - --format <png|bmp|hdr|exr> : format of the images written by renderFrames
      *   - --env <env_map> : load and use the given environment map.
      */
     int init( int argc, const char* argv[] ) override;
@@ -100,12 +125,32 @@ class HEADLESS_API CLIViewer : public CLIBaseApplication
     /**
      * Render one frame of the scene attached to the engine for the given time
      * stamp.
+     * In pipelined mode, the engine tasks of the next frame run while rendering, so that the
+     * rendered frame is the one computed by the previous call, if any.
      *
      * @return 0 if the image was correctly computed or an application dependant error code if
      * something went wrong.
      */
     int oneFrame( float timeStep = 1.f / 60.f );
 
+    /**
+     * Render frameCount frames with the given time step and write them to
+     * <prefix><frame index>.<format>.
+     * In batch mode, each frame is read back in one of two pixel buffer objects and mapped only
+     * once the next frame is rendered. Its conversion, flip and encoding then run on a persistent
+     * pool of worker threads, overlapped with the rendering of the next frames. Otherwise, each
+     * frame is read back and written before rendering the next one.
+     * The OpenGL context must be bound.
+     *
+     * @return 0 if all the frames were written or an application dependant error code if
+     * something went wrong.
+     * \see getFramesPerSecond
+     */
+    int renderFrames( int frameCount, float timeStep = 1.f / 60.f );
+
+    /** Number of frames rendered and written per second by the last call to renderFrames */
+    inline double getFramesPerSecond() const;
+
     /**
      * Set the renderer to use to compute an image
      *  The app takes ownership of the give pointer.
@@ -190,6 +235,10 @@ inline void CLIViewer::setDataFileName( std::string filename ) {
     m_parameters.m_dataFile = std::move( filename );
 }
 
+inline double CLIViewer::getFramesPerSecond() const {
+    return m_framesPerSecond;
+}
+
 inline OpenGLContext& CLIViewer::getWindow() {
     return *m_glContext;
 }
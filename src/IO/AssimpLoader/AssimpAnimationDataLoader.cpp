@@ -7,6 +7,7 @@
 #include <Core/Animation/KeyFramedValueInterpolators.hpp>
 #include <Core/Asset/AnimationData.hpp>
 #include <Core/Math/Math.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/Utils/Log.hpp>
 
 #include <IO/AssimpLoader/AssimpWrapper.hpp>
@@ -107,8 +108,12 @@ void AssimpAnimationDataLoader::fetchAnimation( const aiAnimation* anim,
     const uint size    = anim->mNumChannels;
     AnimationTime time = data->getTime();
     std::vector<HandleAnimation> keyFrame( size );
+    // channels are independent, fetch them in parallel
+    const auto dt = data->getTimeStep();
+    Core::parallelFor( 0u, size, [&]( uint i ) {
+        fetchHandleAnimation( anim->mChannels[i], keyFrame[i], dt );
+    } );
     for ( uint i = 0; i < size; ++i ) {
-        fetchHandleAnimation( anim->mChannels[i], keyFrame[i], data->getTimeStep() );
         time.extends( keyFrame[i].m_animationTime );
     }
     data->setHandleData( keyFrame );
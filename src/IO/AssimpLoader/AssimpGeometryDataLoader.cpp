@@ -59,11 +59,8 @@ uint AssimpGeometryDataLoader::sceneGeometrySize( const aiScene* scene ) const {
     return mesh_size;
 }
 
-void AssimpGeometryDataLoader::loadMeshAttrib( const aiMesh& mesh,
-                                               GeometryData& data,
-                                               std::set<std::string>& usedNames ) {
+void AssimpGeometryDataLoader::loadMeshAttrib( const aiMesh& mesh, GeometryData& data ) const {
     // Translate general identification of the mesh
-    fetchName( mesh, data, usedNames );
     fetchType( mesh, data );
 
     // Translate Geometry data
@@ -285,25 +282,40 @@ void AssimpGeometryDataLoader::loadGeometryData(
     const uint size = scene->mNumMeshes;
     std::map<uint, std::size_t> indexTable;
     std::set<std::string> usedNames;
+    // Names depend on the previous meshes, they are fetched in order before the conversion.
+    std::vector<const aiMesh*> meshes;
     for ( uint i = 0; i < size; ++i ) {
         aiMesh* mesh = scene->mMeshes[i];
         if ( mesh->HasPositions() ) {
-            if ( m_verbose ) { LOG( logINFO ) << "Loading mesh attribs..."; }
             auto geometry = new GeometryData();
-            loadMeshAttrib( *mesh, *geometry, usedNames );
-            if ( m_verbose ) { LOG( logINFO ) << "Mesh attribs loaded."; }
-            // This returns always true (see assimp documentation)
-            if ( scene->HasMaterials() ) {
-                const uint matID = mesh->mMaterialIndex;
-                if ( matID < scene->mNumMaterials ) {
-                    aiMaterial* material = scene->mMaterials[matID];
-                    loadMaterial( *material, *geometry );
-                }
-            }
+            fetchName( *mesh, *geometry, usedNames );
             data.push_back( std::unique_ptr<GeometryData>( geometry ) );
             indexTable[i] = data.size() - 1;
+            meshes.push_back( mesh );
+        }
+    }
 
-            if ( m_verbose ) { geometry->displayInfo(); }
+    // Meshes are independent, convert them in parallel, one mesh per chunk.
+    const size_t first = data.size() - meshes.size();
+    if ( m_verbose ) { LOG( logINFO ) << "Loading mesh attribs..."; }
+    Core::parallelFor( size_t( 0 ), meshes.size(), size_t( 1 ), [&]( size_t m ) {
+        const aiMesh* mesh = meshes[m];
+        auto& geometry     = *data[first + m];
+        loadMeshAttrib( *mesh, geometry );
+        // This returns always true (see assimp documentation)
+        if ( scene->HasMaterials() ) {
+            const uint matID = mesh->mMaterialIndex;
+            if ( matID < scene->mNumMaterials ) {
+                aiMaterial* material = scene->mMaterials[matID];
+                loadMaterial( *material, geometry );
+            }
+        }
+    } );
+
+    if ( m_verbose ) {
+        LOG( logINFO ) << "Mesh attribs loaded.";
+        for ( size_t m = first; m < data.size(); ++m ) {
+            data[m]->displayInfo();
         }
     }
     loadMeshFrame( scene->mRootNode, Core::Transform::Identity(), indexTable, data );
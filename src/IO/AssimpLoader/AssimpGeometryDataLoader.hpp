@@ -3,6 +3,7 @@
 #include <Core/Asset/DataLoader.hpp>
 #include <Core/Asset/GeometryData.hpp>
 #include <Core/Geometry/StandardAttribNames.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/Types.hpp>
 #include <IO/AssimpLoader/AssimpWrapper.hpp>
 #include <IO/RaIO.hpp>
@@ -49,6 +50,8 @@ class RA_IO_API AssimpGeometryDataLoader : public Core::Asset::DataLoader<Core::
     uint sceneGeometrySize( const aiScene* scene ) const;
 
     /// Fill \p data with all the GeometryData from \p scene.
+    /// The meshes are converted in parallel (see Core::parallelFor), \p data is ordered as the
+    /// meshes of \p scene.
     void loadGeometryData( const aiScene* scene,
                            std::vector<std::unique_ptr<Core::Asset::GeometryData>>& data );
 
@@ -63,9 +66,7 @@ class RA_IO_API AssimpGeometryDataLoader : public Core::Asset::DataLoader<Core::
 
   private:
     /// Fill \p data with the GeometryData from \p mesh.
-    void loadMeshAttrib( const aiMesh& mesh,
-                         Core::Asset::GeometryData& data,
-                         std::set<std::string>& usedNames );
+    void loadMeshAttrib( const aiMesh& mesh, Core::Asset::GeometryData& data ) const;
 
     /// Fill \p data with the name from \p mesh.
     /// \note If the name is already in use, then appends as much "_" as needed.
@@ -104,10 +105,7 @@ void AssimpGeometryDataLoader::fetchAttribute( T* aiData,
     auto attribHandle = data.addAttrib<typename AssimpTypeWrapper<T>::Type>( getAttribName( a ) );
     auto& attribData  = data.vertexAttribs().getDataWithLock( attribHandle );
     attribData.resize( size );
-#pragma omp parallel for
-    for ( int i = 0; i < size; ++i ) {
-        attribData.at( i ) = assimpToCore( aiData[i] );
-    }
+    Core::parallelFor( 0, size, [&]( int i ) { attribData.at( i ) = assimpToCore( aiData[i] ); } );
     data.vertexAttribs().unlock( attribHandle );
 }
 
@@ -118,10 +116,9 @@ void AssimpGeometryDataLoader::fetchIndexLayer( aiFace* faces,
     auto layer    = std::make_unique<T>();
     auto& indices = layer->collection();
     indices.resize( numFaces );
-#pragma omp parallel for
-    for ( int i = 0; i < numFaces; ++i ) {
+    Core::parallelFor( 0, numFaces, [&]( int i ) {
         indices[i] = assimpToCore<typename T::IndexType>( faces[i].mIndices, faces[i].mNumIndices );
-    }
+    } );
     data.addLayer( std::move( layer ), false, "indices" );
 }
 
@@ -6,6 +6,7 @@
 #include <set>
 
 #include <Core/Asset/HandleData.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/Utils/Log.hpp>
 
 #include <IO/AssimpLoader/AssimpWrapper.hpp>
@@ -106,6 +107,13 @@ void AssimpHandleDataLoader::loadHandleData(
 
     // load the HandleComponentData for all meshes
     std::map<std::string, HandleComponentData> mapBone2Data;
+    // skinning weights of a bone for a mesh, and where to store them
+    struct WeightsRange {
+        const aiBone* m_bone;
+        std::vector<std::pair<uint, Scalar>>* m_weights;
+        size_t m_offset;
+    };
+    std::vector<WeightsRange> weightsRanges;
     for ( uint n = 0; n < scene->mNumMeshes; ++n ) {
         const aiMesh* mesh = scene->mMeshes[n];
         // fetch mesh name as registered by the GeometryLoader
@@ -131,9 +139,13 @@ void AssimpHandleDataLoader::loadHandleData(
             // fetch bone data
             const std::string boneName = assimpToCore( bone->mName );
             // if data doesn't exist yet, create it
-            mapBone2Data[boneName].m_name = boneName;
-            // fill skinning weights and offset matrix for this mesh
-            loadHandleComponentDataWeights( bone, meshName, mapBone2Data[boneName] );
+            auto& boneData  = mapBone2Data[boneName];
+            boneData.m_name = boneName;
+            // allocate skinning weights (filled below) and set offset matrix for this mesh
+            auto& weights = boneData.m_weights[meshName];
+            weightsRanges.push_back( { bone, &weights, weights.size() } );
+            weights.resize( weights.size() + bone->mNumWeights );
+            boneData.m_bindMatrices[meshName] = assimpToCore( bone->mOffsetMatrix );
             // deal with hierarchy
             aiNode* node = scene->mRootNode->FindNode( bone->mName );
             if ( node == nullptr ) { continue; }
@@ -151,6 +163,12 @@ void AssimpHandleDataLoader::loadHandleData(
         }
     }
 
+    // fill skinning weights in parallel, they are all allocated so that the maps are unchanged
+    Core::parallelFor( size_t( 0 ), weightsRanges.size(), [&weightsRanges, this]( size_t i ) {
+        const auto& range = weightsRanges[i];
+        loadHandleComponentDataWeights( range.m_bone, range.m_weights->data() + range.m_offset );
+    } );
+
     // also add bone nodes for skeletons not attached to a mesh
     auto rootNode = scene->mRootNode;
     for ( uint i = 0; i < rootNode->mNumChildren; ++i ) {
@@ -262,15 +280,13 @@ void AssimpHandleDataLoader::loadHandleComponentDataFrame( const aiScene* scene,
     }
 }
 
-void AssimpHandleDataLoader::loadHandleComponentDataWeights( const aiBone* bone,
-                                                             const std::string& meshName,
-                                                             HandleComponentData& data ) const {
+void AssimpHandleDataLoader::loadHandleComponentDataWeights(
+    const aiBone* bone,
+    std::pair<uint, Scalar>* weights ) const {
     // fetch skinning weigthts
     for ( uint j = 0; j < bone->mNumWeights; ++j ) {
-        std::pair<uint, Scalar> weight( bone->mWeights[j].mVertexId, bone->mWeights[j].mWeight );
-        data.m_weights[meshName].push_back( weight );
+        weights[j] = { bone->mWeights[j].mVertexId, Scalar( bone->mWeights[j].mWeight ) };
     }
-    data.m_bindMatrices[meshName] = assimpToCore( bone->mOffsetMatrix );
 }
 
 void AssimpHandleDataLoader::fillHandleData(
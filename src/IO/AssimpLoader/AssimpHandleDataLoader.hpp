@@ -43,9 +43,9 @@ class RA_IO_API AssimpHandleDataLoader : public Core::Asset::DataLoader<Core::As
     void loadHandleComponentDataFrame( const aiScene* scene,
                                        const aiString& boneName,
                                        Core::Asset::HandleComponentData& data ) const;
+    /// Fill \p weights with the bone->mNumWeights skinning weights of \p bone.
     void loadHandleComponentDataWeights( const aiBone* bone,
-                                         const std::string& meshName,
-                                         Core::Asset::HandleComponentData& data ) const;
+                                         std::pair<uint, Scalar>* weights ) const;
     void
     fillHandleData( const std::string& node,
                     const std::vector<std::pair<std::string, std::string>>& edgeList,
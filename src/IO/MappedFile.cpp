@@ -0,0 +1,62 @@
+#include <IO/MappedFile.hpp>
+
+#ifdef OS_WINDOWS
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace Ra {
+namespace IO {
+
+MappedFile::MappedFile( const std::string& filename ) {
+#ifdef OS_WINDOWS
+    HANDLE file = CreateFileA( filename.c_str(),
+                               GENERIC_READ,
+                               FILE_SHARE_READ,
+                               nullptr,
+                               OPEN_EXISTING,
+                               FILE_FLAG_SEQUENTIAL_SCAN,
+                               nullptr );
+    if ( file == INVALID_HANDLE_VALUE ) { return; }
+    m_file = file;
+    LARGE_INTEGER size;
+    if ( !GetFileSizeEx( m_file, &size ) || size.QuadPart == 0 ) { return; }
+    m_mapping = CreateFileMappingA( m_file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if ( m_mapping == nullptr ) { return; }
+    auto data = MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 );
+    if ( data == nullptr ) { return; }
+    m_data = static_cast<const char*>( data );
+    m_size = size_t( size.QuadPart );
+#else
+    const int fd = open( filename.c_str(), O_RDONLY );
+    if ( fd < 0 ) { return; }
+    struct stat st;
+    if ( fstat( fd, &st ) == 0 && st.st_size > 0 ) {
+        auto data = mmap( nullptr, size_t( st.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+        if ( data != MAP_FAILED ) {
+            madvise( data, size_t( st.st_size ), MADV_WILLNEED );
+            m_data = static_cast<const char*>( data );
+            m_size = size_t( st.st_size );
+        }
+    }
+    // the mapping stays valid after closing the file.
+    close( fd );
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef OS_WINDOWS
+    if ( m_data != nullptr ) { UnmapViewOfFile( m_data ); }
+    if ( m_mapping != nullptr ) { CloseHandle( m_mapping ); }
+    if ( m_file != nullptr ) { CloseHandle( m_file ); }
+#else
+    if ( m_data != nullptr ) { munmap( const_cast<char*>( m_data ), m_size ); }
+#endif
+}
+
+} // namespace IO
+} // namespace Ra
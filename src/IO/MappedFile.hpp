@@ -0,0 +1,50 @@
+#pragma once
+
+#include <IO/RaIO.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace Ra {
+namespace IO {
+
+/// Read-only memory mapping of a whole file.
+/// The file content is paged in on access, without being copied in a user buffer.
+class RA_IO_API MappedFile
+{
+  public:
+    /// Map the file filename. The mapping is invalid if the file cannot be opened or is empty.
+    explicit MappedFile( const std::string& filename );
+    ~MappedFile();
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    inline bool isValid() const;
+    inline const char* data() const;
+    inline size_t size() const;
+
+  private:
+    const char* m_data { nullptr };
+    size_t m_size { 0 };
+#ifdef OS_WINDOWS
+    // file and mapping HANDLEs, not exposing windows.h to the users of this header.
+    void* m_file { nullptr };
+    void* m_mapping { nullptr };
+#endif
+};
+
+inline bool MappedFile::isValid() const {
+    return m_data != nullptr;
+}
+
+inline const char* MappedFile::data() const {
+    return m_data;
+}
+
+inline size_t MappedFile::size() const {
+    return m_size;
+}
+
+} // namespace IO
+} // namespace Ra
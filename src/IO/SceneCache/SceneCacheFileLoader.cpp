@@ -0,0 +1,768 @@
+#include <IO/SceneCache/SceneCacheFileLoader.hpp>
+
+#include <IO/MappedFile.hpp>
+
+#include <Core/Asset/BlinnPhongMaterialData.hpp>
+#include <Core/Asset/FileData.hpp>
+#include <Core/Utils/Log.hpp>
+#include <Core/Utils/StringUtils.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Ra {
+namespace IO {
+
+using namespace Core::Utils; // log
+using namespace Core::Asset;
+using Core::Geometry::MultiIndexedGeometry;
+
+namespace {
+
+/// Header of the cache files.
+struct Header {
+    char m_magic[8];
+    uint32_t m_version;
+    uint32_t m_scalarSize;
+    uint64_t m_sourceHash;
+};
+
+constexpr char cacheMagic[8] = "RACACHE";
+constexpr uint32_t cacheVersion { 1 };
+
+/// Type of the cached vertex attributes.
+enum class AttribType : uint8_t { Unknown, Float, Vector2, Vector3, Vector4 };
+
+AttribType getAttribType( const AttribBase* attrib ) {
+    if ( attrib->isFloat() ) { return AttribType::Float; }
+    if ( attrib->isVector2() ) { return AttribType::Vector2; }
+    if ( attrib->isVector3() ) { return AttribType::Vector3; }
+    if ( attrib->isVector4() ) { return AttribType::Vector4; }
+    return AttribType::Unknown;
+}
+
+/// Binary output, values are written with the memory layout of the platform.
+class Writer
+{
+  public:
+    explicit Writer( std::ostream& out ) : m_out( out ) {}
+
+    template <typename T>
+    void write( const T& value ) {
+        writeRaw( &value, sizeof( T ) );
+    }
+
+    void write( const std::string& value ) {
+        write( uint64_t( value.size() ) );
+        writeRaw( value.data(), value.size() );
+    }
+
+    /// Write the size and the elements of a contiguous container of plain values.
+    template <typename Container>
+    void writeArray( const Container& container ) {
+        write( uint64_t( container.size() ) );
+        writeRaw( container.data(), container.size() * sizeof( typename Container::value_type ) );
+    }
+
+    void writeRaw( const void* data, size_t size ) {
+        m_out.write( static_cast<const char*>( data ), std::streamsize( size ) );
+    }
+
+  private:
+    std::ostream& m_out;
+};
+
+/// Bounds checked binary input, reading a (memory mapped) buffer written by Writer.
+/// Once the end of the buffer is reached, the reader is invalid and reads zeros.
+class Reader
+{
+  public:
+    Reader( const char* data, size_t size ) : m_cursor( data ), m_end( data + size ) {}
+
+    bool isValid() const { return m_valid; }
+    void invalidate() { m_valid = false; }
+
+    template <typename T>
+    void read( T& value ) {
+        readRaw( &value, sizeof( T ) );
+    }
+
+    void read( std::string& value ) {
+        const auto size = readSize( 1 );
+        value.assign( m_cursor, size );
+        m_cursor += size;
+    }
+
+    /// Read a number of elements, checking that the buffer is large enough to store them.
+    size_t readSize( size_t elementSize ) {
+        uint64_t size { 0 };
+        read( size );
+        if ( m_valid && size <= uint64_t( m_end - m_cursor ) / elementSize ) {
+            return size_t( size );
+        }
+        m_valid = false;
+        return 0;
+    }
+
+    /// Read the elements of a container written by Writer::writeArray, copied at once in its
+    /// storage.
+    template <typename Container>
+    void readArray( Container& container ) {
+        using ValueType = typename Container::value_type;
+        container.resize( readSize( sizeof( ValueType ) ) );
+        readRaw( container.data(), container.size() * sizeof( ValueType ) );
+    }
+
+    void readRaw( void* data, size_t size ) {
+        if ( !m_valid || size > size_t( m_end - m_cursor ) ) {
+            m_valid = false;
+            if ( size > 0 ) { std::memset( data, 0, size ); }
+            return;
+        }
+        if ( size > 0 ) { std::memcpy( data, m_cursor, size ); }
+        m_cursor += size;
+    }
+
+  private:
+    const char* m_cursor;
+    const char* m_end;
+    bool m_valid { true };
+};
+
+Core::Transform readTransform( Reader& in ) {
+    Core::Transform transform;
+    in.read( transform.matrix() );
+    return transform;
+}
+
+/// Faces with a variable number of vertices, i.e. Core::VectorNui.
+template <typename Container>
+void writeFaces( Writer& out, const Container& faces ) {
+    out.write( uint64_t( faces.size() ) );
+    for ( const auto& face : faces ) {
+        out.write( uint64_t( face.size() ) );
+        out.writeRaw( face.data(), size_t( face.size() ) * sizeof( uint ) );
+    }
+}
+
+template <typename Container>
+void readFaces( Reader& in, Container& faces ) {
+    faces.resize( in.readSize( sizeof( uint64_t ) ) );
+    for ( auto& face : faces ) {
+        face.resize( Eigen::Index( in.readSize( sizeof( uint ) ) ) );
+        in.readRaw( face.data(), size_t( face.size() ) * sizeof( uint ) );
+    }
+}
+
+/// Apply \p func on each field of a Blinn-Phong material.
+template <typename Material, typename Func>
+void visitFields( Material& material, Func&& func ) {
+    func( material.m_diffuse );
+    func( material.m_specular );
+    func( material.m_shininess );
+    func( material.m_opacity );
+    func( material.m_texDiffuse );
+    func( material.m_texSpecular );
+    func( material.m_texShininess );
+    func( material.m_texNormal );
+    func( material.m_texOpacity );
+    func( material.m_hasDiffuse );
+    func( material.m_hasSpecular );
+    func( material.m_hasShininess );
+    func( material.m_hasOpacity );
+    func( material.m_hasTexDiffuse );
+    func( material.m_hasTexSpecular );
+    func( material.m_hasTexShininess );
+    func( material.m_hasTexNormal );
+    func( material.m_hasTexOpacity );
+}
+
+template <typename T>
+void readAttrib( Reader& in, MultiIndexedGeometry& geometry, const std::string& name ) {
+    auto handle  = geometry.addAttrib<T>( name );
+    auto& attrib = geometry.getAttrib( handle );
+    in.readArray( attrib.getDataWithLock() );
+    attrib.unlock();
+}
+
+template <typename Layer>
+void readLayer( Reader& in, MultiIndexedGeometry& geometry, const std::string& name ) {
+    auto layer = std::make_unique<Layer>();
+    in.readArray( layer->collection() );
+    if ( !geometry.addLayer( std::move( layer ), false, name ).first ) { in.invalidate(); }
+}
+
+bool writeGeometry( Writer& out, const GeometryData& data ) {
+    out.write( data.getName() );
+    out.write( int32_t( data.getType() ) );
+    out.write( data.getFrame().matrix() );
+    out.write( int32_t( data.getPrimitiveCount() ) );
+
+    const auto& geometry = data.getGeometry();
+    std::vector<const AttribBase*> attribs;
+    geometry.vertexAttribs().for_each_attrib(
+        [&attribs]( const AttribBase* attrib ) { attribs.push_back( attrib ); } );
+    out.write( uint64_t( attribs.size() ) );
+    for ( const auto attrib : attribs ) {
+        const auto type = getAttribType( attrib );
+        out.write( attrib->getName() );
+        out.write( type );
+        switch ( type ) {
+        case AttribType::Float:
+            out.writeArray( attrib->cast<Scalar>().data() );
+            break;
+        case AttribType::Vector2:
+            out.writeArray( attrib->cast<Core::Vector2>().data() );
+            break;
+        case AttribType::Vector3:
+            out.writeArray( attrib->cast<Core::Vector3>().data() );
+            break;
+        case AttribType::Vector4:
+            out.writeArray( attrib->cast<Core::Vector4>().data() );
+            break;
+        default:
+            LOG( logINFO ) << "Scene cache : attribute \"" << attrib->getName()
+                           << "\" of geometry \"" << data.getName() << "\" cannot be cached.";
+            return false;
+        }
+    }
+
+    std::vector<MultiIndexedGeometry::LayerKeyType> layerKeys;
+    for ( const auto& key : geometry.layerKeys() ) {
+        layerKeys.push_back( key );
+    }
+    out.write( uint64_t( layerKeys.size() ) );
+    for ( const auto& key : layerKeys ) {
+        // only the predefined layers, identified by a single semantic, are cached.
+        const auto& layer          = geometry.getLayer( key );
+        const std::string semantic = key.first.size() == 1 ? *key.first.begin() : "";
+        out.write( semantic );
+        out.write( key.second );
+        if ( semantic == Core::Geometry::PointCloudIndexLayer::staticSemanticName ) {
+            out.writeArray( static_cast<const Core::Geometry::PointCloudIndexLayer&>( layer )
+                                .collection() );
+        }
+        else if ( semantic == Core::Geometry::LineIndexLayer::staticSemanticName ) {
+            out.writeArray(
+                static_cast<const Core::Geometry::LineIndexLayer&>( layer ).collection() );
+        }
+        else if ( semantic == Core::Geometry::TriangleIndexLayer::staticSemanticName ) {
+            out.writeArray(
+                static_cast<const Core::Geometry::TriangleIndexLayer&>( layer ).collection() );
+        }
+        else if ( semantic == Core::Geometry::QuadIndexLayer::staticSemanticName ) {
+            out.writeArray(
+                static_cast<const Core::Geometry::QuadIndexLayer&>( layer ).collection() );
+        }
+        else if ( semantic == Core::Geometry::PolyIndexLayer::staticSemanticName ) {
+            writeFaces( out,
+                        static_cast<const Core::Geometry::PolyIndexLayer&>( layer ).collection() );
+        }
+        else {
+            LOG( logINFO ) << "Scene cache : index layer \"" << key.second << "\" of geometry \""
+                           << data.getName() << "\" cannot be cached.";
+            return false;
+        }
+    }
+
+    out.write( data.hasMaterial() );
+    if ( data.hasMaterial() ) {
+        const auto& material = data.getMaterial();
+        if ( material.getType() != "BlinnPhong" ) {
+            LOG( logINFO ) << "Scene cache : material \"" << material.getName() << "\" of type "
+                           << material.getType() << " cannot be cached.";
+            return false;
+        }
+        out.write( material.getName() );
+        visitFields( static_cast<const BlinnPhongMaterialData&>( material ),
+                     [&out]( const auto& field ) { out.write( field ); } );
+    }
+    return true;
+}
+
+std::unique_ptr<GeometryData> readGeometry( Reader& in ) {
+    std::string name;
+    int32_t type { 0 }, primitiveCount { 0 };
+    in.read( name );
+    in.read( type );
+    auto data = std::make_unique<GeometryData>( name, GeometryData::GeometryType( type ) );
+    data->setFrame( readTransform( in ) );
+    in.read( primitiveCount );
+    data->setPrimitiveCount( primitiveCount );
+
+    auto& geometry   = data->getGeometry();
+    const auto count = in.readSize( 1 );
+    for ( size_t i = 0; i < count && in.isValid(); ++i ) {
+        std::string attribName;
+        auto attribType = AttribType::Unknown;
+        in.read( attribName );
+        in.read( attribType );
+        // existing attributes (i.e. positions and normals) must have the cached type.
+        const auto attrib = geometry.getAttribBase( attribName );
+        if ( attrib != nullptr && getAttribType( attrib ) != attribType ) {
+            in.invalidate();
+            break;
+        }
+        switch ( attribType ) {
+        case AttribType::Float:
+            readAttrib<Scalar>( in, geometry, attribName );
+            break;
+        case AttribType::Vector2:
+            readAttrib<Core::Vector2>( in, geometry, attribName );
+            break;
+        case AttribType::Vector3:
+            readAttrib<Core::Vector3>( in, geometry, attribName );
+            break;
+        case AttribType::Vector4:
+            readAttrib<Core::Vector4>( in, geometry, attribName );
+            break;
+        default:
+            in.invalidate();
+        }
+    }
+
+    const auto layerCount = in.readSize( 1 );
+    for ( size_t i = 0; i < layerCount && in.isValid(); ++i ) {
+        std::string semantic, layerName;
+        in.read( semantic );
+        in.read( layerName );
+        if ( semantic == Core::Geometry::PointCloudIndexLayer::staticSemanticName ) {
+            readLayer<Core::Geometry::PointCloudIndexLayer>( in, geometry, layerName );
+        }
+        else if ( semantic == Core::Geometry::LineIndexLayer::staticSemanticName ) {
+            readLayer<Core::Geometry::LineIndexLayer>( in, geometry, layerName );
+        }
+        else if ( semantic == Core::Geometry::TriangleIndexLayer::staticSemanticName ) {
+            readLayer<Core::Geometry::TriangleIndexLayer>( in, geometry, layerName );
+        }
+        else if ( semantic == Core::Geometry::QuadIndexLayer::staticSemanticName ) {
+            readLayer<Core::Geometry::QuadIndexLayer>( in, geometry, layerName );
+        }
+        else if ( semantic == Core::Geometry::PolyIndexLayer::staticSemanticName ) {
+            auto layer = std::make_unique<Core::Geometry::PolyIndexLayer>();
+            readFaces( in, layer->collection() );
+            if ( !geometry.addLayer( std::move( layer ), false, layerName ).first ) {
+                in.invalidate();
+            }
+        }
+        else { in.invalidate(); }
+    }
+
+    bool hasMaterial { false };
+    in.read( hasMaterial );
+    if ( hasMaterial ) {
+        std::string materialName;
+        in.read( materialName );
+        auto material = new BlinnPhongMaterialData( materialName );
+        visitFields( *material, [&in]( auto& field ) { in.read( field ); } );
+        data->setMaterial( material );
+    }
+    return data;
+}
+
+void writeHandle( Writer& out, const HandleData& data ) {
+    out.write( data.getName() );
+    out.write( int32_t( data.getType() ) );
+    out.write( data.getFrame().matrix() );
+    out.write( uint32_t( data.getVertexSize() ) );
+    out.write( data.needsEndNodes() );
+    out.write( uint64_t( data.getBindMeshes().size() ) );
+    for ( const auto& mesh : data.getBindMeshes() ) {
+        out.write( mesh );
+    }
+
+    out.write( uint64_t( data.getComponentData().size() ) );
+    for ( const auto& component : data.getComponentData() ) {
+        out.write( component.m_name );
+        out.write( component.m_frame.matrix() );
+        out.write( uint64_t( component.m_bindMatrices.size() ) );
+        for ( const auto& bind : component.m_bindMatrices ) {
+            out.write( bind.first );
+            out.write( bind.second.matrix() );
+        }
+        out.write( uint64_t( component.m_weights.size() ) );
+        for ( const auto& weights : component.m_weights ) {
+            out.write( weights.first );
+            out.write( uint64_t( weights.second.size() ) );
+            for ( const auto& weight : weights.second ) {
+                out.write( weight.first );
+                out.write( weight.second );
+            }
+        }
+    }
+    out.writeArray( data.getEdgeData() );
+    writeFaces( out, data.getFaceData() );
+}
+
+std::unique_ptr<HandleData> readHandle( Reader& in ) {
+    std::string name;
+    int32_t type { 0 };
+    uint32_t vertexSize { 0 };
+    bool endNodes { false };
+    in.read( name );
+    in.read( type );
+    auto data = std::make_unique<HandleData>( name, HandleData::HandleType( type ) );
+    data->setFrame( readTransform( in ) );
+    in.read( vertexSize );
+    data->setVertexSize( vertexSize );
+    in.read( endNodes );
+    data->needEndNodes( endNodes );
+    const auto meshCount = in.readSize( 1 );
+    for ( size_t i = 0; i < meshCount; ++i ) {
+        std::string mesh;
+        in.read( mesh );
+        data->addBindMesh( mesh );
+    }
+
+    auto& components = data->getComponentData();
+    components.resize( in.readSize( 1 ) );
+    for ( auto& component : components ) {
+        in.read( component.m_name );
+        component.m_frame    = readTransform( in );
+        const auto bindCount = in.readSize( 1 );
+        for ( size_t i = 0; i < bindCount; ++i ) {
+            std::string mesh;
+            in.read( mesh );
+            component.m_bindMatrices[mesh] = readTransform( in );
+        }
+        const auto weightsCount = in.readSize( 1 );
+        for ( size_t i = 0; i < weightsCount; ++i ) {
+            std::string mesh;
+            in.read( mesh );
+            auto& weights = component.m_weights[mesh];
+            weights.resize( in.readSize( sizeof( uint ) + sizeof( Scalar ) ) );
+            for ( auto& weight : weights ) {
+                in.read( weight.first );
+                in.read( weight.second );
+            }
+        }
+    }
+    in.readArray( data->getEdgeData() );
+    readFaces( in, data->getFaceData() );
+    data->recomputeAllIndices();
+    return data;
+}
+
+void writeAnimation( Writer& out, const AnimationData& data ) {
+    out.write( data.getName() );
+    out.write( data.getTime().getStart() );
+    out.write( data.getTime().getEnd() );
+    out.write( data.getTimeStep() );
+    const auto handleAnimations = data.getHandleData();
+    out.write( uint64_t( handleAnimations.size() ) );
+    for ( const auto& animation : handleAnimations ) {
+        out.write( animation.m_name );
+        out.write( animation.m_animationTime.getStart() );
+        out.write( animation.m_animationTime.getEnd() );
+        const auto& keyFrames = animation.m_anim.getKeyFrames();
+        out.write( uint64_t( keyFrames.size() ) );
+        for ( const auto& keyFrame : keyFrames ) {
+            out.write( keyFrame.first );
+            out.write( keyFrame.second.matrix() );
+        }
+    }
+}
+
+std::unique_ptr<AnimationData> readAnimation( Reader& in ) {
+    std::string name;
+    AnimationTime::Time start { 0 }, end { 0 }, timeStep { 0 };
+    in.read( name );
+    in.read( start );
+    in.read( end );
+    in.read( timeStep );
+    auto data = std::make_unique<AnimationData>( name );
+    data->setTime( AnimationTime( start, end ) );
+    data->setTimeStep( timeStep );
+
+    std::vector<HandleAnimation> handleAnimations( in.readSize( 1 ) );
+    for ( auto& animation : handleAnimations ) {
+        in.read( animation.m_name );
+        in.read( start );
+        in.read( end );
+        animation.m_animationTime = AnimationTime( start, end );
+        // a keyframed value has at least one keyframe.
+        const auto count = in.readSize( sizeof( Scalar ) );
+        if ( count == 0 ) {
+            in.invalidate();
+            break;
+        }
+        Scalar time { 0 };
+        in.read( time );
+        animation.m_anim =
+            Core::Animation::KeyFramedValue<Core::Transform>( time, readTransform( in ) );
+        for ( size_t i = 1; i < count; ++i ) {
+            in.read( time );
+            animation.m_anim.insertKeyFrame( time, readTransform( in ) );
+        }
+    }
+    data->setHandleData( handleAnimations );
+    return data;
+}
+
+void writeLight( Writer& out, const LightData& data ) {
+    out.write( data.getName() );
+    out.write( int32_t( data.getType() ) );
+    out.write( data.getFrame() );
+    out.write( data.m_color );
+    switch ( data.getType() ) {
+    case LightData::DIRECTIONAL_LIGHT:
+        out.write( data.m_dirlight );
+        break;
+    case LightData::POINT_LIGHT:
+        out.write( data.m_pointlight );
+        break;
+    case LightData::SPOT_LIGHT:
+        out.write( data.m_spotlight );
+        break;
+    case LightData::AREA_LIGHT:
+        out.write( data.m_arealight );
+        break;
+    default:
+        break;
+    }
+}
+
+std::unique_ptr<LightData> readLight( Reader& in ) {
+    std::string name;
+    int32_t type { 0 };
+    in.read( name );
+    in.read( type );
+    auto data = std::make_unique<LightData>( name, LightData::LightType( type ) );
+    Eigen::Matrix<Scalar, 4, 4> frame;
+    in.read( frame );
+    data->setFrame( frame );
+    in.read( data->m_color );
+    switch ( data->getType() ) {
+    case LightData::DIRECTIONAL_LIGHT:
+        in.read( data->m_dirlight );
+        break;
+    case LightData::POINT_LIGHT:
+        in.read( data->m_pointlight );
+        break;
+    case LightData::SPOT_LIGHT:
+        in.read( data->m_spotlight );
+        break;
+    case LightData::AREA_LIGHT:
+        in.read( data->m_arealight );
+        break;
+    default:
+        break;
+    }
+    return data;
+}
+
+void writeCamera( Writer& out, const Camera& camera ) {
+    out.write( camera.getFrame().matrix() );
+    out.write( int32_t( camera.getType() ) );
+    out.write( camera.getWidth() );
+    out.write( camera.getHeight() );
+    out.write( camera.getZoomFactor() );
+    out.write( camera.getFOV() );
+    out.write( camera.getXYmag().first );
+    out.write( camera.getXYmag().second );
+    out.write( camera.getZNear() );
+    out.write( camera.getZFar() );
+    out.write( camera.getProjMatrix() );
+}
+
+std::unique_ptr<Camera> readCamera( Reader& in ) {
+    auto camera = std::make_unique<Camera>();
+    camera->setFrame( readTransform( in ) );
+    int32_t type { 0 };
+    in.read( type );
+    Scalar width, height, zoom, fov, xmag, ymag, zNear, zFar;
+    for ( auto value : { &width, &height, &zoom, &fov, &xmag, &ymag, &zNear, &zFar } ) {
+        in.read( *value );
+    }
+    camera->setType( Camera::ProjType( type ) );
+    camera->setViewport( width, height );
+    camera->setZoomFactor( zoom );
+    // the field of view and the magnification are deduced from each other by their setters, keep
+    // the one of the projection type.
+    if ( camera->getType() == Camera::ProjType::ORTHOGRAPHIC ) {
+        camera->setFOV( fov );
+        camera->setXYmag( xmag, ymag );
+    }
+    else {
+        camera->setXYmag( xmag, ymag );
+        camera->setFOV( fov );
+    }
+    camera->setZNear( zNear );
+    camera->setZFar( zFar );
+    // the projection matrix may have been given by the loader.
+    Core::Matrix4 projMatrix;
+    in.read( projMatrix );
+    camera->setProjMatrix( projMatrix );
+    return camera;
+}
+
+} // namespace
+
+SceneCacheFileLoader::SceneCacheFileLoader( std::shared_ptr<FileLoaderInterface> loader,
+                                            const std::string& cacheDir ) :
+    m_loader( std::move( loader ) ), m_cacheDir( cacheDir ) {}
+
+SceneCacheFileLoader::~SceneCacheFileLoader() = default;
+
+std::vector<std::string> SceneCacheFileLoader::getFileExtensions() const {
+    return m_loader->getFileExtensions();
+}
+
+bool SceneCacheFileLoader::handleFileExtension( const std::string& extension ) const {
+    return m_loader->handleFileExtension( extension );
+}
+
+FileData* SceneCacheFileLoader::loadFile( const std::string& filename ) {
+    uint64_t sourceHash { 0 };
+    {
+        const MappedFile source( filename );
+        // let the wrapped loader report the error
+        if ( !source.isValid() ) { return m_loader->loadFile( filename ); }
+        sourceHash = hashData( source.data(), source.size() );
+    }
+
+    const auto cacheFile = getCacheFileName( filename );
+    if ( auto fileData = readCache( cacheFile, sourceHash ) ) {
+        fileData->setFileName( filename );
+        LOG( logINFO ) << "File \"" << filename << "\" loaded from scene cache \"" << cacheFile
+                       << "\" in " << fileData->getLoadingTime() << " sec.";
+        return fileData;
+    }
+
+    auto fileData = m_loader->loadFile( filename );
+    if ( fileData != nullptr && writeCache( *fileData, cacheFile, sourceHash ) ) {
+        LOG( logINFO ) << "Scene cache \"" << cacheFile << "\" written.";
+    }
+    return fileData;
+}
+
+std::string SceneCacheFileLoader::name() const {
+    return "SceneCache(" + m_loader->name() + ")";
+}
+
+std::string SceneCacheFileLoader::getCacheFileName( const std::string& filename ) const {
+    if ( m_cacheDir.empty() ) { return filename + "." + cacheExtension; }
+    // distinguish files with the same name in different directories.
+    std::ostringstream cacheFile;
+    cacheFile << m_cacheDir << "/" << getBaseName( filename ) << "." << std::hex
+              << std::setfill( '0' ) << std::setw( 16 )
+              << hashData( filename.data(), filename.size() ) << "." << cacheExtension;
+    return cacheFile.str();
+}
+
+uint64_t SceneCacheFileLoader::hashData( const char* data, size_t size ) {
+    uint64_t hash = 14695981039346656037ull;
+    for ( size_t i = 0; i < size; ++i ) {
+        hash = ( hash ^ uint8_t( data[i] ) ) * 1099511628211ull;
+    }
+    return hash;
+}
+
+bool SceneCacheFileLoader::writeCache( const FileData& data,
+                                       const std::string& cacheFile,
+                                       uint64_t sourceHash ) {
+    if ( !data.m_volumeData.empty() ) {
+        LOG( logINFO ) << "Scene cache : volumes cannot be cached.";
+        return false;
+    }
+
+    // write in a temporary file, so that an interrupted write does not leave a corrupted cache.
+    const std::string tmpFile = cacheFile + ".tmp";
+    bool ok                   = true;
+    {
+        std::ofstream stream( tmpFile, std::ios::binary );
+        if ( !stream ) { return false; }
+        Writer out( stream );
+        Header header;
+        std::memcpy( header.m_magic, cacheMagic, sizeof( header.m_magic ) );
+        header.m_version    = cacheVersion;
+        header.m_scalarSize = uint32_t( sizeof( Scalar ) );
+        header.m_sourceHash = sourceHash;
+        out.write( header );
+
+        out.write( uint64_t( data.m_geometryData.size() ) );
+        for ( const auto& geometry : data.m_geometryData ) {
+            ok = ok && writeGeometry( out, *geometry );
+        }
+        out.write( uint64_t( data.m_handleData.size() ) );
+        for ( const auto& handle : data.m_handleData ) {
+            writeHandle( out, *handle );
+        }
+        out.write( uint64_t( data.m_animationData.size() ) );
+        for ( const auto& animation : data.m_animationData ) {
+            writeAnimation( out, *animation );
+        }
+        out.write( uint64_t( data.m_lightData.size() ) );
+        for ( const auto& light : data.m_lightData ) {
+            writeLight( out, *light );
+        }
+        out.write( uint64_t( data.m_cameraData.size() ) );
+        for ( const auto& camera : data.m_cameraData ) {
+            writeCamera( out, *camera );
+        }
+        stream.close();
+        ok = ok && !stream.fail();
+    }
+
+    if ( ok ) {
+        std::remove( cacheFile.c_str() );
+        ok = std::rename( tmpFile.c_str(), cacheFile.c_str() ) == 0;
+    }
+    if ( !ok ) { std::remove( tmpFile.c_str() ); }
+    return ok;
+}
+
+FileData* SceneCacheFileLoader::readCache( const std::string& cacheFile, uint64_t sourceHash ) {
+    const MappedFile file( cacheFile );
+    if ( !file.isValid() ) { return nullptr; }
+
+    std::clock_t startTime = std::clock();
+    Reader in( file.data(), file.size() );
+    Header header;
+    in.read( header );
+    if ( !in.isValid() || std::memcmp( header.m_magic, cacheMagic, sizeof( cacheMagic ) ) != 0 ||
+         header.m_version != cacheVersion || header.m_scalarSize != sizeof( Scalar ) ) {
+        LOG( logWARNING ) << "Scene cache \"" << cacheFile << "\" has an invalid format.";
+        return nullptr;
+    }
+    // outdated cache
+    if ( header.m_sourceHash != sourceHash ) { return nullptr; }
+
+    auto fileData = std::make_unique<FileData>();
+    // each element is at least 8 bytes long (e.g. the size of a name)
+    fileData->m_geometryData.resize( in.readSize( sizeof( uint64_t ) ) );
+    for ( auto& geometry : fileData->m_geometryData ) {
+        geometry = readGeometry( in );
+    }
+    fileData->m_handleData.resize( in.readSize( sizeof( uint64_t ) ) );
+    for ( auto& handle : fileData->m_handleData ) {
+        handle = readHandle( in );
+    }
+    fileData->m_animationData.resize( in.readSize( sizeof( uint64_t ) ) );
+    for ( auto& animation : fileData->m_animationData ) {
+        animation = readAnimation( in );
+    }
+    fileData->m_lightData.resize( in.readSize( sizeof( uint64_t ) ) );
+    for ( auto& light : fileData->m_lightData ) {
+        light = readLight( in );
+    }
+    fileData->m_cameraData.resize( in.readSize( sizeof( uint64_t ) ) );
+    for ( auto& camera : fileData->m_cameraData ) {
+        camera = readCamera( in );
+    }
+
+    if ( !in.isValid() ) {
+        LOG( logWARNING ) << "Scene cache \"" << cacheFile << "\" is corrupted.";
+        return nullptr;
+    }
+    fileData->m_loadingTime = ( std::clock() - startTime ) / Scalar( CLOCKS_PER_SEC );
+    fileData->m_processed   = true;
+    return fileData.release();
+}
+
+} // namespace IO
+} // namespace Ra
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Core/Asset/FileLoaderInterface.hpp>
+#include <IO/RaIO.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Ra {
+namespace IO {
+
+/**
+ * Loader caching the FileData produced by another loader (e.g. AssimpFileLoader) in a Radium
+ * binary file, written after the first import of a file and loaded instead of it afterwards.
+ *
+ * The cache of a file is valid as long as the content of the file is unchanged: it stores a hash
+ * of the source file, checked at each load. The cache is memory mapped and its arrays (vertex
+ * attributes, indices) are copied at once in the attributes and index layers of the geometries,
+ * so that reloading a file is bounded by the disk bandwidth.
+ *
+ * The cached data are the geometries (attributes, index layers and Blinn-Phong materials), the
+ * handles, the animations, the lights and the cameras. A file with volumes, custom materials or
+ * attributes of a non standard type is not cached, and is loaded by the wrapped loader each time.
+ * \note Files referenced by the source (e.g. textures) are not part of the hash.
+ */
+class RA_IO_API SceneCacheFileLoader : public Core::Asset::FileLoaderInterface
+{
+  public:
+    /// Extension of the cache files.
+    static constexpr const char* cacheExtension = "racache";
+
+    /// Cache the files loaded by \p loader.
+    /// \param cacheDir directory of the cache files, next to the source files if empty.
+    explicit SceneCacheFileLoader( std::shared_ptr<Core::Asset::FileLoaderInterface> loader,
+                                   const std::string& cacheDir = "" );
+
+    ~SceneCacheFileLoader() override;
+
+    std::vector<std::string> getFileExtensions() const override;
+    bool handleFileExtension( const std::string& extension ) const override;
+    Core::Asset::FileData* loadFile( const std::string& filename ) override;
+    std::string name() const override;
+
+    /// Return the name of the cache file of the source file \p filename.
+    std::string getCacheFileName( const std::string& filename ) const;
+
+    /// Hash (64 bits FNV-1a) of a source file content, stored in its cache to validate it.
+    static uint64_t hashData( const char* data, size_t size );
+
+    /// Write \p data in \p cacheFile, tagged with \p sourceHash.
+    /// \return false if the data cannot be cached, or if the file cannot be written.
+    static bool writeCache( const Core::Asset::FileData& data,
+                            const std::string& cacheFile,
+                            uint64_t sourceHash );
+
+    /// Read the cached data from \p cacheFile.
+    /// \return nullptr if the file does not exist, is corrupted, or has not the hash \p sourceHash.
+    static Core::Asset::FileData* readCache( const std::string& cacheFile, uint64_t sourceHash );
+
+  private:
+    std::shared_ptr<Core::Asset::FileLoaderInterface> m_loader;
+    std::string m_cacheDir;
+};
+
+} // namespace IO
+} // namespace Ra
@@ -1,14 +1,21 @@
 #include <IO/TinyPlyLoader/TinyPlyFileLoader.hpp>
 
+#include <IO/MappedFile.hpp>
+
 #include <Core/Asset/FileData.hpp>
 #include <Core/Containers/VectorArray.hpp>
 #include <Core/Geometry/StandardAttribNames.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/Utils/Attribs.hpp>
 
 #include <tinyply.h>
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <set>
 #include <string>
 
 const std::string plyExt( "ply" );
@@ -55,22 +62,6 @@ struct memory_buffer : public std::streambuf {
     }
 };
 
-inline std::vector<uint8_t> read_file_binary( const std::string& pathToFile ) {
-    std::ifstream file( pathToFile, std::ios::binary );
-    std::vector<uint8_t> fileBufferBytes;
-
-    if ( file.is_open() ) {
-        file.seekg( 0, std::ios::end );
-        size_t sizeBytes = file.tellg();
-        file.seekg( 0, std::ios::beg );
-        fileBufferBytes.resize( sizeBytes );
-        if ( file.read( (char*)fileBufferBytes.data(), sizeBytes ) ) return fileBufferBytes;
-    }
-    else
-        throw std::runtime_error( "could not open binary ifstream to path " + pathToFile );
-    return fileBufferBytes;
-}
-
 struct memory_stream : virtual memory_buffer, public std::istream {
     memory_stream( char const* first_elem, size_t size_ ) :
         memory_buffer( first_elem, size_ ), std::istream( static_cast<std::streambuf*>( this ) ) {}
@@ -116,64 +107,203 @@ void copyBufferToContainer( const std::shared_ptr<tinyply::PlyData>& buffer,
     }
 }
 
-FileData* TinyPlyFileLoader::loadFile( const std::string& filename ) {
+namespace {
+/// Read a property of type T at data, which may not be aligned.
+template <typename T>
+inline Scalar readProperty( const char* data ) {
+    T value;
+    std::memcpy( &value, data, sizeof( T ) );
+    return Scalar( value );
+}
 
-    std::unique_ptr<std::istream> file_stream;
-    std::vector<uint8_t> byte_buffer;
-
-    // from https://github.com/ddiakopoulos/tinyply/blob/master/source/example.cpp
-    // For most files < 1gb, pre-loading the entire file upfront and wrapping it into a
-    // stream is a net win for parsing speed, about 40% faster.
-    const bool preload_into_memory = true;
-    if ( preload_into_memory ) {
-        byte_buffer = read_file_binary( filename );
-        file_stream.reset( new memory_stream( (char*)byte_buffer.data(), byte_buffer.size() ) );
+/// Copy a property of the records [begin, end) to out[i * outStride], multiplied by scale.
+template <typename T>
+void gatherProperty( const char* records,
+                     size_t recordSize,
+                     size_t begin,
+                     size_t end,
+                     Scalar* out,
+                     size_t outStride,
+                     Scalar scale ) {
+    for ( size_t i = begin; i < end; ++i ) {
+        out[i * outStride] = scale * readProperty<T>( records + i * recordSize );
     }
-    else { file_stream.reset( new std::ifstream( filename, std::ios::binary ) ); }
+}
 
-    if ( !file_stream || file_stream->fail() ) {
-        LOG( logINFO ) << "[TinyPLY] Could not open file [" << filename << "] Aborting"
-                       << std::endl;
-        return nullptr;
+/// A vertex property of a binary little endian file, and where it is stored in the geometry.
+struct BinaryChannel {
+    /// Offset of the property in the vertex records.
+    size_t m_offset;
+    tinyply::Type m_type;
+    /// First Scalar of the destination container and stride between two vertices.
+    Scalar* m_out;
+    size_t m_outStride;
+    Scalar m_scale;
+};
+
+void gatherChannel( const BinaryChannel& c,
+                    const char* records,
+                    size_t recordSize,
+                    size_t begin,
+                    size_t end ) {
+    records += c.m_offset;
+    switch ( c.m_type ) {
+    case tinyply::Type::INT8:
+        gatherProperty<int8_t>( records, recordSize, begin, end, c.m_out, c.m_outStride, c.m_scale );
+        break;
+    case tinyply::Type::UINT8:
+        gatherProperty<uint8_t>(
+            records, recordSize, begin, end, c.m_out, c.m_outStride, c.m_scale );
+        break;
+    case tinyply::Type::INT16:
+        gatherProperty<int16_t>(
+            records, recordSize, begin, end, c.m_out, c.m_outStride, c.m_scale );
+        break;
+    case tinyply::Type::UINT16:
+        gatherProperty<uint16_t>(
+            records, recordSize, begin, end, c.m_out, c.m_outStride, c.m_scale );
+        break;
+    case tinyply::Type::INT32:
+        gatherProperty<int32_t>(
+            records, recordSize, begin, end, c.m_out, c.m_outStride, c.m_scale );
+        break;
+    case tinyply::Type::UINT32:
+        gatherProperty<uint32_t>(
+            records, recordSize, begin, end, c.m_out, c.m_outStride, c.m_scale );
+        break;
+    case tinyply::Type::FLOAT32:
+        gatherProperty<float>( records, recordSize, begin, end, c.m_out, c.m_outStride, c.m_scale );
+        break;
+    case tinyply::Type::FLOAT64:
+        gatherProperty<double>(
+            records, recordSize, begin, end, c.m_out, c.m_outStride, c.m_scale );
+        break;
+    default:
+        break;
     }
+}
 
-    // Parse the ASCII header fields
-    tinyply::PlyFile file;
-    file.parse_header( *file_stream );
+/// Read the vertices of a binary little endian point cloud directly from the mapped file content,
+/// in parallel, without intermediate buffers.
+/// \param data: content of the file after the header.
+/// \return false if the file layout is not supported, e.g. ascii or big endian files, or lists
+/// before or in the vertex element. Nothing is read in this case.
+bool readBinaryVertices( const char* header,
+                         const char* data,
+                         const char* dataEnd,
+                         const std::vector<tinyply::PlyElement>& elements,
+                         Ra::Core::Geometry::AttribArrayGeometry& geometry ) {
+    const uint16_t one = 1;
+    if ( *reinterpret_cast<const uint8_t*>( &one ) != 1 ||
+         std::string( header, data ).find( "format binary_little_endian" ) == std::string::npos ) {
+        return false;
+    }
 
-    auto elements = file.get_elements();
-    if ( std::any_of( elements.begin(), elements.end(), []( const auto& e ) -> bool {
-             return e.name == "face" && e.size != 0;
-         } ) ) {
-        // Mesh found. Let the other loaders handle it
-        LOG( logINFO ) << "[TinyPLY] Faces found. Aborting" << std::endl;
-        return nullptr;
+    // skip the elements stored before the vertices, which must have a fixed size.
+    const tinyply::PlyElement* vertexElement = nullptr;
+    for ( const auto& e : elements ) {
+        size_t recordSize = 0;
+        for ( const auto& p : e.properties ) {
+            if ( p.isList ) { return false; }
+            recordSize += size_t( tinyply::PropertyTable[p.propertyType].stride );
+        }
+        if ( e.name == "vertex" ) {
+            vertexElement = &e;
+            break;
+        }
+        data += e.size * recordSize;
     }
+    if ( vertexElement == nullptr || vertexElement->size == 0 ) { return false; }
 
-    // we are now sure to have a point-cloud
-    FileData* fileData = new FileData( filename );
-    fileData->setVerbose( true );
+    std::map<std::string, std::pair<size_t, tinyply::Type>> properties;
+    size_t recordSize = 0;
+    for ( const auto& p : vertexElement->properties ) {
+        properties[p.name] = { recordSize, p.propertyType };
+        recordSize += size_t( tinyply::PropertyTable[p.propertyType].stride );
+    }
+    const size_t count = vertexElement->size;
+    if ( data > dataEnd || size_t( dataEnd - data ) / recordSize < count ) {
+        LOG( logWARNING ) << "[TinyPLY] Truncated binary file";
+        return false;
+    }
+    auto hasProperties = [&properties]( const std::vector<std::string>& names ) {
+        return std::all_of( names.begin(), names.end(), [&properties]( const std::string& n ) {
+            return properties.find( n ) != properties.end();
+        } );
+    };
+    if ( !hasProperties( { "x", "y", "z" } ) ) { return false; }
+
+    std::vector<BinaryChannel> channels;
+    auto addChannels = [&properties, &channels]( const std::vector<std::string>& names,
+                                                 Scalar* out,
+                                                 size_t outStride,
+                                                 bool normalize ) {
+        for ( size_t i = 0; i < names.size(); ++i ) {
+            const auto& p = properties[names[i]];
+            // 8 bits colors are stored in [0, 255]
+            const Scalar scale =
+                normalize && p.second == tinyply::Type::UINT8 ? 1_ra / 255_ra : 1_ra;
+            channels.push_back( { p.first, p.second, out + i, outStride, scale } );
+        }
+    };
 
-    if ( !fileData->isInitialized() ) {
-        delete fileData;
-        LOG( logINFO ) << "[TinyPLY] Filedata cannot be initialized...";
-        return nullptr;
+    auto& vertexAttribs = geometry.vertexAttribs();
+    auto unlocker       = vertexAttribs.getScopedLockState();
+
+    auto& vertices = geometry.verticesWithLock();
+    vertices.resize( count );
+    addChannels( { "x", "y", "z" }, vertices.data()->data(), 3, false );
+
+    if ( hasProperties( { "nx", "ny", "nz" } ) ) {
+        auto& normals = geometry.normalsWithLock();
+        normals.resize( count );
+        addChannels( { "nx", "ny", "nz" }, normals.data()->data(), 3, false );
     }
 
-    if ( fileData->isVerbose() ) {
-        LOG( logINFO ) << "[TinyPLY] File Loading begin...";
-        LOG( logINFO ) << "....................................................................";
-        for ( auto c : file.get_comments() )
-            LOG( logINFO ) << "Comment: " << c;
-        for ( auto e : file.get_elements() ) {
-            LOG( logINFO ) << "element - " << e.name << " (" << e.size << ")";
-            for ( auto p : e.properties )
-                LOG( logINFO ) << "\tproperty - " << p.name << " ("
-                               << tinyply::PropertyTable[p.propertyType].str << ")";
+    if ( hasProperties( { "red", "green", "blue" } ) ) {
+        auto handle = vertexAttribs.addAttrib<Ra::Core::Vector4>(
+            Ra::Core::Geometry::getAttribName( Ra::Core::Geometry::MeshAttrib::VERTEX_COLOR ) );
+        auto& colors = vertexAttribs.getDataWithLock( handle );
+        colors.resize( count, Ra::Core::Vector4( 0_ra, 0_ra, 0_ra, 1_ra ) );
+        addChannels( { "red", "green", "blue" }, colors.data()->data(), 4, true );
+        if ( hasProperties( { "alpha" } ) ) {
+            addChannels( { "alpha" }, colors.data()->data() + 3, 4, true );
         }
-        LOG( logINFO ) << "....................................................................";
     }
 
+    const std::set<std::string> usedAttributes {
+        "x", "y", "z", "nx", "ny", "nz", "alpha", "red", "green", "blue" };
+    for ( const auto& p : vertexElement->properties ) {
+        if ( usedAttributes.find( p.name ) != usedAttributes.end() ) { continue; }
+        /// Transform attrib name to valid GLSL identifier
+        auto attribName { p.name };
+        std::replace( attribName.begin(), attribName.end(), '-', '_' );
+        LOG( logINFO ) << "[TinyPLY] Adding custom attrib with name " << attribName << " (was "
+                       << p.name << ")";
+        auto handle     = vertexAttribs.addAttrib<Scalar>( attribName );
+        auto& container = vertexAttribs.getDataWithLock( handle );
+        container.resize( count );
+        addChannels( { p.name }, container.data(), 1, false );
+    }
+
+    // blocks of vertices are processed in parallel, each block being read once for all the
+    // properties while it is in cache.
+    const size_t blockSize = 16384;
+    Ra::Core::parallelFor( size_t( 0 ), ( count + blockSize - 1 ) / blockSize, [&]( size_t b ) {
+        const size_t begin = b * blockSize;
+        const size_t end   = std::min( begin + blockSize, count );
+        for ( const auto& c : channels ) {
+            gatherChannel( c, data, recordSize, begin, end );
+        }
+    } );
+    return true;
+}
+
+/// Read the vertices with tinyply, for the files not handled by readBinaryVertices.
+/// \return false if the file has no vertex.
+bool readVertices( tinyply::PlyFile& file,
+                   std::istream& stream,
+                   Ra::Core::Geometry::AttribArrayGeometry& geometry ) {
     auto initBuffer = [&file]( const std::string& elementKey,
                                const std::vector<std::string> propertyKeys ) {
         std::shared_ptr<tinyply::PlyData> ret;
@@ -187,22 +317,10 @@ FileData* TinyPlyFileLoader::loadFile( const std::string& filename ) {
         return ret;
     };
 
-    auto startTime { std::clock() };
-
-    // a unique name is required by the component messaging system
-    static int nameId { 0 };
-    auto geomData = std::make_unique<GeometryData>( "PC_" + std::to_string( ++nameId ),
-                                                    GeometryData::POINT_CLOUD );
-    geomData->setFrame( Core::Transform::Identity() );
-
     /// request for vertex position
     auto vertBuffer { initBuffer( "vertex", { "x", "y", "z" } ) };
     // if there is no vertex prop, or their count is 0, then quit.
-    if ( !vertBuffer || vertBuffer->count == 0 ) {
-        delete fileData;
-        LOG( logINFO ) << "[TinyPLY] No vertex found";
-        return nullptr;
-    }
+    if ( !vertBuffer || vertBuffer->count == 0 ) { return false; }
     /// request for standard vertex attributes
     /// \todo merge with non standard attributes when all will be stored as Attribs in GeometryData
     auto normalBuffer { initBuffer( "vertex", { "nx", "ny", "nz" } ) };
@@ -226,14 +344,14 @@ FileData* TinyPlyFileLoader::loadFile( const std::string& filename ) {
     }
 
     // read requested buffers (and only those) from file content
-    file.read( *file_stream );
+    file.read( stream );
     {
-        auto unlocker = geomData->getGeometry().vertexAttribs().getScopedLockState();
-        copyBufferToContainer( vertBuffer, geomData->getGeometry().verticesWithLock() );
-        copyBufferToContainer( normalBuffer, geomData->getGeometry().normalsWithLock() );
+        auto unlocker = geometry.vertexAttribs().getScopedLockState();
+        copyBufferToContainer( vertBuffer, geometry.verticesWithLock() );
+        copyBufferToContainer( normalBuffer, geometry.normalsWithLock() );
     }
 
-    auto& vertexAttribs = geomData->getGeometry().vertexAttribs();
+    auto& vertexAttribs = geometry.vertexAttribs();
 
     size_t colorCount = colorBuffer ? colorBuffer->count : 0;
     if ( colorCount != 0 ) {
@@ -280,6 +398,83 @@ FileData* TinyPlyFileLoader::loadFile( const std::string& filename ) {
         copyBufferToContainer( a.second, container );
         vertexAttribs.unlock( handle );
     }
+    return true;
+}
+} // namespace
+
+FileData* TinyPlyFileLoader::loadFile( const std::string& filename ) {
+
+    // The file is memory mapped rather than read in a buffer: binary little endian vertices are
+    // copied from the mapping directly to the geometry, other files are parsed by tinyply from a
+    // stream over the mapping.
+    const MappedFile mappedFile( filename );
+    std::unique_ptr<std::istream> file_stream;
+    if ( mappedFile.isValid() ) {
+        file_stream.reset( new memory_stream( mappedFile.data(), mappedFile.size() ) );
+    }
+
+    if ( !file_stream || file_stream->fail() ) {
+        LOG( logINFO ) << "[TinyPLY] Could not open file [" << filename << "] Aborting"
+                       << std::endl;
+        return nullptr;
+    }
+
+    // Parse the ASCII header fields
+    tinyply::PlyFile file;
+    file.parse_header( *file_stream );
+
+    auto elements = file.get_elements();
+    if ( std::any_of( elements.begin(), elements.end(), []( const auto& e ) -> bool {
+             return e.name == "face" && e.size != 0;
+         } ) ) {
+        // Mesh found. Let the other loaders handle it
+        LOG( logINFO ) << "[TinyPLY] Faces found. Aborting" << std::endl;
+        return nullptr;
+    }
+
+    // we are now sure to have a point-cloud
+    FileData* fileData = new FileData( filename );
+    fileData->setVerbose( true );
+
+    if ( !fileData->isInitialized() ) {
+        delete fileData;
+        LOG( logINFO ) << "[TinyPLY] Filedata cannot be initialized...";
+        return nullptr;
+    }
+
+    if ( fileData->isVerbose() ) {
+        LOG( logINFO ) << "[TinyPLY] File Loading begin...";
+        LOG( logINFO ) << "....................................................................";
+        for ( auto c : file.get_comments() )
+            LOG( logINFO ) << "Comment: " << c;
+        for ( auto e : file.get_elements() ) {
+            LOG( logINFO ) << "element - " << e.name << " (" << e.size << ")";
+            for ( auto p : e.properties )
+                LOG( logINFO ) << "\tproperty - " << p.name << " ("
+                               << tinyply::PropertyTable[p.propertyType].str << ")";
+        }
+        LOG( logINFO ) << "....................................................................";
+    }
+
+    auto startTime { std::clock() };
+
+    // a unique name is required by the component messaging system
+    static int nameId { 0 };
+    auto geomData = std::make_unique<GeometryData>( "PC_" + std::to_string( ++nameId ),
+                                                    GeometryData::POINT_CLOUD );
+    geomData->setFrame( Core::Transform::Identity() );
+
+    const char* dataBegin = mappedFile.data() + std::streamoff( file_stream->tellg() );
+    if ( !readBinaryVertices( mappedFile.data(),
+                              dataBegin,
+                              mappedFile.data() + mappedFile.size(),
+                              elements,
+                              geomData->getGeometry() ) &&
+         !readVertices( file, *file_stream, geomData->getGeometry() ) ) {
+        delete fileData;
+        LOG( logINFO ) << "[TinyPLY] No vertex found";
+        return nullptr;
+    }
 
     fileData->m_geometryData.clear();
     fileData->m_geometryData.reserve( 1 );
@@ -4,11 +4,17 @@
 
 #include <Core/Asset/FileData.hpp>
 #include <Core/Geometry/Volume.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/Utils/Log.hpp>
 
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <numeric>
 
 namespace Ra {
 namespace IO {
@@ -48,11 +54,97 @@ bool checkExpected( const std::string& expected, const std::string& found ) {
     return true;
 }
 
+namespace {
+/// Parse the value at the beginning of [it, end).
+/// Return the position after the value, or nullptr if no value could be parsed.
+/// \note buffer must be null terminated when floating point std::from_chars is not available.
+inline const char* parseScalar( const char* it, const char* end, Scalar& value ) {
+#if defined( __cpp_lib_to_chars )
+    // std::from_chars does not accept the leading '+' that strtod accepts.
+    if ( it != end && *it == '+' ) {
+        ++it;
+        if ( it != end && *it == '-' ) { return nullptr; }
+    }
+    const auto res = std::from_chars( it, end, value );
+    return res.ec == std::errc() ? res.ptr : nullptr;
+#else
+    char* last = nullptr;
+    value      = Scalar( std::strtod( it, &last ) );
+    return ( last == it || last > end ) ? nullptr : last;
+#endif
+}
+
+inline bool isSpace( char c ) {
+    return std::isspace( static_cast<unsigned char>( c ) ) != 0;
+}
+
+/// Parse the white space separated values of [begin, end) into data, which must hold exactly
+/// data.size() values.
+/// The buffer is split in chunks, whose values are counted and then parsed in parallel.
+bool parseScalars( const char* begin, const char* end, std::vector<Scalar>& data ) {
+    constexpr size_t chunkSize = 1 << 20;
+    const size_t numChunks     = std::max( size_t( 1 ), size_t( end - begin ) / chunkSize );
+    // chunk bounds are moved to the next white space so that values are not split.
+    std::vector<const char*> bounds( numChunks + 1, end );
+    bounds[0] = begin;
+    for ( size_t c = 1; c < numChunks; ++c ) {
+        const char* it = std::max( bounds[c - 1], begin + c * ( ( end - begin ) / numChunks ) );
+        while ( it != end && !isSpace( *it ) ) {
+            ++it;
+        }
+        bounds[c] = it;
+    }
+
+    std::vector<size_t> offsets( numChunks + 1, 0 );
+    parallelFor( size_t( 0 ), numChunks, [&bounds, &offsets]( size_t c ) {
+        size_t count = 0;
+        bool inValue = false;
+        for ( const char* it = bounds[c]; it != bounds[c + 1]; ++it ) {
+            const bool space = isSpace( *it );
+            if ( !space && !inValue ) { ++count; }
+            inValue = !space;
+        }
+        offsets[c + 1] = count;
+    } );
+    std::partial_sum( offsets.begin(), offsets.end(), offsets.begin() );
+    if ( offsets.back() != data.size() ) {
+        LOG( logWARNING ) << "\tVolumeLoader : found " << offsets.back() << " density values, "
+                          << data.size() << " were expected";
+        return false;
+    }
+
+    std::vector<char> valid( numChunks, 1 );
+    parallelFor( size_t( 0 ), numChunks, [&]( size_t c ) {
+        const char* it   = bounds[c];
+        const char* last = bounds[c + 1];
+        Scalar* value    = data.data() + offsets[c];
+        while ( it != last ) {
+            if ( isSpace( *it ) ) {
+                ++it;
+                continue;
+            }
+            const char* next = parseScalar( it, last, *value++ );
+            // a value must be followed by a white space.
+            if ( next == nullptr || ( next != last && !isSpace( *next ) ) ) {
+                valid[c] = 0;
+                return;
+            }
+            it = next;
+        }
+    } );
+    if ( std::find( valid.begin(), valid.end(), 0 ) != valid.end() ) {
+        LOG( logWARNING ) << "\tVolumeLoader : invalid density value";
+        return false;
+    }
+    return true;
+}
+} // namespace
+
 Ra::Core::Asset::FileData* VolumeLoader::loadVolFile( const std::string& filename ) {
     LOG( logINFO ) << "VolumeLoader : loading vol (pbrt based) file " << filename;
     std::ifstream input( filename );
     if ( input.is_open() ) {
-        auto fileData = new Ra::Core::Asset::FileData( filename );
+        auto fileData = std::make_unique<Ra::Core::Asset::FileData>( filename );
         std::string attribname;
         auto sigma_a = readColor( input, attribname );
         if ( !checkExpected( "sigma_a", attribname ) ) { return nullptr; }
@@ -76,25 +168,30 @@ Ra::Core::Asset::FileData* VolumeLoader::loadVolFile( const std::string& filenam
                        << sz;
 
         Ra::Core::Vector3 voxelSize { 1_ra, 1_ra, 1_ra };
-        auto density = new Geometry::VolumeGrid();
+        auto density = std::make_unique<Geometry::VolumeGrid>();
         density->setSize( Vector3i( sx, sy, sz ) );
         density->setBinSize( voxelSize );
-        std::generate( density->data().begin(), density->data().end(), [&input]() {
-            Scalar v;
-            input >> v;
-            return v;
-        } );
-
-        input >> end;
-        if ( end != ']' ) {
-            LOG( logWARNING ) << "\tVolumeLoader : unexpected end of density grid delimiter "
-                              << end;
+
+        // read the density values at once and parse them in parallel, which is much faster than
+        // extracting them one by one from the stream.
+        const auto start = input.tellg();
+        input.seekg( 0, std::ios::end );
+        std::string buffer( size_t( input.tellg() - start ), '\0' );
+        input.seekg( start );
+        input.read( &buffer[0], std::streamsize( buffer.size() ) );
+        buffer.resize( size_t( input.gcount() ) );
+        const auto endPos = buffer.find( ']' );
+        if ( endPos == std::string::npos ) {
+            LOG( logWARNING ) << "\tVolumeLoader : missing end of density grid delimiter";
+            return nullptr;
+        }
+        if ( !parseScalars( buffer.data(), buffer.data() + endPos, density->data() ) ) {
             return nullptr;
         }
         LOG( logINFO ) << "\tVolumeLoader : done reading";
 
         auto volume = new Asset::VolumeData( filename.substr( filename.find_last_of( '/' ) + 1 ) );
-        volume->volume  = density;
+        volume->volume  = density.release();
         volume->sigma_a = sigma_a;
         volume->sigma_s = sigma_s;
         Scalar maxDim   = std::max( std::max( sx, sy ), sz );
@@ -104,7 +201,7 @@ Ra::Core::Asset::FileData* VolumeLoader::loadVolFile( const std::string& filenam
         volume->densityToModel = Transform::Identity(); // Eigen::Scaling( 1_ra / maxDim );
         volume->modelToWorld   = Eigen::Scaling( 1_ra / maxDim ); // Transform::Identity();
         fileData->m_volumeData.push_back( std::unique_ptr<Ra::Core::Asset::VolumeData>( volume ) );
-        return fileData;
+        return fileData.release();
     }
     LOG( logWARNING ) << "VolumeLoader : unable to open file " << filename;
     return nullptr;
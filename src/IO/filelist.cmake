@@ -4,9 +4,11 @@
 # from ./scripts directory
 # ----------------------------------------------------
 
-set(io_sources CameraLoader/CameraLoader.cpp)
+set(io_sources CameraLoader/CameraLoader.cpp MappedFile.cpp SceneCache/SceneCacheFileLoader.cpp)
 
-set(io_headers CameraLoader/CameraLoader.hpp RaIO.hpp)
+set(io_headers CameraLoader/CameraLoader.hpp MappedFile.hpp RaIO.hpp
+               SceneCache/SceneCacheFileLoader.hpp
+)
 
 if(RADIUM_IO_DEPRECATED)
     list(APPEND io_sources deprecated/OBJFileManager.cpp deprecated/OFFFileManager.cpp)
@@ -0,0 +1,97 @@
+#include <Core/Geometry/Bvh.hpp>
+#include <Core/Geometry/DistanceQueries.hpp>
+#include <Core/Geometry/KdTree.hpp>
+#include <Core/Geometry/TriangleMesh.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace Ra::Core;
+
+namespace {
+/// Height field of ( n - 1 ) x ( n - 1 ) quads over [-1,1]^2, similar to a scanned terrain.
+Geometry::TriangleMesh makeHeightField( uint n ) {
+    Vector3Array vertices;
+    Geometry::TriangleMesh::IndexContainerType triangles;
+    for ( uint i = 0; i < n; ++i ) {
+        for ( uint j = 0; j < n; ++j ) {
+            const Scalar x = 2_ra * i / ( n - 1 ) - 1_ra;
+            const Scalar y = 2_ra * j / ( n - 1 ) - 1_ra;
+            vertices.emplace_back( x, y, 0.2_ra * std::sin( 5 * x ) * std::cos( 7 * y ) );
+        }
+    }
+    for ( uint i = 0; i + 1 < n; ++i ) {
+        for ( uint j = 0; j + 1 < n; ++j ) {
+            const uint v = i * n + j;
+            triangles.emplace_back( v, v + n, v + 1 );
+            triangles.emplace_back( v + 1, v + n, v + n + 1 );
+        }
+    }
+    Geometry::TriangleMesh mesh;
+    mesh.setVertices( std::move( vertices ) );
+    mesh.setIndices( std::move( triangles ) );
+    return mesh;
+}
+} // namespace
+
+TEST_CASE( "Core/Geometry/DistanceQueries", "[Core][Geometry][DistanceQueries]" ) {
+    // 500k triangles, 250k vertices, 100k query points around the surface.
+    const auto mesh      = makeHeightField( 501 );
+    const auto& vertices = mesh.vertices();
+    const auto& indices  = mesh.getIndices();
+    Vector3Array queries( 100000 );
+    for ( auto& q : queries ) {
+        q    = Vector3::Random();
+        q[2] = 0.2_ra * std::sin( 5 * q[0] ) * std::cos( 7 * q[1] ) + 0.05_ra * q[2];
+    }
+
+    Geometry::Bvh bvh( mesh );
+    Geometry::KdTree tree( mesh );
+
+    // brute force is too slow for 100k points, multiply by 1e4 to compare.
+    BENCHMARK( "brute force closest point, 10 points" ) {
+        Scalar sum = 0;
+        for ( uint i = 0; i < 10; ++i ) {
+            Scalar best = std::numeric_limits<Scalar>::max();
+            for ( const auto& t : indices ) {
+                best = std::min( best,
+                                 Geometry::pointToTriSq(
+                                     queries[i], vertices[t[0]], vertices[t[1]], vertices[t[2]] )
+                                     .distanceSquared );
+            }
+            sum += best;
+        }
+        return sum;
+    };
+    BENCHMARK( "bvh closest point, 100k points" ) {
+        Scalar sum = 0;
+        Geometry::Bvh::Projection projection;
+        for ( const auto& q : queries ) {
+            if ( bvh.closestPoint( q, projection ) ) { sum += projection.m_distanceSquared; }
+        }
+        return sum;
+    };
+
+    BENCHMARK( "kd-tree build" ) { return Geometry::KdTree( mesh ); };
+    BENCHMARK( "kd-tree 8 nearest vertices, 100k points" ) {
+        size_t count = 0;
+        std::vector<uint> indicesOut;
+        std::vector<Scalar> distancesOut;
+        for ( const auto& q : queries ) {
+            tree.kNearest( q, 8, indicesOut, distancesOut );
+            count += indicesOut.size();
+        }
+        return count;
+    };
+    BENCHMARK( "kd-tree radius 0.01, 100k points" ) {
+        size_t count = 0;
+        std::vector<uint> indicesOut;
+        for ( const auto& q : queries ) {
+            tree.radiusSearch( q, 0.01_ra, indicesOut );
+            count += indicesOut.size();
+        }
+        return count;
+    };
+}
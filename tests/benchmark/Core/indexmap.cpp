@@ -0,0 +1,82 @@
+#include <Core/Utils/IndexMap.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using Ra::Core::Utils::Index;
+using Ra::Core::Utils::IndexMap;
+
+namespace {
+/// Payload similar to the render objects held by the RenderObjectManager.
+using Payload = std::shared_ptr<int>;
+
+void benchmarkIndexMap( int numElements ) {
+    const std::string suffix = ", " + std::to_string( numElements ) + " elements";
+
+    // removal order, to avoid removing always the first or last element.
+    std::vector<Index> order;
+    {
+        IndexMap<Payload> map;
+        for ( int i = 0; i < numElements; ++i ) {
+            order.push_back( map.insert( std::make_shared<int>( i ) ) );
+        }
+        std::shuffle( order.begin(), order.end(), std::mt19937( 42 ) );
+    }
+
+    // insert and remove need a fresh map for each run.
+    BENCHMARK_ADVANCED( "insert" + suffix )( Catch::Benchmark::Chronometer meter ) {
+        std::vector<IndexMap<Payload>> maps( meter.runs() );
+        const auto payload = std::make_shared<int>( 0 );
+        meter.measure( [&maps, &payload, numElements]( int run ) {
+            for ( int i = 0; i < numElements; ++i ) {
+                maps[run].insert( payload );
+            }
+        } );
+    };
+
+    BENCHMARK_ADVANCED( "remove" + suffix )( Catch::Benchmark::Chronometer meter ) {
+        std::vector<IndexMap<Payload>> maps( meter.runs() );
+        const auto payload = std::make_shared<int>( 0 );
+        for ( auto& map : maps ) {
+            for ( int i = 0; i < numElements; ++i ) {
+                map.insert( payload );
+            }
+        }
+        meter.measure( [&maps, &order]( int run ) {
+            for ( const auto& idx : order ) {
+                maps[run].remove( idx );
+            }
+        } );
+    };
+
+    IndexMap<Payload> map;
+    for ( int i = 0; i < numElements; ++i ) {
+        map.insert( std::make_shared<int>( i ) );
+    }
+    BENCHMARK( "lookup" + suffix ) {
+        long sum = 0;
+        for ( const auto& idx : order ) {
+            sum += *map.at( idx );
+        }
+        return sum;
+    };
+    BENCHMARK( "iterate" + suffix ) {
+        long sum = 0;
+        for ( const auto& p : map ) {
+            sum += *p;
+        }
+        return sum;
+    };
+}
+} // namespace
+
+TEST_CASE( "Core/Utils/IndexMap", "[Core][Core/Utils][IndexMap]" ) {
+    benchmarkIndexMap( 1000 );
+    benchmarkIndexMap( 100000 );
+    benchmarkIndexMap( 1000000 );
+}
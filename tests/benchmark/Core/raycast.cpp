@@ -0,0 +1,97 @@
+#include <Core/Geometry/Bvh.hpp>
+#include <Core/Geometry/RayCast.hpp>
+#include <Core/Geometry/TriangleMesh.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace Ra::Core;
+using Geometry::Bvh;
+
+namespace {
+/// Height field of ( n - 1 ) x ( n - 1 ) quads over [-1,1]^2, similar to a scanned terrain.
+Geometry::TriangleMesh makeHeightField( uint n ) {
+    Vector3Array vertices;
+    Geometry::TriangleMesh::IndexContainerType triangles;
+    for ( uint i = 0; i < n; ++i ) {
+        for ( uint j = 0; j < n; ++j ) {
+            const Scalar x = 2_ra * i / ( n - 1 ) - 1_ra;
+            const Scalar y = 2_ra * j / ( n - 1 ) - 1_ra;
+            vertices.emplace_back( x, y, 0.2_ra * std::sin( 5 * x ) * std::cos( 7 * y ) );
+        }
+    }
+    for ( uint i = 0; i + 1 < n; ++i ) {
+        for ( uint j = 0; j + 1 < n; ++j ) {
+            const uint v = i * n + j;
+            triangles.emplace_back( v, v + n, v + 1 );
+            triangles.emplace_back( v + 1, v + n, v + n + 1 );
+        }
+    }
+    Geometry::TriangleMesh mesh;
+    mesh.setVertices( std::move( vertices ) );
+    mesh.setIndices( std::move( triangles ) );
+    return mesh;
+}
+
+/// numRays x numRays rays shot from above to the height field, in scanline order.
+std::vector<Ray> makeRays( uint numRays ) {
+    std::vector<Ray> rays;
+    rays.reserve( numRays * numRays );
+    for ( uint i = 0; i < numRays; ++i ) {
+        for ( uint j = 0; j < numRays; ++j ) {
+            const Vector3 target( 2_ra * i / numRays - 1_ra, 2_ra * j / numRays - 1_ra, 0_ra );
+            const Vector3 origin( 0_ra, 0_ra, 3_ra );
+            rays.emplace_back( origin, ( target - origin ).normalized() );
+        }
+    }
+    return rays;
+}
+} // namespace
+
+TEST_CASE( "Core/Geometry/Bvh", "[Core][Geometry][Bvh]" ) {
+    // 500k triangles, 1M rays
+    const auto mesh = makeHeightField( 501 );
+    const auto rays = makeRays( 1000 );
+    Bvh bvh( mesh );
+    std::vector<Bvh::Hit> hits;
+
+    // brute force is too slow for 1M rays, multiply by 1e5 to compare.
+    BENCHMARK( "brute force, 10 rays" ) {
+        uint numHits = 0;
+        for ( uint r = 0; r < 10; ++r ) {
+            std::vector<Scalar> t;
+            std::vector<Vector3ui> tri;
+            numHits += Geometry::RayCastTriangleMesh( rays[r * 100003], mesh, t, tri ) ? 1 : 0;
+        }
+        return numHits;
+    };
+    BENCHMARK( "build" ) { return Bvh( mesh ); };
+    BENCHMARK( "refit" ) { bvh.refit( mesh.vertices() ); };
+    BENCHMARK( "closest hit, 1M rays" ) {
+        uint numHits = 0;
+        Bvh::Hit hit;
+        for ( const auto& ray : rays ) {
+            numHits += bvh.closestHit( ray, hit ) ? 1 : 0;
+        }
+        return numHits;
+    };
+    BENCHMARK( "any hit, 1M rays" ) {
+        uint numHits = 0;
+        for ( const auto& ray : rays ) {
+            numHits += bvh.anyHit( ray ) ? 1 : 0;
+        }
+        return numHits;
+    };
+    BENCHMARK( "packets, 1M rays" ) { bvh.closestHits( rays, hits ); };
+
+    TaskQueue taskQueue( std::max( 1u, std::thread::hardware_concurrency() - 1 ) );
+    setParallelTaskQueue( &taskQueue );
+    BENCHMARK( "packets, 1M rays, task queue threads" ) { bvh.closestHits( rays, hits ); };
+    setParallelTaskQueue( nullptr );
+}
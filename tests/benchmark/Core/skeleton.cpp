@@ -0,0 +1,112 @@
+#include <Core/Animation/Skeleton.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <stack>
+#include <thread>
+
+using namespace Ra::Core;
+using namespace Ra::Core::Animation;
+
+namespace {
+/// Previous implementation of Skeleton::setPose( pose, LOCAL ): walk the children lists.
+void childrenLocalToModel( const AdjacencyList& graph, const Pose& local, Pose& model ) {
+    model.resize( local.size() );
+    for ( uint i = 0; i < graph.size(); ++i ) {
+        if ( graph.isRoot( i ) ) { model[i] = local[i]; }
+        for ( const auto& child : graph.children()[i] ) {
+            model[child] = model[i] * local[child];
+        }
+    }
+}
+
+/// Previous implementation of Skeleton::setLocalTransform: depth first traversal with a stack.
+void stackLocalTransform( const AdjacencyList& graph, uint i, Pose& local, Pose& model ) {
+    model[i] = model[graph.parents()[i]] * local[i];
+    std::stack<uint> stack;
+    stack.push( i );
+    while ( !stack.empty() ) {
+        uint parent = stack.top();
+        stack.pop();
+        for ( const auto& child : graph.children()[parent] ) {
+            model[child] = model[parent] * local[child];
+            stack.push( child );
+        }
+    }
+}
+} // namespace
+
+TEST_CASE( "Core/Animation/Skeleton", "[Core][Animation][Skeleton]" ) {
+    // facial rig like skeleton: 800 joints, random hierarchy.
+    const uint numBones = 800;
+    std::mt19937 gen( 42 );
+    std::uniform_real_distribution<Scalar> dist( -1_ra, 1_ra );
+    auto randomTransform = [&]() {
+        Transform T = Transform::Identity();
+        T.translate( Vector3( dist( gen ), dist( gen ), dist( gen ) ) );
+        T.rotate( AngleAxis( dist( gen ), Vector3::UnitZ() ) );
+        return T;
+    };
+    Skeleton skel;
+    skel.addRoot( randomTransform() );
+    for ( uint i = 1; i < numBones; ++i ) {
+        skel.addBone( std::uniform_int_distribution<uint>( 0, i - 1 )( gen ), randomTransform() );
+    }
+    const Pose local = skel.getPose( HandleArray::SpaceType::LOCAL );
+    Pose model       = skel.getPose( HandleArray::SpaceType::MODEL );
+
+    BENCHMARK( "children lists local to model, 800 joints" ) {
+        childrenLocalToModel( skel.m_graph, local, model );
+        return model[numBones - 1].translation().x();
+    };
+    BENCHMARK( "setPose local, 800 joints" ) {
+        skel.setPose( local, HandleArray::SpaceType::LOCAL );
+        return skel.getTransform( numBones - 1, HandleArray::SpaceType::MODEL ).translation().x();
+    };
+    BENCHMARK( "setPose model, 800 joints" ) {
+        skel.setPose( model, HandleArray::SpaceType::MODEL );
+        return skel.getTransform( numBones - 1, HandleArray::SpaceType::LOCAL ).translation().x();
+    };
+
+    // first child of the root, moving its whole subtree.
+    const uint bone = skel.m_graph.children()[0][0];
+    Pose stackLocal = local;
+    BENCHMARK( "stack traversal local transform, 800 joints" ) {
+        stackLocalTransform( skel.m_graph, bone, stackLocal, model );
+        return model[numBones - 1].translation().x();
+    };
+    BENCHMARK( "setTransform local, 800 joints" ) {
+        skel.setTransform( bone, local[bone], HandleArray::SpaceType::LOCAL );
+        return skel.getTransform( numBones - 1, HandleArray::SpaceType::MODEL ).translation().x();
+    };
+
+    // 100 instances of the rig.
+    const uint numSkeletons = 100;
+    Pose localPoses;
+    for ( uint k = 0; k < numSkeletons; ++k ) {
+        localPoses.insert( localPoses.end(), local.begin(), local.end() );
+    }
+    Pose modelPoses;
+    BENCHMARK( "setPose local, 100 skeletons" ) {
+        for ( uint k = 0; k < numSkeletons; ++k ) {
+            skel.setPose( local, HandleArray::SpaceType::LOCAL );
+        }
+        return skel.getTransform( numBones - 1, HandleArray::SpaceType::MODEL ).translation().x();
+    };
+    BENCHMARK( "computeModelPoses, 100 skeletons" ) {
+        skel.computeModelPoses( localPoses, modelPoses );
+        return modelPoses.back().translation().x();
+    };
+
+    TaskQueue taskQueue( std::max( 1u, std::thread::hardware_concurrency() - 1 ) );
+    setParallelTaskQueue( &taskQueue );
+    BENCHMARK( "computeModelPoses, 100 skeletons, task queue threads" ) {
+        skel.computeModelPoses( localPoses, modelPoses );
+        return modelPoses.back().translation().x();
+    };
+    setParallelTaskQueue( nullptr );
+}
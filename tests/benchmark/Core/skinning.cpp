@@ -0,0 +1,109 @@
+#include <Core/Animation/HandleWeightOperation.hpp>
+#include <Core/Animation/LinearBlendSkinning.hpp>
+#include <Core/Animation/SkinningData.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace Ra::Core;
+using namespace Ra::Core::Animation;
+
+namespace {
+/// Previous implementation : scatter the influences of the sparse weight matrix, column by column
+/// (sequential since the parallel version races on the vertices).
+void sparseLinearBlendSkinning( const SkinningRefData& refData,
+                                const Vector3Array& tangents,
+                                const Vector3Array& bitangents,
+                                SkinningFrameData& frameData ) {
+    const auto& W          = refData.m_weights;
+    const auto& vertices   = refData.m_referenceMesh.vertices();
+    const auto& normals    = refData.m_referenceMesh.normals();
+    const auto& bindMatrix = refData.m_bindMatrices;
+    const auto& pose       = frameData.m_skeleton.getPose( HandleArray::SpaceType::MODEL );
+    for ( size_t i = 0; i < frameData.m_currentPosition.size(); ++i ) {
+        frameData.m_currentPosition[i]  = Vector3::Zero();
+        frameData.m_currentNormal[i]    = Vector3::Zero();
+        frameData.m_currentTangent[i]   = Vector3::Zero();
+        frameData.m_currentBitangent[i] = Vector3::Zero();
+    }
+    for ( int k = 0; k < W.outerSize(); ++k ) {
+        for ( WeightMatrix::InnerIterator it( W, k ); it; ++it ) {
+            const uint i      = it.row();
+            const uint j      = it.col();
+            const Scalar w    = it.value();
+            const Transform M = refData.m_meshTransformInverse * pose[j] * bindMatrix[j];
+            frameData.m_currentPosition[i] += w * ( M * vertices[i] );
+            frameData.m_currentNormal[i] += w * ( M.linear() * normals[i] );
+            frameData.m_currentTangent[i] += w * ( M.linear() * tangents[i] );
+            frameData.m_currentBitangent[i] += w * ( M.linear() * bitangents[i] );
+        }
+    }
+}
+
+Transform randomTransform() {
+    Transform t( Eigen::AngleAxis( Scalar( Vector3::Random()[0] * M_PI ),
+                                   Vector3::Random().normalized() ) );
+    t.translation() = Vector3::Random();
+    return t;
+}
+} // namespace
+
+TEST_CASE( "Core/Animation/LinearBlendSkinning", "[Core][Animation][LinearBlendSkinning]" ) {
+    // 1M vertices influenced by up to 4 out of 64 bones.
+    const int numVertices = 1000000;
+    const int numBones    = 64;
+
+    SkinningRefData refData;
+    SkinningFrameData frameData;
+    Vector3Array vertices( numVertices ), normals( numVertices );
+    for ( int i = 0; i < numVertices; ++i ) {
+        vertices[i] = Vector3::Random();
+        normals[i]  = Vector3::Random().normalized();
+    }
+    const Vector3Array tangents   = normals;
+    const Vector3Array bitangents = normals;
+    refData.m_referenceMesh.setVertices( vertices );
+    refData.m_referenceMesh.setNormals( normals );
+    refData.m_meshTransformInverse = Transform::Identity();
+    for ( int j = 0; j < numBones; ++j ) {
+        refData.m_skeleton.addRoot( Transform::Identity() );
+        refData.m_bindMatrices.push_back( randomTransform() );
+        frameData.m_skeleton.addRoot( randomTransform() );
+    }
+
+    refData.m_weights.resize( numVertices, numBones );
+    std::vector<Eigen::Triplet<Scalar>> triplets;
+    for ( int i = 0; i < numVertices; ++i ) {
+        const int bone          = ( i / 1000 ) % numBones;
+        const int numInfluences = 1 + i % 4;
+        for ( int k = 0; k < numInfluences; ++k ) {
+            triplets.emplace_back( i, ( bone + k ) % numBones, 1_ra / numInfluences );
+        }
+    }
+    refData.m_weights.setFromTriplets( triplets.begin(), triplets.end() );
+    refData.m_packedWeights = packWeights( refData.m_weights );
+
+    frameData.m_currentPosition.resize( numVertices );
+    frameData.m_currentNormal.resize( numVertices );
+    frameData.m_currentTangent.resize( numVertices );
+    frameData.m_currentBitangent.resize( numVertices );
+
+    BENCHMARK( "sparse scatter" ) {
+        sparseLinearBlendSkinning( refData, tangents, bitangents, frameData );
+    };
+    BENCHMARK( "packed gather, 1 thread" ) {
+        linearBlendSkinning( refData, tangents, bitangents, frameData );
+    };
+
+    TaskQueue taskQueue( std::max( 1u, std::thread::hardware_concurrency() - 1 ) );
+    setParallelTaskQueue( &taskQueue );
+    BENCHMARK( "packed gather, task queue threads" ) {
+        linearBlendSkinning( refData, tangents, bitangents, frameData );
+    };
+    setParallelTaskQueue( nullptr );
+}
@@ -0,0 +1,90 @@
+#include <Core/Tasks/Task.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace Ra::Core;
+
+namespace {
+// Small amount of work, comparable to a per-component animation task.
+void work( std::atomic<int>& counter ) {
+    volatile int sum = 0;
+    for ( int i = 0; i < 200; ++i ) {
+        sum = sum + i;
+    }
+    ++counter;
+}
+
+TaskQueue::TaskId addTask( TaskQueue& queue, std::atomic<int>& counter, const std::string& name ) {
+    return queue.registerTask(
+        std::make_unique<FunctionTask>( [&counter]() { work( counter ); }, name ) );
+}
+
+/// numTasks independent tasks.
+void buildWide( TaskQueue& queue, std::atomic<int>& counter, int numTasks ) {
+    for ( int i = 0; i < numTasks; ++i ) {
+        addTask( queue, counter, "wide" );
+    }
+}
+
+/// numChains chains of length tasks.
+void buildDeep( TaskQueue& queue, std::atomic<int>& counter, int numChains, int length ) {
+    for ( int c = 0; c < numChains; ++c ) {
+        TaskQueue::TaskId prev = addTask( queue, counter, "deep" );
+        for ( int i = 1; i < length; ++i ) {
+            TaskQueue::TaskId cur = addTask( queue, counter, "deep" );
+            queue.addDependency( prev, cur );
+            prev = cur;
+        }
+    }
+}
+
+/// numDiamonds sequential diamonds, each one fanning out to width tasks and joining back.
+void buildDiamond( TaskQueue& queue, std::atomic<int>& counter, int numDiamonds, int width ) {
+    TaskQueue::TaskId source = addTask( queue, counter, "diamond" );
+    for ( int d = 0; d < numDiamonds; ++d ) {
+        TaskQueue::TaskId sink = addTask( queue, counter, "diamond" );
+        for ( int i = 0; i < width; ++i ) {
+            TaskQueue::TaskId mid = addTask( queue, counter, "diamond" );
+            queue.addDependency( source, mid );
+            queue.addDependency( mid, sink );
+        }
+        source = sink;
+    }
+}
+
+template <typename Builder>
+int runFrame( TaskQueue& queue, Builder&& build ) {
+    std::atomic<int> counter { 0 };
+    build( queue, counter );
+    queue.startTasks();
+    queue.waitForTasks();
+    queue.flushTaskQueue();
+    return counter;
+}
+
+template <typename Builder>
+void benchmarkPolicies( const std::string& name, Builder&& build ) {
+    const uint numThreads = std::max( std::thread::hardware_concurrency(), 2u ) - 1;
+    TaskQueue sharedQueue( numThreads, TaskQueue::SchedulingPolicy::SharedQueue );
+    TaskQueue stealingQueue( numThreads, TaskQueue::SchedulingPolicy::WorkStealing );
+
+    BENCHMARK( name + " SharedQueue" ) { return runFrame( sharedQueue, build ); };
+    BENCHMARK( name + " WorkStealing" ) { return runFrame( stealingQueue, build ); };
+}
+} // namespace
+
+TEST_CASE( "Core/TaskQueue/Benchmark", "[Core][TaskQueue][benchmark]" ) {
+    benchmarkPolicies( "wide 2000",
+                       []( TaskQueue& q, std::atomic<int>& c ) { buildWide( q, c, 2000 ); } );
+    benchmarkPolicies( "deep 16x125",
+                       []( TaskQueue& q, std::atomic<int>& c ) { buildDeep( q, c, 16, 125 ); } );
+    benchmarkPolicies( "diamond 20x100", []( TaskQueue& q, std::atomic<int>& c ) {
+        buildDiamond( q, c, 20, 100 );
+    } );
+}
@@ -0,0 +1,68 @@
+#include <Core/Containers/TransformStore.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+using namespace Ra::Core;
+
+TEST_CASE( "Core/Containers/TransformStore", "[Core][Containers][TransformStore]" ) {
+    // scene of 50k entities: 5k roots with 9 children each.
+    const int numEntities = 50000;
+    std::mt19937 gen( 42 );
+    std::uniform_real_distribution<Scalar> dist( -1_ra, 1_ra );
+    auto randomTransform = [&]() {
+        Transform T = Transform::Identity();
+        T.translate( Vector3( dist( gen ), dist( gen ), dist( gen ) ) );
+        T.rotate( AngleAxis( dist( gen ), Vector3::UnitZ() ) );
+        return T;
+    };
+    TransformStore store;
+    std::vector<Transform, Eigen::aligned_allocator<Transform>> locals;
+    for ( int i = 0; i < numEntities; ++i ) {
+        locals.push_back( randomTransform() );
+        store.add( locals.back(), i % 10 == 0 ? -1 : i - i % 10 );
+    }
+    store.update();
+
+    auto moveAll = [&]() {
+        for ( int i = 0; i < numEntities; ++i ) {
+            store.setLocal( i, locals[i] );
+        }
+    };
+    // 1% of the roots are moved.
+    auto moveFew = [&]() {
+        for ( int i = 0; i < numEntities; i += 1000 ) {
+            store.setLocal( i, locals[i] );
+        }
+    };
+
+    BENCHMARK( "update all, 50k entities" ) {
+        moveAll();
+        store.update();
+        return store.getWorld( numEntities - 1 ).translation().x();
+    };
+    BENCHMARK( "update 1%, 50k entities" ) {
+        moveFew();
+        store.update();
+        return store.getWorld( numEntities - 1 ).translation().x();
+    };
+
+    TaskQueue taskQueue( std::max( 1u, std::thread::hardware_concurrency() - 1 ) );
+    setParallelTaskQueue( &taskQueue );
+    BENCHMARK( "update all, 50k entities, task queue threads" ) {
+        moveAll();
+        store.update();
+        return store.getWorld( numEntities - 1 ).translation().x();
+    };
+    BENCHMARK( "update 1%, 50k entities, task queue threads" ) {
+        moveFew();
+        store.update();
+        return store.getWorld( numEntities - 1 ).translation().x();
+    };
+    setParallelTaskQueue( nullptr );
+}
@@ -0,0 +1,59 @@
+#include <Core/Geometry/Volume.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+using namespace Ra::Core;
+using Geometry::VolumeGrid;
+using Geometry::VolumeSparse;
+
+TEST_CASE( "Core/Geometry/VolumeSparse", "[Core][Geometry][Volume]" ) {
+    // 1M samples on a thin shell of a 512^3 volume, too large to be stored densely in float.
+    const int n = 512;
+    std::mt19937 gen( 42 );
+    std::normal_distribution<Scalar> dist;
+    VolumeSparse::Container samples;
+    for ( int i = 0; i < 1000000; ++i ) {
+        const Vector3 d = Vector3( dist( gen ), dist( gen ), dist( gen ) ).normalized();
+        const Vector3i p =
+            ( ( 0.45_ra * d + Vector3::Constant( 0.5_ra ) ) * Scalar( n ) ).cast<int>();
+        samples.emplace_back( p.x() + n * ( p.y() + n * p.z() ), 1_ra );
+    }
+    auto binOf = [n]( int idx ) { return Vector3i( idx % n, ( idx / n ) % n, idx / ( n * n ) ); };
+
+    VolumeSparse volume;
+    volume.setSize( Vector3i::Constant( n ) );
+    BENCHMARK( "addToBin, 1M samples" ) {
+        volume.setSize( Vector3i::Constant( n ) );
+        for ( const auto& s : samples ) {
+            volume.addToBin( s.value, binOf( s.index ) );
+        }
+        return volume.getNumBricks();
+    };
+    BENCHMARK( "addToBins, 1M samples" ) {
+        volume.setSize( Vector3i::Constant( n ) );
+        volume.addToBins( samples );
+        return volume.getNumBricks();
+    };
+    BENCHMARK( "getBinValue, 1M samples" ) {
+        Scalar sum = 0;
+        for ( const auto& s : samples ) {
+            sum += *volume.getBinValue( binOf( s.index ) );
+        }
+        return sum;
+    };
+
+    TaskQueue taskQueue( std::max( 1u, std::thread::hardware_concurrency() - 1 ) );
+    setParallelTaskQueue( &taskQueue );
+    BENCHMARK( "addToBins, 1M samples, task queue threads" ) {
+        volume.setSize( Vector3i::Constant( n ) );
+        volume.addToBins( samples );
+        return volume.getNumBricks();
+    };
+    setParallelTaskQueue( nullptr );
+}
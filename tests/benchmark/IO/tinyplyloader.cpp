@@ -0,0 +1,57 @@
+#include <Core/Asset/FileData.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+#include <IO/TinyPlyLoader/TinyPlyFileLoader.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace Ra::Core;
+using Ra::IO::TinyPlyFileLoader;
+
+TEST_CASE( "IO/TinyPlyFileLoader", "[IO][PointCloud]" ) {
+    // 4M points with positions, normals and colors, about 110 MB.
+    const int n                = 4000000;
+    const std::string filename = "tinyplyloader_benchmark.ply";
+    {
+        std::ofstream file( filename, std::ios::binary );
+        file << "ply\nformat binary_little_endian 1.0\nelement vertex " << n
+             << "\nproperty float x\nproperty float y\nproperty float z\nproperty float "
+                "nx\nproperty float ny\nproperty float nz\nproperty uchar red\nproperty uchar "
+                "green\nproperty uchar blue\nend_header\n";
+        std::mt19937 gen( 42 );
+        std::uniform_real_distribution<float> dist;
+        std::vector<char> record( 6 * sizeof( float ) + 3 );
+        for ( int i = 0; i < n; ++i ) {
+            for ( int j = 0; j < 6; ++j ) {
+                const float v = dist( gen );
+                std::copy_n( reinterpret_cast<const char*>( &v ),
+                             sizeof( float ),
+                             record.data() + j * sizeof( float ) );
+            }
+            std::fill_n( record.data() + 6 * sizeof( float ), 3, char( i ) );
+            file.write( record.data(), std::streamsize( record.size() ) );
+        }
+    }
+
+    TinyPlyFileLoader loader;
+    BENCHMARK( "load 4M points binary ply" ) {
+        return std::unique_ptr<Asset::FileData>( loader.loadFile( filename ) );
+    };
+
+    TaskQueue taskQueue( std::max( 1u, std::thread::hardware_concurrency() - 1 ) );
+    setParallelTaskQueue( &taskQueue );
+    BENCHMARK( "load 4M points binary ply, task queue threads" ) {
+        return std::unique_ptr<Asset::FileData>( loader.loadFile( filename ) );
+    };
+    setParallelTaskQueue( nullptr );
+
+    std::remove( filename.c_str() );
+}
@@ -0,0 +1,52 @@
+#include <Core/Asset/FileData.hpp>
+#include <Core/Asset/VolumeData.hpp>
+#include <Core/Geometry/Volume.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+#include <IO/VolumesLoader/VolumeLoader.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <thread>
+
+using namespace Ra::Core;
+using Ra::IO::VolumeLoader;
+
+TEST_CASE( "IO/VolumesLoader", "[IO][Volume]" ) {
+    // 256^3 density grid, about 160 MB of text.
+    const int n                = 256;
+    const std::string filename = "volumeloader_benchmark.vol";
+    {
+        std::ofstream file( filename );
+        file << "sigma_a [ 0.5 0.5 0.5 ]\nsigma_s [ 1 1 1 ]\nsize [ " << n << " " << n << " " << n
+             << " ]\ndensity [\n";
+        std::mt19937 gen( 42 );
+        std::uniform_real_distribution<float> dist;
+        for ( int i = 0; i < n * n * n; ++i ) {
+            file << dist( gen ) << ( i % n == n - 1 ? '\n' : ' ' );
+        }
+        file << "]\n";
+    }
+
+    VolumeLoader loader;
+    // the loaded grid is not owned by the VolumeData.
+    auto load = [&loader, &filename]() {
+        std::unique_ptr<Asset::FileData> fileData( loader.loadFile( filename ) );
+        auto volume = fileData->getVolumeData()[0]->volume;
+        delete volume;
+        return volume != nullptr;
+    };
+    BENCHMARK( "load 256^3 vol file" ) { return load(); };
+
+    TaskQueue taskQueue( std::max( 1u, std::thread::hardware_concurrency() - 1 ) );
+    setParallelTaskQueue( &taskQueue );
+    BENCHMARK( "load 256^3 vol file, task queue threads" ) { return load(); };
+    setParallelTaskQueue( nullptr );
+
+    std::remove( filename.c_str() );
+}
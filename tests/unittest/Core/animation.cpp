@@ -1,3 +1,4 @@
+#include <Core/Animation/AnimationClip.hpp>
 #include <Core/Animation/HandleWeightOperation.hpp>
 //! [include keyframed]
 #include <Core/Animation/KeyFramedValue.hpp>
@@ -11,11 +12,17 @@
 #include <Core/Animation/DualQuaternionSkinning.hpp>
 //! [include DualQuaternionSkinning ]
 
+#include <Core/Animation/LinearBlendSkinning.hpp>
 #include <Core/Animation/PoseOperation.hpp>
 #include <Core/Animation/Skeleton.hpp>
+#include <Core/Animation/SkinningData.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
 
 #include <catch2/catch.hpp>
 
+#include <random>
+
 using namespace Ra::Core;
 using namespace Ra::Core::Animation;
 
@@ -393,6 +400,82 @@ TEST_CASE( "Core/Animation/KeyFramedStruct" ) {
     }
 }
 
+TEST_CASE( "Core/Animation/AnimationClip", "[Core][Core/Animation][AnimationClip]" ) {
+    std::mt19937 gen( 3 );
+    std::uniform_real_distribution<Scalar> dist( -1_ra, 1_ra );
+    auto randomTransform = [&]() {
+        Transform T = Transform::Identity();
+        T.translate( Vector3( dist( gen ), dist( gen ), dist( gen ) ) );
+        T.rotate( AngleAxis( 3_ra * dist( gen ),
+                             Vector3( dist( gen ), dist( gen ), dist( gen ) ).normalized() ) );
+        T.scale( Vector3( 1.5_ra + dist( gen ), 1.5_ra + dist( gen ), 1.5_ra + dist( gen ) ) );
+        return T;
+    };
+
+    // bone 0 is animated, bone 1 is constant, bone 2 only moves on some keys, bone 3 has a
+    // single keyframe.
+    AnimationClip::KeyFramedTransforms animation;
+    animation.emplace_back( 0_ra, randomTransform() );
+    const Transform constant = randomTransform();
+    animation.emplace_back( 0_ra, constant );
+    const Transform base = randomTransform();
+    animation.emplace_back( 0_ra, base );
+    animation.emplace_back( 0.5_ra, randomTransform() );
+    for ( int k = 1; k <= 20; ++k ) {
+        const Scalar t = Scalar( k ) / 4_ra;
+        animation[0].insertKeyFrame( t, randomTransform() );
+        animation[1].insertKeyFrame( t, constant );
+        animation[2].insertKeyFrame(
+            t, k > 5 && k < 10 ? Translation( Vector3::Constant( t ) ) * base : base );
+    }
+
+    AnimationClip clip( animation );
+    REQUIRE( clip.getNumBones() == 4 );
+    REQUIRE( clip.getStartTime() == 0_ra );
+    REQUIRE( clip.getEndTime() == 5_ra );
+    // bone 0 keeps its 21 * 3 keys, bone 1 and 3 only one key per track, bone 2 rotation and
+    // scale are constant, its translation has keys 5 to 10.
+    REQUIRE( clip.getNumKeys() == 21 * 3 + 3 + 3 + 2 + 6 );
+
+    auto check = [&animation]( const Pose& pose, Scalar t ) {
+        REQUIRE( pose.size() == animation.size() );
+        for ( size_t i = 0; i < animation.size(); ++i ) {
+            const Transform expected = animation[i].at( t, linearInterpolate<Transform> );
+            REQUIRE( pose[i].matrix().isApprox( expected.matrix(), 1e-3_ra ) );
+        }
+    };
+
+    AnimationClip::Cursor cursor;
+    Pose pose;
+    // forward playback, with times before the first and after the last keyframe.
+    for ( Scalar t = -0.5_ra; t < 5.5_ra; t += 1_ra / 60_ra ) {
+        clip.sample( t, cursor, pose );
+        check( pose, t );
+    }
+    // looping, large jumps and exact keyframe times.
+    for ( Scalar t : { 0.1_ra, 4.9_ra, 0.25_ra, 3_ra, 2.9_ra, 1.75_ra, 5_ra, 0_ra } ) {
+        clip.sample( t, cursor, pose );
+        check( pose, t );
+        check( clip.sample( t ), t );
+    }
+
+    SECTION( "Keyframes stamps" ) {
+        auto copy          = animation[0];
+        const size_t stamp = animation[0].getStamp();
+        REQUIRE( copy.getStamp() == stamp );
+        REQUIRE( animation[1].getStamp() != stamp );
+        animation[0].insertKeyFrame( 10_ra, Transform::Identity() );
+        REQUIRE( animation[0].getStamp() != stamp );
+        const size_t insertStamp = animation[0].getStamp();
+        animation[0].moveKeyFrame( 0, -1_ra );
+        REQUIRE( animation[0].getStamp() != insertStamp );
+        const size_t moveStamp = animation[0].getStamp();
+        animation[0].removeKeyFrame( 0 );
+        REQUIRE( animation[0].getStamp() != moveStamp );
+        REQUIRE( copy.getStamp() == stamp );
+    }
+}
+
 TEST_CASE( "Core/Animation/Skeleton", "[Core][Core/Animation][Skeleton]" ) {
     using Space = HandleArray::SpaceType;
     // build the skeleton in the X direction: > - > - > - > starting at the origin
@@ -964,6 +1047,93 @@ TEST_CASE( "Core/Animation/Skeleton", "[Core][Core/Animation][Skeleton]" ) {
     }
 }
 
+TEST_CASE( "Core/Animation/Skeleton/Propagation", "[Core][Core/Animation][Skeleton]" ) {
+    using Space = HandleArray::SpaceType;
+    // a large random hierarchy, more than 255 bones.
+    const uint numBones = 800;
+    std::mt19937 gen( 5 );
+    std::uniform_real_distribution<Scalar> dist( -1_ra, 1_ra );
+    auto randomTransform = [&]() {
+        Transform T = Transform::Identity();
+        T.translate( Vector3( dist( gen ), dist( gen ), dist( gen ) ) );
+        T.rotate( AngleAxis( 3_ra * dist( gen ),
+                             Vector3( dist( gen ), dist( gen ), dist( gen ) ).normalized() ) );
+        return T;
+    };
+    Skeleton skel;
+    skel.addRoot( randomTransform() );
+    for ( uint i = 1; i < numBones; ++i ) {
+        const uint parent = std::uniform_int_distribution<uint>( 0, i - 1 )( gen );
+        const Transform T = randomTransform();
+        REQUIRE( skel.addBone( parent, T, Space::LOCAL ) == i );
+        REQUIRE( skel.getTransform( i, Space::MODEL ).isApprox(
+            skel.getTransform( parent, Space::MODEL ) * T ) );
+    }
+    REQUIRE( skel.m_graph.computeConsistencyStatus() == AdjacencyList::ConsistencyStatus::Valid );
+
+    // reference propagation, following the parents recursively.
+    const auto& parents = skel.m_graph.parents();
+    auto modelTransform = [&parents]( const Pose& local, uint i ) {
+        Transform T = local[i];
+        for ( int p = parents[i]; p != -1; p = parents[p] ) {
+            T = local[p] * T;
+        }
+        return T;
+    };
+    auto checkPoses = [&]( const Pose& local, const Pose& model ) {
+        for ( uint i = 0; i < numBones; ++i ) {
+            REQUIRE( model[i].isApprox( modelTransform( local, i ), 1e-4_ra ) );
+        }
+    };
+
+    Pose local( numBones );
+    for ( auto& T : local ) {
+        T = randomTransform();
+    }
+    skel.setPose( local, Space::LOCAL );
+    checkPoses( skel.getPose( Space::LOCAL ), skel.getPose( Space::MODEL ) );
+
+    const Pose model = skel.getPose( Space::MODEL );
+    skel.setPose( model, Space::MODEL );
+    for ( uint i = 0; i < numBones; ++i ) {
+        REQUIRE( skel.getTransform( i, Space::LOCAL ).isApprox( local[i], 1e-3_ra ) );
+    }
+
+    // changing a bone transform updates its descendants.
+    const uint bone = skel.m_graph.children()[0][0];
+    skel.setPose( local, Space::LOCAL );
+    skel.setTransform( bone, randomTransform(), Space::LOCAL );
+    checkPoses( skel.getPose( Space::LOCAL ), skel.getPose( Space::MODEL ) );
+    const Transform boneModel = randomTransform();
+    skel.setTransform( bone, boneModel, Space::MODEL );
+    REQUIRE( skel.getTransform( bone, Space::MODEL ).isApprox( boneModel ) );
+    checkPoses( skel.getPose( Space::LOCAL ), skel.getPose( Space::MODEL ) );
+
+    // batch of poses, with several threads.
+    const uint numSkeletons = 5;
+    Pose localPoses;
+    for ( uint k = 0; k < numSkeletons * numBones; ++k ) {
+        localPoses.push_back( randomTransform() );
+    }
+    Pose modelPoses, localPosesBack;
+    TaskQueue taskQueue( 3 );
+    setParallelTaskQueue( &taskQueue );
+    skel.computeModelPoses( localPoses, modelPoses );
+    skel.computeLocalPoses( modelPoses, localPosesBack );
+    setParallelTaskQueue( nullptr );
+    REQUIRE( modelPoses.size() == localPoses.size() );
+    REQUIRE( localPosesBack.size() == localPoses.size() );
+    for ( uint k = 0; k < numSkeletons; ++k ) {
+        const Pose skelLocal( localPoses.begin() + k * numBones,
+                              localPoses.begin() + ( k + 1 ) * numBones );
+        skel.setPose( skelLocal, Space::LOCAL );
+        for ( uint i = 0; i < numBones; ++i ) {
+            REQUIRE( modelPoses[k * numBones + i].isApprox( skel.getTransform( i, Space::MODEL ) ) );
+            REQUIRE( localPosesBack[k * numBones + i].isApprox( skelLocal[i], 1e-3_ra ) );
+        }
+    }
+}
+
 TEST_CASE( "Core/Animation/DualQuaternionSkinning",
            "[Core][Core/Animation][DualQuaternionSkinning]" ) {
     // initialize the pose
@@ -1016,3 +1186,89 @@ TEST_CASE( "Core/Animation/DualQuaternionSkinning",
     auto dq_n = Ra::Core::Animation::computeDQ( pose, weights );
     REQUIRE( q3.toRotationMatrix().isApprox( dq_n[2].getTransform().linear() ) );
 }
+
+TEST_CASE( "Core/Animation/LinearBlendSkinning",
+           "[Core][Core/Animation][LinearBlendSkinning]" ) {
+    const int numVertices = 1000;
+    const int numBones    = 10;
+    auto randomTransform  = []() {
+        Transform t( Eigen::AngleAxis( Scalar( Vector3::Random()[0] * M_PI ),
+                                        Vector3::Random().normalized() ) );
+        t.translation() = Vector3::Random();
+        return t;
+    };
+
+    SkinningRefData refData;
+    SkinningFrameData frameData;
+    Vector3Array vertices( numVertices ), normals( numVertices );
+    Vector3Array tangents( numVertices ), bitangents( numVertices );
+    for ( int i = 0; i < numVertices; ++i ) {
+        vertices[i]   = Vector3::Random();
+        normals[i]    = Vector3::Random().normalized();
+        tangents[i]   = Vector3::Random().normalized();
+        bitangents[i] = Vector3::Random().normalized();
+    }
+    refData.m_referenceMesh.setVertices( vertices );
+    refData.m_referenceMesh.setNormals( normals );
+    refData.m_meshTransformInverse = randomTransform();
+    for ( int j = 0; j < numBones; ++j ) {
+        refData.m_skeleton.addRoot( Transform::Identity() );
+        refData.m_bindMatrices.push_back( randomTransform() );
+        frameData.m_skeleton.addRoot( randomTransform() );
+    }
+
+    // vertex i is influenced by 1 + i % 6 bones.
+    refData.m_weights.resize( numVertices, numBones );
+    std::vector<Eigen::Triplet<Scalar>> triplets;
+    for ( int i = 0; i < numVertices; ++i ) {
+        for ( int k = 0; k <= i % 6; ++k ) {
+            triplets.emplace_back( i, ( i + 3 * k ) % numBones, 1_ra + Scalar( k ) );
+        }
+    }
+    refData.m_weights.setFromTriplets( triplets.begin(), triplets.end() );
+    normalizeWeights( refData.m_weights );
+
+    frameData.m_currentPosition.resize( numVertices );
+    frameData.m_currentNormal.resize( numVertices );
+    frameData.m_currentTangent.resize( numVertices );
+    frameData.m_currentBitangent.resize( numVertices );
+
+    // weights are not packed yet, so that they are packed on the fly.
+    linearBlendSkinning( refData, tangents, bitangents, frameData );
+
+    const auto& pose = frameData.m_skeleton.getPose( HandleArray::SpaceType::MODEL );
+    for ( int i = 0; i < numVertices; ++i ) {
+        Vector3 p = Vector3::Zero();
+        Vector3 n = Vector3::Zero();
+        for ( int j = 0; j < numBones; ++j ) {
+            const Scalar w = refData.m_weights.coeff( i, j );
+            if ( w == 0 ) { continue; }
+            const Transform M =
+                refData.m_meshTransformInverse * pose[j] * refData.m_bindMatrices[j];
+            p += w * ( M * vertices[i] );
+            n += w * ( M.linear() * normals[i] );
+        }
+        REQUIRE( frameData.m_currentPosition[i].isApprox( p, 1e-4_ra ) );
+        REQUIRE( frameData.m_currentNormal[i].isApprox( n, 1e-4_ra ) );
+    }
+
+    // packed weights
+    refData.m_packedWeights = packWeights( refData.m_weights );
+    REQUIRE( refData.m_packedWeights.m_numVertices == uint( numVertices ) );
+    REQUIRE( refData.m_packedWeights.m_numInfluences == 8 );
+    REQUIRE( refData.m_packedWeights.m_handles.size() == size_t( 8 * numVertices ) );
+    REQUIRE( refData.m_packedWeights.m_weights[7] == 0_ra );
+    REQUIRE( refData.m_packedWeights.m_weights[5 * 8 + 5] > 0_ra );
+
+    // same results, bit to bit, with several threads.
+    const Vector3Array positions   = frameData.m_currentPosition;
+    const Vector3Array tangentsOut = frameData.m_currentTangent;
+    TaskQueue taskQueue( 4 );
+    setParallelTaskQueue( &taskQueue );
+    linearBlendSkinning( refData, tangents, bitangents, frameData );
+    setParallelTaskQueue( nullptr );
+    for ( int i = 0; i < numVertices; ++i ) {
+        REQUIRE( frameData.m_currentPosition[i] == positions[i] );
+        REQUIRE( frameData.m_currentTangent[i] == tangentsOut[i] );
+    }
+}
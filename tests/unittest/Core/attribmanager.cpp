@@ -117,6 +117,44 @@ TEST_CASE( "Core/Utils/Attibs", "[Core][Utils][Attribs]" ) {
         REQUIRE( cont4.data() == attr4.dataPtr() );
         REQUIRE( cont5.data() == attr5.dataPtr() );
     }
+    SECTION( "dirty range" ) {
+        REQUIRE( attr1.getDirtyRange().isEmpty() );
+        attr1.setData( { 1_ra, 2_ra, 3_ra, 4_ra, 5_ra } );
+        REQUIRE( attr1.getDirtyRange().m_begin == 0 );
+        REQUIRE( attr1.getDirtyRange().m_end == 5 );
+        attr1.clearDirtyRange();
+        REQUIRE( attr1.getDirtyRange().isEmpty() );
+
+        // ranged write access, the range is set on unlock.
+        attr1.getDataWithLock( 3, 1 )[3] = 0_ra;
+        REQUIRE( attr1.getDirtyRange().isEmpty() );
+        attr1.unlock();
+        REQUIRE( attr1.getDirtyRange().m_begin == 3 );
+        REQUIRE( attr1.getDirtyRange().m_end == 4 );
+        // ranges accumulate until cleared.
+        attr1.getDataWithLock( 1, 1 )[1] = 0_ra;
+        attr1.unlock();
+        REQUIRE( attr1.getDirtyRange().m_begin == 1 );
+        REQUIRE( attr1.getDirtyRange().m_end == 4 );
+        attr1.clearDirtyRange();
+
+        // whole write access, even when resizing.
+        attr1.getDataWithLock().push_back( 6_ra );
+        attr1.unlock();
+        REQUIRE( attr1.getDirtyRange().m_begin == 0 );
+        REQUIRE( attr1.getDirtyRange().m_end == 6 );
+        attr1.clearDirtyRange();
+        attr1.resize( 2 );
+        REQUIRE( attr1.getDirtyRange().m_end == 2 );
+
+        // observers are notified on unlock
+        int notified = 0;
+        attr2.attach( [&notified]() { ++notified; } );
+        attr2.getDataWithLock( 0, 0 );
+        attr2.unlock();
+        REQUIRE( notified == 1 );
+        REQUIRE( attr2.getDirtyRange().isEmpty() );
+    }
 }
 
 TEST_CASE( "Core/Utils/AttibManager", "[Core][Utils][Attribs][AttribManager]" ) {
@@ -0,0 +1,104 @@
+#include <Core/Asset/Camera.hpp>
+#include <Core/Geometry/AabbTree.hpp>
+#include <Core/Geometry/Frustum.hpp>
+#include <Core/Geometry/OcclusionBuffer.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <random>
+
+using namespace Ra::Core;
+using namespace Ra::Core::Geometry;
+
+namespace {
+/// Camera at the origin looking toward -z, with a horizontal fov of 90 degrees and an aspect
+/// ratio of 2 : the visible points at depth d have |x| <= d and |y| <= d / 2.
+Matrix4 viewProjection() {
+    return Asset::Camera::perspective( 2_ra, Scalar( Math::Pi ) / 2_ra, 0.1_ra, 100_ra );
+}
+
+Aabb box( const Vector3& center, Scalar halfSize ) {
+    return Aabb( center - Vector3::Constant( halfSize ), center + Vector3::Constant( halfSize ) );
+}
+} // namespace
+
+TEST_CASE( "Core/Geometry/Frustum", "[Core][Core/Geometry][Culling]" ) {
+    const Frustum frustum( viewProjection() );
+    REQUIRE( frustum.classify( box( { 0, 0, -10 }, 1 ) ) == Frustum::Intersection::Inside );
+    REQUIRE( frustum.classify( box( { 10, 0, -10 }, 1 ) ) ==
+             Frustum::Intersection::Intersecting );
+    REQUIRE( frustum.classify( box( { 0, 0, 0 }, 1 ) ) == Frustum::Intersection::Intersecting );
+    REQUIRE( frustum.classify( box( { 0, 0, -100 }, 1 ) ) ==
+             Frustum::Intersection::Intersecting );
+    // outside of each plane.
+    REQUIRE( !frustum.intersects( box( { 15, 0, -10 }, 1 ) ) );
+    REQUIRE( !frustum.intersects( box( { -15, 0, -10 }, 1 ) ) );
+    REQUIRE( !frustum.intersects( box( { 0, 8, -10 }, 1 ) ) );
+    REQUIRE( !frustum.intersects( box( { 0, -8, -10 }, 1 ) ) );
+    REQUIRE( !frustum.intersects( box( { 0, 0, 10 }, 1 ) ) );
+    REQUIRE( !frustum.intersects( box( { 0, 0, -110 }, 1 ) ) );
+}
+
+TEST_CASE( "Core/Geometry/AabbTree", "[Core][Core/Geometry][Culling]" ) {
+    std::mt19937 gen( 3 );
+    std::uniform_real_distribution<Scalar> position( -60_ra, 60_ra );
+    std::uniform_real_distribution<Scalar> size( 0.1_ra, 5_ra );
+    std::vector<Aabb> boxes;
+    for ( int i = 0; i < 3000; ++i ) {
+        boxes.push_back( box( { position( gen ), position( gen ), position( gen ) }, size( gen ) ) );
+    }
+    // empty boxes are skipped.
+    boxes[10] = Aabb();
+
+    const AabbTree tree( boxes );
+    REQUIRE( !tree.isEmpty() );
+    REQUIRE( AabbTree( std::vector<Aabb>( 3 ) ).isEmpty() );
+
+    const Frustum frustum( viewProjection() );
+    std::vector<uint> expected;
+    for ( uint i = 0; i < uint( boxes.size() ); ++i ) {
+        if ( !boxes[i].isEmpty() && frustum.intersects( boxes[i] ) ) { expected.push_back( i ); }
+    }
+    REQUIRE( !expected.empty() );
+    REQUIRE( expected.size() < boxes.size() );
+
+    std::vector<uint> visible;
+    tree.frustumQuery( frustum, visible );
+    std::sort( visible.begin(), visible.end() );
+    REQUIRE( visible == expected );
+}
+
+TEST_CASE( "Core/Geometry/OcclusionBuffer", "[Core][Core/Geometry][Culling]" ) {
+    OcclusionBuffer buffer( 128, 64 );
+    buffer.clear( viewProjection() );
+    REQUIRE( buffer.getDepth( 10, 10 ) == 1_ra );
+    REQUIRE( !buffer.isOccluded( box( { 0, 0, -20 }, 1 ) ) );
+
+    // wall of 10 x 10 at depth 10, covering half of the buffer width and all its height.
+    Vector3Array vertices { { -5, -5, 0 }, { 5, -5, 0 }, { 5, 5, 0 }, { -5, 5, 0 } };
+    VectorArray<Vector3ui> triangles { { 0, 1, 2 }, { 0, 2, 3 } };
+    Transform transform = Transform::Identity();
+    transform.translate( Vector3( 0, 0, -10 ) );
+    const Aabb wall( Vector3( -5, -5, -10 ), Vector3( 5, 5, -10 ) );
+    REQUIRE( buffer.getCoverage( wall ) == Approx( 0.5_ra ).margin( 0.05_ra ) );
+    REQUIRE( buffer.getCoverage( box( { 0, 0, 0 }, 1 ) ) == 1_ra );
+
+    buffer.addOccluder( transform, vertices, triangles );
+    REQUIRE( buffer.getDepth( 64, 32 ) < 1_ra );
+    REQUIRE( buffer.getDepth( 10, 32 ) == 1_ra );
+
+    // behind the wall.
+    REQUIRE( buffer.isOccluded( box( { 0, 0, -20 }, 1 ) ) );
+    REQUIRE( buffer.isOccluded( box( { 5, 3, -40 }, 2 ) ) );
+    // in front of the wall, across the wall, beside the wall, partially hidden.
+    REQUIRE( !buffer.isOccluded( box( { 0, 0, -5 }, 1 ) ) );
+    REQUIRE( !buffer.isOccluded( box( { 0, 0, -10 }, 1 ) ) );
+    REQUIRE( !buffer.isOccluded( box( { 15, 0, -20 }, 1 ) ) );
+    REQUIRE( !buffer.isOccluded( box( { 9.5, 0, -20 }, 1 ) ) );
+    // crossing the near plane.
+    REQUIRE( !buffer.isOccluded( box( { 0, 0, 0 }, 1 ) ) );
+
+    buffer.clear( viewProjection() );
+    REQUIRE( !buffer.isOccluded( box( { 0, 0, -20 }, 1 ) ) );
+}
@@ -1,8 +1,14 @@
+#include <Core/Geometry/Bvh.hpp>
 #include <Core/Geometry/DistanceQueries.hpp>
+#include <Core/Geometry/KdTree.hpp>
+#include <Core/Geometry/TriangleMesh.hpp>
 #include <Core/Math/LinearAlgebra.hpp> // Math::getOrthogonalVectors
 #include <Core/Math/Math.hpp>          //  Math::areApproxEqual
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <numeric>
+
 TEST_CASE( "Core/Geometry/DistanceQueries", "[Core][Core/Geometry][DistanceQueries]" ) {
 
     using namespace Ra::Core;
@@ -143,3 +149,104 @@ TEST_CASE( "Core/Geometry/DistanceQueries", "[Core][Core/Geometry][DistanceQueri
         REQUIRE( dg.flags == Geometry::FlagsInternal::HIT_FACE );
     }
 }
+
+TEST_CASE( "Core/Geometry/SpatialIndex", "[Core][Core/Geometry][DistanceQueries]" ) {
+    using namespace Ra::Core;
+    // triangle soup of small random triangles
+    Geometry::TriangleMesh mesh;
+    {
+        Vector3Array points;
+        Geometry::TriangleMesh::IndexContainerType triangles;
+        for ( uint i = 0; i < 500; ++i ) {
+            const Vector3 center = Vector3::Random();
+            for ( int k = 0; k < 3; ++k ) {
+                points.push_back( center + 0.1_ra * Vector3::Random() );
+            }
+            triangles.emplace_back( 3 * i, 3 * i + 1, 3 * i + 2 );
+        }
+        mesh.setVertices( std::move( points ) );
+        mesh.setIndices( std::move( triangles ) );
+    }
+    const auto& vertices = mesh.vertices();
+    const auto& indices  = mesh.getIndices();
+
+    Vector3Array queries( 200 );
+    for ( auto& q : queries ) {
+        q = 1.5_ra * Vector3::Random();
+    }
+
+    SECTION( "Closest point on the triangles" ) {
+        Geometry::Bvh bvh( mesh );
+        for ( const auto& q : queries ) {
+            Scalar best = std::numeric_limits<Scalar>::max();
+            for ( const auto& t : indices ) {
+                best = std::min(
+                    best,
+                    Geometry::pointToTriSq( q, vertices[t[0]], vertices[t[1]], vertices[t[2]] )
+                        .distanceSquared );
+            }
+            Geometry::Bvh::Projection projection;
+            REQUIRE( bvh.closestPoint( q, projection ) );
+            REQUIRE( Math::areApproxEqual( projection.m_distanceSquared, best ) );
+            REQUIRE( Math::areApproxEqual( ( projection.m_point - q ).squaredNorm(), best ) );
+            const auto& t = indices[projection.m_triangle];
+            REQUIRE( Math::areApproxEqual(
+                Geometry::pointToTriSq( q, vertices[t[0]], vertices[t[1]], vertices[t[2]] )
+                    .distanceSquared,
+                best ) );
+            // nothing closer than the closest point
+            REQUIRE( !bvh.closestPoint( q, projection, best * 0.999_ra ) );
+        }
+        Geometry::Bvh::Projection projection;
+        REQUIRE( !Geometry::Bvh().closestPoint( Vector3::Zero(), projection ) );
+    }
+
+    SECTION( "Nearest vertices" ) {
+        Geometry::KdTree tree( mesh, 4 );
+        REQUIRE( tree.getNumPoints() == vertices.size() );
+        std::vector<uint> order( vertices.size() );
+        std::vector<uint> indicesOut;
+        std::vector<Scalar> distancesOut;
+        for ( const auto& q : queries ) {
+            std::iota( order.begin(), order.end(), 0u );
+            std::sort( order.begin(), order.end(), [&]( uint a, uint b ) {
+                return ( vertices[a] - q ).squaredNorm() < ( vertices[b] - q ).squaredNorm();
+            } );
+
+            uint index;
+            Scalar distance;
+            REQUIRE( tree.nearest( q, index, distance ) );
+            REQUIRE( distance == ( vertices[order[0]] - q ).squaredNorm() );
+
+            tree.kNearest( q, 10, indicesOut, distancesOut );
+            REQUIRE( indicesOut.size() == 10 );
+            for ( uint i = 0; i < 10; ++i ) {
+                REQUIRE( distancesOut[i] == ( vertices[order[i]] - q ).squaredNorm() );
+                REQUIRE( distancesOut[i] == ( vertices[indicesOut[i]] - q ).squaredNorm() );
+            }
+
+            const Scalar radius = 0.3_ra;
+            tree.radiusSearch( q, radius, indicesOut );
+            std::sort( indicesOut.begin(), indicesOut.end() );
+            std::vector<uint> expected;
+            for ( uint i = 0; i < vertices.size(); ++i ) {
+                if ( ( vertices[i] - q ).squaredNorm() <= radius * radius ) {
+                    expected.push_back( i );
+                }
+            }
+            REQUIRE( indicesOut == expected );
+        }
+
+        // more neighbours than points
+        tree.kNearest( Vector3::Zero(), uint( vertices.size() + 5 ), indicesOut, distancesOut );
+        REQUIRE( indicesOut.size() == vertices.size() );
+        REQUIRE( std::is_sorted( distancesOut.begin(), distancesOut.end() ) );
+
+        Geometry::KdTree empty;
+        uint index;
+        Scalar distance;
+        REQUIRE( !empty.nearest( Vector3::Zero(), index, distance ) );
+        empty.kNearest( Vector3::Zero(), 3, indicesOut, distancesOut );
+        REQUIRE( indicesOut.empty() );
+    }
+}
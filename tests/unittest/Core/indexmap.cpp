@@ -124,6 +124,58 @@ TEST_CASE( "Core/Utils/IndexMap", "[Core][Core/Utils][IndexMap]" ) {
     }
 }
 
+TEST_CASE( "Core/Utils/IndexMap/SlotMap", "[Core][Core/Utils][IndexMap]" ) {
+    IndexMap<int> map;
+    std::vector<Index> indices;
+    for ( int i = 0; i < 100; ++i ) {
+        indices.push_back( map.insert( i ) );
+        REQUIRE( indices.back() == Index( i ) );
+    }
+
+    // remove every third object, the others keep their index.
+    for ( int i = 0; i < 100; i += 3 ) {
+        REQUIRE( map.remove( indices[i] ) );
+    }
+    REQUIRE( map.size() == 66 );
+    for ( int i = 0; i < 100; ++i ) {
+        REQUIRE( map.contains( indices[i] ) == ( i % 3 != 0 ) );
+        if ( i % 3 != 0 ) { REQUIRE( map[indices[i]] == i ); }
+    }
+
+    // objects and indices are stored densely and stay paired.
+    int sum = 0;
+    for ( uint i = 0; i < map.size(); ++i ) {
+        REQUIRE( map.at( map.index( i ) ) == map.index( i ).getValue() );
+        sum += map.index( i ).getValue();
+    }
+    for ( int v : map ) {
+        sum -= v;
+    }
+    REQUIRE( sum == 0 );
+    REQUIRE( std::distance( map.cbegin_index(), map.cend_index() ) == 66 );
+    REQUIRE( map.index( 66 ).isInvalid() );
+
+    // the first free indices are reused first.
+    REQUIRE( map.insert( -1 ) == Index( 0 ) );
+    REQUIRE( map.insert( -1 ) == Index( 3 ) );
+    REQUIRE( map[Index( 3 )] == -1 );
+
+    // an empty map starts again from index 0.
+    while ( !map.empty() ) {
+        REQUIRE( map.remove( map.index( map.size() - 1 ) ) );
+    }
+    REQUIRE( !map.contains( Index( 1 ) ) );
+    REQUIRE( map.insert( 7 ) == Index( 0 ) );
+
+    // copies are independent.
+    IndexMap<int> copy( map );
+    REQUIRE( copy.remove( Index( 0 ) ) );
+    REQUIRE( map.contains( Index( 0 ) ) );
+    REQUIRE( !copy.contains( Index( 0 ) ) );
+    REQUIRE( !map.contains( Index::Invalid() ) );
+    REQUIRE( !map.remove( Index::Invalid() ) );
+}
+
 template <typename T>
 void testType() {
     T step = std::numeric_limits<T>::max() / T { 1000 };
@@ -0,0 +1,120 @@
+#include <Core/Geometry/MultiDrawBatch.hpp>
+#include <Core/Geometry/StandardAttribNames.hpp>
+
+#include <catch2/catch.hpp>
+
+using namespace Ra::Core;
+using namespace Ra::Core::Geometry;
+
+namespace {
+/// Single triangle in the xy plane, with normals toward +z.
+TriangleMesh triangle() {
+    TriangleMesh mesh;
+    mesh.setVertices( { { 0, 0, 0 }, { 1, 0, 0 }, { 0, 1, 0 } } );
+    mesh.setNormals( { { 0, 0, 1 }, { 0, 0, 1 }, { 0, 0, 1 } } );
+    mesh.setIndices( { { 0, 1, 2 } } );
+    return mesh;
+}
+
+/// Unit square in the xy plane, made of two triangles.
+TriangleMesh square() {
+    TriangleMesh mesh;
+    mesh.setVertices( { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } } );
+    mesh.setNormals( { { 0, 0, 1 }, { 0, 0, 1 }, { 0, 0, 1 }, { 0, 0, 1 } } );
+    mesh.setIndices( { { 0, 1, 2 }, { 0, 2, 3 } } );
+    return mesh;
+}
+} // namespace
+
+TEST_CASE( "Core/Geometry/MultiDrawBatch", "[Core][Core/Geometry][MultiDrawBatch]" ) {
+    SECTION( "Packing and draw commands" ) {
+        MultiDrawBatch batch;
+        REQUIRE( batch.isEmpty() );
+
+        const auto quad = square();
+        const auto tri  = triangle();
+        Transform transform( Translation( Vector3( 1, 2, 3 ) ) );
+        REQUIRE( batch.add( quad ) == 0 );
+        REQUIRE( batch.add( tri, transform, 4 ) == 1 );
+        REQUIRE( batch.add( quad ) == 2 );
+        REQUIRE( batch.getNumDraws() == 3 );
+
+        const auto& mesh = batch.getMesh();
+        const auto nquad = quad.vertices().size();
+        REQUIRE( mesh.vertices().size() == 2 * nquad + 3 );
+        REQUIRE( mesh.normals().size() == mesh.vertices().size() );
+        REQUIRE( mesh.getIndices().size() == 2 * quad.getIndices().size() + 1 );
+
+        const auto& commands = batch.getCommands();
+        REQUIRE( commands[0].m_count == quad.getIndices().size() * 3 );
+        REQUIRE( commands[0].m_firstIndex == 0 );
+        REQUIRE( commands[0].m_baseVertex == 0 );
+        REQUIRE( commands[1].m_count == 3 );
+        REQUIRE( commands[1].m_firstIndex == commands[0].m_count );
+        REQUIRE( commands[1].m_baseVertex == int( nquad ) );
+        REQUIRE( commands[1].m_baseInstance == 1 );
+        REQUIRE( commands[2].m_firstIndex == commands[0].m_count + 3 );
+        REQUIRE( commands[2].m_baseVertex == int( nquad + 3 ) );
+
+        // indices are relative to the base vertex of each draw.
+        for ( const auto& c : commands ) {
+            for ( uint i = 0; i < c.m_count / 3; ++i ) {
+                const auto& t = mesh.getIndices()[c.m_firstIndex / 3 + i];
+                REQUIRE( t.maxCoeff() < mesh.vertices().size() - size_t( c.m_baseVertex ) );
+            }
+        }
+        REQUIRE( mesh.vertices()[nquad + 1] == tri.vertices()[1] );
+
+        const auto& data = batch.getDrawData();
+        REQUIRE( data[1].m_materialIndex == 4 );
+        REQUIRE( data[1].m_transform.isApprox( transform.matrix().cast<float>() ) );
+        REQUIRE( data[0].m_transform.isIdentity() );
+
+        batch.setVisible( 1, false );
+        REQUIRE( !batch.isVisible( 1 ) );
+        REQUIRE( commands[1].m_instanceCount == 0 );
+        REQUIRE( batch.getNumVisible() == 2 );
+        batch.setAllVisible( true );
+        REQUIRE( batch.getNumVisible() == 3 );
+
+        batch.clear();
+        REQUIRE( batch.isEmpty() );
+        REQUIRE( batch.getMesh().vertices().empty() );
+        REQUIRE( batch.getMesh().getIndices().empty() );
+    }
+
+    SECTION( "Compatibility" ) {
+        MultiDrawBatch batch;
+        auto colored = triangle();
+        colored.colorize( Utils::Color::Red() );
+        REQUIRE( batch.add( colored ) == 0 );
+        REQUIRE( batch.getMesh().hasAttrib( getAttribName( MeshAttrib::VERTEX_COLOR ) ) );
+        REQUIRE( !batch.isCompatible( triangle() ) );
+        REQUIRE( batch.add( triangle() ) == -1 );
+        REQUIRE( batch.getNumDraws() == 1 );
+
+        auto scalar = triangle();
+        auto h      = scalar.addAttrib<Scalar>( getAttribName( MeshAttrib::VERTEX_COLOR ) );
+        scalar.getAttrib( h ).setData( { 1, 2, 3 } );
+        REQUIRE( !batch.isCompatible( scalar ) );
+        REQUIRE( batch.add( colored ) == 1 );
+    }
+
+    SECTION( "Baked transforms" ) {
+        MultiDrawBatch batch( true );
+        REQUIRE( batch.areTransformsBaked() );
+        Transform transform( AngleAxis( Scalar( Math::PiDiv2 ), Vector3::UnitX() ) );
+        transform.pretranslate( Vector3( 0, 0, 5 ) );
+        transform.scale( Vector3( 2, 1, 1 ) );
+        batch.add( triangle() );
+        batch.add( triangle(), transform );
+
+        const auto& mesh = batch.getMesh();
+        REQUIRE( mesh.vertices()[1].isApprox( Vector3( 1, 0, 0 ) ) );
+        REQUIRE( mesh.vertices()[4].isApprox( Vector3( 2, 0, 5 ) ) );
+        REQUIRE( mesh.vertices()[5].isApprox( Vector3( 0, 0, 6 ) ) );
+        REQUIRE( mesh.normals()[3].isApprox( Vector3( 0, -1, 0 ) ) );
+        REQUIRE( batch.getDrawData()[1].m_transform.isIdentity() );
+        REQUIRE( mesh.computeAabb().max().z() == Approx( 6_ra ) );
+    }
+}
@@ -0,0 +1,102 @@
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/Task.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+using namespace Ra::Core;
+
+TEST_CASE( "Core/ParallelFor", "[Core][ParallelFor]" ) {
+    SECTION( "without task queue" ) {
+        REQUIRE( getParallelTaskQueue() == nullptr );
+        std::vector<int> values( 100, 0 );
+        parallelFor( 0, 100, [&values]( int i ) { values[i] = i; } );
+        for ( int i = 0; i < 100; ++i ) {
+            REQUIRE( values[i] == i );
+        }
+        const int sum = parallelReduce(
+            0,
+            100,
+            7,
+            0,
+            [&values]( int b, int e, int init ) {
+                return std::accumulate( values.begin() + b, values.begin() + e, init );
+            },
+            []( int a, int b ) { return a + b; } );
+        REQUIRE( sum == 4950 );
+    }
+
+    auto policy = GENERATE( TaskQueue::SchedulingPolicy::SharedQueue,
+                            TaskQueue::SchedulingPolicy::WorkStealing );
+    TaskQueue taskQueue( 4, policy );
+    setParallelTaskQueue( &taskQueue );
+    REQUIRE( getParallelTaskQueue() == &taskQueue );
+
+    SECTION( "parallelFor" ) {
+        const size_t size = 10007;
+        std::vector<std::atomic<int>> visits( size );
+        for ( auto& v : visits ) {
+            v = 0;
+        }
+        for ( size_t grain : { size_t( 0 ), size_t( 1 ), size_t( 13 ), size + 1 } ) {
+            parallelFor( size_t( 0 ), size, grain, [&visits]( size_t i ) { ++visits[i]; } );
+        }
+        // empty range
+        parallelFor( size, size_t( 0 ), [&visits]( size_t i ) { ++visits[i]; } );
+        for ( size_t i = 0; i < size; ++i ) {
+            REQUIRE( visits[i] == 4 );
+        }
+    }
+
+    SECTION( "parallelReduce" ) {
+        const int size = 100000;
+        std::vector<double> values( size );
+        for ( int i = 0; i < size; ++i ) {
+            values[i] = 1. / ( i + 1 );
+        }
+        auto sumChunk = [&values]( int b, int e, double init ) {
+            return std::accumulate( values.begin() + b, values.begin() + e, init );
+        };
+        auto add = []( double a, double b ) { return a + b; };
+
+        // results do not depend on the scheduling, for a given grain.
+        const double reference = parallelReduce( 0, size, 100, 0., sumChunk, add );
+        for ( int run = 0; run < 10; ++run ) {
+            REQUIRE( parallelReduce( 0, size, 100, 0., sumChunk, add ) == reference );
+        }
+        REQUIRE( reference == Approx( std::accumulate( values.begin(), values.end(), 0. ) ) );
+        REQUIRE( parallelReduce( 0, 0, 100, -1., sumChunk, add ) == -1. );
+    }
+
+    SECTION( "nested and from tasks" ) {
+        const int outer = 16;
+        const int inner = 1000;
+        std::vector<int> values( outer * inner, 0 );
+        // nested parallelFor, called from running tasks.
+        for ( int t = 0; t < 4; ++t ) {
+            taskQueue.registerTask( std::make_unique<FunctionTask>(
+                [&values, t]() {
+                    parallelFor( t * outer / 4, ( t + 1 ) * outer / 4, 1, [&values]( int i ) {
+                        parallelFor( 0, inner, 10, [&values, i]( int j ) {
+                            values[i * inner + j] = i + j;
+                        } );
+                    } );
+                },
+                "task" + std::to_string( t ) ) );
+        }
+        taskQueue.startTasks();
+        taskQueue.waitForTasks();
+        taskQueue.flushTaskQueue();
+        for ( int i = 0; i < outer; ++i ) {
+            for ( int j = 0; j < inner; ++j ) {
+                REQUIRE( values[i * inner + j] == i + j );
+            }
+        }
+    }
+
+    setParallelTaskQueue( nullptr );
+}
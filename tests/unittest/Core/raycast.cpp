@@ -1,4 +1,6 @@
+#include <Core/Geometry/Bvh.hpp>
 #include <Core/Geometry/RayCast.hpp>
+#include <Core/Geometry/TriangleMesh.hpp>
 #include <Core/Math/Math.hpp>
 #include <catch2/catch.hpp>
 
@@ -69,3 +71,98 @@ TEST_CASE( "Core/Geometry/RayCast", "[Core][Core/Geometry][RayCast]" ) {
         }
     }
 }
+
+TEST_CASE( "Core/Geometry/Bvh", "[Core][Core/Geometry][Bvh]" ) {
+    using namespace Ra::Core;
+    using Geometry::Bvh;
+
+    // random triangle soup in [-1,1]^3
+    const int numTriangles = 2000;
+    Vector3Array vertices;
+    Geometry::TriangleMesh::IndexContainerType triangles;
+    for ( int i = 0; i < numTriangles; ++i ) {
+        const Vector3 c = Vector3::Random();
+        const uint v    = uint( vertices.size() );
+        for ( int k = 0; k < 3; ++k ) {
+            vertices.push_back( c + 0.1_ra * Vector3::Random() );
+        }
+        triangles.emplace_back( v, v + 1, v + 2 );
+    }
+    Geometry::TriangleMesh mesh;
+    mesh.setVertices( vertices );
+    mesh.setIndices( triangles );
+
+    std::vector<Ray> rays;
+    for ( int i = 0; i < 500; ++i ) {
+        rays.emplace_back( 2_ra * Vector3::Random(), Vector3::Random().normalized() );
+    }
+
+    // closest hit by brute force
+    auto bruteForce = [&vertices, &triangles]( const Ray& ray, Scalar& tOut, uint& triOut ) {
+        tOut   = std::numeric_limits<Scalar>::max();
+        triOut = uint( -1 );
+        for ( uint i = 0; i < triangles.size(); ++i ) {
+            const auto& t = triangles[i];
+            std::vector<Scalar> hits;
+            if ( Geometry::RayCastTriangle(
+                     ray, vertices[t[0]], vertices[t[1]], vertices[t[2]], hits ) &&
+                 hits[0] < tOut ) {
+                tOut   = hits[0];
+                triOut = i;
+            }
+        }
+        return triOut != uint( -1 );
+    };
+
+    auto checkQueries = [&]( const Bvh& bvh ) {
+        std::vector<Bvh::Hit> packetHits;
+        bvh.closestHits( rays, packetHits );
+        REQUIRE( packetHits.size() == rays.size() );
+        for ( size_t r = 0; r < rays.size(); ++r ) {
+            Scalar t;
+            uint tri;
+            const bool expected = bruteForce( rays[r], t, tri );
+            Bvh::Hit hit;
+            REQUIRE( bvh.closestHit( rays[r], hit ) == expected );
+            REQUIRE( bvh.anyHit( rays[r] ) == expected );
+            REQUIRE( packetHits[r].isValid() == expected );
+            if ( expected ) {
+                REQUIRE( hit.m_t == Approx( t ) );
+                REQUIRE( packetHits[r].m_t == Approx( hit.m_t ) );
+                // hit point from barycentric coordinates
+                const auto& tv  = triangles[hit.m_triangle];
+                const Vector3 p = ( 1 - hit.m_u - hit.m_v ) * vertices[tv[0]] +
+                                  hit.m_u * vertices[tv[1]] + hit.m_v * vertices[tv[2]];
+                REQUIRE( p.isApprox( rays[r].pointAt( hit.m_t ), 1e-3_ra ) );
+                // nothing before the closest hit
+                REQUIRE( !bvh.anyHit( rays[r], hit.m_t * 0.999_ra ) );
+            }
+        }
+    };
+
+    SECTION( "empty" ) {
+        Bvh bvh;
+        REQUIRE( bvh.isEmpty() );
+        Bvh::Hit hit;
+        REQUIRE( !bvh.closestHit( rays[0], hit ) );
+        REQUIRE( !bvh.anyHit( rays[0] ) );
+    }
+
+    SECTION( "build" ) {
+        Bvh bvh( mesh );
+        REQUIRE( !bvh.isEmpty() );
+        REQUIRE( bvh.getNumTriangles() == size_t( numTriangles ) );
+        REQUIRE( bvh.getAabb().isApprox( mesh.computeAabb() ) );
+        checkQueries( bvh );
+    }
+
+    SECTION( "refit" ) {
+        Bvh bvh( mesh );
+        for ( auto& v : vertices ) {
+            v = Vector3( 0.5_ra * v.x(), v.y() + 0.2_ra * v.x(), v.z() ) +
+                0.05_ra * Vector3::Random();
+        }
+        bvh.refit( vertices );
+        checkQueries( bvh );
+    }
+}
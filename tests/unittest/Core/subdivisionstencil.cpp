@@ -0,0 +1,195 @@
+#include <Core/Geometry/CatmullClarkSubdivider.hpp>
+#include <Core/Geometry/LoopSubdivider.hpp>
+#include <Core/Geometry/MeshPrimitives.hpp>
+#include <Core/Geometry/SubdivisionStencil.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <random>
+
+using namespace Ra::Core;
+using Geometry::SubdivisionStencil;
+
+namespace {
+/// Mimics the OpenMesh handles stored in the subdividers operations.
+struct Handle {
+    int m_idx;
+    int idx() const { return m_idx; }
+};
+using Op  = std::pair<Scalar, Handle>;
+using Ops = std::vector<Op>;
+
+/// Moves the vertices of \p coarse after subdividing it \p n times, and checks that recompute()
+/// gives the subdivision of the moved mesh.
+template <typename Subdivider>
+void checkRecompute( const Geometry::TriangleMesh& coarse, size_t n ) {
+    using Geometry::deprecated::TopologicalMesh;
+    TopologicalMesh topo( coarse );
+    Subdivider subdivider( topo );
+    subdivider( n );
+    const auto subdivided = topo.toTriangleMesh();
+
+    // moves are functions of the positions, so that vertices sharing a position still do.
+    Vector3Array vertices = coarse.vertices();
+    Vector3Array normals  = coarse.normals();
+    for ( size_t i = 0; i < vertices.size(); ++i ) {
+        const Vector3 p = vertices[i];
+        vertices[i] += 0.2_ra * Vector3( std::sin( 3_ra * p.y() ), p.x() * p.z(), p.x() );
+        normals[i] = ( normals[i] + 0.3_ra * Vector3( p.z(), -p.x(), p.y() ) ).normalized();
+    }
+    Vector3Array subdivVertices;
+    Vector3Array subdivNormals;
+    subdivider.recompute( vertices, normals, subdivVertices, subdivNormals, topo );
+
+    Geometry::TriangleMesh moved = coarse;
+    moved.setVertices( vertices );
+    moved.setNormals( normals );
+    TopologicalMesh movedTopo( moved );
+    Subdivider movedSubdivider( movedTopo );
+    movedSubdivider( n );
+    const auto expected = movedTopo.toTriangleMesh();
+
+    REQUIRE( subdivVertices.size() == subdivided.vertices().size() );
+    REQUIRE( subdivVertices.size() == expected.vertices().size() );
+    REQUIRE( subdivNormals.size() == expected.normals().size() );
+    REQUIRE( subdivided.getIndices() == expected.getIndices() );
+    for ( size_t i = 0; i < subdivVertices.size(); ++i ) {
+        REQUIRE( ( subdivVertices[i] - expected.vertices()[i] ).norm() < 1e-4_ra );
+        REQUIRE( ( subdivNormals[i] - expected.normals()[i] ).norm() < 1e-4_ra );
+    }
+}
+} // namespace
+
+TEST_CASE( "Core/Geometry/SubdivisionStencil", "[Core][Core/Geometry][Subdivision]" ) {
+    // two steps of subdivision of a closed polygon of n points, with the cubic B-spline masks:
+    // new points at edges midpoints, old points moved to ( p_prev + 6 p + p_next ) / 8.
+    // Slots: the n coarse points, then the n points added by each step, in the order of the curve.
+    const int n = 50;
+    std::vector<int> curve( n );
+    for ( int i = 0; i < n; ++i ) {
+        curve[i] = i;
+    }
+    // Normals are only interpolated at the new points, and normalized at each step.
+    SubdivisionStencil::Builder builder( 4 * n );
+    SubdivisionStencil::NormalBuilder normalBuilder( 4 * n );
+    for ( int i = 0; i < n; ++i ) {
+        builder.setInput( i, i );
+        normalBuilder.setInput( i, i );
+    }
+
+    std::mt19937 gen( 11 );
+    std::uniform_real_distribution<Scalar> dist( -1_ra, 1_ra );
+    Vector3Array coarse( n );
+    for ( auto& p : coarse ) {
+        p = Vector3( dist( gen ), dist( gen ), dist( gen ) );
+    }
+    Vector3Array reference( 4 * n );
+    Vector3Array normalReference( 4 * n );
+    std::copy( coarse.begin(), coarse.end(), reference.begin() );
+    std::copy( coarse.begin(), coarse.end(), normalReference.begin() );
+
+    int nextSlot = n;
+    for ( int step = 0; step < 2; ++step ) {
+        const int size = int( curve.size() );
+        std::vector<int> refined;
+        std::vector<Ops> newOps;
+        std::vector<Ops> oldOps;
+        for ( int i = 0; i < size; ++i ) {
+            const Handle prev { curve[( i + size - 1 ) % size] };
+            const Handle cur { curve[i] };
+            const Handle next { curve[( i + 1 ) % size] };
+            newOps.push_back( { { 0.5_ra, cur }, { 0.5_ra, next } } );
+            oldOps.push_back( { { 0.125_ra, prev }, { 0.75_ra, cur }, { 0.125_ra, next } } );
+        }
+        // new points first, then old points, all computed before being committed.
+        for ( int i = 0; i < size; ++i ) {
+            const int slot = nextSlot++;
+            builder.setRow( slot, builder.combine( newOps[i] ) );
+            normalBuilder.setNormalized( slot, newOps[i] );
+            reference[slot] = 0.5_ra * ( reference[curve[i]] + reference[curve[( i + 1 ) % size]] );
+            normalReference[slot] =
+                ( normalReference[curve[i]] + normalReference[curve[( i + 1 ) % size]] )
+                    .normalized();
+            refined.push_back( curve[i] );
+            refined.push_back( slot );
+        }
+        std::vector<SubdivisionStencil::Builder::Row> rows;
+        Vector3Array moved;
+        for ( int i = 0; i < size; ++i ) {
+            rows.push_back( builder.combine( oldOps[i] ) );
+            Vector3 p = Vector3::Zero();
+            for ( const auto& op : oldOps[i] ) {
+                p += op.first * reference[op.second.idx()];
+            }
+            moved.push_back( p );
+        }
+        for ( int i = 0; i < size; ++i ) {
+            builder.setRow( curve[i], std::move( rows[i] ) );
+            reference[curve[i]] = moved[i];
+        }
+        curve = refined;
+    }
+
+    SECTION( "Rows" ) {
+        // cubic B-spline after two steps: each point has a support of 4 or 5 coarse points,
+        // and the weights are an affine combination.
+        for ( const int slot : curve ) {
+            const auto& row = builder.getRow( slot );
+            REQUIRE( row.size() >= 3 );
+            REQUIRE( row.size() <= 5 );
+            Scalar sum = 0_ra;
+            for ( size_t k = 0; k < row.size(); ++k ) {
+                if ( k > 0 ) { REQUIRE( row[k].first > row[k - 1].first ); }
+                sum += row[k].second;
+            }
+            REQUIRE( sum == Approx( 1_ra ) );
+        }
+    }
+
+    SECTION( "Apply" ) {
+        // outputs in reverse order of the curve, plus an unused one.
+        std::vector<int> outputSlots( curve.rbegin(), curve.rend() );
+        outputSlots.push_back( -1 );
+        const auto matrix = builder.toMatrix( outputSlots, n );
+        REQUIRE( matrix.rows() == 4 * n + 1 );
+        REQUIRE( matrix.cols() == n );
+        const SubdivisionStencil stencil( matrix, normalBuilder.toStencil( outputSlots, n ) );
+        REQUIRE( stencil.getNormalStencil().m_levels.size() == 3 );
+        REQUIRE( !stencil.empty() );
+        REQUIRE( SubdivisionStencil().empty() );
+
+        TaskQueue taskQueue( 3 );
+        setParallelTaskQueue( &taskQueue );
+        Vector3Array vertices;
+        Vector3Array normals;
+        stencil.apply( coarse, coarse, vertices, normals );
+        setParallelTaskQueue( nullptr );
+
+        REQUIRE( vertices.size() == outputSlots.size() );
+        REQUIRE( normals.size() == outputSlots.size() );
+        for ( size_t k = 0; k < curve.size(); ++k ) {
+            const Vector3& expected = reference[outputSlots[k]];
+            REQUIRE( vertices[k].isApprox( expected ) );
+            REQUIRE( normals[k].isApprox( normalReference[outputSlots[k]] ) );
+        }
+        REQUIRE( vertices.back() == Vector3::Zero() );
+        REQUIRE( normals.back() == Vector3::Zero() );
+    }
+}
+
+TEST_CASE( "Core/Geometry/Subdivision/Recompute", "[Core][Core/Geometry][Subdivision]" ) {
+    // closed mesh, and open mesh with boundaries
+    const auto sphere = Geometry::makeGeodesicSphere( 1_ra, 1 );
+    const auto grid   = Geometry::makePlaneGrid( 3, 4 );
+
+    SECTION( "Loop" ) {
+        checkRecompute<Geometry::LoopSubdivider>( sphere, 2 );
+        checkRecompute<Geometry::LoopSubdivider>( grid, 2 );
+    }
+    SECTION( "Catmull-Clark" ) {
+        checkRecompute<Geometry::CatmullClarkSubdivider>( sphere, 2 );
+        checkRecompute<Geometry::CatmullClarkSubdivider>( grid, 2 );
+    }
+}
@@ -1,15 +1,22 @@
 #include <Core/Tasks/Task.hpp>
 #include <Core/Tasks/TaskQueue.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <catch2/catch.hpp>
 #include <memory>
+#include <random>
 #include <string>
+#include <vector>
 
 using namespace Ra::Core;
 using namespace Ra::Core::Utils;
 
 TEST_CASE( "Core/TaskQueue", "[Core][TaskQueue]" ) {
-    TaskQueue taskQueue( 4 );
+    auto policy = GENERATE( TaskQueue::SchedulingPolicy::SharedQueue,
+                            TaskQueue::SchedulingPolicy::WorkStealing );
+    TaskQueue taskQueue( 4, policy );
+    REQUIRE( taskQueue.getSchedulingPolicy() == policy );
 
     const int arraySize  = 7; // if changed, update test values also
     int array[arraySize] = { -1, -1, -1, -1, -1, -1, -1 };
@@ -161,3 +168,106 @@ TEST_CASE( "Core/TaskQueue", "[Core][TaskQueue]" ) {
         REQUIRE( array[6] == -1 ); // task 6 removed
     }
 }
+
+TEST_CASE( "Core/TaskQueue/RandomGraph", "[Core][TaskQueue]" ) {
+    auto policy = GENERATE( TaskQueue::SchedulingPolicy::SharedQueue,
+                            TaskQueue::SchedulingPolicy::WorkStealing );
+    TaskQueue taskQueue( 4, policy );
+
+    const int numTasks = 500;
+    std::mt19937 gen( 0 );
+    std::uniform_int_distribution<int> numPredDist( 0, 3 );
+    std::vector<std::vector<int>> predecessors( numTasks );
+    for ( int t = 1; t < numTasks; ++t ) {
+        std::uniform_int_distribution<int> predDist( 0, t - 1 );
+        int numPred = numPredDist( gen );
+        for ( int p = 0; p < numPred; ++p ) {
+            int pred = predDist( gen );
+            if ( std::find( predecessors[t].begin(), predecessors[t].end(), pred ) ==
+                 predecessors[t].end() ) {
+                predecessors[t].push_back( pred );
+            }
+        }
+    }
+
+    // run several frames on the same task queue
+    for ( int frame = 0; frame < 10; ++frame ) {
+        std::vector<std::atomic<int>> order( numTasks );
+        std::atomic<int> counter { 0 };
+        for ( int t = 0; t < numTasks; ++t ) {
+            taskQueue.registerTask( std::make_unique<FunctionTask>(
+                [&order, &counter, t]() { order[t] = counter++; },
+                std::string( "task " ) + std::to_string( t ) ) );
+        }
+        for ( int t = 0; t < numTasks; ++t ) {
+            for ( auto p : predecessors[t] ) {
+                taskQueue.addDependency( p, t );
+            }
+        }
+        taskQueue.startTasks();
+        taskQueue.waitForTasks();
+        REQUIRE( taskQueue.getTimerData().size() == size_t( numTasks ) );
+        taskQueue.flushTaskQueue();
+
+        REQUIRE( counter == numTasks );
+        for ( int t = 0; t < numTasks; ++t ) {
+            for ( auto p : predecessors[t] ) {
+                REQUIRE( order[p] < order[t] );
+            }
+        }
+    }
+}
+
+TEST_CASE( "Core/TaskQueue/Persistent", "[Core][TaskQueue]" ) {
+    auto policy = GENERATE( TaskQueue::SchedulingPolicy::SharedQueue,
+                            TaskQueue::SchedulingPolicy::WorkStealing );
+    bool runInThisThread = GENERATE( false, true );
+    TaskQueue taskQueue( 4, policy );
+
+    int counts[3] = { 0, 0, 0 };
+    int persistentSum { 0 };
+    auto t0 = taskQueue.registerTask(
+        std::make_unique<FunctionTask>( [&counts]() { ++counts[0]; }, "persistent 0" ) );
+    auto t1 = taskQueue.registerTask( std::make_unique<FunctionTask>(
+        [&counts, &persistentSum]() {
+            ++counts[1];
+            persistentSum = counts[0] + counts[1];
+        },
+        "persistent 1" ) );
+    taskQueue.addDependency( t0, t1 );
+    taskQueue.markTasksAsPersistent();
+    REQUIRE( taskQueue.getPersistentTaskCount() == 2 );
+
+    for ( int frame = 1; frame <= 3; ++frame ) {
+        // transient task, depending on a persistent one
+        int transientResult = -1;
+        auto t2             = taskQueue.registerTask( std::make_unique<FunctionTask>(
+            [&counts, &persistentSum, &transientResult]() {
+                ++counts[2];
+                transientResult = persistentSum;
+            },
+            "transient" ) );
+        REQUIRE( taskQueue.getTaskId( "transient" ) == t2 );
+        taskQueue.addDependency( "persistent 1", t2 );
+
+        if ( runInThisThread ) { taskQueue.runTasksInThisThread(); }
+        else {
+            taskQueue.startTasks();
+            taskQueue.waitForTasks();
+            taskQueue.flushTaskQueue();
+        }
+        REQUIRE( counts[0] == frame );
+        REQUIRE( counts[1] == frame );
+        REQUIRE( counts[2] == frame );
+        REQUIRE( transientResult == 2 * frame );
+        // transient task has been flushed, persistent ones are kept
+        REQUIRE( taskQueue.getTaskId( "transient" ).isInvalid() );
+        REQUIRE( taskQueue.getTaskId( "persistent 1" ) == t1 );
+        REQUIRE( taskQueue.getTimerData().size() == 2 );
+    }
+
+    taskQueue.clearTaskQueue();
+    REQUIRE( taskQueue.getPersistentTaskCount() == 0 );
+    REQUIRE( taskQueue.getTaskId( "persistent 0" ).isInvalid() );
+    REQUIRE( taskQueue.getTimerData().empty() );
+}
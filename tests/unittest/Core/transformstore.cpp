@@ -0,0 +1,122 @@
+#include <Core/Containers/TransformStore.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <random>
+
+using namespace Ra::Core;
+
+namespace {
+/// World transform of \p slot, by walking up the hierarchy.
+Transform referenceWorld( const TransformStore& store, TransformStore::Slot slot ) {
+    Transform world = store.getLocal( slot );
+    for ( auto p = store.getParent( slot ); p >= 0; p = store.getParent( p ) ) {
+        world = store.getLocal( p ) * world;
+    }
+    return world;
+}
+} // namespace
+
+TEST_CASE( "Core/Containers/TransformStore", "[Core][Core/Containers][TransformStore]" ) {
+    std::mt19937 gen( 7 );
+    std::uniform_real_distribution<Scalar> dist( -1_ra, 1_ra );
+    auto randomTransform = [&]() {
+        Transform T = Transform::Identity();
+        T.translate( Vector3( dist( gen ), dist( gen ), dist( gen ) ) );
+        T.rotate( AngleAxis( dist( gen ), Vector3::UnitY() ) );
+        return T;
+    };
+
+    // random forest, parents added after their children by reparenting.
+    const int n = 2000;
+    TransformStore store;
+    for ( int i = 0; i < n; ++i ) {
+        const auto slot = store.add( randomTransform() );
+        REQUIRE( slot == i );
+    }
+    for ( int i = 0; i < n - 1; ++i ) {
+        if ( i % 10 == 0 ) { continue; }
+        store.setParent( i, std::uniform_int_distribution<int>( i + 1, n - 1 )( gen ) );
+    }
+    REQUIRE( store.size() == size_t( n ) );
+
+    TaskQueue taskQueue( 3 );
+    setParallelTaskQueue( &taskQueue );
+
+    SECTION( "Update" ) {
+        std::atomic<int> numChanged { 0 };
+        store.update( [&]( TransformStore::Slot ) { ++numChanged; } );
+        REQUIRE( numChanged > 0 );
+        for ( int i = 0; i < n; ++i ) {
+            REQUIRE( store.getWorld( i ).isApprox( referenceWorld( store, i ) ) );
+        }
+
+        // nothing to do.
+        numChanged = 0;
+        store.update( [&]( TransformStore::Slot ) { ++numChanged; } );
+        REQUIRE( numChanged == 0 );
+        REQUIRE( !store.hasChanged( 0 ) );
+
+        // world transforms are only written by update.
+        const Transform world = store.getWorld( n - 1 );
+        store.setLocal( n - 1, randomTransform() );
+        REQUIRE( store.getWorld( n - 1 ).isApprox( world ) );
+
+        // only the subtree of the modified node is updated.
+        int subtreeSize = 0;
+        for ( int i = 0; i < n; ++i ) {
+            auto p = i;
+            while ( p >= 0 && p != n - 1 ) {
+                p = store.getParent( p );
+            }
+            if ( p == n - 1 ) { ++subtreeSize; }
+        }
+        store.update( [&]( TransformStore::Slot ) { ++numChanged; } );
+        REQUIRE( numChanged == subtreeSize );
+        int numFlagged = 0;
+        for ( int i = 0; i < n; ++i ) {
+            if ( store.hasChanged( i ) ) { ++numFlagged; }
+        }
+        REQUIRE( numFlagged == subtreeSize );
+        for ( int i = 0; i < n; ++i ) {
+            REQUIRE( store.getWorld( i ).isApprox( referenceWorld( store, i ) ) );
+        }
+    }
+
+    SECTION( "Hierarchy edition" ) {
+        store.update();
+        // detach the children of the first non leaf root and remove it.
+        TransformStore::Slot removed = -1;
+        for ( int i = n - 1; i >= 0 && removed < 0; --i ) {
+            if ( store.getParent( i ) < 0 ) {
+                for ( int j = 0; j < n; ++j ) {
+                    if ( store.getParent( j ) == i ) {
+                        store.setParent( j, -1 );
+                        removed = i;
+                    }
+                }
+            }
+        }
+        REQUIRE( removed >= 0 );
+        store.remove( removed );
+        REQUIRE( !store.isValid( removed ) );
+        REQUIRE( store.size() == size_t( n - 1 ) );
+
+        // slot reuse, world transform available right away.
+        const Transform local = randomTransform();
+        const auto slot       = store.add( local, 0 );
+        REQUIRE( slot == removed );
+        REQUIRE( store.getWorld( slot ).isApprox( store.getWorld( 0 ) * local ) );
+        store.setParent( 0, slot == n - 1 ? n - 2 : n - 1 );
+
+        store.update();
+        for ( int i = 0; i < n; ++i ) {
+            REQUIRE( store.getWorld( i ).isApprox( referenceWorld( store, i ) ) );
+        }
+    }
+
+    setParallelTaskQueue( nullptr );
+}
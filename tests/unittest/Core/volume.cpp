@@ -0,0 +1,130 @@
+#include <Core/Geometry/Volume.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <random>
+
+using namespace Ra::Core;
+using Geometry::VolumeGrid;
+using Geometry::VolumeSparse;
+
+TEST_CASE( "Core/Geometry/VolumeSparse", "[Core][Core/Geometry][Volume]" ) {
+    // size is not a multiple of the brick size.
+    const Vector3i size( 37, 21, 18 );
+    const int numBins = size.prod();
+    auto binOf        = [&size]( int idx ) {
+        return Vector3i(
+            idx % size.x(), ( idx / size.x() ) % size.y(), idx / ( size.x() * size.y() ) );
+    };
+
+    std::mt19937 gen( 7 );
+    std::uniform_int_distribution<int> binDist( 0, numBins - 1 );
+    std::uniform_real_distribution<Scalar> valueDist( -1_ra, 1_ra );
+    VolumeSparse::Container samples;
+    std::map<int, Scalar> expected;
+    for ( int i = 0; i < 5000; ++i ) {
+        samples.emplace_back( binDist( gen ), valueDist( gen ) );
+        expected[samples.back().index] += samples.back().value;
+    }
+
+    SECTION( "Add to bins" ) {
+        VolumeSparse volume;
+        volume.setSize( size );
+        for ( const auto& s : samples ) {
+            REQUIRE( volume.addToBin( s.value, binOf( s.index ) ) );
+        }
+        REQUIRE( !volume.addToBin( 1_ra, size ) );
+        REQUIRE( volume.getNumSamples() == expected.size() );
+        for ( int idx = 0; idx < numBins; ++idx ) {
+            const auto value = volume.getBinValue( binOf( idx ) );
+            const auto it    = expected.find( idx );
+            REQUIRE( value.has_value() == ( it != expected.end() ) );
+            if ( value ) { REQUIRE( *value == Approx( it->second ).margin( 1e-5 ) ); }
+        }
+
+        size_t count = 0;
+        volume.forEachSample( [&]( int idx, Scalar value ) {
+            REQUIRE( expected.count( idx ) == 1 );
+            REQUIRE( value == *volume.getBinValue( binOf( idx ) ) );
+            ++count;
+        } );
+        REQUIRE( count == expected.size() );
+    }
+
+    SECTION( "Parallel fill" ) {
+        VolumeSparse reference;
+        reference.setSize( size );
+        for ( const auto& s : samples ) {
+            reference.addToBin( s.value, binOf( s.index ) );
+        }
+
+        TaskQueue taskQueue( 3 );
+        setParallelTaskQueue( &taskQueue );
+        VolumeSparse volume;
+        volume.setSize( size );
+        // out of bounds samples are ignored
+        auto allSamples = samples;
+        allSamples.emplace_back( -1, 1_ra );
+        allSamples.emplace_back( numBins, 1_ra );
+        // fill in two batches, the second one adding to existing bricks.
+        const VolumeSparse::Container first( allSamples.begin(), allSamples.begin() + 2000 );
+        const VolumeSparse::Container second( allSamples.begin() + 2000, allSamples.end() );
+        volume.addToBins( first );
+        volume.addToBins( second );
+        setParallelTaskQueue( nullptr );
+
+        REQUIRE( volume.getNumSamples() == reference.getNumSamples() );
+        REQUIRE( volume.getNumBricks() == reference.getNumBricks() );
+        for ( int idx = 0; idx < numBins; ++idx ) {
+            // same order of additions, hence same values.
+            REQUIRE( volume.getBinValue( binOf( idx ) ) == reference.getBinValue( binOf( idx ) ) );
+        }
+    }
+
+    SECTION( "Conversion to and from VolumeGrid" ) {
+        VolumeSparse volume;
+        volume.setSize( size );
+        volume.setBinSize( Vector3( 0.5_ra, 1_ra, 2_ra ) );
+        volume.addToBins( samples );
+
+        const VolumeGrid grid = volume.toGrid( 10_ra );
+        REQUIRE( grid.size() == size );
+        REQUIRE( grid.binSize() == volume.binSize() );
+        for ( int idx = 0; idx < numBins; ++idx ) {
+            const auto it = expected.find( idx );
+            REQUIRE( *grid.getBinValue( binOf( idx ) ) ==
+                     ( it != expected.end() ? *volume.getBinValue( binOf( idx ) ) : 10_ra ) );
+        }
+
+        const VolumeSparse back( grid, 10_ra );
+        REQUIRE( back.size() == size );
+        REQUIRE( back.binSize() == volume.binSize() );
+        REQUIRE( back.getNumSamples() == volume.getNumSamples() );
+        for ( int idx = 0; idx < numBins; ++idx ) {
+            REQUIRE( back.getBinValue( binOf( idx ) ) == volume.getBinValue( binOf( idx ) ) );
+        }
+
+        // a single bin, far from the origin, allocates a single brick.
+        VolumeGrid sparseGrid;
+        sparseGrid.setSize( size );
+        sparseGrid.addToBin( 3_ra, Vector3i( 36, 20, 17 ) );
+        const VolumeSparse fromSparseGrid( sparseGrid );
+        REQUIRE( fromSparseGrid.getNumBricks() == 1 );
+        REQUIRE( fromSparseGrid.getNumSamples() == 1 );
+        REQUIRE( *fromSparseGrid.getBinValue( Vector3i( 36, 20, 17 ) ) == 3_ra );
+        REQUIRE( !fromSparseGrid.getBinValue( Vector3i( 0, 0, 0 ) ) );
+    }
+
+    SECTION( "Resize clears the samples" ) {
+        VolumeSparse volume;
+        volume.setSize( size );
+        volume.addToBins( samples );
+        volume.setSize( size );
+        REQUIRE( volume.getNumSamples() == 0 );
+        REQUIRE( volume.getNumBricks() == 0 );
+        REQUIRE( !volume.getBinValue( binOf( samples[0].index ) ) );
+    }
+}
@@ -0,0 +1,174 @@
+#include <catch2/catch.hpp>
+
+#include <Core/Asset/FileData.hpp>
+#include <Core/Asset/FileLoaderInterface.hpp>
+#include <Engine/RadiumEngine.hpp>
+#include <Engine/Scene/Component.hpp>
+#include <Engine/Scene/Entity.hpp>
+#include <Engine/Scene/EntityManager.hpp>
+#include <Engine/Scene/SignalManager.hpp>
+#include <Engine/Scene/System.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <vector>
+
+using namespace Ra::Engine::Scene;
+using FileLoadingStep = SignalManager::FileLoadingStep;
+
+/// Loader of the ".foo" files, that counts the files it parses.
+class FooLoader : public Ra::Core::Asset::FileLoaderInterface
+{
+  public:
+    std::vector<std::string> getFileExtensions() const override { return { "*.foo" }; }
+    bool handleFileExtension( const std::string& extension ) const override {
+        return extension == "foo";
+    }
+    Ra::Core::Asset::FileData* loadFile( const std::string& filename ) override {
+        ++m_parsed;
+        return new Ra::Core::Asset::FileData( filename );
+    }
+    std::string name() const override { return "foo"; }
+
+    std::atomic<int> m_parsed { 0 };
+};
+
+/// Loader of the ".slow" files, whose parsing waits until m_release is set.
+class SlowLoader : public Ra::Core::Asset::FileLoaderInterface
+{
+  public:
+    std::vector<std::string> getFileExtensions() const override { return { "*.slow" }; }
+    bool handleFileExtension( const std::string& extension ) const override {
+        return extension == "slow";
+    }
+    Ra::Core::Asset::FileData* loadFile( const std::string& filename ) override {
+        m_released.wait();
+        return new Ra::Core::Asset::FileData( filename );
+    }
+    std::string name() const override { return "slow"; }
+
+    std::promise<void> m_release;
+    std::shared_future<void> m_released { m_release.get_future() };
+};
+
+class FooComponent : public Component
+{
+  public:
+    using Component::Component;
+    void initialize() override { m_initialized = true; }
+    bool m_initialized { false };
+};
+
+/// System adding a FooComponent to the root entity of each loaded file.
+class FooSystem : public System
+{
+  public:
+    void handleAssetLoading( Entity* entity, const Ra::Core::Asset::FileData* ) override {
+        registerComponent( entity, new FooComponent( "foo", entity ) );
+    }
+    void generateTasks( Ra::Core::TaskQueue*, const Ra::Engine::FrameInfo& ) override {}
+};
+
+TEST_CASE( "Engine/RadiumEngine/loadFileAsync", "[Engine][RadiumEngine][loadFileAsync]" ) {
+    auto engine = Ra::Engine::RadiumEngine::createInstance();
+    engine->initialize();
+    auto loader = std::make_shared<FooLoader>();
+    engine->registerFileLoader( loader );
+    engine->registerSystem( "FooSystem", new FooSystem );
+
+    std::vector<std::pair<std::string, FileLoadingStep>> steps;
+    auto& notifier = engine->getSignalManager()->getFileLoadingNotifier();
+    int id         = notifier.attach( [&steps]( const std::string& file, FileLoadingStep step ) {
+        steps.emplace_back( file, step );
+    } );
+
+    auto numEntities = engine->getEntityManager()->getEntities().size();
+    auto first       = engine->loadFileAsync( "first.foo" );
+    auto second      = engine->loadFileAsync( "second.foo" );
+    auto invalid     = engine->loadFileAsync( "invalid.bar" );
+
+    // Nothing is added to the scene before the engine processes the parsed files.
+    REQUIRE( engine->getEntityManager()->getEntities().size() == numEntities );
+    REQUIRE( steps.size() == 3 );
+    REQUIRE( steps[0].second == FileLoadingStep::Started );
+
+    engine->waitForAsyncLoads();
+    REQUIRE( loader->m_parsed == 2 );
+    REQUIRE( first.get() );
+    REQUIRE( second.get() );
+    REQUIRE( !invalid.get() );
+    REQUIRE( engine->getEntityManager()->entityExists( "first" ) );
+    REQUIRE( engine->getEntityManager()->entityExists( "second" ) );
+    auto entity = engine->getEntityManager()->getEntity( "first" );
+    REQUIRE( entity->getComponents().size() == 1 );
+    REQUIRE( static_cast<FooComponent*>( entity->getComponents()[0].get() )->m_initialized );
+
+    auto count = [&steps]( const std::string& file, FileLoadingStep step ) {
+        return std::count( steps.begin(), steps.end(), std::make_pair( file, step ) );
+    };
+    REQUIRE( count( "first.foo", FileLoadingStep::Parsed ) == 1 );
+    REQUIRE( count( "first.foo", FileLoadingStep::Loaded ) == 1 );
+    REQUIRE( count( "invalid.bar", FileLoadingStep::Failed ) == 1 );
+    REQUIRE( count( "invalid.bar", FileLoadingStep::Loaded ) == 0 );
+
+    // At most one parsed file is added to the scene at the end of each frame.
+    auto third  = engine->loadFileAsync( "third.foo" );
+    auto fourth = engine->loadFileAsync( "fourth.foo" );
+    while ( count( "third.foo", FileLoadingStep::Parsed ) == 0 ||
+            count( "fourth.foo", FileLoadingStep::Parsed ) == 0 ) {
+        engine->processAsyncLoads( 0 );
+    }
+    engine->endFrameSync();
+    REQUIRE( engine->getEntityManager()->entityExists( "third" ) );
+    REQUIRE( !engine->getEntityManager()->entityExists( "fourth" ) );
+    REQUIRE( engine->processAsyncLoads() == 0 );
+    REQUIRE( engine->getEntityManager()->entityExists( "fourth" ) );
+    REQUIRE( third.get() );
+    REQUIRE( fourth.get() );
+
+    notifier.detach( id );
+    engine->cleanup();
+    Ra::Engine::RadiumEngine::destroyInstance();
+}
+
+TEST_CASE( "Engine/RadiumEngine/loadFileAsync/order", "[Engine][RadiumEngine][loadFileAsync]" ) {
+    auto engine = Ra::Engine::RadiumEngine::createInstance();
+    engine->initialize();
+    auto slowLoader = std::make_shared<SlowLoader>();
+    engine->registerFileLoader( std::make_shared<FooLoader>() );
+    engine->registerFileLoader( slowLoader );
+    engine->registerSystem( "FooSystem", new FooSystem );
+
+    std::vector<std::pair<std::string, FileLoadingStep>> steps;
+    auto& notifier = engine->getSignalManager()->getFileLoadingNotifier();
+    int id         = notifier.attach( [&steps]( const std::string& file, FileLoadingStep step ) {
+        steps.emplace_back( file, step );
+    } );
+    auto find = [&steps]( const std::string& file, FileLoadingStep step ) {
+        return std::find( steps.begin(), steps.end(), std::make_pair( file, step ) );
+    };
+
+    // The first file is parsed after the second one, but added to the scene before it.
+    auto slow = engine->loadFileAsync( "slow.slow" );
+    auto fast = engine->loadFileAsync( "fast.foo" );
+    while ( find( "fast.foo", FileLoadingStep::Parsed ) == steps.end() ) {
+        REQUIRE( engine->processAsyncLoads( 2 ) == 2 );
+    }
+    REQUIRE( engine->processAsyncLoads( 2 ) == 2 );
+    REQUIRE( !engine->getEntityManager()->entityExists( "fast" ) );
+    REQUIRE( find( "slow.slow", FileLoadingStep::Parsed ) == steps.end() );
+
+    slowLoader->m_release.set_value();
+    engine->waitForAsyncLoads();
+    REQUIRE( slow.get() );
+    REQUIRE( fast.get() );
+    REQUIRE( engine->getEntityManager()->entityExists( "slow" ) );
+    REQUIRE( engine->getEntityManager()->entityExists( "fast" ) );
+    REQUIRE( find( "slow.slow", FileLoadingStep::Loaded ) <
+             find( "fast.foo", FileLoadingStep::Loaded ) );
+
+    notifier.detach( id );
+    engine->cleanup();
+    Ra::Engine::RadiumEngine::destroyInstance();
+}
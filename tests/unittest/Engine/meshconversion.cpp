@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+
+#include <Core/Asset/GeometryData.hpp>
+#include <Core/Geometry/TriangleMesh.hpp>
+#include <Core/Asset/FileData.hpp>
+#include <Engine/Data/Mesh.hpp>
+#include <Engine/RadiumEngine.hpp>
+#include <Engine/Scene/Entity.hpp>
+#include <Engine/Scene/EntityManager.hpp>
+#include <Engine/Scene/GeometryComponent.hpp>
+#include <Engine/Scene/GeometrySystem.hpp>
+
+using namespace Ra::Core;
+
+TEST_CASE( "Engine/Data/Mesh/GeometryData", "[Engine][Engine/Data][Mesh]" ) {
+    Geometry::TriangleMesh ref;
+    ref.setVertices( { { 0_ra, 0_ra, 0_ra }, { 1_ra, 0_ra, 0_ra }, { 0_ra, 1_ra, 0_ra } } );
+    ref.setNormals( { { 0_ra, 0_ra, 1_ra }, { 0_ra, 0_ra, 1_ra }, { 0_ra, 0_ra, 1_ra } } );
+    ref.setIndices( { { 0, 1, 2 } } );
+
+    Asset::GeometryData data( "triangle", Asset::GeometryData::TRI_MESH );
+    auto& geo = data.getGeometry();
+    geo.setVertices( ref.vertices() );
+    geo.setNormals( ref.normals() );
+    auto layer          = std::make_unique<Geometry::TriangleIndexLayer>();
+    layer->collection() = ref.getIndices();
+    geo.addLayer( std::move( layer ), false, "indices" );
+
+    SECTION( "Copy" ) {
+        auto mesh =
+            Ra::Engine::Data::createCoreMeshFromGeometryData<Geometry::TriangleMesh>( &data );
+        REQUIRE( mesh.vertices() == ref.vertices() );
+        REQUIRE( mesh.normals() == ref.normals() );
+        REQUIRE( mesh.getIndices() == ref.getIndices() );
+        REQUIRE( geo.vertices() == ref.vertices() );
+    }
+
+    SECTION( "Move" ) {
+        const auto* vertices = geo.vertices().data();
+        auto mesh =
+            Ra::Engine::Data::moveCoreMeshFromGeometryData<Geometry::TriangleMesh>( &data );
+        // The attribute arrays are moved, not cloned.
+        REQUIRE( mesh.vertices().data() == vertices );
+        REQUIRE( mesh.vertices() == ref.vertices() );
+        REQUIRE( mesh.normals() == ref.normals() );
+        REQUIRE( mesh.getIndices() == ref.getIndices() );
+        // The geometry is moved, the other data are kept.
+        REQUIRE( geo.vertices().empty() );
+        REQUIRE( !( geo.layerKeys().begin() != geo.layerKeys().end() ) );
+        REQUIRE( data.getName() == "triangle" );
+    }
+}
+
+TEST_CASE( "Engine/Scene/GeometrySystem/consume", "[Engine][Engine/Scene][GeometrySystem]" ) {
+    using namespace Ra::Engine::Scene;
+    auto engine = Ra::Engine::RadiumEngine::createInstance();
+    engine->initialize();
+    auto system = new GeometrySystem;
+    system->setConsumeGeometryData( true );
+    REQUIRE( system->isConsumingGeometryData() );
+    engine->registerSystem( "GeometrySystem", system );
+
+    Geometry::TriangleMesh ref;
+    ref.setVertices( { { 0_ra, 0_ra, 0_ra }, { 1_ra, 0_ra, 0_ra }, { 0_ra, 1_ra, 0_ra } } );
+    ref.setIndices( { { 0, 1, 2 } } );
+
+    Asset::FileData fileData( "triangle.tri" );
+    fileData.m_geometryData.push_back(
+        std::make_unique<Asset::GeometryData>( "triangle", Asset::GeometryData::TRI_MESH ) );
+    auto& geo = fileData.m_geometryData.front()->getGeometry();
+    geo.setVertices( ref.vertices() );
+    auto layer          = std::make_unique<Geometry::TriangleIndexLayer>();
+    layer->collection() = ref.getIndices();
+    geo.addLayer( std::move( layer ), false, "indices" );
+    const auto* vertices = geo.vertices().data();
+
+    auto entity = engine->getEntityManager()->createEntity( "triangle" );
+    system->handleAssetLoading( entity, &fileData );
+
+    REQUIRE( entity->getComponents().size() == 1 );
+    auto comp = dynamic_cast<TriangleMeshComponent*>( entity->getComponents().front().get() );
+    REQUIRE( comp != nullptr );
+    const auto& mesh = comp->getCoreGeometry();
+    REQUIRE( mesh.vertices() == ref.vertices() );
+    REQUIRE( mesh.getIndices() == ref.getIndices() );
+    // The loaded geometry is handed over to the component.
+    REQUIRE( mesh.vertices().data() == vertices );
+    REQUIRE( geo.vertices().empty() );
+
+    engine->cleanup();
+    Ra::Engine::RadiumEngine::destroyInstance();
+}
@@ -4,8 +4,11 @@
 #include <Core/Utils/Color.hpp>
 #include <Engine/Data/RenderParameters.hpp>
 #include <Engine/Data/Texture.hpp>
+#include <Engine/Data/UniformCache.hpp>
 #include <Engine/RadiumEngine.hpp>
 
+#include <map>
+
 using namespace Ra::Engine::Data;
 using namespace Ra::Core;
 using namespace Ra::Core::Utils;
@@ -75,6 +78,31 @@ class StaticPrintVisitor
     }
 };
 
+/// Binds the parameters through a binding plan as RenderParameters::bind() does, with the fake
+/// uniform locations of m_locations.
+class PlanBinder
+{
+  public:
+    using types = RenderParameters::BindableTypes;
+
+    struct Context {
+        UniformBindingPlans::Plan& m_plan;
+        const std::map<std::string, int>& m_locations;
+        std::vector<std::pair<std::string, int>> m_bound {};
+        int m_queries { 0 };
+    };
+
+    template <typename T>
+    void operator()( const std::string& name, const T&, Context&& context ) {
+        auto query = [&context]( const std::string& n ) {
+            ++context.m_queries;
+            return context.m_locations.at( n );
+        };
+        const int location = context.m_plan.getLocation( context.m_bound.size(), name, query );
+        context.m_bound.emplace_back( name, location );
+    }
+};
+
 TEST_CASE( "Engine/Data/RenderParameters", "[Engine][Engine/Data][RenderParameters]" ) {
     using RP = RenderParameters;
     SECTION( "Parameter storage" ) {
@@ -343,3 +371,96 @@ TEST_CASE( "Engine/Data/RenderParameters", "[Engine][Engine/Data][RenderParamete
         paramsToVisit.visit( vstr, "Visiting with subparameters" );
     }
 }
+
+TEST_CASE( "Engine/Data/UniformCache", "[Engine][Engine/Data][RenderParameters]" ) {
+    SECTION( "Locations and values" ) {
+        UniformCache cache;
+        REQUIRE( cache.getLinkId() == 0 );
+        cache.setLinkId( 1 );
+        int queries = 0;
+        auto query  = [&queries]( const std::string& name ) {
+            ++queries;
+            return name == "color" ? 3 : -1;
+        };
+        REQUIRE( cache.getLocation( std::string( "color" ), query ) == 3 );
+        REQUIRE( cache.getLocation( "color", query ) == 3 );
+        REQUIRE( cache.getLocation( "missing", query ) == -1 );
+        REQUIRE( cache.getLocation( "missing", query ) == -1 );
+        REQUIRE( queries == 2 );
+
+        float value   = 1.f;
+        double dvalue = 1.;
+        REQUIRE( cache.updateValue( 3, &value, sizeof( value ) ) );
+        REQUIRE( !cache.updateValue( 3, &value, sizeof( value ) ) );
+        value = 2.f;
+        REQUIRE( cache.updateValue( 3, &value, sizeof( value ) ) );
+        REQUIRE( cache.updateValue( 3, &dvalue, sizeof( dvalue ) ) );
+        REQUIRE( !cache.updateValue( 3, &dvalue, sizeof( dvalue ) ) );
+        REQUIRE( cache.updateValue( 0, &value, sizeof( value ) ) );
+
+        // Setting the same link keeps the cache.
+        cache.setLinkId( 1 );
+        REQUIRE( !cache.updateValue( 3, &dvalue, sizeof( dvalue ) ) );
+        REQUIRE( cache.getLocation( "color", query ) == 3 );
+        REQUIRE( queries == 2 );
+
+        // A new link resets the values and the locations.
+        cache.setLinkId( 2 );
+        REQUIRE( cache.getLinkId() == 2 );
+        REQUIRE( cache.updateValue( 3, &dvalue, sizeof( dvalue ) ) );
+        REQUIRE( cache.updateValue( 0, &value, sizeof( value ) ) );
+        REQUIRE( cache.getLocation( "color", query ) == 3 );
+        REQUIRE( queries == 3 );
+    }
+
+    SECTION( "Binding plans" ) {
+        const std::map<std::string, int> locations {
+            { "a", 0 }, { "b", 1 }, { "c", 2 }, { "d", 3 }, { "e", 4 } };
+        UniformBindingPlans plans;
+        RenderParameters params;
+        params.addParameter( "a", 1 );
+        params.addParameter( "b", 2_ra );
+        params.addParameter( "c", true );
+        params.addParameter( "d", 3 );
+
+        auto bind = [&plans, &locations, &params]( std::uint64_t linkId ) {
+            auto& plan = plans.getPlan( linkId );
+            PlanBinder::Context context { plan, locations };
+            params.visit( PlanBinder {}, context );
+            plan.resize( context.m_bound.size() );
+            REQUIRE( plan.size() == context.m_bound.size() );
+            for ( const auto& bound : context.m_bound ) {
+                REQUIRE( bound.second == locations.at( bound.first ) );
+            }
+            return context;
+        };
+
+        auto first = bind( 1 );
+        REQUIRE( first.m_bound.size() == 4 );
+        REQUIRE( first.m_queries == 4 );
+        REQUIRE( bind( 1 ).m_queries == 0 );
+        REQUIRE( plans.size() == 1 );
+
+        // Removing the first bound parameter shifts the following ones, which are queried again.
+        const auto removed = first.m_bound.front().first;
+        if ( removed == "b" ) { REQUIRE( params.removeParameter<Scalar>( removed ) ); }
+        else if ( removed == "c" ) { REQUIRE( params.removeParameter<bool>( removed ) ); }
+        else { REQUIRE( params.removeParameter<int>( removed ) ); }
+        auto afterRemove = bind( 1 );
+        REQUIRE( afterRemove.m_bound.size() == 3 );
+        REQUIRE( afterRemove.m_queries == 3 );
+        REQUIRE( bind( 1 ).m_queries == 0 );
+
+        // Added parameters are queried.
+        params.addParameter( "e", 4 );
+        auto afterAdd = bind( 1 );
+        REQUIRE( afterAdd.m_bound.size() == 4 );
+        REQUIRE( afterAdd.m_queries >= 1 );
+        REQUIRE( bind( 1 ).m_queries == 0 );
+
+        // Each linked program has its own plan.
+        REQUIRE( bind( 2 ).m_queries == 4 );
+        REQUIRE( plans.size() == 2 );
+        REQUIRE( bind( 1 ).m_queries == 0 );
+    }
+}
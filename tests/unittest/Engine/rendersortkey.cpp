@@ -0,0 +1,69 @@
+#include <Engine/Rendering/RenderSortKey.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Ra::Core;
+using namespace Ra::Engine::Rendering;
+using Bucket = RenderSortKey::Bucket;
+
+TEST_CASE( "Engine/Rendering/RenderSortKey", "[Engine][Engine/Rendering][RenderSortKey]" ) {
+    SECTION( "Depth quantization preserves the order" ) {
+        REQUIRE( RenderSortKey::quantizeDepth( -3_ra ) == 0 );
+        REQUIRE( RenderSortKey::quantizeDepth( 0_ra ) == 0 );
+        Scalar previous = 0_ra;
+        for ( Scalar depth : { 1e-3_ra, 0.1_ra, 0.5_ra, 1_ra, 2_ra, 10_ra, 1000_ra, 1e6_ra } ) {
+            REQUIRE( RenderSortKey::quantizeDepth( previous ) <
+                     RenderSortKey::quantizeDepth( depth ) );
+            previous = depth;
+        }
+        REQUIRE( RenderSortKey::quantizeDepth( 1e30_ra ) <= RenderSortKey::FieldMask );
+    }
+
+    SECTION( "Fields are packed and read back" ) {
+        for ( auto bucket : { Bucket::Opaque, Bucket::Transparent, Bucket::Volumetric } ) {
+            const auto key = RenderSortKey::make( bucket, 42, 7, 3_ra );
+            REQUIRE( RenderSortKey::getBucket( key ) == bucket );
+            REQUIRE( RenderSortKey::getShader( key ) == 42 );
+            REQUIRE( RenderSortKey::getParameters( key ) == 7 );
+        }
+    }
+
+    SECTION( "Opaque objects are grouped by state, then front to back" ) {
+        using Key = RenderSortKey::Key;
+        // buckets first
+        REQUIRE( RenderSortKey::make( Bucket::Opaque, 9, 9, 100_ra ) <
+                 RenderSortKey::make( Bucket::Transparent, 0, 0, 1_ra ) );
+        REQUIRE( RenderSortKey::make( Bucket::Transparent, 9, 9, 1_ra ) <
+                 RenderSortKey::make( Bucket::Volumetric, 0, 0, 100_ra ) );
+
+        std::vector<Key> keys { RenderSortKey::make( Bucket::Opaque, 2, 1, 1_ra ),
+                                RenderSortKey::make( Bucket::Opaque, 1, 2, 5_ra ),
+                                RenderSortKey::make( Bucket::Opaque, 2, 0, 10_ra ),
+                                RenderSortKey::make( Bucket::Opaque, 1, 2, 2_ra ),
+                                RenderSortKey::make( Bucket::Opaque, 1, 1, 50_ra ) };
+        std::sort( keys.begin(), keys.end() );
+        REQUIRE( keys == std::vector<Key> { RenderSortKey::make( Bucket::Opaque, 1, 1, 50_ra ),
+                                            RenderSortKey::make( Bucket::Opaque, 1, 2, 2_ra ),
+                                            RenderSortKey::make( Bucket::Opaque, 1, 2, 5_ra ),
+                                            RenderSortKey::make( Bucket::Opaque, 2, 0, 10_ra ),
+                                            RenderSortKey::make( Bucket::Opaque, 2, 1, 1_ra ) } );
+    }
+
+    SECTION( "Blended objects are sorted back to front" ) {
+        REQUIRE( RenderSortKey::make( Bucket::Transparent, 9, 9, 10_ra ) <
+                 RenderSortKey::make( Bucket::Transparent, 0, 0, 1_ra ) );
+        REQUIRE( RenderSortKey::make( Bucket::Transparent, 0, 1, 5_ra ) <
+                 RenderSortKey::make( Bucket::Transparent, 1, 0, 5_ra ) );
+    }
+
+    SECTION( "Ids are truncated" ) {
+        const auto key = RenderSortKey::make(
+            Bucket::Opaque, RenderSortKey::FieldMask + 3, RenderSortKey::FieldMask + 4, 0_ra );
+        REQUIRE( RenderSortKey::getBucket( key ) == Bucket::Opaque );
+        REQUIRE( RenderSortKey::getShader( key ) == 2 );
+        REQUIRE( RenderSortKey::getParameters( key ) == 3 );
+    }
+}
@@ -0,0 +1,199 @@
+#include <Core/Asset/GeometryData.hpp>
+#include <Core/Asset/HandleData.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+#include <IO/AssimpLoader/AssimpGeometryDataLoader.hpp>
+#include <IO/AssimpLoader/AssimpHandleDataLoader.hpp>
+#include <catch2/catch.hpp>
+
+#include <assimp/mesh.h>
+#include <assimp/scene.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr unsigned int numVertices = 500;
+
+aiMatrix4x4 translation( float x, float y, float z ) {
+    aiMatrix4x4 m;
+    aiMatrix4x4::Translation( aiVector3D( x, y, z ), m );
+    return m;
+}
+
+aiNode* createNode( const std::string& name, const aiMatrix4x4& transform ) {
+    auto node             = new aiNode( name );
+    node->mTransformation = transform;
+    return node;
+}
+
+aiNode* createMeshNode( const std::string& name, unsigned int mesh ) {
+    auto node        = new aiNode( name );
+    node->mNumMeshes = 1;
+    node->mMeshes    = new unsigned int[1] { mesh };
+    return node;
+}
+
+/// Skinning weights of the bone \p b in the mesh \p m, on one vertex over two.
+aiBone* createBone( const std::string& name, unsigned int m, unsigned int b ) {
+    auto bone           = new aiBone;
+    bone->mName         = aiString( name );
+    bone->mOffsetMatrix = translation( float( m ), float( b ), 0.f );
+    bone->mNumWeights   = numVertices / 2;
+    bone->mWeights      = new aiVertexWeight[bone->mNumWeights];
+    for ( unsigned int i = 0; i < bone->mNumWeights; ++i ) {
+        bone->mWeights[i] =
+            aiVertexWeight( 2 * i + b, float( i + m * numVertices ) / float( 4 * numVertices ) );
+    }
+    return bone;
+}
+
+/// A triangle strip, skinned by \p bones.
+aiMesh* createMesh( const std::string& name,
+                    unsigned int m,
+                    const std::vector<std::string>& bones ) {
+    auto mesh             = new aiMesh;
+    mesh->mName           = aiString( name );
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices    = numVertices;
+    mesh->mVertices       = new aiVector3D[numVertices];
+    for ( unsigned int i = 0; i < numVertices; ++i ) {
+        mesh->mVertices[i] = aiVector3D( float( i / 2 ), float( i % 2 ), float( m ) );
+    }
+    mesh->mNumFaces = numVertices - 2;
+    mesh->mFaces    = new aiFace[mesh->mNumFaces];
+    for ( unsigned int i = 0; i < mesh->mNumFaces; ++i ) {
+        mesh->mFaces[i].mNumIndices = 3;
+        mesh->mFaces[i].mIndices    = new unsigned int[3] { i, i + 1, i + 2 };
+    }
+    mesh->mNumBones = static_cast<unsigned int>( bones.size() );
+    mesh->mBones    = new aiBone*[mesh->mNumBones];
+    for ( unsigned int b = 0; b < mesh->mNumBones; ++b ) {
+        mesh->mBones[b] = createBone( bones[b], m, b );
+    }
+    return mesh;
+}
+
+/// Three meshes, the first two having the same name, skinned by a two bones skeleton whose bone
+/// "hip" is shared by the first two meshes.
+std::unique_ptr<aiScene> createScene() {
+    auto scene        = std::make_unique<aiScene>();
+    scene->mNumMeshes = 3;
+    scene->mMeshes    = new aiMesh*[scene->mNumMeshes];
+    scene->mMeshes[0] = createMesh( "body", 0, { "hip", "knee" } );
+    scene->mMeshes[1] = createMesh( "body", 1, { "hip" } );
+    scene->mMeshes[2] = createMesh( "body_", 2, { "knee" } );
+
+    auto knee     = createNode( "knee", translation( 0.f, 1.f, 0.f ) );
+    auto hip      = createNode( "hip", translation( 0.f, 1.f, 0.f ) );
+    auto armature = createNode( "armature", translation( 1.f, 0.f, 0.f ) );
+    hip->addChildren( 1, &knee );
+    armature->addChildren( 1, &hip );
+    aiNode* children[] = { armature,
+                           createMeshNode( "mesh0", 0 ),
+                           createMeshNode( "mesh1", 1 ),
+                           createMeshNode( "mesh2", 2 ) };
+    scene->mRootNode   = new aiNode( "root" );
+    scene->mRootNode->addChildren( 4, children );
+    return scene;
+}
+
+struct LoadedData {
+    std::vector<std::unique_ptr<Ra::Core::Asset::GeometryData>> m_geometries;
+    std::vector<std::unique_ptr<Ra::Core::Asset::HandleData>> m_handles;
+};
+
+LoadedData load( const aiScene* scene ) {
+    LoadedData loaded;
+    Ra::IO::AssimpGeometryDataLoader( "" ).loadData( scene, loaded.m_geometries );
+    Ra::IO::AssimpHandleDataLoader().loadData( scene, loaded.m_handles );
+    return loaded;
+}
+
+const Ra::Core::Geometry::TriangleIndexLayer::IndexContainerType&
+getTriangles( const Ra::Core::Asset::GeometryData& data ) {
+    using Ra::Core::Geometry::TriangleIndexLayer;
+    const auto& layer =
+        data.getGeometry().getFirstLayerOccurrence( TriangleIndexLayer::staticSemanticName ).second;
+    return static_cast<const TriangleIndexLayer&>( layer ).collection();
+}
+} // namespace
+
+TEST_CASE( "IO/AssimpLoader/ParallelConversion", "[IO]" ) {
+    using namespace Ra::Core;
+    using namespace Ra::Core::Asset;
+
+    auto scene = createScene();
+    // reference conversion, without task queue, i.e. sequential
+    const auto reference = load( scene.get() );
+
+    TaskQueue taskQueue( 3 );
+    setParallelTaskQueue( &taskQueue );
+    const auto loaded = load( scene.get() );
+    setParallelTaskQueue( nullptr );
+
+    SECTION( "Geometry" ) {
+        // names are disambiguated in scene order
+        const std::vector<std::string> names { "body", "body_", "body__" };
+        REQUIRE( reference.m_geometries.size() == names.size() );
+        REQUIRE( loaded.m_geometries.size() == names.size() );
+        for ( size_t m = 0; m < names.size(); ++m ) {
+            const auto& ref  = *reference.m_geometries[m];
+            const auto& data = *loaded.m_geometries[m];
+            REQUIRE( ref.getName() == names[m] );
+            REQUIRE( data.getName() == names[m] );
+            REQUIRE( data.getType() == ref.getType() );
+            REQUIRE( data.getPrimitiveCount() == ref.getPrimitiveCount() );
+            REQUIRE( data.getGeometry().vertices() == ref.getGeometry().vertices() );
+            REQUIRE( data.getGeometry().vertices().size() == numVertices );
+            REQUIRE( data.getGeometry().vertices()[1].z() == Scalar( m ) );
+            REQUIRE( getTriangles( data ) == getTriangles( ref ) );
+            REQUIRE( data.getFrame().isApprox( ref.getFrame() ) );
+        }
+    }
+
+    SECTION( "Handles" ) {
+        REQUIRE( reference.m_handles.size() == 1 );
+        REQUIRE( loaded.m_handles.size() == 1 );
+        const auto& ref    = *reference.m_handles[0];
+        const auto& handle = *loaded.m_handles[0];
+        REQUIRE( handle.getName() == ref.getName() );
+        REQUIRE( handle.getFrame().isApprox( ref.getFrame() ) );
+        REQUIRE( handle.getEdgeData() == ref.getEdgeData() );
+        REQUIRE( handle.getComponentDataSize() == ref.getComponentDataSize() );
+        for ( uint i = 0; i < handle.getComponentDataSize(); ++i ) {
+            const auto& refBone = ref.getComponentData()[i];
+            const auto& bone    = handle.getComponentData()[i];
+            REQUIRE( bone.m_name == refBone.m_name );
+            REQUIRE( bone.m_frame.isApprox( refBone.m_frame ) );
+            REQUIRE( bone.m_weights == refBone.m_weights );
+            REQUIRE( bone.m_bindMatrices.size() == refBone.m_bindMatrices.size() );
+            for ( const auto& bind : refBone.m_bindMatrices ) {
+                auto it = bone.m_bindMatrices.find( bind.first );
+                REQUIRE( it != bone.m_bindMatrices.end() );
+                REQUIRE( it->second.isApprox( bind.second ) );
+            }
+        }
+
+        // the bone shared by the two meshes named "body" has the weights of both
+        const auto& hip = handle.getComponentData()[handle.getIndexOf( "hip" )];
+        REQUIRE( hip.m_weights.size() == 2 );
+        const auto& mesh0 = hip.m_weights.at( "body" );
+        const auto& mesh1 = hip.m_weights.at( "body_" );
+        REQUIRE( mesh0.size() == numVertices / 2 );
+        REQUIRE( mesh1.size() == numVertices / 2 );
+        for ( uint i = 0; i < numVertices / 2; ++i ) {
+            const aiVertexWeight& w0 = scene->mMeshes[0]->mBones[0]->mWeights[i];
+            const aiVertexWeight& w1 = scene->mMeshes[1]->mBones[0]->mWeights[i];
+            REQUIRE( mesh0[i] == std::make_pair( w0.mVertexId, Scalar( w0.mWeight ) ) );
+            REQUIRE( mesh1[i] == std::make_pair( w1.mVertexId, Scalar( w1.mWeight ) ) );
+        }
+        REQUIRE( hip.m_bindMatrices.at( "body" ).translation().isApprox( Vector3( 0, 0, 0 ) ) );
+        REQUIRE( hip.m_bindMatrices.at( "body_" ).translation().isApprox( Vector3( 1, 0, 0 ) ) );
+        const auto& knee = handle.getComponentData()[handle.getIndexOf( "knee" )];
+        REQUIRE( knee.m_weights.size() == 2 );
+        REQUIRE( knee.m_bindMatrices.at( "body" ).translation().isApprox( Vector3( 0, 1, 0 ) ) );
+        REQUIRE( knee.m_bindMatrices.at( "body__" ).translation().isApprox( Vector3( 2, 0, 0 ) ) );
+    }
+}
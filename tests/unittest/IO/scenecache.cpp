@@ -0,0 +1,254 @@
+#include <Core/Asset/BlinnPhongMaterialData.hpp>
+#include <Core/Asset/FileData.hpp>
+#include <Core/Geometry/StandardAttribNames.hpp>
+#include <IO/SceneCache/SceneCacheFileLoader.hpp>
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+using namespace Ra::Core;
+using namespace Ra::Core::Asset;
+using namespace Ra::IO;
+
+namespace {
+/// Loader of the ".scene" files, creating a scene with a geometry, a skeleton, an animation, a
+/// light and a camera, and counting the files it loads.
+class SceneLoader : public FileLoaderInterface
+{
+  public:
+    std::vector<std::string> getFileExtensions() const override { return { "*.scene" }; }
+    bool handleFileExtension( const std::string& extension ) const override {
+        return extension == "scene";
+    }
+    FileData* loadFile( const std::string& filename ) override {
+        ++m_loaded;
+        auto fileData = new FileData( filename );
+
+        auto geometry = std::make_unique<GeometryData>( "quad", GeometryData::QUAD_MESH );
+        geometry->setFrame( Transform( Translation( Vector3( 1, 2, 3 ) ) ) );
+        geometry->setPrimitiveCount( 1 );
+        auto& geo = geometry->getGeometry();
+        geo.setVertices( { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } } );
+        geo.setNormals( { { 0, 0, 1 }, { 0, 0, 1 }, { 0, 0, 1 }, { 0, 0, 1 } } );
+        auto quality = geo.addAttrib<Scalar>( "quality" );
+        geo.getAttrib( quality ).setData( { 1, 2, 3, 4 } );
+        auto texCoord = geo.addAttrib<Vector3>(
+            Geometry::getAttribName( Geometry::MeshAttrib::VERTEX_TEXCOORD ) );
+        geo.getAttrib( texCoord ).setData( { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } } );
+        auto quads = std::make_unique<Geometry::QuadIndexLayer>();
+        quads->collection().push_back( { 0, 1, 2, 3 } );
+        geo.addLayer( std::move( quads ), false, "indices" );
+        auto polys = std::make_unique<Geometry::PolyIndexLayer>();
+        polys->collection().push_back( VectorNui::LinSpaced( 3, 0, 2 ) );
+        polys->collection().push_back( VectorNui::LinSpaced( 4, 0, 3 ) );
+        geo.addLayer( std::move( polys ), false, "polygons" );
+        auto material            = new BlinnPhongMaterialData( "material" );
+        material->m_diffuse      = Utils::Color::Red();
+        material->m_hasDiffuse   = true;
+        material->m_texNormal    = "normal.png";
+        material->m_hasTexNormal = true;
+        geometry->setMaterial( material );
+        fileData->m_geometryData.push_back( std::move( geometry ) );
+
+        auto handle = std::make_unique<HandleData>( "skeleton", HandleData::SKELETON );
+        handle->addBindMesh( "quad" );
+        AlignedStdVector<HandleComponentData> components( 2 );
+        components[0].m_name = "root";
+        components[1].m_name = "bone";
+        components[1].m_frame.translate( Vector3( 0, 1, 0 ) );
+        components[1].m_bindMatrices["quad"] = Transform( Translation( Vector3( 0, -1, 0 ) ) );
+        components[1].m_weights["quad"]      = { { 2, 0.5_ra }, { 3, 1_ra } };
+        handle->setComponents( components );
+        handle->setEdges( { { 0, 1 } } );
+        handle->recomputeAllIndices();
+        fileData->m_handleData.push_back( std::move( handle ) );
+
+        auto animation = std::make_unique<AnimationData>( "walk" );
+        animation->setTime( AnimationTime( 0, 2 ) );
+        animation->setTimeStep( 0.5_ra );
+        HandleAnimation boneAnimation( "bone" );
+        boneAnimation.m_anim = Animation::KeyFramedValue<Transform>( 0, Transform::Identity() );
+        boneAnimation.m_anim.insertKeyFrame( 2, Transform( Translation( Vector3( 1, 0, 0 ) ) ) );
+        boneAnimation.m_animationTime = AnimationTime( 0, 2 );
+        animation->setHandleData( { boneAnimation } );
+        fileData->m_animationData.push_back( std::move( animation ) );
+
+        auto light = std::make_unique<LightData>( "spot" );
+        light->setLight( Utils::Color::White(),
+                         Vector3( 0, 0, 5 ),
+                         Vector3( 0, 0, -1 ),
+                         0.5_ra,
+                         1_ra,
+                         LightData::LightAttenuation( 1, 0.5_ra, 0 ) );
+        fileData->m_lightData.push_back( std::move( light ) );
+
+        auto camera = std::make_unique<Camera>();
+        camera->setViewport( 640, 480 );
+        camera->setFOV( 1_ra );
+        camera->setPosition( Vector3( 0, 0, 10 ) );
+        fileData->m_cameraData.push_back( std::move( camera ) );
+
+        fileData->m_processed = true;
+        return fileData;
+    }
+    std::string name() const override { return "scene"; }
+
+    int m_loaded { 0 };
+};
+} // namespace
+
+TEST_CASE( "IO/SceneCacheFileLoader", "[IO]" ) {
+    const std::string sourceFile { "scenecache.scene" };
+    auto writeSource = [&sourceFile]( const std::string& content ) {
+        std::ofstream out( sourceFile, std::ios::binary );
+        out << content;
+    };
+    writeSource( "first version" );
+
+    auto sceneLoader = std::make_shared<SceneLoader>();
+    SceneCacheFileLoader loader( sceneLoader );
+    const auto cacheFile = loader.getCacheFileName( sourceFile );
+    std::remove( cacheFile.c_str() );
+    REQUIRE( loader.handleFileExtension( "scene" ) );
+    REQUIRE( loader.name() == "SceneCache(scene)" );
+
+    std::unique_ptr<FileData> reference( loader.loadFile( sourceFile ) );
+    REQUIRE( reference != nullptr );
+    REQUIRE( sceneLoader->m_loaded == 1 );
+    REQUIRE( std::ifstream( cacheFile ).good() );
+
+    std::unique_ptr<FileData> cached( loader.loadFile( sourceFile ) );
+    REQUIRE( cached != nullptr );
+    REQUIRE( sceneLoader->m_loaded == 1 );
+    REQUIRE( cached->getFileName() == sourceFile );
+    REQUIRE( cached->isProcessed() );
+
+    SECTION( "Geometry" ) {
+        REQUIRE( cached->m_geometryData.size() == 1 );
+        const auto& ref  = *reference->m_geometryData[0];
+        const auto& data = *cached->m_geometryData[0];
+        REQUIRE( data.getName() == "quad" );
+        REQUIRE( data.isQuadMesh() );
+        REQUIRE( data.getPrimitiveCount() == 1 );
+        REQUIRE( data.getFrame().isApprox( ref.getFrame() ) );
+
+        const auto& geo = data.getGeometry();
+        REQUIRE( geo.vertices() == ref.getGeometry().vertices() );
+        REQUIRE( geo.normals() == ref.getGeometry().normals() );
+        REQUIRE( geo.vertexAttribs().getNumAttribs() ==
+                 ref.getGeometry().vertexAttribs().getNumAttribs() );
+        REQUIRE( geo.getAttrib<Scalar>( "quality" ).data() ==
+                 ref.getGeometry().getAttrib<Scalar>( "quality" ).data() );
+        const auto texCoord = Geometry::getAttribName( Geometry::MeshAttrib::VERTEX_TEXCOORD );
+        REQUIRE( geo.getAttribBase( texCoord )->isVector3() );
+
+        REQUIRE( geo.containsLayer( { Geometry::QuadIndexLayer::staticSemanticName }, "indices" ) );
+        const auto& quads = static_cast<const Geometry::QuadIndexLayer&>(
+            geo.getLayer( { { Geometry::QuadIndexLayer::staticSemanticName }, "indices" } ) );
+        REQUIRE( quads.collection().size() == 1 );
+        REQUIRE( quads.collection()[0] == Vector4ui( 0, 1, 2, 3 ) );
+        const auto& polys = static_cast<const Geometry::PolyIndexLayer&>(
+            geo.getLayer( { { Geometry::PolyIndexLayer::staticSemanticName }, "polygons" } ) );
+        REQUIRE( polys.collection().size() == 2 );
+        REQUIRE( polys.collection()[1] == VectorNui::LinSpaced( 4, 0, 3 ) );
+
+        REQUIRE( data.hasMaterial() );
+        const auto& material = static_cast<const BlinnPhongMaterialData&>( data.getMaterial() );
+        REQUIRE( material.getName() == "material" );
+        REQUIRE( material.getType() == "BlinnPhong" );
+        REQUIRE( material.hasDiffuse() );
+        REQUIRE( material.m_diffuse == Utils::Color::Red() );
+        REQUIRE( material.hasNormalTexture() );
+        REQUIRE( material.m_texNormal == "normal.png" );
+        REQUIRE( !material.hasSpecularTexture() );
+    }
+
+    SECTION( "Skeleton and animation" ) {
+        REQUIRE( cached->m_handleData.size() == 1 );
+        const auto& handle = *cached->m_handleData[0];
+        REQUIRE( handle.getName() == "skeleton" );
+        REQUIRE( handle.isSkeleton() );
+        REQUIRE( handle.getBindMeshes().count( "quad" ) == 1 );
+        REQUIRE( handle.getComponentDataSize() == 2 );
+        REQUIRE( handle.getIndexOf( "bone" ) == 1 );
+        const auto& bone = handle.getComponent( 1 );
+        REQUIRE( bone.m_frame.isApprox( reference->m_handleData[0]->getComponent( 1 ).m_frame ) );
+        REQUIRE( bone.m_bindMatrices.at( "quad" ).translation() == Vector3( 0, -1, 0 ) );
+        REQUIRE( bone.m_weights.at( "quad" ).size() == 2 );
+        REQUIRE( bone.m_weights.at( "quad" )[1].first == 3 );
+        REQUIRE( bone.m_weights.at( "quad" )[0].second == 0.5_ra );
+        REQUIRE( handle.getEdgeData().size() == 1 );
+        REQUIRE( handle.getEdgeData()[0] == Vector2ui( 0, 1 ) );
+
+        REQUIRE( cached->m_animationData.size() == 1 );
+        const auto& animation = *cached->m_animationData[0];
+        REQUIRE( animation.getName() == "walk" );
+        REQUIRE( animation.getTime().getEnd() == 2_ra );
+        REQUIRE( animation.getTimeStep() == 0.5_ra );
+        const auto handleAnimations = animation.getHandleData();
+        REQUIRE( handleAnimations.size() == 1 );
+        REQUIRE( handleAnimations[0].m_name == "bone" );
+        const auto& keyFrames = handleAnimations[0].m_anim.getKeyFrames();
+        REQUIRE( keyFrames.size() == 2 );
+        REQUIRE( keyFrames[1].first == 2_ra );
+        REQUIRE( keyFrames[1].second.translation() == Vector3( 1, 0, 0 ) );
+    }
+
+    SECTION( "Light and camera" ) {
+        REQUIRE( cached->m_lightData.size() == 1 );
+        const auto& light = *cached->m_lightData[0];
+        REQUIRE( light.getName() == "spot" );
+        REQUIRE( light.isSpotLight() );
+        REQUIRE( light.m_color == Utils::Color::White() );
+        REQUIRE( light.m_spotlight.position == Vector3( 0, 0, 5 ) );
+        REQUIRE( light.m_spotlight.outerAngle == 1_ra );
+        REQUIRE( light.m_spotlight.attenuation.linear == 0.5_ra );
+
+        REQUIRE( cached->m_cameraData.size() == 1 );
+        const auto& camera = *cached->m_cameraData[0];
+        const auto& ref    = *reference->m_cameraData[0];
+        REQUIRE( camera.getWidth() == 640 );
+        REQUIRE( camera.getFOV() == 1_ra );
+        REQUIRE( camera.getPosition().isApprox( Vector3( 0, 0, 10 ) ) );
+        REQUIRE( camera.getProjMatrix().isApprox( ref.getProjMatrix() ) );
+    }
+
+    SECTION( "Outdated and corrupted caches" ) {
+        const auto hash = SceneCacheFileLoader::hashData( "first version", 13 );
+        std::unique_ptr<FileData> data( SceneCacheFileLoader::readCache( cacheFile, hash ) );
+        REQUIRE( data != nullptr );
+        REQUIRE( SceneCacheFileLoader::readCache( cacheFile, hash + 1 ) == nullptr );
+
+        // a modified source is loaded again, and its cache is updated.
+        writeSource( "second version" );
+        std::unique_ptr<FileData> reloaded( loader.loadFile( sourceFile ) );
+        REQUIRE( reloaded != nullptr );
+        REQUIRE( sceneLoader->m_loaded == 2 );
+        REQUIRE( SceneCacheFileLoader::readCache( cacheFile, hash ) == nullptr );
+        reloaded.reset( loader.loadFile( sourceFile ) );
+        REQUIRE( sceneLoader->m_loaded == 2 );
+
+        // truncated cache
+        const auto newHash = SceneCacheFileLoader::hashData( "second version", 14 );
+        data.reset( SceneCacheFileLoader::readCache( cacheFile, newHash ) );
+        REQUIRE( data != nullptr );
+        std::string content;
+        {
+            std::ifstream in( cacheFile, std::ios::binary );
+            content.assign( std::istreambuf_iterator<char>( in ), {} );
+        }
+        {
+            std::ofstream out( cacheFile, std::ios::binary );
+            out << content.substr( 0, content.size() / 2 );
+        }
+        REQUIRE( SceneCacheFileLoader::readCache( cacheFile, newHash ) == nullptr );
+        reloaded.reset( loader.loadFile( sourceFile ) );
+        REQUIRE( reloaded != nullptr );
+        REQUIRE( sceneLoader->m_loaded == 3 );
+    }
+
+    std::remove( sourceFile.c_str() );
+    std::remove( cacheFile.c_str() );
+}
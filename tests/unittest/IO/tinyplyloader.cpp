@@ -0,0 +1,89 @@
+#include <Core/Asset/FileData.hpp>
+#include <Core/Asset/GeometryData.hpp>
+#include <Core/Geometry/StandardAttribNames.hpp>
+#include <IO/TinyPlyLoader/TinyPlyFileLoader.hpp>
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+TEST_CASE( "IO/TinyPlyFileLoader", "[IO]" ) {
+    using namespace Ra::Core;
+    using namespace Ra::Core::Asset;
+    using namespace Ra::IO;
+
+    TinyPlyFileLoader loader;
+    const int numVertices = 5;
+    // the vertex properties, preceded by an empty element, x, y, z, nx, ny, nz, red, green, blue,
+    // alpha and a custom property.
+    auto header = []( const std::string& format ) {
+        return "ply\nformat " + format +
+               " 1.0\ncomment test\nelement camera 0\nproperty float view_px\nelement vertex " +
+               std::to_string( numVertices ) +
+               "\nproperty float x\nproperty float y\nproperty float z\nproperty double "
+               "nx\nproperty double ny\nproperty double nz\nproperty uchar red\nproperty uchar "
+               "green\nproperty uchar blue\nproperty uchar alpha\nproperty float my-quality\n"
+               "end_header\n";
+    };
+    auto position = []( int i ) { return Vector3( i, 2 * i, 0.5_ra * i ); };
+    auto normal   = []( int i ) { return Vector3( 0, 1, i ).normalized(); };
+    auto color    = []( int i ) { return Vector4( 50 * i, 255 - 50 * i, 10, 255 ); };
+
+    const std::string binaryFile { "tinyplyloader_binary.ply" };
+    {
+        std::ofstream out( binaryFile, std::ios::binary );
+        out << header( "binary_little_endian" );
+        for ( int i = 0; i < numVertices; ++i ) {
+            const float p[3]   = { float( position( i ).x() ),
+                                 float( position( i ).y() ),
+                                 float( position( i ).z() ) };
+            const double n[3]  = { normal( i ).x(), normal( i ).y(), normal( i ).z() };
+            const uint8_t c[4] = { uint8_t( color( i ).x() ),
+                                   uint8_t( color( i ).y() ),
+                                   uint8_t( color( i ).z() ),
+                                   uint8_t( color( i ).w() ) };
+            const float q      = -i;
+            out.write( reinterpret_cast<const char*>( p ), sizeof( p ) );
+            out.write( reinterpret_cast<const char*>( n ), sizeof( n ) );
+            out.write( reinterpret_cast<const char*>( c ), sizeof( c ) );
+            out.write( reinterpret_cast<const char*>( &q ), sizeof( q ) );
+        }
+    }
+    const std::string asciiFile { "tinyplyloader_ascii.ply" };
+    {
+        std::ofstream out( asciiFile );
+        out << header( "ascii" );
+        for ( int i = 0; i < numVertices; ++i ) {
+            out << position( i ).transpose() << " " << normal( i ).transpose() << " "
+                << color( i ).transpose() << " " << -i << "\n";
+        }
+    }
+
+    for ( const auto& filename : { binaryFile, asciiFile } ) {
+        std::unique_ptr<FileData> fileData( loader.loadFile( filename ) );
+        REQUIRE( fileData != nullptr );
+        REQUIRE( fileData->getGeometryData().size() == 1 );
+        const auto& geometry = fileData->getGeometryData()[0]->getGeometry();
+        REQUIRE( geometry.vertices().size() == numVertices );
+        REQUIRE( geometry.normals().size() == numVertices );
+        const auto& attribs = geometry.vertexAttribs();
+        const auto& colors  = attribs
+                                 .getAttrib( attribs.findAttrib<Vector4>( Geometry::getAttribName(
+                                     Geometry::MeshAttrib::VERTEX_COLOR ) ) )
+                                 .data();
+        const auto& quality = attribs.getAttrib( attribs.findAttrib<Scalar>( "my_quality" ) ).data();
+        REQUIRE( colors.size() == numVertices );
+        REQUIRE( quality.size() == numVertices );
+        for ( int i = 0; i < numVertices; ++i ) {
+            REQUIRE( geometry.vertices()[i].isApprox( position( i ) ) );
+            REQUIRE( geometry.normals()[i].isApprox( normal( i ) ) );
+            REQUIRE( colors[i].isApprox( color( i ) / 255_ra ) );
+            REQUIRE( quality[i] == Scalar( -i ) );
+        }
+    }
+
+    std::remove( binaryFile.c_str() );
+    std::remove( asciiFile.c_str() );
+}
@@ -6,6 +6,9 @@
 #include <IO/VolumesLoader/VolumeLoader.hpp>
 #include <catch2/catch.hpp>
 
+#include <cstdio>
+#include <fstream>
+
 TEST_CASE( "IO/VolumesLoader", "[IO]" ) {
     using namespace Ra::Core;
     using namespace Ra::Core::Asset;
@@ -42,6 +45,44 @@ TEST_CASE( "IO/VolumesLoader", "[IO]" ) {
         auto handle_openvdb = loader.handleFileExtension( "vdb" );
         REQUIRE( !handle_openvdb );
     }
+    SECTION( "Loading vol data file" ) {
+        auto writeFile = []( const std::string& filename, const std::string& density ) {
+            std::ofstream out( filename );
+            out << "sigma_a [ 0.5 0.25 0.125 ]\nsigma_s [ 1 2 3 ]\nsize [ 3 2 2 ]\ndensity [ "
+                << density << " ]\n";
+        };
+        const std::string filename { "volumeloader_test.vol" };
+
+        writeFile( filename, "0 0.5 1\n1.5 2 2.5\n  3e-1 -1 1e2\t+7 8 +9" );
+        auto loadedFile = loader.loadFile( filename );
+        REQUIRE( loadedFile != nullptr );
+        auto volumeFiledata = loadedFile->getVolumeData();
+        REQUIRE( volumeFiledata.size() == 1 );
+        REQUIRE( volumeFiledata[0]->sigma_a.isApprox( Color( 0.5_ra, 0.25_ra, 0.125_ra ) ) );
+        auto volumeData = dynamic_cast<VolumeGrid*>( volumeFiledata[0]->volume );
+        REQUIRE( volumeData != nullptr );
+        REQUIRE( volumeData->size() == Vector3i( 3, 2, 2 ) );
+        const std::vector<Scalar> expected {
+            0_ra, 0.5_ra, 1_ra, 1.5_ra, 2_ra, 2.5_ra, 0.3_ra, -1_ra, 100_ra, 7_ra, 8_ra, 9_ra };
+        REQUIRE( volumeData->data().size() == expected.size() );
+        for ( size_t i = 0; i < expected.size(); ++i ) {
+            REQUIRE( Math::areApproxEqual( volumeData->data()[i], expected[i] ) );
+        }
+        delete volumeData;
+        delete loadedFile;
+
+        // wrong number of values
+        writeFile( filename, "0 1 2 3 4 5 6 7 8 9 10" );
+        REQUIRE( loader.loadFile( filename ) == nullptr );
+        writeFile( filename, "0 1 2 3 4 5 6 7 8 9 10 11 12" );
+        REQUIRE( loader.loadFile( filename ) == nullptr );
+        // invalid value
+        writeFile( filename, "0 1 2 3 4 5 6 7 8 9 10 1x" );
+        REQUIRE( loader.loadFile( filename ) == nullptr );
+        writeFile( filename, "0 1 2 3 4 5 6 7 8 9 10 +-1" );
+        REQUIRE( loader.loadFile( filename ) == nullptr );
+        std::remove( filename.c_str() );
+    }
     SECTION( "Loading PVM unkown file" ) {
         auto loadedFile = loader.loadFile( "unknown.pvm" );
         REQUIRE( loadedFile == nullptr );